@@ -177,9 +177,66 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation, and give the model trained on the last fold
+   * to the caller instead of keeping it.  Unlike Evaluate(), this does not
+   * modify the object, so it can be called by several threads at once (when
+   * Parallel() is true the folds of every call are then trained by the calling
+   * thread alone, unless nested OpenMP parallelism is enabled).
+   *
+   * @param model Pointer to store the model trained on the last fold in.
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateWithModel(std::unique_ptr<MLAlgorithm>& model,
+                           const MLAlgorithmArgs& ...args);
+
+  /**
+   * Run k-fold cross-validation like EvaluateWithModel(), but train every
+   * model on only the first part of its training subset, which holds the given
+   * fraction of the points (at least one).  The validation subsets are not
+   * changed.  This gives cheaper, rougher evaluations, which is what
+   * SuccessiveHalving and Hyperband use.
+   *
+   * @param model Pointer to store the model trained on the last fold in.
+   * @param trainingFraction Fraction of the training points to use, in
+   *     (0, 1].
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateOnSubset(std::unique_ptr<MLAlgorithm>& model,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  /**
+   * Get whether the folds are trained in parallel with OpenMP.  In that case
+   * each fold is trained with random number generators of its own (see
+   * math::LocalRandomSeed), seeded from the fold index and a seed drawn once
+   * per evaluation, so the results do not depend on the scheduling of the
+   * threads; the Armadillo generator of the calling thread is reseeded
+   * afterwards (see math::ArmaRandomSeedGuard).  The learner must be safe to train in several threads at once,
+   * and must draw its random numbers from Armadillo or from math::Random() and
+   * friends, not from another shared generator such as std::rand().  The
+   * default is false.
+   */
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds are trained in parallel.
+  bool& Parallel() { return parallel; }
+
+  /**
+   * Get the maximum number of models that are trained at the same time in
+   * parallel mode, which bounds the memory used by the models; 0 means one
+   * per OpenMP thread (the default).
+   */
+  size_t MaxConcurrentModels() const { return maxConcurrentModels; }
+  //! Modify the maximum number of models that are trained at the same time.
+  size_t& MaxConcurrentModels() { return maxConcurrentModels; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -222,6 +279,12 @@ class KFoldCV
   //! The size of each bin in terms of data points.
   size_t binSize;
 
+  //! Whether the folds are trained in parallel.
+  bool parallel;
+
+  //! The maximum number of models trained at the same time (0 for no limit).
+  size_t maxConcurrentModels;
+
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
@@ -254,21 +317,41 @@ class KFoldCV
   void InitKFoldCVMat(const DataType& source, DataType& destination);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Train on the given fraction of each training subset and run evaluation in
+   * the case of non-weighted learning, and store the model trained on the last
+   * fold in the given pointer.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& lastModel,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
-   * Train and run evaluation in the case of supporting weighted learning.
+   * Train on the given fraction of each training subset and run evaluation in
+   * the case of supporting weighted learning, and store the model trained on
+   * the last fold in the given pointer.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& lastModel,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Train a model on every fold with the given function (which takes the
+   * index of the fold and returns the trained model), evaluate it on the
+   * validation subset of the fold, and store the model trained on the last
+   * fold in the given pointer.  The folds are trained in parallel if
+   * Parallel() is true.
+   */
+  template<typename TrainFunction>
+  void EvaluateFolds(const TrainFunction& train,
+                     arma::vec& evaluations,
+                     std::unique_ptr<MLAlgorithm>& lastModel);
 
   /**
    * Calculate the index of the first column of the ith validation subset.
@@ -279,18 +362,28 @@ class KFoldCV
   inline size_t ValidationSubsetFirstCol(const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a matrix type.
+   * Calculate the number of points of the first part of the ith training
+   * subset that holds the given fraction of its points.
+   */
+  inline size_t TrainingSubsetSize(const size_t i, const double fraction);
+
+  /**
+   * Get the given fraction of the ith training subset from a variable of a
+   * matrix type.
    */
   template<typename ElementType>
   inline arma::Mat<ElementType> GetTrainingSubset(arma::Mat<ElementType>& m,
-                                                  const size_t i);
+                                                  const size_t i,
+                                                  const double fraction = 1.0);
 
   /**
-   * Get the ith training subset from a variable of a row type.
+   * Get the given fraction of the ith training subset from a variable of a row
+   * type.
    */
   template<typename ElementType>
   inline arma::Row<ElementType> GetTrainingSubset(arma::Row<ElementType>& r,
-                                                  const size_t i);
+                                                  const size_t i,
+                                                  const double fraction = 1.0);
 
   /**
    * Get the ith validation subset from a variable of a matrix type.
@@ -135,7 +135,9 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    maxConcurrentModels(0)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +168,9 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    maxConcurrentModels(0)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -191,7 +195,48 @@ double KFoldCV<MLAlgorithm,
                PredictionsType,
                WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateWithModel(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateOnSubset(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
+{
+  if (trainingFraction <= 0.0 || trainingFraction > 1.0)
+  {
+    throw std::invalid_argument("KFoldCV::EvaluateOnSubset(): the training "
+        "fraction must be in (0, 1]");
+  }
+
+  return TrainAndEvaluate(model, trainingFraction, args...);
 }
 
 template<typename MLAlgorithm,
@@ -242,17 +287,21 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& lastModel,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
+  EvaluateFolds([&](const size_t i)
+      {
+        return base.Train(GetTrainingSubset(xs, i, trainingFraction),
+            GetTrainingSubset(ys, i, trainingFraction), args...);
+      }, evaluations, lastModel);
 
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,8 +309,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -284,24 +331,102 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& lastModel,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
+  EvaluateFolds([&](const size_t i)
+      {
+        return (weights.n_elem > 0) ?
+            base.Train(GetTrainingSubset(xs, i, trainingFraction),
+                GetTrainingSubset(ys, i, trainingFraction),
+                GetTrainingSubset(weights, i, trainingFraction), args...) :
+            base.Train(GetTrainingSubset(xs, i, trainingFraction),
+                GetTrainingSubset(ys, i, trainingFraction), args...);
+      }, evaluations, lastModel);
 
-  for (size_t i = 0; i < k; ++i)
+  return arma::mean(evaluations);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TrainFunction>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::EvaluateFolds(
+    const TrainFunction& train,
+    arma::vec& evaluations,
+    std::unique_ptr<MLAlgorithm>& lastModel)
+{
+  if (!parallel)
+  {
+    for (size_t i = 0; i < k; ++i)
+    {
+      MLAlgorithm&& model = train(i);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        lastModel.reset(new MLAlgorithm(std::move(model)));
+    }
+
+    return;
+  }
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = (maxConcurrentModels == 0) ?
+      (size_t) omp_get_max_threads() :
+      std::min((size_t) omp_get_max_threads(), maxConcurrentModels);
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // Every fold gets its own seed, so the results do not depend on which thread
+  // trains which fold.  The base seed comes from the (per-thread) Armadillo
+  // generator, so it follows the seed set by the caller.
+  const size_t seed = arma::randi<arma::uvec>(1,
+      arma::distr_param(0, std::numeric_limits<int>::max()))[0];
+
+  // The folds reseed the Armadillo generator of the threads that train them,
+  // this one included.
+  math::ArmaRandomSeedGuard armaGuard;
+
+  // Exceptions cannot leave the parallel region, so the first one is kept and
+  // thrown afterwards.
+  std::exception_ptr error;
+  std::unique_ptr<MLAlgorithm> model;
+  #pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      math::LocalRandomSeed localSeed(seed + i);
+      MLAlgorithm&& foldModel = train(i);
+      evaluations(i) = Metric::Evaluate(foldModel, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        model.reset(new MLAlgorithm(std::move(foldModel)));
+    }
+    catch (...)
+    {
+      #pragma omp critical(KFoldCVError)
+      {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
   }
 
-  return arma::mean(evaluations);
+  if (error)
+    std::rethrow_exception(error);
+
+  lastModel = std::move(model);
 }
 
 template<typename MLAlgorithm,
@@ -371,6 +496,31 @@ size_t KFoldCV<MLAlgorithm,
   return (i == 0) ? binSize * (k - 1) : binSize * (i - 1);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::TrainingSubsetSize(const size_t i,
+                                                const double fraction)
+{
+  // If this is not the first fold, we have to handle it a little bit
+  // differently, since the last fold may contain slightly more than 'binSize'
+  // points.
+  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
+      (k - 1) * binSize;
+
+  if (fraction >= 1.0)
+    return subsetSize;
+
+  return std::min(subsetSize, std::max((size_t) 1,
+      (size_t) std::ceil(fraction * subsetSize)));
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -383,16 +533,11 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Mat<ElementType>& m,
-    const size_t i)
+    const size_t i,
+    const double fraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows,
+      TrainingSubsetSize(i, fraction), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -407,15 +552,11 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Row<ElementType>& r,
-    const size_t i)
+    const size_t i,
+    const double fraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  return arma::Row<ElementType>(r.colptr(binSize * i),
+      TrainingSubsetSize(i, fraction), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -208,6 +208,37 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on the training set and assess performance on the validation set,
+   * and give the trained model to the caller instead of keeping it.  Unlike
+   * Evaluate(), this does not modify the object, so it can be called by
+   * several threads at once.
+   *
+   * @param model Pointer to store the trained model in.
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateWithModel(std::unique_ptr<MLAlgorithm>& model,
+                           const MLAlgorithmArgs&... args);
+
+  /**
+   * Train like EvaluateWithModel(), but on only the first part of the training
+   * set, which holds the given fraction of its points (at least one).  The
+   * validation set is not changed.  This gives cheaper, rougher evaluations,
+   * which is what SuccessiveHalving and Hyperband use.
+   *
+   * @param model Pointer to store the trained model in.
+   * @param trainingFraction Fraction of the training points to use, in
+   *     (0, 1].
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateOnSubset(std::unique_ptr<MLAlgorithm>& model,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -269,6 +300,12 @@ class SimpleCV
    */
   size_t CalculateAndAssertNumberOfTrainingPoints(const double validationSize);
 
+  /**
+   * Calculate the number of points of the first part of the training set that
+   * holds the given fraction of its points.
+   */
+  size_t NumTrainingPoints(const double fraction) const;
+
   /**
    * Get the specified submatrix without coping the data.
    */
@@ -286,21 +323,29 @@ class SimpleCV
                                    const size_t lastCol);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Train on the given fraction of the training set and run evaluation in the
+   * case of non-weighted learning, and store the trained model in the given
+   * pointer.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs&... args);
 
   /**
-   * Train and run evaluation in the case of supporting weighted learning.
+   * Train on the given fraction of the training set and run evaluation in the
+   * case of supporting weighted learning, and store the trained model in the
+   * given pointer.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const double trainingFraction,
+                          const MLAlgorithmArgs&... args);
 };
 
 } // namespace cv
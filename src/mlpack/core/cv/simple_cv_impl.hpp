@@ -194,7 +194,48 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateWithModel(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, 1.0, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateOnSubset(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
+{
+  if (trainingFraction <= 0.0 || trainingFraction > 1.0)
+  {
+    throw std::invalid_argument("SimpleCV::EvaluateOnSubset(): the training "
+        "fraction must be in (0, 1]");
+  }
+
+  return TrainAndEvaluate(model, trainingFraction, args...);
 }
 
 template<typename MLAlgorithm,
@@ -243,6 +284,21 @@ size_t SimpleCV<MLAlgorithm,
   return trainingPoints;
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::NumTrainingPoints(const double fraction) const
+{
+  return std::min((size_t) trainingXs.n_cols, std::max((size_t) 1,
+      (size_t) std::ceil(fraction * trainingXs.n_cols)));
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -291,11 +347,23 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  if (trainingFraction >= 1.0)
+  {
+    model.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  }
+  else
+  {
+    const size_t lastCol = NumTrainingPoints(trainingFraction) - 1;
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol), args...)));
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 template<typename MLAlgorithm,
@@ -308,16 +376,33 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const double trainingFraction,
+    const MLAlgorithmArgs&... args)
 {
-  if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+  if (trainingFraction >= 1.0)
+  {
+    if (trainingWeights.n_elem > 0)
+      model.reset(new MLAlgorithm(
+          base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+    else
+      model.reset(new MLAlgorithm(
+          base.Train(trainingXs, trainingYs, args...)));
+  }
   else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+  {
+    const size_t lastCol = NumTrainingPoints(trainingFraction) - 1;
+    if (trainingWeights.n_elem > 0)
+      model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+          GetSubset(trainingYs, 0, lastCol),
+          GetSubset(trainingWeights, 0, lastCol), args...)));
+    else
+      model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+          GetSubset(trainingYs, 0, lastCol), args...)));
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 } // namespace cv
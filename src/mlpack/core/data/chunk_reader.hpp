@@ -0,0 +1,205 @@
+/**
+ * @file core/data/chunk_reader.hpp
+ *
+ * Definition of the ChunkReader class, which reads a dataset from a file one
+ * block of points at a time, so that the dataset does not need to fit in
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_READER_HPP
+#define MLPACK_CORE_DATA_CHUNK_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <fstream>
+#include <future>
+
+#ifdef ARMA_USE_HDF5
+  #include <hdf5.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ChunkReader reads a dataset from a file in chunks of a fixed number of
+ * points (columns), so that datasets that are larger than the memory can be
+ * processed.  The chunks hold the same points as the matrix that data::Load()
+ * would load from the same file, in the same order.  The following formats are
+ * supported:
+ *
+ *  - CSV (arma::csv_ascii) and whitespace-separated text (arma::raw_ascii)
+ *    files, with one point per line;
+ *  - Armadillo binary files (arma::arma_binary), such as those written by
+ *    data::Save();
+ *  - raw binary files (arma::raw_binary), which hold the points one after the
+ *    other; since they have no header, their dimensionality must be given;
+ *  - HDF5 files (arma::hdf5_binary), if Armadillo was compiled with HDF5
+ *    support; the data is read from the dataset named "dataset", like
+ *    Armadillo does.
+ *
+ * By default, the next chunk is read by a background thread while the current
+ * one is processed, so that the computation on a chunk overlaps with the
+ * reading of the next one.
+ *
+ * @code
+ * data::ChunkReader<double> reader("queries.csv", 10000);
+ * arma::mat chunk;
+ * while (reader.Next(chunk))
+ * {
+ *   // Process the 10000 (or fewer, for the last chunk) points in chunk.
+ * }
+ * @endcode
+ *
+ * A std::runtime_error is thrown if the file cannot be opened or is
+ * malformed.  A ChunkReader must only be used by one thread at a time.
+ *
+ * @tparam eT Type of the elements of the chunks.
+ */
+template<typename eT = double>
+class ChunkReader
+{
+ public:
+  /**
+   * Open the given file for reading.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Number of points of every chunk (the last chunk may hold
+   *     fewer).
+   * @param transpose If true (the default, like data::Load()), the file holds
+   *     one point per row; otherwise, it holds one point per column.  Text
+   *     files can only be read with one point per row, and the points of raw
+   *     binary files are always stored one after the other.
+   * @param inputLoadType Format of the file; by default, it is detected like
+   *     data::Load() does.
+   * @param dimensionality Dimensionality of the points of a raw binary file
+   *     (ignored for the other formats).
+   * @param readAhead Whether to read the next chunk in a background thread.
+   *     It is ignored for HDF5 files if the HDF5 library is not thread-safe.
+   */
+  ChunkReader(const std::string& filename,
+              const size_t chunkSize = 65536,
+              const bool transpose = true,
+              const arma::file_type inputLoadType = arma::auto_detect,
+              const size_t dimensionality = 1,
+              const bool readAhead = true);
+
+  //! Wait for the background read, if any, and close the file.
+  ~ChunkReader();
+
+  //! The reader cannot be copied.
+  ChunkReader(const ChunkReader&) = delete;
+  //! The reader cannot be copied.
+  ChunkReader& operator=(const ChunkReader&) = delete;
+
+  /**
+   * Read the next chunk of points.  If every point has been read, the chunk
+   * is emptied and false is returned.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return Whether a chunk was read.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  /**
+   * Go back to the beginning of the file, so that the next call to Next()
+   * returns the first chunk again.
+   */
+  void Reset();
+
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the number of points of the file, or 0 if it is not known before
+  //! the whole file has been read (for text files).
+  size_t NumPoints() const { return numPoints; }
+  //! Get the number of points that Next() has returned since the beginning of
+  //! the file.
+  size_t PointsRead() const { return pointsRead; }
+  //! Get the number of points of every chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Get the format of the file.
+  arma::file_type Type() const { return type; }
+
+ private:
+  /**
+   * Read the chunk that starts at the current position, and move the position
+   * past it.  This is what the background thread runs.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return Whether a chunk was read.
+   */
+  bool ReadChunk(arma::Mat<eT>& chunk);
+
+  //! Read the next chunk of a text file.
+  bool ReadTextChunk(arma::Mat<eT>& chunk);
+  //! Read the next chunk of a binary file.
+  bool ReadBinaryChunk(arma::Mat<eT>& chunk);
+  //! Read the next chunk of an HDF5 file.
+  bool ReadHDF5Chunk(arma::Mat<eT>& chunk);
+
+  //! Start reading the next chunk in the background.
+  void StartReadAhead();
+  //! Wait for the background read, if any, and ignore its result.
+  void WaitReadAhead();
+
+  //! The name of the file.
+  std::string filename;
+  //! The number of points of every chunk.
+  size_t chunkSize;
+  //! Whether the file holds one point per row.
+  bool transpose;
+  //! The format of the file.
+  arma::file_type type;
+  //! The dimensionality of the points.
+  size_t dimensionality;
+  //! The number of points of the file (0 if unknown).
+  size_t numPoints;
+  //! Whether the next chunk is read in the background.
+  bool readAhead;
+
+  //! The file, for the text and binary formats.
+  std::fstream stream;
+  //! The offset of the first point in the file.
+  std::streamoff dataOffset;
+  //! The index of the next point to read.
+  size_t position;
+  //! The number of the last line read from a text file.
+  size_t line;
+  //! The number of points returned by Next().
+  size_t pointsRead;
+
+  //! The result of the background read.
+  std::future<bool> nextChunkRead;
+  //! The chunk read in the background.
+  arma::Mat<eT> nextChunk;
+
+#ifdef ARMA_USE_HDF5
+  //! The HDF5 file.
+  hid_t file;
+  //! The HDF5 dataset.
+  hid_t dataset;
+#endif
+};
+
+namespace details {
+
+#ifdef ARMA_USE_HDF5
+/**
+ * Return the native HDF5 type of the given element type.
+ */
+template<typename eT>
+hid_t HDF5Type();
+#endif
+
+} // namespace details
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunk_reader_impl.hpp"
+
+#endif
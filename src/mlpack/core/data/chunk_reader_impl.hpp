@@ -0,0 +1,534 @@
+/**
+ * @file core/data/chunk_reader_impl.hpp
+ *
+ * Implementation of the ChunkReader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNK_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunk_reader.hpp"
+#include "detect_file_type.hpp"
+
+#include <cstdlib>
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+#ifdef ARMA_USE_HDF5
+template<typename eT>
+hid_t HDF5Type()
+{
+  if (std::is_same<eT, double>::value)
+    return H5T_NATIVE_DOUBLE;
+  else if (std::is_same<eT, float>::value)
+    return H5T_NATIVE_FLOAT;
+
+  switch (sizeof(eT))
+  {
+    case 1: return std::is_signed<eT>::value ? H5T_NATIVE_INT8 :
+        H5T_NATIVE_UINT8;
+    case 2: return std::is_signed<eT>::value ? H5T_NATIVE_INT16 :
+        H5T_NATIVE_UINT16;
+    case 4: return std::is_signed<eT>::value ? H5T_NATIVE_INT32 :
+        H5T_NATIVE_UINT32;
+    default: return std::is_signed<eT>::value ? H5T_NATIVE_INT64 :
+        H5T_NATIVE_UINT64;
+  }
+}
+#endif
+
+/**
+ * Parse the values of a line of a text file, separated by commas (for CSV
+ * files) or by whitespace.  Empty values of CSV files are parsed as zeros.
+ *
+ * @param text Line to parse.
+ * @param csv Whether the values are separated by commas.
+ * @param values Array to store the values in (may be NULL).
+ * @param maxValues Number of values that the array can hold; the values
+ *     after these are counted but not stored.
+ * @param count Set to the number of values of the line.
+ * @return Whether every value could be parsed.
+ */
+template<typename eT>
+bool ParseTextLine(const std::string& text,
+                   const bool csv,
+                   eT* values,
+                   const size_t maxValues,
+                   size_t& count)
+{
+  count = 0;
+  const char* begin = text.c_str();
+  const char* end = begin + text.size();
+  while (true)
+  {
+    // Skip the whitespace before the value.
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r'))
+      ++begin;
+    if (!csv && begin == end)
+      break;
+
+    const char* tokenEnd = begin;
+    if (csv)
+    {
+      while (tokenEnd < end && *tokenEnd != ',')
+        ++tokenEnd;
+    }
+    else
+    {
+      while (tokenEnd < end && *tokenEnd != ' ' && *tokenEnd != '\t' &&
+          *tokenEnd != '\r')
+        ++tokenEnd;
+    }
+
+    // Remove the whitespace after the value.
+    const char* valueEnd = tokenEnd;
+    while (valueEnd > begin && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t' ||
+        valueEnd[-1] == '\r'))
+      --valueEnd;
+
+    double value = 0.0;
+    if (valueEnd > begin)
+    {
+      // The value ends with a separator or with the end of the string, so
+      // strtod() stops there if the value is valid.
+      char* parsedEnd;
+      value = std::strtod(begin, &parsedEnd);
+      if (parsedEnd != valueEnd)
+        return false;
+    }
+
+    if (count < maxValues)
+      values[count] = (eT) value;
+    ++count;
+
+    if (!csv)
+      begin = tokenEnd;
+    else if (tokenEnd == end)
+      break;
+    else
+      begin = tokenEnd + 1;
+  }
+
+  return true;
+}
+
+} // namespace details
+
+template<typename eT>
+ChunkReader<eT>::ChunkReader(const std::string& filename,
+                             const size_t chunkSize,
+                             const bool transpose,
+                             const arma::file_type inputLoadType,
+                             const size_t dimensionality,
+                             const bool readAhead) :
+    filename(filename),
+    chunkSize(chunkSize),
+    transpose(transpose),
+    type(inputLoadType),
+    dimensionality(dimensionality),
+    numPoints(0),
+    readAhead(readAhead),
+    dataOffset(0),
+    position(0),
+    line(0),
+    pointsRead(0)
+#ifdef ARMA_USE_HDF5
+    , file(-1),
+    dataset(-1)
+#endif
+{
+  if (chunkSize == 0)
+  {
+    throw std::invalid_argument("ChunkReader::ChunkReader(): the chunk size "
+        "must be positive");
+  }
+
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("ChunkReader::ChunkReader(): cannot open file '" +
+        filename + "'");
+  }
+
+  if (type == arma::auto_detect)
+    type = AutoDetect(stream, filename);
+
+  if (type == arma::csv_ascii || type == arma::raw_ascii)
+  {
+    if (!transpose)
+    {
+      throw std::invalid_argument("ChunkReader::ChunkReader(): text files can "
+          "only be read with one point per line");
+    }
+
+    // The dimensionality is the number of values of the first line that is
+    // not blank.
+    this->dimensionality = 0;
+    std::string text;
+    while (std::getline(stream, text))
+    {
+      ++line;
+      if (text.find_first_not_of(" \t\r") == std::string::npos)
+        continue;
+
+      if (!details::ParseTextLine<eT>(text, type == arma::csv_ascii, NULL, 0,
+          this->dimensionality))
+      {
+        throw std::runtime_error("ChunkReader::ChunkReader(): cannot parse "
+            "line " + std::to_string(line) + " of '" + filename + "'");
+      }
+      break;
+    }
+
+    // The number of points is only known at the end of the file.
+    stream.clear();
+    stream.seekg(0);
+    line = 0;
+  }
+  else if (type == arma::arma_binary)
+  {
+    std::string header;
+    size_t nRows, nCols;
+    stream >> header >> nRows >> nCols;
+    if (!stream.good() ||
+        header != arma::diskio::gen_bin_header(arma::Mat<eT>()))
+    {
+      throw std::runtime_error("ChunkReader::ChunkReader(): '" + filename +
+          "' is not an Armadillo binary file with elements of the requested "
+          "type");
+    }
+    stream.get();
+    dataOffset = stream.tellg();
+
+    // Data saved with data::Save() is transposed, so it holds one point per
+    // row.
+    this->dimensionality = transpose ? nCols : nRows;
+    numPoints = transpose ? nRows : nCols;
+
+    stream.seekg(0, std::fstream::end);
+    if ((size_t) (stream.tellg() - dataOffset) < nRows * nCols * sizeof(eT))
+    {
+      throw std::runtime_error("ChunkReader::ChunkReader(): '" + filename +
+          "' is truncated");
+    }
+  }
+  else if (type == arma::raw_binary)
+  {
+    if (dimensionality == 0)
+    {
+      throw std::invalid_argument("ChunkReader::ChunkReader(): the "
+          "dimensionality of a raw binary file must be positive");
+    }
+
+    stream.seekg(0, std::fstream::end);
+    const size_t fileSize = (size_t) stream.tellg();
+    const size_t pointSize = dimensionality * sizeof(eT);
+    if (fileSize % pointSize != 0)
+    {
+      throw std::runtime_error("ChunkReader::ChunkReader(): the size of '" +
+          filename + "' is not a multiple of the size of a point");
+    }
+    numPoints = fileSize / pointSize;
+  }
+  else if (type == arma::hdf5_binary)
+  {
+#ifdef ARMA_USE_HDF5
+    stream.close();
+
+    file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0)
+    {
+      throw std::runtime_error("ChunkReader::ChunkReader(): cannot open HDF5 "
+          "file '" + filename + "'");
+    }
+
+    dataset = H5Dopen(file, "dataset", H5P_DEFAULT);
+    hid_t space = (dataset < 0) ? -1 : H5Dget_space(dataset);
+    hsize_t dims[2];
+    if (space < 0 || H5Sget_simple_extent_ndims(space) != 2 ||
+        H5Sget_simple_extent_dims(space, dims, NULL) < 0)
+    {
+      if (space >= 0)
+        H5Sclose(space);
+      if (dataset >= 0)
+        H5Dclose(dataset);
+      H5Fclose(file);
+      throw std::runtime_error("ChunkReader::ChunkReader(): '" + filename +
+          "' does not have a two-dimensional dataset named 'dataset'");
+    }
+    H5Sclose(space);
+
+    // HDF5 is row-major, so Armadillo stores a matrix with its dimensions
+    // swapped.
+    this->dimensionality = transpose ? dims[0] : dims[1];
+    numPoints = transpose ? dims[1] : dims[0];
+
+    // The background thread calls HDF5 while the caller may call it too, so
+    // read-ahead is only used if the library was built thread-safe.
+    if (this->readAhead)
+    {
+      hbool_t threadSafe = 0;
+      #if H5_VERSION_GE(1, 8, 16)
+      if (H5is_library_threadsafe(&threadSafe) < 0)
+        threadSafe = 0;
+      #endif
+      this->readAhead = (threadSafe != 0);
+    }
+#else
+    throw std::runtime_error("ChunkReader::ChunkReader(): cannot read '" +
+        filename + "' because Armadillo was compiled without HDF5 support");
+#endif
+  }
+  else if (type == arma::file_type_unknown)
+  {
+    throw std::runtime_error("ChunkReader::ChunkReader(): cannot detect the "
+        "type of file '" + filename + "'");
+  }
+  else
+  {
+    throw std::runtime_error("ChunkReader::ChunkReader(): " +
+        GetStringType(type) + " files cannot be read in chunks");
+  }
+}
+
+template<typename eT>
+ChunkReader<eT>::~ChunkReader()
+{
+  WaitReadAhead();
+
+#ifdef ARMA_USE_HDF5
+  if (dataset >= 0)
+    H5Dclose(dataset);
+  if (file >= 0)
+    H5Fclose(file);
+#endif
+}
+
+template<typename eT>
+bool ChunkReader<eT>::Next(arma::Mat<eT>& chunk)
+{
+  if (!readAhead)
+  {
+    const bool read = ReadChunk(chunk);
+    pointsRead += chunk.n_cols;
+    return read;
+  }
+
+  // The first chunk, and the chunk after a failed read, are not being read
+  // yet.
+  if (!nextChunkRead.valid())
+    StartReadAhead();
+
+  // This throws the exception of the background read, if any.
+  const bool read = nextChunkRead.get();
+  chunk = std::move(nextChunk);
+  if (!read)
+    return false;
+
+  pointsRead += chunk.n_cols;
+  StartReadAhead();
+  return true;
+}
+
+template<typename eT>
+void ChunkReader<eT>::Reset()
+{
+  WaitReadAhead();
+
+  if (stream.is_open())
+  {
+    stream.clear();
+    stream.seekg(dataOffset);
+  }
+
+  position = 0;
+  line = 0;
+  pointsRead = 0;
+}
+
+template<typename eT>
+bool ChunkReader<eT>::ReadChunk(arma::Mat<eT>& chunk)
+{
+  if (type == arma::csv_ascii || type == arma::raw_ascii)
+    return ReadTextChunk(chunk);
+  else if (type == arma::hdf5_binary)
+    return ReadHDF5Chunk(chunk);
+  else
+    return ReadBinaryChunk(chunk);
+}
+
+template<typename eT>
+bool ChunkReader<eT>::ReadTextChunk(arma::Mat<eT>& chunk)
+{
+  chunk.set_size(dimensionality, chunkSize);
+
+  size_t n = 0;
+  std::string text;
+  while (n < chunkSize && std::getline(stream, text))
+  {
+    ++line;
+    if (text.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    size_t count;
+    if (!details::ParseTextLine(text, type == arma::csv_ascii, chunk.colptr(n),
+        dimensionality, count))
+    {
+      throw std::runtime_error("ChunkReader::Next(): cannot parse line " +
+          std::to_string(line) + " of '" + filename + "'");
+    }
+    if (count != dimensionality)
+    {
+      throw std::runtime_error("ChunkReader::Next(): line " +
+          std::to_string(line) + " of '" + filename + "' has " +
+          std::to_string(count) + " values, but the first line has " +
+          std::to_string(dimensionality));
+    }
+    ++n;
+  }
+
+  chunk.resize(dimensionality, n);
+  position += n;
+  return (n > 0);
+}
+
+template<typename eT>
+bool ChunkReader<eT>::ReadBinaryChunk(arma::Mat<eT>& chunk)
+{
+  if (position >= numPoints)
+  {
+    chunk.reset();
+    return false;
+  }
+
+  const size_t n = std::min(chunkSize, numPoints - position);
+  if (type == arma::raw_binary || !transpose)
+  {
+    // The points are stored one after the other.
+    chunk.set_size(dimensionality, n);
+    stream.seekg(dataOffset +
+        std::streamoff(position * dimensionality * sizeof(eT)));
+    stream.read(reinterpret_cast<char*>(chunk.memptr()),
+        std::streamsize(chunk.n_elem * sizeof(eT)));
+  }
+  else
+  {
+    // The dimensions are stored one after the other, so every dimension of the
+    // chunk is a contiguous block of the file.
+    arma::Mat<eT> points(n, dimensionality);
+    for (size_t i = 0; i < dimensionality; ++i)
+    {
+      stream.seekg(dataOffset +
+          std::streamoff((i * numPoints + position) * sizeof(eT)));
+      stream.read(reinterpret_cast<char*>(points.colptr(i)),
+          std::streamsize(n * sizeof(eT)));
+    }
+    chunk = points.t();
+  }
+
+  if (!stream.good())
+  {
+    throw std::runtime_error("ChunkReader::Next(): cannot read '" + filename +
+        "'");
+  }
+
+  position += n;
+  return true;
+}
+
+template<typename eT>
+bool ChunkReader<eT>::ReadHDF5Chunk(arma::Mat<eT>& chunk)
+{
+  if (position >= numPoints)
+  {
+    chunk.reset();
+    return false;
+  }
+
+#ifdef ARMA_USE_HDF5
+  const size_t n = std::min(chunkSize, numPoints - position);
+
+  // Since HDF5 is row-major, the selection of a transposed file is read as the
+  // transpose of the chunk.
+  hsize_t offset[2], count[2];
+  arma::Mat<eT> points;
+  eT* memory;
+  if (transpose)
+  {
+    offset[0] = 0;
+    offset[1] = position;
+    count[0] = dimensionality;
+    count[1] = n;
+    points.set_size(n, dimensionality);
+    memory = points.memptr();
+  }
+  else
+  {
+    offset[0] = position;
+    offset[1] = 0;
+    count[0] = n;
+    count[1] = dimensionality;
+    chunk.set_size(dimensionality, n);
+    memory = chunk.memptr();
+  }
+
+  hid_t fileSpace = H5Dget_space(dataset);
+  hid_t memorySpace = H5Screate_simple(2, count, NULL);
+  herr_t status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, NULL,
+      count, NULL);
+  if (status >= 0)
+  {
+    status = H5Dread(dataset, details::HDF5Type<eT>(), memorySpace, fileSpace,
+        H5P_DEFAULT, memory);
+  }
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+
+  if (status < 0)
+  {
+    throw std::runtime_error("ChunkReader::Next(): cannot read '" + filename +
+        "'");
+  }
+
+  if (transpose)
+    chunk = points.t();
+
+  position += n;
+  return true;
+#else
+  // The constructor does not accept HDF5 files in this case.
+  return false;
+#endif
+}
+
+template<typename eT>
+void ChunkReader<eT>::StartReadAhead()
+{
+  nextChunkRead = std::async(std::launch::async, [this]()
+      {
+        return ReadChunk(nextChunk);
+      });
+}
+
+template<typename eT>
+void ChunkReader<eT>::WaitReadAhead()
+{
+  if (nextChunkRead.valid())
+  {
+    // The result, and any exception, are discarded.
+    nextChunkRead.wait();
+    nextChunkRead = std::future<bool>();
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file core/data/chunk_writer.hpp
+ *
+ * Definition of the ChunkWriter class, which writes a dataset to a file one
+ * block of points at a time, so that the dataset does not need to fit in
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_WRITER_HPP
+#define MLPACK_CORE_DATA_CHUNK_WRITER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "chunk_reader.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ChunkWriter writes a dataset to a file one chunk of points (columns) at a
+ * time, in the formats that ChunkReader reads.  Once every chunk has been
+ * written, the file holds the same data as if the whole dataset had been saved
+ * with data::Save().  The chunks may have different numbers of points, but
+ * they must all have the same dimensionality.
+ *
+ * An Armadillo binary file that holds one point per row (the default) stores
+ * the dimensions one after the other, so its points are written to a
+ * temporary file named after the file first, and are rearranged by Close().
+ * The other formats are written directly.
+ *
+ * @code
+ * data::ChunkReader<double> reader("queries.csv");
+ * data::ChunkWriter<double> writer("predictions.csv");
+ * arma::mat chunk, predictions;
+ * while (reader.Next(chunk))
+ * {
+ *   model.Predict(chunk, predictions);
+ *   writer.Write(predictions);
+ * }
+ * writer.Close();
+ * @endcode
+ *
+ * A std::runtime_error is thrown if the file cannot be written.
+ *
+ * @tparam eT Type of the elements of the chunks.
+ */
+template<typename eT = double>
+class ChunkWriter
+{
+ public:
+  /**
+   * Open the given file for writing.  If the file exists, it is overwritten.
+   *
+   * @param filename Name of the file to write.
+   * @param transpose If true (the default, like data::Save()), the file holds
+   *     one point per row; otherwise, it holds one point per column.  Text
+   *     files can only be written with one point per row, and the points of
+   *     raw binary files are always stored one after the other.
+   * @param inputSaveType Format of the file; by default, it is detected from
+   *     the extension of the file, like data::Save() does.
+   */
+  ChunkWriter(const std::string& filename,
+              const bool transpose = true,
+              const arma::file_type inputSaveType = arma::auto_detect);
+
+  /**
+   * Close the file, if Close() has not been called.  Errors are only reported
+   * as warnings, so Close() should be called to detect them.
+   */
+  ~ChunkWriter();
+
+  //! The writer cannot be copied.
+  ChunkWriter(const ChunkWriter&) = delete;
+  //! The writer cannot be copied.
+  ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+  /**
+   * Append the points of the given chunk to the file.
+   *
+   * @param chunk Chunk to write.
+   */
+  void Write(const arma::Mat<eT>& chunk);
+
+  /**
+   * Finish writing the file and close it.  No chunk can be written after
+   * this.
+   */
+  void Close();
+
+  //! Get the dimensionality of the points (0 before the first chunk).
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the number of points written.
+  size_t PointsWritten() const { return pointsWritten; }
+  //! Get the format of the file.
+  arma::file_type Type() const { return type; }
+
+ private:
+  //! Write the header of an Armadillo binary file.
+  void WriteBinaryHeader(std::fstream& output);
+  //! Rearrange the points of the temporary file into the file, with the
+  //! dimensions one after the other.
+  void WriteTransposedBinary();
+  //! Create the HDF5 dataset, which can grow along the points.
+  void CreateHDF5Dataset();
+  //! Append the points of the given chunk to the HDF5 dataset.
+  void WriteHDF5(const arma::Mat<eT>& chunk);
+
+  //! The name of the file.
+  std::string filename;
+  //! Whether the file holds one point per row.
+  bool transpose;
+  //! The format of the file.
+  arma::file_type type;
+  //! The dimensionality of the points.
+  size_t dimensionality;
+  //! The number of points written.
+  size_t pointsWritten;
+  //! Whether the file is closed.
+  bool closed;
+
+  //! The file (or the temporary file), for the text and binary formats.
+  std::fstream stream;
+
+#ifdef ARMA_USE_HDF5
+  //! The HDF5 file.
+  hid_t file;
+  //! The HDF5 dataset (created by the first chunk).
+  hid_t dataset;
+#endif
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunk_writer_impl.hpp"
+
+#endif
@@ -0,0 +1,431 @@
+/**
+ * @file core/data/chunk_writer_impl.hpp
+ *
+ * Implementation of the ChunkWriter class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_WRITER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNK_WRITER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunk_writer.hpp"
+#include "detect_file_type.hpp"
+
+#include <mlpack/core/util/log.hpp>
+#include <cstdio>
+#include <iomanip>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ChunkWriter<eT>::ChunkWriter(const std::string& filename,
+                             const bool transpose,
+                             const arma::file_type inputSaveType) :
+    filename(filename),
+    transpose(transpose),
+    type(inputSaveType),
+    dimensionality(0),
+    pointsWritten(0),
+    closed(false)
+#ifdef ARMA_USE_HDF5
+    , file(-1),
+    dataset(-1)
+#endif
+{
+  if (type == arma::auto_detect)
+    type = DetectFromExtension(filename);
+
+  if (type == arma::csv_ascii || type == arma::raw_ascii)
+  {
+    if (!transpose)
+    {
+      throw std::invalid_argument("ChunkWriter::ChunkWriter(): text files can "
+          "only be written with one point per line");
+    }
+
+    stream.open(filename.c_str(), std::fstream::out | std::fstream::binary |
+        std::fstream::trunc);
+    // Floating-point values are written with enough digits to be read back
+    // exactly.
+    stream.precision(std::numeric_limits<eT>::max_digits10);
+  }
+  else if (type == arma::raw_binary)
+  {
+    stream.open(filename.c_str(), std::fstream::out | std::fstream::binary |
+        std::fstream::trunc);
+  }
+  else if (type == arma::arma_binary)
+  {
+    if (transpose)
+    {
+      // The points are rearranged by Close().
+      stream.open((filename + ".tmp").c_str(), std::fstream::in |
+          std::fstream::out | std::fstream::binary | std::fstream::trunc);
+    }
+    else
+    {
+      // The header is written again by Close(), with the number of points.
+      stream.open(filename.c_str(), std::fstream::out | std::fstream::binary |
+          std::fstream::trunc);
+      if (stream.is_open())
+        WriteBinaryHeader(stream);
+    }
+  }
+  else if (type == arma::hdf5_binary)
+  {
+#ifdef ARMA_USE_HDF5
+    file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+        H5P_DEFAULT);
+    if (file < 0)
+    {
+      throw std::runtime_error("ChunkWriter::ChunkWriter(): cannot open HDF5 "
+          "file '" + filename + "' for writing");
+    }
+    return;
+#else
+    throw std::runtime_error("ChunkWriter::ChunkWriter(): cannot write '" +
+        filename + "' because Armadillo was compiled without HDF5 support");
+#endif
+  }
+  else if (type == arma::file_type_unknown)
+  {
+    throw std::runtime_error("ChunkWriter::ChunkWriter(): cannot detect the "
+        "type of file '" + filename + "' for writing");
+  }
+  else
+  {
+    throw std::runtime_error("ChunkWriter::ChunkWriter(): " +
+        GetStringType(type) + " files cannot be written in chunks");
+  }
+
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("ChunkWriter::ChunkWriter(): cannot open file '" +
+        filename + "' for writing");
+  }
+}
+
+template<typename eT>
+ChunkWriter<eT>::~ChunkWriter()
+{
+  if (!closed)
+  {
+    try
+    {
+      Close();
+    }
+    catch (std::exception& e)
+    {
+      Log::Warn << e.what() << std::endl;
+    }
+  }
+
+#ifdef ARMA_USE_HDF5
+  if (dataset >= 0)
+    H5Dclose(dataset);
+  if (file >= 0)
+    H5Fclose(file);
+#endif
+}
+
+template<typename eT>
+void ChunkWriter<eT>::Write(const arma::Mat<eT>& chunk)
+{
+  if (closed)
+  {
+    throw std::runtime_error("ChunkWriter::Write(): '" + filename + "' is "
+        "closed");
+  }
+
+  if (pointsWritten == 0)
+  {
+    dimensionality = chunk.n_rows;
+  }
+  else if (chunk.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "ChunkWriter::Write(): the chunk has dimensionality "
+        << chunk.n_rows << " but the previous chunks have dimensionality "
+        << dimensionality;
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (chunk.n_cols == 0)
+    return;
+
+  if (type == arma::hdf5_binary)
+  {
+    WriteHDF5(chunk);
+  }
+  else if (type == arma::csv_ascii || type == arma::raw_ascii)
+  {
+    const char separator = (type == arma::csv_ascii) ? ',' : ' ';
+    for (size_t col = 0; col < chunk.n_cols; ++col)
+    {
+      for (size_t row = 0; row < chunk.n_rows; ++row)
+      {
+        if (row > 0)
+          stream << separator;
+        // The unary plus writes char types as numbers.
+        stream << +chunk(row, col);
+      }
+      stream << '\n';
+    }
+  }
+  else
+  {
+    // Transposed Armadillo binary files are written to the temporary file one
+    // point after the other too.
+    stream.write(reinterpret_cast<const char*>(chunk.memptr()),
+        std::streamsize(chunk.n_elem * sizeof(eT)));
+  }
+
+  if (type != arma::hdf5_binary && !stream.good())
+  {
+    throw std::runtime_error("ChunkWriter::Write(): cannot write to '" +
+        filename + "'");
+  }
+
+  pointsWritten += chunk.n_cols;
+}
+
+template<typename eT>
+void ChunkWriter<eT>::Close()
+{
+  if (closed)
+    return;
+  closed = true;
+
+  if (type == arma::hdf5_binary)
+  {
+#ifdef ARMA_USE_HDF5
+    // If no chunk was written, the dimensionality is unknown, so an empty
+    // matrix is written, like Armadillo does.  It cannot be stored in chunks,
+    // because HDF5 does not allow chunks of size zero.
+    if (dataset < 0)
+    {
+      const hsize_t dims[2] = { 0, 0 };
+      hid_t space = H5Screate_simple(2, dims, NULL);
+      if (space >= 0)
+      {
+        dataset = H5Dcreate(file, "dataset", details::HDF5Type<eT>(), space,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Sclose(space);
+      }
+    }
+
+    const herr_t status = (dataset < 0) ? -1 : H5Dclose(dataset);
+    dataset = -1;
+    if (H5Fclose(file) < 0 || status < 0)
+    {
+      file = -1;
+      throw std::runtime_error("ChunkWriter::Close(): cannot write '" +
+          filename + "'");
+    }
+    file = -1;
+#endif
+  }
+  else if (type == arma::arma_binary && transpose)
+  {
+    WriteTransposedBinary();
+  }
+  else
+  {
+    if (type == arma::arma_binary)
+    {
+      stream.seekp(0);
+      WriteBinaryHeader(stream);
+    }
+
+    const bool success = stream.good();
+    stream.close();
+    if (!success || stream.fail())
+    {
+      throw std::runtime_error("ChunkWriter::Close(): cannot write '" +
+          filename + "'");
+    }
+  }
+}
+
+template<typename eT>
+void ChunkWriter<eT>::WriteBinaryHeader(std::fstream& output)
+{
+  // The sizes are padded to a fixed width, so that the header written before
+  // the number of points is known can be overwritten in place.  Armadillo
+  // skips the padding when it reads the sizes.
+  const size_t nRows = transpose ? pointsWritten : dimensionality;
+  const size_t nCols = transpose ? dimensionality : pointsWritten;
+  output << arma::diskio::gen_bin_header(arma::Mat<eT>()) << '\n'
+      << std::setw(20) << nRows << ' ' << std::setw(20) << nCols << '\n';
+}
+
+template<typename eT>
+void ChunkWriter<eT>::WriteTransposedBinary()
+{
+  const std::string temporaryFilename = filename + ".tmp";
+  std::fstream output(filename.c_str(), std::fstream::out |
+      std::fstream::binary | std::fstream::trunc);
+  if (!output.is_open())
+  {
+    stream.close();
+    std::remove(temporaryFilename.c_str());
+    throw std::runtime_error("ChunkWriter::Close(): cannot open file '" +
+        filename + "' for writing");
+  }
+
+  WriteBinaryHeader(output);
+  const std::streamoff dataOffset = output.tellp();
+
+  // Extend the file to its final size, so that every dimension can be written
+  // at its place.
+  const size_t dataSize = pointsWritten * dimensionality * sizeof(eT);
+  if (dataSize > 0)
+  {
+    output.seekp(dataOffset + std::streamoff(dataSize - 1));
+    output.put('\0');
+  }
+
+  // Every block of points of the temporary file is read once, and each of its
+  // dimensions is written at its place in the file.
+  const size_t blockSize = std::max((size_t) 1,
+      (size_t) 1048576 / std::max(dimensionality, (size_t) 1));
+  arma::Mat<eT> block;
+  stream.seekg(0);
+  for (size_t begin = 0; begin < pointsWritten && stream.good() &&
+      output.good(); begin += blockSize)
+  {
+    const size_t n = std::min(blockSize, pointsWritten - begin);
+    block.set_size(dimensionality, n);
+    stream.read(reinterpret_cast<char*>(block.memptr()),
+        std::streamsize(block.n_elem * sizeof(eT)));
+
+    const arma::Mat<eT> points = block.t();
+    for (size_t i = 0; i < dimensionality; ++i)
+    {
+      output.seekp(dataOffset +
+          std::streamoff((i * pointsWritten + begin) * sizeof(eT)));
+      output.write(reinterpret_cast<const char*>(points.colptr(i)),
+          std::streamsize(n * sizeof(eT)));
+    }
+  }
+
+  const bool success = stream.good() && output.good();
+  stream.close();
+  output.close();
+  std::remove(temporaryFilename.c_str());
+  if (!success || output.fail())
+  {
+    throw std::runtime_error("ChunkWriter::Close(): cannot write '" +
+        filename + "'");
+  }
+}
+
+template<typename eT>
+void ChunkWriter<eT>::CreateHDF5Dataset()
+{
+#ifdef ARMA_USE_HDF5
+  // HDF5 is row-major, so the dimensions of the dataset are swapped like
+  // Armadillo does, and the dataset is stored in chunks of about 65536
+  // elements.
+  const hsize_t blockSize = std::max((size_t) 1,
+      (size_t) 65536 / std::max(dimensionality, (size_t) 1));
+  hsize_t dims[2], maxDims[2], blockDims[2];
+  if (transpose)
+  {
+    dims[0] = maxDims[0] = blockDims[0] = dimensionality;
+    dims[1] = 0;
+    maxDims[1] = H5S_UNLIMITED;
+    blockDims[1] = blockSize;
+  }
+  else
+  {
+    dims[0] = 0;
+    maxDims[0] = H5S_UNLIMITED;
+    blockDims[0] = blockSize;
+    dims[1] = maxDims[1] = blockDims[1] = dimensionality;
+  }
+
+  hid_t space = H5Screate_simple(2, dims, maxDims);
+  hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+  if (H5Pset_chunk(properties, 2, blockDims) >= 0)
+  {
+    dataset = H5Dcreate(file, "dataset", details::HDF5Type<eT>(), space,
+        H5P_DEFAULT, properties, H5P_DEFAULT);
+  }
+  H5Pclose(properties);
+  H5Sclose(space);
+
+  if (dataset < 0)
+  {
+    throw std::runtime_error("ChunkWriter::Write(): cannot create the dataset "
+        "of '" + filename + "'");
+  }
+#endif
+}
+
+template<typename eT>
+void ChunkWriter<eT>::WriteHDF5(const arma::Mat<eT>& chunk)
+{
+#ifdef ARMA_USE_HDF5
+  if (dataset < 0)
+    CreateHDF5Dataset();
+
+  hsize_t dims[2], offset[2], count[2];
+  arma::Mat<eT> points;
+  const eT* memory;
+  if (transpose)
+  {
+    dims[0] = count[0] = dimensionality;
+    dims[1] = pointsWritten + chunk.n_cols;
+    offset[0] = 0;
+    offset[1] = pointsWritten;
+    count[1] = chunk.n_cols;
+    points = chunk.t();
+    memory = points.memptr();
+  }
+  else
+  {
+    dims[0] = pointsWritten + chunk.n_cols;
+    offset[0] = pointsWritten;
+    count[0] = chunk.n_cols;
+    dims[1] = count[1] = dimensionality;
+    offset[1] = 0;
+    memory = chunk.memptr();
+  }
+
+  herr_t status = H5Dset_extent(dataset, dims);
+  if (status >= 0)
+  {
+    hid_t fileSpace = H5Dget_space(dataset);
+    hid_t memorySpace = H5Screate_simple(2, count, NULL);
+    status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, NULL,
+        count, NULL);
+    if (status >= 0)
+    {
+      status = H5Dwrite(dataset, details::HDF5Type<eT>(), memorySpace,
+          fileSpace, H5P_DEFAULT, memory);
+    }
+    H5Sclose(memorySpace);
+    H5Sclose(fileSpace);
+  }
+
+  if (status < 0)
+  {
+    throw std::runtime_error("ChunkWriter::Write(): cannot write to '" +
+        filename + "'");
+  }
+#else
+  // The constructor does not accept HDF5 files in this case.
+  (void) chunk;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file core/data/column_blocks.hpp
+ *
+ * Utilities to process a column-major dataset in blocks of columns, in
+ * parallel with OpenMP.  These are used by the preprocessing classes in
+ * core/data, so that every pass over the data works on cache-sized blocks
+ * and can use every core.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMN_BLOCKS_HPP
+#define MLPACK_CORE_DATA_COLUMN_BLOCKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Return the number of columns of a block for a dataset with the given number
+ * of rows.  A block holds about 32768 elements (256kB of doubles), so that the
+ * input and output blocks of a pass fit in the L2 cache of a core.
+ *
+ * @param nRows Number of rows of the dataset.
+ */
+inline size_t ColumnBlockSize(const size_t nRows)
+{
+  return std::max((size_t) 1, (size_t) 32768 / std::max((size_t) 1, nRows));
+}
+
+/**
+ * Return the number of blocks of columns of a dataset with the given size.
+ *
+ * @param nRows Number of rows of the dataset.
+ * @param nCols Number of columns of the dataset.
+ */
+inline size_t NumColumnBlocks(const size_t nRows, const size_t nCols)
+{
+  const size_t blockSize = ColumnBlockSize(nRows);
+  return (nCols + blockSize - 1) / blockSize;
+}
+
+/**
+ * Call the given function on every block of columns of a dataset with the
+ * given size, in parallel if OpenMP is available.  The function is called as
+ * function(block, begin, end), where block is the index of the block and the
+ * block holds the columns begin to end - 1 (it is never empty).  Calls on
+ * different blocks may run at the same time, so the function must only write
+ * to the columns of its own block, or to data indexed by the block.
+ *
+ * @param nRows Number of rows of the dataset.
+ * @param nCols Number of columns of the dataset.
+ * @param function Function to call on every block.
+ */
+template<typename FunctionType>
+void ForEachColumnBlock(const size_t nRows,
+                        const size_t nCols,
+                        const FunctionType& function)
+{
+  const size_t blockSize = ColumnBlockSize(nRows);
+  const size_t numBlocks = NumColumnBlocks(nRows, nCols);
+
+  #pragma omp parallel for schedule(static) if (numBlocks > 1)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(nCols, begin + blockSize);
+    function((size_t) block, begin, end);
+  }
+}
+
+/**
+ * Compute the minimum and maximum of every row of the given dataset.  Each
+ * block of columns is reduced on its own and the blocks are then combined in
+ * order, so the result does not depend on the number of threads.
+ *
+ * @param input Dataset.
+ * @param rowMin Vector to store the minimum of every row in.
+ * @param rowMax Vector to store the maximum of every row in.
+ */
+template<typename MatType>
+void RowMinMax(const MatType& input, arma::vec& rowMin, arma::vec& rowMax)
+{
+  const size_t numBlocks = NumColumnBlocks(input.n_rows, input.n_cols);
+  arma::mat blockMin(input.n_rows, numBlocks);
+  arma::mat blockMax(input.n_rows, numBlocks);
+  ForEachColumnBlock(input.n_rows, input.n_cols,
+      [&](const size_t block, const size_t begin, const size_t end)
+      {
+        blockMin.col(block) = arma::min(input.cols(begin, end - 1), 1);
+        blockMax.col(block) = arma::max(input.cols(begin, end - 1), 1);
+      });
+
+  rowMin = arma::min(blockMin, 1);
+  rowMax = arma::max(blockMax, 1);
+}
+
+/**
+ * Compute the mean of every row of the given dataset.  The result does not
+ * depend on the number of threads.
+ *
+ * @param input Dataset.
+ * @param rowMean Vector to store the mean of every row in.
+ */
+template<typename MatType>
+void RowMean(const MatType& input, arma::vec& rowMean)
+{
+  const size_t numBlocks = NumColumnBlocks(input.n_rows, input.n_cols);
+  arma::mat blockSum(input.n_rows, numBlocks);
+  ForEachColumnBlock(input.n_rows, input.n_cols,
+      [&](const size_t block, const size_t begin, const size_t end)
+      {
+        blockSum.col(block) = arma::sum(input.cols(begin, end - 1), 1);
+      });
+
+  rowMean = arma::sum(blockSum, 1) / (double) input.n_cols;
+}
+
+/**
+ * Compute the standard deviation of every row of the given dataset, given
+ * the mean of every row, normalized by the number of columns (like
+ * arma::stddev(input, 1, 1)).  The result does not depend on the number of
+ * threads.
+ *
+ * @param input Dataset.
+ * @param rowMean Mean of every row of the dataset.
+ * @param rowStdDev Vector to store the standard deviation of every row in.
+ */
+template<typename MatType>
+void RowStdDev(const MatType& input,
+               const arma::vec& rowMean,
+               arma::vec& rowStdDev)
+{
+  const size_t numBlocks = NumColumnBlocks(input.n_rows, input.n_cols);
+  arma::mat blockSum(input.n_rows, numBlocks);
+  ForEachColumnBlock(input.n_rows, input.n_cols,
+      [&](const size_t block, const size_t begin, const size_t end)
+      {
+        blockSum.col(block) = arma::sum(arma::square(
+            input.cols(begin, end - 1).each_col() - rowMean), 1);
+      });
+
+  rowStdDev = arma::sqrt(arma::sum(blockSum, 1) / (double) input.n_cols);
+}
+
+/**
+ * Copy the given columns of a dataset, in the given order, into another
+ * matrix, in parallel if OpenMP is available.
+ *
+ * @param input Dataset.
+ * @param indices Indices of the columns to copy.
+ * @param output Matrix to store the columns in.
+ */
+template<typename T>
+void GatherColumns(const arma::Mat<T>& input,
+                   const arma::uvec& indices,
+                   arma::Mat<T>& output)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+  ForEachColumnBlock(input.n_rows, indices.n_elem,
+      [&](const size_t /* block */, const size_t begin, const size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+          output.col(i) = input.col(indices[i]);
+      });
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -46,28 +46,20 @@ class CustomImputation
               const size_t dimension,
               const bool columnMajor = true)
   {
+    // The dimension is a row of a column-major matrix or a column of a
+    // row-major one, so it is visited with a stride.
+    const size_t numElems = columnMajor ? input.n_cols : input.n_rows;
+    const size_t stride = columnMajor ? input.n_rows : 1;
+    T* values = columnMajor ? input.memptr() + dimension :
+        input.colptr(dimension);
+
     // replace the target value to custom value
-    if (columnMajor)
-    {
-      for (size_t i = 0; i < input.n_cols; ++i)
-      {
-        if (input(dimension, i) == mappedValue ||
-            std::isnan(input(dimension, i)))
-        {
-          input(dimension, i) = customValue;
-        }
-      }
-    }
-    else
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) numElems; ++i)
     {
-      for (size_t i = 0; i < input.n_rows; ++i)
-      {
-        if (input(i, dimension) == mappedValue ||
-            std::isnan(input(i, dimension)))
-        {
-          input(i, dimension) = customValue;
-        }
-      }
+      T& value = values[i * stride];
+      if (value == mappedValue || std::isnan(value))
+        value = customValue;
     }
   }
 
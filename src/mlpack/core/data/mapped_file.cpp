@@ -0,0 +1,90 @@
+/**
+ * @file core/data/mapped_file.cpp
+ *
+ * Implementation of the MappedFile class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "mapped_file.hpp"
+
+#if defined(_WIN32)
+  #include <fstream>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+MappedFile::MappedFile(const std::string& filename) :
+    data(NULL),
+    size(0)
+{
+#if defined(_WIN32)
+  std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("MappedFile: cannot open '" + filename +
+        "' for reading");
+  }
+
+  size = stream.tellg();
+  stream.seekg(0);
+  data = new char[std::max(size, (size_t) 1)];
+  if (!stream.read(data, size))
+  {
+    delete[] data;
+    throw std::runtime_error("MappedFile: cannot read '" + filename + "'");
+  }
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("MappedFile: cannot open '" + filename +
+        "' for reading");
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0)
+  {
+    close(fd);
+    throw std::runtime_error("MappedFile: cannot stat '" + filename + "'");
+  }
+
+  size = info.st_size;
+  if (size > 0)
+  {
+    void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+        0);
+    if (address == MAP_FAILED)
+    {
+      close(fd);
+      throw std::runtime_error("MappedFile: cannot map '" + filename + "'");
+    }
+
+    data = static_cast<char*>(address);
+  }
+
+  // The mapping stays valid after the file is closed.
+  close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(_WIN32)
+  delete[] data;
+#else
+  if (data)
+    munmap(data, size);
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
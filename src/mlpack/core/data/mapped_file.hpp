@@ -0,0 +1,65 @@
+/**
+ * @file core/data/mapped_file.hpp
+ *
+ * Definition of the MappedFile class, which gives access to the contents of a
+ * file in memory without reading it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The contents of a whole file, in memory.  On POSIX systems the file is
+ * memory-mapped, so its pages are only read from disk when they are first used,
+ * and the page cache is shared by every process that maps the same file.  On
+ * other systems the file is read into memory.
+ *
+ * The mapping is private: the memory may be written to, but the changes are
+ * never written back to the file, and every page that is written to becomes a
+ * private copy.
+ *
+ * A std::runtime_error is thrown if the file cannot be opened or mapped.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the given file.
+   *
+   * @param filename Name of the file to map.
+   */
+  MappedFile(const std::string& filename);
+
+  //! Unmap the file.
+  ~MappedFile();
+
+  //! The mapping cannot be copied.
+  MappedFile(const MappedFile&) = delete;
+  //! The mapping cannot be copied.
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! Get the contents of the file.
+  char* Data() const { return data; }
+  //! Get the size of the file, in bytes.
+  size_t Size() const { return size; }
+
+ private:
+  //! The contents of the file.
+  char* data;
+  //! The size of the file, in bytes.
+  size_t size;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -15,10 +15,42 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core.hpp>
+#include <unordered_map>
 
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+//! Hash of the values of a dimension to encode, where every NaN is the same.
+template<typename eT>
+struct CategoryHash
+{
+  size_t operator()(const eT value) const
+  {
+    return (value != value) ? 0 : std::hash<eT>()(value);
+  }
+};
+
+//! Equality of the values of a dimension to encode, where every NaN is the
+//! same.
+template<typename eT>
+struct CategoryEqual
+{
+  bool operator()(const eT a, const eT b) const
+  {
+    return (a == b) || (a != a && b != b);
+  }
+};
+
+//! Mapping from the values of a dimension to encode to their category.  All
+//! NaN values are one category.
+template<typename eT>
+using CategoryMap = std::unordered_map<eT, size_t, CategoryHash<eT>,
+    CategoryEqual<eT>>;
+
+} // namespace details
+
 /**
  * Given a set of labels of a particular datatype, convert them to binary
  * vector. The categorical values be mapped to integer values.
@@ -33,10 +65,23 @@ template<typename RowType, typename MatType>
 void OneHotEncoding(const RowType& labelsIn,
                     MatType& output);
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ * This holds one nonzero value per label, so it should be preferred when
+ * there are many different labels.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Sparse binary matrix.
+ */
+template<typename RowType, typename eT>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a vector of indices to encode and outputs a matrix.
- * Indices represent the IDs of the dimensions to be one-hot encoded.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.  All the
+ * NaN values of a dimension are encoded as one category.
  *
  * @param input Input dataset to be encoded.
  * @param indices Index of rows to be encoded.
@@ -47,6 +92,21 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ * The encoded dimensions only take one nonzero value per point, so this should
+ * be preferred when they have many categories.  The dimensions that are not
+ * encoded are copied, without their zero values.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Sparse encoded matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -62,6 +122,20 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ * This function encodes all the dimensions marked `Datatype::categorical`
+ * in the data::DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Sparse encoded matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
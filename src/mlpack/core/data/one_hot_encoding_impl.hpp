@@ -65,6 +65,103 @@ void OneHotEncoding(const RowType& labelsIn,
   labelMap.clear();
 }
 
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ *
+ * @param labelsIn Input labels of arbitrary datatype.
+ * @param output Sparse binary matrix.
+ */
+template<typename RowType, typename eT>
+void OneHotEncoding(const RowType& labelsIn,
+                    arma::SpMat<eT>& output)
+{
+  // Map the labels to the rows of the output, in order of appearance.
+  std::unordered_map<typename RowType::elem_type, size_t> labelMap;
+  arma::umat locations(2, labelsIn.n_elem);
+  for (size_t i = 0; i < labelsIn.n_elem; ++i)
+  {
+    locations(0, i) = labelMap.emplace(labelsIn[i], labelMap.size()).first->
+        second;
+    locations(1, i) = i;
+  }
+
+  // The locations are already sorted in column-major order.
+  output = arma::SpMat<eT>(locations, arma::ones<arma::Col<eT>>(
+      labelsIn.n_elem), labelMap.size(), labelsIn.n_elem, false, false);
+}
+
+namespace details {
+
+/**
+ * Find the values taken by the dimensions to encode, and the offsets of every
+ * dimension in the encoded matrix.  The dimensions are scanned in parallel,
+ * and the values of every dimension are numbered in order of appearance.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param mappings Mapping from the values of every dimension to encode to the
+ *     index of their row among the rows of the dimension (all NaN values share
+ *     one row); the mapping of the other dimensions is empty.
+ * @param encoded Whether every dimension is encoded.
+ * @param offsets Offset of every dimension in the encoded matrix, followed by
+ *     the number of rows of the encoded matrix.
+ */
+template<typename eT>
+void OneHotEncodingMappings(
+    const arma::Mat<eT>& input,
+    const arma::Col<size_t>& indices,
+    std::vector<CategoryMap<eT>>& mappings,
+    std::vector<char>& encoded,
+    arma::Col<size_t>& offsets)
+{
+  mappings.clear();
+  mappings.resize(input.n_rows);
+  encoded.assign(input.n_rows, 0);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    encoded[indices[i]] = 1;
+
+  // Every dimension that is not encoded takes a single row.
+  arma::Col<size_t> counts(input.n_rows, arma::fill::ones);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t row = 0; row < (omp_size_t) input.n_rows; ++row)
+  {
+    if (!encoded[row])
+      continue;
+
+    CategoryMap<eT>& mapping = mappings[row];
+    for (size_t col = 0; col < input.n_cols; ++col)
+      mapping.emplace(input(row, col), mapping.size());
+    counts[row] = mapping.size();
+  }
+
+  offsets.zeros(input.n_rows + 1);
+  for (size_t row = 0; row < input.n_rows; ++row)
+    offsets[row + 1] = offsets[row] + counts[row];
+}
+
+/**
+ * Return the indices of the dimensions marked `Datatype::categorical` in the
+ * given data::DatasetInfo.
+ *
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+inline arma::Col<size_t> CategoricalDimensions(
+    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  return arma::Col<size_t>(indices);
+}
+
+} // namespace details
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a vector of indices to encode and outputs a matrix.
@@ -86,61 +183,78 @@ void OneHotEncoding(const arma::Mat<eT>& input,
     return;
   }
 
-  // First, we need to compute the size of the output matrix.
+  std::vector<details::CategoryMap<eT>> mappings;
+  std::vector<char> encoded;
+  arma::Col<size_t> offsets;
+  details::OneHotEncodingMappings(input, indices, mappings, encoded, offsets);
 
-  // This vector will eventually hold the offsets for each dimension in the
-  // one-hot encoded matrix, but first it will just hold the counts of
-  // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
-  // This will hold the mappings from a value that should be one-hot encoded to
-  // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
-  for (size_t i = 0; i < indices.n_elem; ++i)
-  {
-    dimensionOffsets[indices[i]] = 0;
-    mappings.insert(
-        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
-  }
+  // Now, initialize the output matrix to the right size.
+  output.zeros(offsets[input.n_rows], input.n_cols);
 
-  for (size_t col = 0; col < input.n_cols; ++col)
+  // Finally, one-hot encode the matrix; every point is encoded on its own.
+  #pragma omp parallel for
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
   {
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      if (mappings.count(row) != 0)
+      if (encoded[row])
       {
-        // We have to one-hot encode this point.
-        if (mappings[row].count(input(row, col)) == 0)
-          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+        output(offsets[row] + mappings[row].at(input(row, col)), col) = eT(1);
+      }
+      else
+      {
+        // No need for one-hot encoding.
+        output(offsets[row], col) = input(row, col);
       }
     }
   }
+}
 
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
-  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
-    dimensionOffsets[i] += dimensionOffsets[i - 1];
-
-  // Now, initialize the output matrix to the right size.
-  output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Sparse encoded matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  std::vector<details::CategoryMap<eT>> mappings;
+  std::vector<char> encoded;
+  arma::Col<size_t> offsets;
+  details::OneHotEncodingMappings(input, indices, mappings, encoded, offsets);
 
-  // Finally, one-hot encode the matrix.
-  for (size_t col = 0; col < input.n_cols; ++col)
+  // Every dimension gives exactly one value per point, so the location of
+  // every value is known in advance.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  #pragma omp parallel for
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
   {
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
-      if (mappings.count(row) != 0)
+      const size_t i = col * input.n_rows + row;
+      locations(1, i) = col;
+      if (encoded[row])
       {
-        output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
+        locations(0, i) = offsets[row] + mappings[row].at(input(row, col));
+        values[i] = eT(1);
       }
       else
       {
-        // No need for one-hot encoding.
-        output(dimOffset, col) = input(row, col);
+        locations(0, i) = offsets[row];
+        values[i] = input(row, col);
       }
     }
   }
+
+  // The locations are already sorted in column-major order, but the zero
+  // values of the dimensions that are not encoded must be dropped.
+  output = arma::SpMat<eT>(locations, values, offsets[input.n_rows],
+      input.n_cols, false, true);
 }
 
 /**
@@ -158,15 +272,22 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo)
 {
-  std::vector<size_t> indices;
-  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
-  {
-    if (datasetInfo.Type(i) == data::Datatype::categorical)
-    {
-      indices.push_back(i);
-    }
-  }
-  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+  OneHotEncoding(input, details::CategoricalDimensions(datasetInfo), output);
+}
+
+/**
+ * Overloaded function for the above function, which outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Sparse encoded matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  OneHotEncoding(input, details::CategoricalDimensions(datasetInfo), output);
 }
 
 } // namespace data
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MAX_ABS_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -54,8 +55,7 @@ class MaxAbsScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    RowMinMax(input, itemMin, itemMax);
     scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -77,7 +77,12 @@ class MaxAbsScaler
         " refer to the documentation.");
     }
     output.copy_size(input);
-    output = input.each_col() / scale;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = input.cols(begin, end - 1).each_col()
+              / scale;
+        });
   }
 
   /**
@@ -90,7 +95,12 @@ class MaxAbsScaler
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = input.each_col() % scale;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = input.cols(begin, end - 1).each_col()
+              % scale;
+        });
   }
 
   //! Get the Min row vector.
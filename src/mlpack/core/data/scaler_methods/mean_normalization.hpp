@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MEAN_NORMALIZATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -54,9 +55,8 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    RowMean(input, itemMean);
+    RowMinMax(input, itemMin, itemMax);
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -78,7 +78,12 @@ class MeanNormalization
         " refer to the documentation.");
     }
     output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / scale;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              - itemMean).each_col() / scale;
+        });
   }
 
   /**
@@ -91,7 +96,12 @@ class MeanNormalization
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + itemMean;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              % scale).each_col() + itemMean;
+        });
   }
 
   //! Get the Mean row vector.
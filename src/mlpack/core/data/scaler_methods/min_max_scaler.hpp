@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -73,8 +74,7 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    RowMinMax(input, itemMin, itemMax);
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -100,7 +100,12 @@ class MinMaxScaler
           " refer to the documentation.");
     }
     output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              % scale).each_col() + scalerowmin;
+        });
   }
 
   /**
@@ -113,7 +118,12 @@ class MinMaxScaler
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              - scalerowmin).each_col() / scale;
+        });
   }
 
   //! Get the Min row vector.
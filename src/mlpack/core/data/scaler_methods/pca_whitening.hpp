@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/lin_alg.hpp>
 #include <mlpack/core/math/ccov.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -70,7 +71,7 @@ class PCAWhitening
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
+    RowMean(input, itemMean);
     // Get eigenvectors and eigenvalues of covariance of input matrix.
     eig_sym(eigenValues, eigenVectors, mlpack::math::ColumnCovariance(
         input.each_col() - itemMean));
@@ -85,16 +86,30 @@ class PCAWhitening
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    const arma::mat whitening = Whitening();
+    output.copy_size(input);
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = whitening *
+              (input.cols(begin, end - 1).each_col() - itemMean);
+        });
+  }
+
+  /**
+   * Build the whitening matrix, so that Transform(input) is whitening times
+   * (input - ItemMean()).  Callers that transform many small batches can build
+   * it once and apply it themselves.
+   */
+  arma::mat Whitening() const
   {
     if (eigenValues.is_empty() || eigenVectors.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean);
-    output = arma::diagmat(1.0 / (arma::sqrt(eigenValues))) * eigenVectors.t()
-        * output;
+    return arma::diagmat(1.0 / (arma::sqrt(eigenValues))) * eigenVectors.t();
   }
 
   /**
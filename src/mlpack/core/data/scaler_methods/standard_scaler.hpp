@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_STANDARD_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -55,8 +56,8 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    RowMean(input, itemMean);
+    RowStdDev(input, itemMean, itemStdDev);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -77,7 +78,12 @@ class StandardScaler
         " refer to the documentation.");
     }
     output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              - itemMean).each_col() / itemStdDev;
+        });
   }
 
   /**
@@ -90,7 +96,12 @@ class StandardScaler
   void InverseTransform(const MatType& input, MatType& output)
   {
     output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = (input.cols(begin, end - 1).each_col()
+              % itemStdDev).each_col() + itemMean;
+        });
   }
 
   //! Get the mean row vector.
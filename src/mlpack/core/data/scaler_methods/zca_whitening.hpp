@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/lin_alg.hpp>
 #include <mlpack/core/data/scaler_methods/pca_whitening.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
 
 namespace mlpack {
 namespace data {
@@ -74,8 +75,30 @@ class ZCAWhitening
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
   {
-    pca.Transform(input, output);
-    output = pca.EigenVectors() * output;
+    const arma::mat whitening = Whitening();
+    output.copy_size(input);
+    ForEachColumnBlock(input.n_rows, input.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          output.cols(begin, end - 1) = whitening *
+              (input.cols(begin, end - 1).each_col() - pca.ItemMean());
+        });
+  }
+
+  /**
+   * Build the whitening matrix, so that Transform(input) is whitening times
+   * (input - ItemMean()).  It rotates back after whitening, so that a single
+   * product is needed.
+   */
+  arma::mat Whitening() const
+  {
+    if (pca.EigenValues().is_empty() || pca.EigenVectors().is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+    return pca.EigenVectors() * arma::diagmat(1.0 /
+        (arma::sqrt(pca.EigenValues()))) * pca.EigenVectors().t();
   }
 
   /**
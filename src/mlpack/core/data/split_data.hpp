@@ -14,9 +14,61 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "column_blocks.hpp"
 
 namespace mlpack {
 namespace data {
+/**
+ * Given the number of points of a dataset, split the indices of the points
+ * into a training set and test set, without copying the dataset.  The indices
+ * can be used to take views of the dataset, which are only copied if they are
+ * stored into a matrix.  The split is the same as the one of the overloads
+ * below for the same random seed.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::uvec trainIndices;
+ * arma::uvec testIndices;
+ * math::RandomSeed(100); // Set the seed if you like.
+ *
+ * // Split the indices of the points into a training and test set, with 30% of
+ * // the points being held out for the test set.
+ * Split(input.n_cols, trainIndices, testIndices, 0.3);
+ *
+ * // Compute something on the training points without copying them.
+ * arma::vec trainMean = arma::mean(input.cols(trainIndices), 1);
+ * @endcode
+ *
+ * @param numPoints Number of points of the dataset.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+inline void Split(const size_t numPoints,
+                  arma::uvec& trainIndices,
+                  arma::uvec& testIndices,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+  if (numPoints == 0)
+  {
+    trainIndices.reset();
+    testIndices.reset();
+    return;
+  }
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload places the split dataset into the four
@@ -66,18 +118,15 @@ void Split(const arma::Mat<T>& input,
 
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(
-        0, input.n_cols - 1, input.n_cols));
-    if (trainSize > 0)
-    {
-      trainData = input.cols(order.subvec(0, trainSize - 1));
-      trainLabel = inputLabel.cols(order.subvec(0, trainSize - 1));
-    }
-    if (trainSize < input.n_cols)
-    {
-    testData = input.cols(order.subvec(trainSize, input.n_cols - 1));
-    testLabel = inputLabel.cols(order.subvec(trainSize, input.n_cols - 1));
-    }
+    arma::uvec trainIndices;
+    arma::uvec testIndices;
+    Split(input.n_cols, trainIndices, testIndices, testRatio, shuffleData);
+    GatherColumns(input, trainIndices, trainData);
+    GatherColumns(input, testIndices, testData);
+    for (size_t i = 0; i < trainSize; ++i)
+      trainLabel[i] = inputLabel[trainIndices[i]];
+    for (size_t i = 0; i < testSize; ++i)
+      testLabel[i] = inputLabel[testIndices[i]];
   }
   else
   {
@@ -131,14 +180,11 @@ void Split(const arma::Mat<T>& input,
 
   if (shuffleData)
   {
-    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(
-        0, input.n_cols - 1, input.n_cols));
-
-    if (trainSize > 0)
-      trainData = input.cols(order.subvec(0, trainSize - 1));
-
-    if (trainSize < input.n_cols)
-      testData = input.cols(order.subvec(trainSize, input.n_cols - 1));
+    arma::uvec trainIndices;
+    arma::uvec testIndices;
+    Split(input.n_cols, trainIndices, testIndices, testRatio, shuffleData);
+    GatherColumns(input, trainIndices, trainData);
+    GatherColumns(input, testIndices, testData);
   }
   else
   {
@@ -150,6 +196,39 @@ void Split(const arma::Mat<T>& input,
   }
 }
 
+/**
+ * Given the number of points of a dataset, split the indices of the points
+ * into a training set and test set.  Example usage below.  This overload
+ * returns the indices as a std::tuple with two elements: an arma::uvec
+ * containing the indices of the training points and an arma::uvec containing
+ * the indices of the test points.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::uvec trainIndices, testIndices;
+ * std::tie(trainIndices, testIndices) = Split(input.n_cols, 0.2);
+ * @endcode
+ *
+ * @param numPoints Number of points of the dataset.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true).
+ * @return std::tuple containing trainIndices (arma::uvec) and testIndices
+ *      (arma::uvec).
+ */
+inline std::tuple<arma::uvec, arma::uvec>
+Split(const size_t numPoints,
+      const double testRatio,
+      const bool shuffleData = true)
+{
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+  Split(numPoints, trainIndices, testIndices, testRatio, shuffleData);
+
+  return std::make_tuple(std::move(trainIndices),
+                         std::move(testIndices));
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload returns the split dataset as a std::tuple
@@ -73,6 +73,34 @@ class CVFunction
    */
   double Evaluate(const arma::mat& parameters);
 
+  /**
+   * Run cross-validation with the bound and passed parameters, and give the
+   * trained model to the caller instead of comparing it with the best model so
+   * far.  This does not modify the object, so it can be called by several
+   * threads at once if CVType::EvaluateWithModel() can.
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the Evaluate method of the CVType object.
+   * @param model Pointer to store the trained model in.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  std::unique_ptr<MLAlgorithm>& model);
+
+  /**
+   * Run cross-validation with the bound and passed parameters like the
+   * previous overload, but train on only the given fraction of the training
+   * points (see CVType::EvaluateOnSubset()).
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the Evaluate method of the CVType object.
+   * @param model Pointer to store the trained model in.
+   * @param trainingFraction Fraction of the training points to use, in
+   *     (0, 1].
+   */
+  double Evaluate(const arma::mat& parameters,
+                  std::unique_ptr<MLAlgorithm>& model,
+                  const double trainingFraction);
+
   /**
    * Evaluate numerically the gradient of the CVFunction with the given
    * parameters.
@@ -104,6 +132,47 @@ class CVFunction
            bool BoundArgsIndexInRange = (BoundArgIndex < BoundArgsAmount)>
   struct UseBoundArg;
 
+  /**
+   * Run cross-validation with the collected arguments, and keep the model if
+   * it is the best so far.
+   */
+  struct KeepBestModel
+  {
+    CVFunction& function;
+
+    template<typename... Args>
+    double operator()(const Args&... args) const;
+  };
+
+  /**
+   * Run cross-validation with the collected arguments, and store the model in
+   * the given pointer.
+   */
+  struct StoreModel
+  {
+    CVType& cv;
+    std::unique_ptr<MLAlgorithm>& model;
+
+    template<typename... Args>
+    double operator()(const Args&... args) const
+    { return cv.EvaluateWithModel(model, args...); }
+  };
+
+  /**
+   * Run cross-validation with the collected arguments on a fraction of the
+   * training points, and store the model in the given pointer.
+   */
+  struct StoreSubsetModel
+  {
+    CVType& cv;
+    std::unique_ptr<MLAlgorithm>& model;
+    double trainingFraction;
+
+    template<typename... Args>
+    double operator()(const Args&... args) const
+    { return cv.EvaluateOnSubset(model, trainingFraction, args...); }
+  };
+
   //! A reference to the cross-validation object.
   CVType& cv;
 
@@ -130,31 +199,40 @@ class CVFunction
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename Callback,
            typename... Args,
            typename = typename
                std::enable_if<(BoundArgIndex + ParamIndex < TotalArgs)>::type>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const Callback& callback,
+                         const Args&... args);
 
   /**
    * Run cross-validation with the collected arguments.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename Callback,
            typename... Args,
            typename = typename
                std::enable_if<BoundArgIndex + ParamIndex == TotalArgs>::type,
            typename = void>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const Callback& callback,
+                         const Args&... args);
 
   /**
    * Put the bound argument (at the BoundArgIndex position) as the next one.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename Callback,
            typename... Args,
            typename = typename std::enable_if<
                UseBoundArg<BoundArgIndex, ParamIndex>::value>::type>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const Callback& callback,
+                           const Args&... args);
 
   /**
    * Put the element (at the ParamIndex position) of the parameters as the next
@@ -162,11 +240,14 @@ class CVFunction
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename Callback,
            typename... Args,
            typename = typename std::enable_if<
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>::type,
            typename = void>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const Callback& callback,
+                           const Args&... args);
 };
 
 
@@ -65,7 +65,53 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  return Evaluate<0, 0>(parameters, KeepBestModel{*this});
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model)
+{
+  return Evaluate<0, 0>(parameters, StoreModel{cv, model});
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model,
+    const double trainingFraction)
+{
+  return Evaluate<0, 0>(parameters,
+      StoreSubsetModel{cv, model, trainingFraction});
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+KeepBestModel::operator()(const Args&... args) const
+{
+  double objective = function.cv.Evaluate(args...);
+
+  // Change the best model if we have got a better score, or if we probably
+  // have not assigned any valid (trained) model yet.
+  if (function.bestObjective > objective ||
+      function.bestObjective == std::numeric_limits<double>::max())
+  {
+    function.bestObjective = objective;
+    function.bestModel = std::move(function.cv.Model());
+  }
+
+  return objective;
 }
 
 template<typename CVType,
@@ -95,13 +141,15 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename Callback,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters,
+    const Callback& callback,
     const Args&... args)
 {
-  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, args...);
+  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, callback, args...);
 }
 
 template<typename CVType,
@@ -110,25 +158,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename Callback,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& /* parameters */,
+    const Callback& callback,
     const Args&... args)
 {
-  double objective = cv.Evaluate(args...);
-
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
-  {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
-  }
-
-  return objective;
+  return callback(args...);
 }
 
 template<typename CVType,
@@ -137,14 +176,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename Callback,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const Callback& callback,
     const Args&... args)
 {
-  return Evaluate<BoundArgIndex + 1, ParamIndex>(
-      parameters, args..., std::get<BoundArgIndex>(boundArgs).value);
+  return Evaluate<BoundArgIndex + 1, ParamIndex>(parameters, callback,
+      args..., std::get<BoundArgIndex>(boundArgs).value);
 }
 
 template<typename CVType,
@@ -153,22 +194,25 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename Callback,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const Callback& callback,
     const Args&... args)
 {
   if (datasetInfo.Type(ParamIndex) == data::Datatype::categorical)
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)), ParamIndex));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, callback,
+        args..., datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)),
+        ParamIndex));
   }
   else
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        parameters(ParamIndex, 0));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, callback,
+        args..., parameters(ParamIndex, 0));
   }
 }
 
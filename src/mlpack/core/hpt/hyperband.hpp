@@ -0,0 +1,118 @@
+/**
+ * @file core/hpt/hyperband.hpp
+ *
+ * A Hyperband search for HyperParameterTuner.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_HYPERBAND_HPP
+#define MLPACK_CORE_HPT_HYPERBAND_HPP
+
+#include <mlpack/core.hpp>
+#include "successive_halving.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * Hyperband is an optimizer for HyperParameterTuner that runs several
+ * successive halving searches (brackets) on random samples of the grid of
+ * values of the hyper-parameters, each bracket trading the number of sampled
+ * combinations against the fraction of the training points they start with:
+ *
+ * @code
+ * @article{li2018hyperband,
+ *   title={Hyperband: A Novel Bandit-Based Approach to Hyperparameter
+ *       Optimization},
+ *   author={Li, L. and Jamieson, K. and DeSalvo, G. and Rostamizadeh, A. and
+ *       Talwalkar, A.},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={18},
+ *   number={185},
+ *   pages={1--52},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * With s_max + 1 the number of rungs of SuccessiveHalving for MinBudget(), the
+ * bracket s (from s_max down to 0) samples ceil((s_max + 1) / (s + 1) * eta^s)
+ * combinations (or the whole grid, if it is smaller) and runs s + 1 rungs of
+ * successive halving on them, starting with a fraction eta^-s of the training
+ * points; the last bracket is a random search on the whole training set.  The
+ * result is the best combination of all brackets.  This is more robust than
+ * SuccessiveHalving alone when some combinations only do well with enough
+ * training points, and cheaper than a grid search on large grids.
+ *
+ * Brackets are run one after the other, and the combinations of a rung are
+ * evaluated in parallel with OpenMP, as in SuccessiveHalving; the same
+ * requirements apply to the function and to the learner.
+ */
+class Hyperband
+{
+ public:
+  /**
+   * Create the optimizer.
+   *
+   * @param eta Factor by which the number of combinations is divided, and the
+   *     training fraction multiplied, from one rung to the next (more than 1).
+   * @param minBudget Smallest fraction of the training points used by a rung
+   *     (in (0, 1]).
+   * @param maxConcurrentModels Maximum number of combinations evaluated at the
+   *     same time; 0 means one per OpenMP thread.
+   */
+  Hyperband(const double eta = 3.0,
+            const double minBudget = 0.1,
+            const size_t maxConcurrentModels = 0);
+
+  /**
+   * Run Hyperband on the grid given by the categories of the given dimensions,
+   * and store the best combination in the iterate, and the model trained with
+   * it on the whole training set in the best model of the function.
+   *
+   * @param function Function to optimize (a CVFunction).
+   * @param iterate Matrix to store the best combination in.
+   * @param categoricalDimensions Whether each dimension is categorical (all of
+   *     them must be).
+   * @param numCategories Number of categories of each dimension.
+   * @return The objective of the best combination.
+   */
+  template<typename FunctionType, typename MatType>
+  double Optimize(FunctionType& function,
+                  MatType& iterate,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  //! Get the factor between rungs.
+  double Eta() const { return eta; }
+  //! Modify the factor between rungs.
+  double& Eta() { return eta; }
+
+  //! Get the smallest fraction of the training points used by a rung.
+  double MinBudget() const { return minBudget; }
+  //! Modify the smallest fraction of the training points used by a rung.
+  double& MinBudget() { return minBudget; }
+
+  //! Get the maximum number of combinations evaluated at the same time.
+  size_t MaxConcurrentModels() const { return maxConcurrentModels; }
+  //! Modify the maximum number of combinations evaluated at the same time.
+  size_t& MaxConcurrentModels() { return maxConcurrentModels; }
+
+ private:
+  //! The factor between rungs.
+  double eta;
+  //! The smallest fraction of the training points used by a rung.
+  double minBudget;
+  //! The maximum number of combinations evaluated at the same time.
+  size_t maxConcurrentModels;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "hyperband_impl.hpp"
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file core/hpt/hyperband_impl.hpp
+ *
+ * Implementation of the Hyperband class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_HYPERBAND_IMPL_HPP
+#define MLPACK_CORE_HPT_HYPERBAND_IMPL_HPP
+
+#include "hyperband.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+inline Hyperband::Hyperband(const double eta,
+                            const double minBudget,
+                            const size_t maxConcurrentModels) :
+    eta(eta),
+    minBudget(minBudget),
+    maxConcurrentModels(maxConcurrentModels)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType, typename MatType>
+double Hyperband::Optimize(FunctionType& function,
+                           MatType& iterate,
+                           const std::vector<bool>& categoricalDimensions,
+                           const arma::Row<size_t>& numCategories)
+{
+  typedef typename std::remove_reference<
+      decltype(function.BestModel())>::type ModelType;
+
+  const size_t gridSize = GridSize("Hyperband",
+      categoricalDimensions, numCategories);
+
+  const SuccessiveHalving successiveHalving(eta, minBudget,
+      maxConcurrentModels);
+  const size_t maxBracket = successiveHalving.NumRungs() - 1;
+
+  // Sample the points of every bracket without replacement before any of
+  // them is evaluated, so that the samples only depend on the seed set by the
+  // caller.  They are sorted so that ties are broken in grid order.
+  std::vector<std::vector<size_t>> brackets(maxBracket + 1);
+  for (size_t i = 0; i <= maxBracket; ++i)
+  {
+    const size_t s = maxBracket - i;
+    const size_t numPoints = std::min(gridSize, (size_t) std::ceil(
+        (double) (maxBracket + 1) / (s + 1) * std::pow(eta, (double) s)));
+
+    std::vector<size_t>& points = brackets[i];
+    points.resize(numPoints);
+    if (numPoints == gridSize)
+    {
+      for (size_t j = 0; j < numPoints; ++j)
+        points[j] = j;
+    }
+    else
+    {
+      const arma::uvec permutation = arma::randperm(gridSize);
+      for (size_t j = 0; j < numPoints; ++j)
+        points[j] = permutation[j];
+      std::sort(points.begin(), points.end());
+    }
+  }
+
+  size_t bestPoint = gridSize;
+  double bestObjective = 0.0;
+  double bestKey = 0.0;
+  std::unique_ptr<ModelType> bestModel;
+  for (size_t i = 0; i <= maxBracket; ++i)
+  {
+    const size_t s = maxBracket - i;
+
+    size_t point;
+    std::unique_ptr<ModelType> model;
+    const double objective = successiveHalving.Run(function, numCategories,
+        brackets[i], s + 1, point, model);
+    const double key = std::isnan(objective) ?
+        std::numeric_limits<double>::infinity() : objective;
+
+    // Ties go to the earlier bracket.
+    if (bestPoint == gridSize || key < bestKey)
+    {
+      bestPoint = point;
+      bestObjective = objective;
+      bestKey = key;
+      bestModel = std::move(model);
+    }
+  }
+
+  iterate.set_size(numCategories.n_elem, 1);
+  GridPoint(bestPoint, numCategories, iterate);
+  function.BestModel() = std::move(*bestModel);
+  return bestObjective;
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
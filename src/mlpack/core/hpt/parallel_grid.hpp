@@ -0,0 +1,154 @@
+/**
+ * @file core/hpt/parallel_grid.hpp
+ *
+ * Helpers shared by the optimizers of HyperParameterTuner that evaluate the
+ * points of a categorical grid in parallel (ParallelGridSearch,
+ * SuccessiveHalving and Hyperband).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_HPP
+
+#include <mlpack/core.hpp>
+#include <exception>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * Check that every dimension is categorical, and return the number of points
+ * of the grid.  A std::invalid_argument is thrown otherwise, or if the grid has
+ * no points.
+ *
+ * @param name Name of the optimizer, for error messages.
+ * @param categoricalDimensions Whether each dimension is categorical.
+ * @param numCategories Number of categories of each dimension.
+ */
+inline size_t GridSize(const std::string& name,
+                       const std::vector<bool>& categoricalDimensions,
+                       const arma::Row<size_t>& numCategories)
+{
+  if (categoricalDimensions.size() != numCategories.n_elem)
+  {
+    std::ostringstream oss;
+    oss << name << "::Optimize(): expected information about "
+        << numCategories.n_elem << " dimensions in categoricalDimensions, but "
+        << "got " << categoricalDimensions.size() << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  size_t gridSize = 1;
+  for (size_t d = 0; d < numCategories.n_elem; ++d)
+  {
+    if (!categoricalDimensions[d])
+    {
+      std::ostringstream oss;
+      oss << name << "::Optimize(): the dimension " << d
+          << " is not categorical" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    gridSize *= numCategories[d];
+  }
+
+  if (gridSize == 0)
+    throw std::invalid_argument(name + "::Optimize(): the grid has no points");
+
+  return gridSize;
+}
+
+/**
+ * Set the given parameters to the grid point of the given index, in the order
+ * of ens::GridSearch (where the first dimension changes slowest).
+ *
+ * @param index Index of the grid point.
+ * @param numCategories Number of categories of each dimension.
+ * @param parameters Matrix to store the grid point in.
+ */
+template<typename MatType>
+void GridPoint(const size_t index,
+               const arma::Row<size_t>& numCategories,
+               MatType& parameters)
+{
+  size_t rest = index;
+  for (size_t d = numCategories.n_elem; d > 0; --d)
+  {
+    parameters(d - 1) = rest % numCategories[d - 1];
+    rest /= numCategories[d - 1];
+  }
+}
+
+/**
+ * Draw the base seed of a set of parallel evaluations from the Armadillo
+ * generator of the calling thread, so that it follows the seed set by the
+ * caller.
+ */
+inline size_t DrawGridSeed()
+{
+  return arma::randi<arma::uvec>(1,
+      arma::distr_param(0, std::numeric_limits<int>::max()))[0];
+}
+
+/**
+ * Run task(i) for every i in [0, numTasks) in parallel with OpenMP, with at
+ * most maxConcurrentModels tasks at the same time (0 means one per OpenMP
+ * thread).  Task i runs with random number generators of its own, seeded with
+ * seed + i (see math::LocalRandomSeed), so the results do not depend on which
+ * thread runs which task, and the Armadillo generator of the calling thread is
+ * reseeded afterwards (see math::ArmaRandomSeedGuard).  Exceptions cannot leave
+ * the parallel region, so the first one thrown by a task is rethrown once every
+ * task has finished.
+ *
+ * @param numTasks Number of tasks to run.
+ * @param maxConcurrentModels Maximum number of tasks run at the same time.
+ * @param seed Seed of the first task.
+ * @param task Function to call with the index of each task.
+ */
+template<typename TaskType>
+void ParallelGridEvaluate(const size_t numTasks,
+                          const size_t maxConcurrentModels,
+                          const size_t seed,
+                          const TaskType& task)
+{
+  #ifdef HAS_OPENMP
+  const size_t numThreads = (maxConcurrentModels == 0) ?
+      (size_t) omp_get_max_threads() :
+      std::min((size_t) omp_get_max_threads(), maxConcurrentModels);
+  #else
+  const size_t numThreads = 1;
+  (void) maxConcurrentModels;
+  #endif
+
+  std::exception_ptr error;
+  math::ArmaRandomSeedGuard armaGuard;
+
+  #pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTasks; ++i)
+  {
+    try
+    {
+      math::LocalRandomSeed localSeed(seed + i);
+      task((size_t) i);
+    }
+    catch (...)
+    {
+      #pragma omp critical(ParallelGridEvaluateError)
+      {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file core/hpt/parallel_grid_search.hpp
+ *
+ * A grid search for HyperParameterTuner that evaluates the grid points in
+ * parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include "parallel_grid.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * ParallelGridSearch is a drop-in replacement for ens::GridSearch as the
+ * optimizer of HyperParameterTuner: it tries every combination of the given
+ * values of the hyper-parameters, like ens::GridSearch, but it evaluates the
+ * combinations in parallel with OpenMP.  For example,
+ *
+ * @code
+ * HyperParameterTuner<LinearRegression, MSE, KFoldCV, ParallelGridSearch>
+ *     hpt(5, data, responses);
+ * hpt.Optimizer().MaxConcurrentModels() = 8;
+ *
+ * arma::vec lambdas{0.0, 0.001, 0.01, 0.1, 1.0};
+ * double bestLambda;
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ *
+ * The result is the same as with ens::GridSearch: the combination with the
+ * lowest objective, and the first one in the order of ens::GridSearch among
+ * equal objectives.  Each combination is evaluated with random number
+ * generators of its own (see math::LocalRandomSeed), seeded from the index of
+ * the combination and a seed drawn once per search, so the results do not
+ * depend on the scheduling of the threads.
+ *
+ * Every thread trains its own models at the same time, so the learner must be
+ * safe to train in several threads at once, and at most twice as many models
+ * as threads are held in memory (the best model so far and the ones being
+ * trained); MaxConcurrentModels() bounds the number of threads.  The learner
+ * must draw its random numbers from Armadillo or from math::Random() and
+ * friends, not from another shared generator such as std::rand().
+ *
+ * The function to optimize must provide Evaluate(parameters, model) and
+ * BestModel() like CVFunction, so ParallelGridSearch can only be used by
+ * HyperParameterTuner, with a cross-validation class that provides
+ * EvaluateWithModel() (KFoldCV and SimpleCV do).
+ */
+class ParallelGridSearch
+{
+ public:
+  /**
+   * Create the optimizer.
+   *
+   * @param maxConcurrentModels Maximum number of combinations evaluated at the
+   *     same time; 0 means one per OpenMP thread.
+   */
+  ParallelGridSearch(const size_t maxConcurrentModels = 0) :
+      maxConcurrentModels(maxConcurrentModels)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate every combination of the categories of the given dimensions, and
+   * store the best one in the iterate, and the model trained with it in the
+   * best model of the function.
+   *
+   * @param function Function to optimize (a CVFunction).
+   * @param iterate Matrix to store the best combination in.
+   * @param categoricalDimensions Whether each dimension is categorical (all of
+   *     them must be).
+   * @param numCategories Number of categories of each dimension.
+   * @return The objective of the best combination.
+   */
+  template<typename FunctionType, typename MatType>
+  double Optimize(FunctionType& function,
+                  MatType& iterate,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  //! Get the maximum number of combinations evaluated at the same time.
+  size_t MaxConcurrentModels() const { return maxConcurrentModels; }
+  //! Modify the maximum number of combinations evaluated at the same time.
+  size_t& MaxConcurrentModels() { return maxConcurrentModels; }
+
+ private:
+  //! The maximum number of combinations evaluated at the same time.
+  size_t maxConcurrentModels;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_grid_search_impl.hpp"
+
+#endif
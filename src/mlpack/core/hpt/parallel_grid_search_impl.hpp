@@ -0,0 +1,73 @@
+/**
+ * @file core/hpt/parallel_grid_search_impl.hpp
+ *
+ * Implementation of the ParallelGridSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_IMPL_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_IMPL_HPP
+
+#include "parallel_grid_search.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+template<typename FunctionType, typename MatType>
+double ParallelGridSearch::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  typedef typename std::remove_reference<
+      decltype(function.BestModel())>::type ModelType;
+
+  const size_t numPoints = GridSize("ParallelGridSearch",
+      categoricalDimensions, numCategories);
+
+  // Only the best model so far is kept.  NaN objectives are treated as
+  // infinite, and ties go to the first point in the order of ens::GridSearch,
+  // so the result is the same as a serial search.
+  size_t bestIndex = numPoints;
+  double bestObjective = 0.0;
+  double bestKey = 0.0;
+  std::unique_ptr<ModelType> bestModel;
+
+  ParallelGridEvaluate(numPoints, maxConcurrentModels, DrawGridSeed(),
+      [&](const size_t i)
+      {
+        arma::mat parameters(numCategories.n_elem, 1);
+        GridPoint(i, numCategories, parameters);
+
+        std::unique_ptr<ModelType> model;
+        const double objective = function.Evaluate(parameters, model);
+        const double key = std::isnan(objective) ?
+            std::numeric_limits<double>::infinity() : objective;
+
+        #pragma omp critical(ParallelGridSearchBest)
+        {
+          if (bestIndex == numPoints || key < bestKey ||
+              (key == bestKey && i < bestIndex))
+          {
+            bestIndex = i;
+            bestObjective = objective;
+            bestKey = key;
+            bestModel = std::move(model);
+          }
+        }
+      });
+
+  iterate.set_size(numCategories.n_elem, 1);
+  GridPoint(bestIndex, numCategories, iterate);
+  function.BestModel() = std::move(*bestModel);
+  return bestObjective;
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * A successive halving search for HyperParameterTuner.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core.hpp>
+#include "parallel_grid.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalving is an optimizer for HyperParameterTuner that tries the
+ * same combinations of values of the hyper-parameters as ens::GridSearch, but
+ * does not train every combination on the whole training set:
+ *
+ * @code
+ * @inproceedings{jamieson2016non,
+ *   title={Non-stochastic Best Arm Identification and Hyperparameter
+ *       Optimization},
+ *   author={Jamieson, K. and Talwalkar, A.},
+ *   booktitle={Proceedings of the 19th International Conference on Artificial
+ *       Intelligence and Statistics (AISTATS)},
+ *   pages={240--248},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The search runs in rungs.  In the first rung every combination is trained on
+ * a fraction MinBudget() (or a little more) of the training points of the
+ * cross-validation, and only the best 1 / Eta() of the combinations go on to
+ * the next rung, where the fraction is Eta() times larger, until the last rung
+ * trains the remaining combinations on the whole training set.  The result is
+ * the best combination of the last rung.  With Eta() = 3, each rung costs
+ * about as much as the last one, so the search costs about as much as
+ * training log_3(1 / MinBudget()) + 1 combinations per combination that
+ * survives to the end, instead of every combination.
+ *
+ * The combinations of a rung are evaluated in parallel with OpenMP, with the
+ * same seeding and limits as ParallelGridSearch.  The training points used in
+ * a rung are the first ones of each training set, so the data should be
+ * shuffled (KFoldCV shuffles it by default).
+ *
+ * @code
+ * HyperParameterTuner<SoftmaxRegression, Accuracy, KFoldCV, SuccessiveHalving>
+ *     hpt(5, data, labels, numClasses);
+ * hpt.Optimizer().MinBudget() = 0.05;
+ *
+ * arma::vec lambdas = arma::logspace(-6, 1, 50);
+ * double bestLambda;
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ *
+ * The function to optimize must provide Evaluate(parameters, model,
+ * trainingFraction) and BestModel() like CVFunction, so SuccessiveHalving can
+ * only be used by HyperParameterTuner, with a cross-validation class that
+ * provides EvaluateOnSubset() (KFoldCV and SimpleCV do).
+ */
+class SuccessiveHalving
+{
+ public:
+  /**
+   * Create the optimizer.
+   *
+   * @param eta Factor by which the number of combinations is divided, and the
+   *     training fraction multiplied, from one rung to the next (more than 1).
+   * @param minBudget Smallest fraction of the training points used by the
+   *     first rung (in (0, 1]).
+   * @param maxConcurrentModels Maximum number of combinations evaluated at the
+   *     same time; 0 means one per OpenMP thread.
+   */
+  SuccessiveHalving(const double eta = 3.0,
+                    const double minBudget = 0.1,
+                    const size_t maxConcurrentModels = 0);
+
+  /**
+   * Run successive halving on every combination of the categories of the
+   * given dimensions, and store the best one in the iterate, and the model
+   * trained with it on the whole training set in the best model of the
+   * function.
+   *
+   * @param function Function to optimize (a CVFunction).
+   * @param iterate Matrix to store the best combination in.
+   * @param categoricalDimensions Whether each dimension is categorical (all of
+   *     them must be).
+   * @param numCategories Number of categories of each dimension.
+   * @return The objective of the best combination.
+   */
+  template<typename FunctionType, typename MatType>
+  double Optimize(FunctionType& function,
+                  MatType& iterate,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  /**
+   * Run successive halving on the given grid points with the given number of
+   * rungs; the first rung uses a fraction Eta()^-(numRungs - 1) of the
+   * training points.  This is the building block of Hyperband.
+   *
+   * @param function Function to optimize (a CVFunction).
+   * @param numCategories Number of categories of each dimension.
+   * @param points Indices of the grid points to try (see GridPoint()).
+   * @param numRungs Number of rungs.
+   * @param bestPoint Index of the best grid point.
+   * @param bestModel Model trained with the best grid point on the whole
+   *     training set.
+   * @return The objective of the best grid point.
+   */
+  template<typename FunctionType, typename ModelType>
+  double Run(FunctionType& function,
+             const arma::Row<size_t>& numCategories,
+             const std::vector<size_t>& points,
+             const size_t numRungs,
+             size_t& bestPoint,
+             std::unique_ptr<ModelType>& bestModel) const;
+
+  /**
+   * Return the number of rungs needed to go from MinBudget() to the whole
+   * training set.
+   */
+  size_t NumRungs() const;
+
+  //! Get the factor between rungs.
+  double Eta() const { return eta; }
+  //! Modify the factor between rungs.
+  double& Eta() { return eta; }
+
+  //! Get the smallest fraction of the training points used by a rung.
+  double MinBudget() const { return minBudget; }
+  //! Modify the smallest fraction of the training points used by a rung.
+  double& MinBudget() { return minBudget; }
+
+  //! Get the maximum number of combinations evaluated at the same time.
+  size_t MaxConcurrentModels() const { return maxConcurrentModels; }
+  //! Modify the maximum number of combinations evaluated at the same time.
+  size_t& MaxConcurrentModels() { return maxConcurrentModels; }
+
+ private:
+  //! The factor between rungs.
+  double eta;
+  //! The smallest fraction of the training points used by a rung.
+  double minBudget;
+  //! The maximum number of combinations evaluated at the same time.
+  size_t maxConcurrentModels;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "successive_halving_impl.hpp"
+
+#endif
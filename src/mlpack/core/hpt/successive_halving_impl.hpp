@@ -0,0 +1,168 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ *
+ * Implementation of the SuccessiveHalving class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+#include "successive_halving.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+inline SuccessiveHalving::SuccessiveHalving(const double eta,
+                                            const double minBudget,
+                                            const size_t maxConcurrentModels) :
+    eta(eta),
+    minBudget(minBudget),
+    maxConcurrentModels(maxConcurrentModels)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType, typename MatType>
+double SuccessiveHalving::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  typedef typename std::remove_reference<
+      decltype(function.BestModel())>::type ModelType;
+
+  const size_t gridSize = GridSize("SuccessiveHalving", categoricalDimensions,
+      numCategories);
+  std::vector<size_t> points(gridSize);
+  for (size_t i = 0; i < gridSize; ++i)
+    points[i] = i;
+
+  size_t bestPoint;
+  std::unique_ptr<ModelType> bestModel;
+  const double objective = Run(function, numCategories, points, NumRungs(),
+      bestPoint, bestModel);
+
+  iterate.set_size(numCategories.n_elem, 1);
+  GridPoint(bestPoint, numCategories, iterate);
+  function.BestModel() = std::move(*bestModel);
+  return objective;
+}
+
+template<typename FunctionType, typename ModelType>
+double SuccessiveHalving::Run(FunctionType& function,
+                              const arma::Row<size_t>& numCategories,
+                              const std::vector<size_t>& points,
+                              const size_t numRungs,
+                              size_t& bestPoint,
+                              std::unique_ptr<ModelType>& bestModel) const
+{
+  if (points.empty())
+  {
+    throw std::invalid_argument("SuccessiveHalving::Run(): no grid points "
+        "given");
+  }
+
+  // Every evaluation gets its own seed, so the results do not depend on which
+  // thread evaluates which point.
+  const size_t seed = DrawGridSeed();
+  size_t numTasks = 0;
+
+  std::vector<size_t> alive(points);
+  for (size_t rung = 0; ; ++rung)
+  {
+    // Once a single point is left, it goes straight to the last rung.
+    const bool last = (rung + 1 >= numRungs) || (alive.size() == 1);
+    const double budget = last ? 1.0 :
+        std::pow(eta, -((double) (numRungs - 1 - rung)));
+
+    // NaN objectives are treated as infinite.  Only the best model of the last
+    // rung is kept, and ties go to the first grid point, as in
+    // ens::GridSearch.
+    arma::vec objectives(alive.size());
+    arma::vec keys(alive.size());
+    size_t bestIndex = alive.size();
+    bestModel.reset();
+
+    ParallelGridEvaluate(alive.size(), maxConcurrentModels, seed + numTasks,
+        [&](const size_t i)
+        {
+          arma::mat parameters(numCategories.n_elem, 1);
+          GridPoint(alive[i], numCategories, parameters);
+
+          std::unique_ptr<ModelType> model;
+          objectives[i] = function.Evaluate(parameters, model, budget);
+          keys[i] = std::isnan(objectives[i]) ?
+              std::numeric_limits<double>::infinity() : objectives[i];
+
+          if (last)
+          {
+            #pragma omp critical(SuccessiveHalvingBest)
+            {
+              if (bestIndex == alive.size() || keys[i] < keys[bestIndex] ||
+                  (keys[i] == keys[bestIndex] && alive[i] < alive[bestIndex]))
+              {
+                bestIndex = i;
+                bestModel = std::move(model);
+              }
+            }
+          }
+        });
+
+    if (last)
+    {
+      bestPoint = alive[bestIndex];
+      return objectives[bestIndex];
+    }
+
+    numTasks += alive.size();
+
+    // Keep the best 1 / eta of the points for the next rung.
+    std::vector<size_t> order(alive.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(),
+        [&keys, &alive](const size_t a, const size_t b)
+        {
+          return (keys[a] < keys[b]) ||
+              (keys[a] == keys[b] && alive[a] < alive[b]);
+        });
+
+    const size_t numKept = std::max((size_t) 1,
+        (size_t) (alive.size() / eta));
+    std::vector<size_t> kept(numKept);
+    for (size_t i = 0; i < numKept; ++i)
+      kept[i] = alive[order[i]];
+    alive.swap(kept);
+  }
+}
+
+inline size_t SuccessiveHalving::NumRungs() const
+{
+  if (eta <= 1.0)
+  {
+    throw std::invalid_argument("SuccessiveHalving: eta must be greater than "
+        "1");
+  }
+
+  if (minBudget <= 0.0 || minBudget > 1.0)
+  {
+    throw std::invalid_argument("SuccessiveHalving: the minimum budget must be "
+        "in (0, 1]");
+  }
+
+  // Allow for rounding errors, so that a minimum budget of exactly eta^-k
+  // gives k + 1 rungs.
+  size_t numRungs = 1;
+  while (std::pow(eta, -((double) numRungs)) >= minBudget * (1.0 - 1e-10))
+    ++numRungs;
+
+  return numRungs;
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/metrics/raw_distances.hpp>
 
 namespace mlpack {
 namespace kernel {
@@ -39,7 +40,26 @@ class CosineDistance
    * @return d(a, b).
    */
   template<typename VecTypeA, typename VecTypeB>
-  static double Evaluate(const VecTypeA& a, const VecTypeB& b);
+  static double Evaluate(const VecTypeA& a,
+                         const VecTypeB& b,
+                         const typename std::enable_if_t<
+                             !metric::UseRawDistance<VecTypeA, VecTypeB>::value
+                         >* = 0);
+
+  /**
+   * Computes the cosine distance between two points stored in contiguous
+   * memory.  The inner product and both norms are computed in a single pass.
+   *
+   * @param a First vector.
+   * @param b Second vector.
+   * @return d(a, b).
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static double Evaluate(const VecTypeA& a,
+                         const VecTypeB& b,
+                         const typename std::enable_if_t<
+                             metric::UseRawDistance<VecTypeA, VecTypeB>::value
+                         >* = 0);
 
   //! Serialize the class (there's nothing to save).
   template<typename Archive>
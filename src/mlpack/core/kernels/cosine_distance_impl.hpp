@@ -18,7 +18,11 @@ namespace mlpack {
 namespace kernel {
 
 template<typename VecTypeA, typename VecTypeB>
-double CosineDistance::Evaluate(const VecTypeA& a, const VecTypeB& b)
+double CosineDistance::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        !metric::UseRawDistance<VecTypeA, VecTypeB>::value>*)
 {
   // Since we are using the L2 inner product, this is easy.  But we have to make
   // sure we aren't dividing by zero (if we are, then the cosine similarity is
@@ -32,6 +36,28 @@ double CosineDistance::Evaluate(const VecTypeA& a, const VecTypeB& b)
     return dot(a, b) / denominator;
 }
 
+template<typename VecTypeA, typename VecTypeB>
+double CosineDistance::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        metric::UseRawDistance<VecTypeA, VecTypeB>::value>*)
+{
+  metric::RawCheckSameSize(a, b,
+      "CosineDistance::Evaluate(): incompatible vector sizes");
+  typename VecTypeA::elem_type aa, bb;
+  const double ab = metric::RawDotProductAndNorms(
+      metric::HasRawMemory<VecTypeA>::Memory(a),
+      metric::HasRawMemory<VecTypeB>::Memory(b), a.n_elem, aa, bb);
+
+  // As above, a zero norm gives a cosine similarity of 0.
+  const double denominator = std::sqrt((double) aa) * std::sqrt((double) bb);
+  if (denominator == 0.0)
+    return 0;
+  else
+    return ab / denominator;
+}
+
 } // namespace kernel
 } // namespace mlpack
 
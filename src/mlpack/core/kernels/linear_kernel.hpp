@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/raw_distances.hpp>
 
 namespace mlpack {
 namespace kernel {
@@ -40,7 +41,8 @@ class LinearKernel
 
   /**
    * Simple evaluation of the dot product.  This evaluation uses Armadillo's
-   * dot() function.
+   * dot() function, or metric::RawDotProduct() if both vectors are stored
+   * contiguously.
    *
    * @tparam VecTypeA Type of first vector (should be arma::vec or
    *      arma::sp_vec).
@@ -52,12 +54,37 @@ class LinearKernel
   template<typename VecTypeA, typename VecTypeB>
   static double Evaluate(const VecTypeA& a, const VecTypeB& b)
   {
-    return arma::dot(a, b);
+    return Dot(a, b);
   }
 
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const unsigned int /* version */) { }
+
+ private:
+  //! Dot product of vectors stored in contiguous memory.
+  template<typename VecTypeA, typename VecTypeB>
+  static double Dot(const VecTypeA& a,
+                    const VecTypeB& b,
+                    const typename std::enable_if_t<
+                        metric::UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+  {
+    metric::RawCheckSameSize(a, b,
+        "LinearKernel::Evaluate(): incompatible vector sizes");
+    return metric::RawDotProduct(metric::HasRawMemory<VecTypeA>::Memory(a),
+        metric::HasRawMemory<VecTypeB>::Memory(b), a.n_elem);
+  }
+
+  //! Dot product of any other vector types.
+  template<typename VecTypeA, typename VecTypeB>
+  static double Dot(const VecTypeA& a,
+                    const VecTypeB& b,
+                    const typename std::enable_if_t<
+                        !metric::UseRawDistance<VecTypeA, VecTypeB>::value>* =
+                        0)
+  {
+    return arma::dot(a, b);
+  }
 };
 
 } // namespace kernel
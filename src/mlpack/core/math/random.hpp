@@ -30,6 +30,152 @@ extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
 
+namespace details {
+
+//! A random number generator with its own distributions.
+struct RandomState
+{
+  std::mt19937 generator;
+  std::uniform_real_distribution<> uniformDist{0.0, 1.0};
+  std::normal_distribution<> normalDist{0.0, 1.0};
+};
+
+//! Get the generator installed on the calling thread by a LocalRandomSeed, or
+//! NULL if the global generator is used.
+inline RandomState*& ThreadRandomState()
+{
+  static thread_local RandomState* state = NULL;
+  return state;
+}
+
+} // namespace details
+
+/**
+ * Get the random number generator used by the random functions on the calling
+ * thread: the one of the innermost LocalRandomSeed of the thread, if any, and
+ * the global randGen otherwise.
+ */
+inline std::mt19937& RandGen()
+{
+  details::RandomState* state = details::ThreadRandomState();
+  return (state != NULL) ? state->generator : randGen;
+}
+
+/**
+ * LocalRandomSeed gives the calling thread a random number generator of its
+ * own, seeded with the given seed, for as long as the object lives.  The random
+ * functions of this file (Random(), RandInt(), RandNormal() and so on) use it
+ * instead of the global randGen, and the Armadillo generator of the thread
+ * (which is already per-thread) is seeded too.  This lets tasks that run in
+ * parallel, such as the folds of KFoldCV, draw random numbers without sharing
+ * randGen, and with results that do not depend on the thread they run on.
+ *
+ * @code
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < (omp_size_t) numTasks; ++i)
+ * {
+ *   math::LocalRandomSeed localSeed(seed + i);
+ *   RunTask(i); // May call math::Random().
+ * }
+ * @endcode
+ *
+ * A LocalRandomSeed must be destroyed on the thread that created it.  The
+ * Armadillo generator cannot be saved, so it is not restored when the object is
+ * destroyed; see ArmaRandomSeedGuard.
+ */
+class LocalRandomSeed
+{
+ public:
+  /**
+   * Install a generator seeded with the given seed on the calling thread.
+   *
+   * @param seed Seed for the random number generator.
+   */
+  explicit LocalRandomSeed(const size_t seed) :
+      previous(details::ThreadRandomState())
+  {
+    state.generator.seed((uint32_t) seed);
+    arma::arma_rng::set_seed(seed);
+    details::ThreadRandomState() = &state;
+  }
+
+  //! Go back to the generator that was used before.
+  ~LocalRandomSeed() { details::ThreadRandomState() = previous; }
+
+  //! The generator cannot be copied.
+  LocalRandomSeed(const LocalRandomSeed&) = delete;
+  //! The generator cannot be copied.
+  LocalRandomSeed& operator=(const LocalRandomSeed&) = delete;
+
+ private:
+  //! The generator of this object.
+  details::RandomState state;
+  //! The generator that was used before.
+  details::RandomState* previous;
+};
+
+/**
+ * A LocalRandomSeed leaves the Armadillo generator of its thread reseeded, so
+ * after a parallel loop of tasks that use LocalRandomSeed, the Armadillo
+ * generator of the calling thread depends on which tasks that thread ran.
+ * ArmaRandomSeedGuard draws a seed from the Armadillo generator of the calling
+ * thread when it is created, and reseeds the generator with it when it is
+ * destroyed, so that the generator only depends on its state before the loop.
+ *
+ * @code
+ * math::ArmaRandomSeedGuard armaGuard;
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < (omp_size_t) numTasks; ++i)
+ * {
+ *   math::LocalRandomSeed localSeed(seed + i);
+ *   RunTask(i);
+ * }
+ * @endcode
+ *
+ * An ArmaRandomSeedGuard must be destroyed on the thread that created it.
+ */
+class ArmaRandomSeedGuard
+{
+ public:
+  //! Draw the seed to reseed the Armadillo generator with.
+  ArmaRandomSeedGuard() :
+      seed(arma::randi<arma::uvec>(1,
+          arma::distr_param(0, std::numeric_limits<int>::max()))[0])
+  { }
+
+  //! Reseed the Armadillo generator.
+  ~ArmaRandomSeedGuard() { arma::arma_rng::set_seed(seed); }
+
+  //! The guard cannot be copied.
+  ArmaRandomSeedGuard(const ArmaRandomSeedGuard&) = delete;
+  //! The guard cannot be copied.
+  ArmaRandomSeedGuard& operator=(const ArmaRandomSeedGuard&) = delete;
+
+ private:
+  //! The seed to reseed the Armadillo generator with.
+  size_t seed;
+};
+
+namespace details {
+
+//! Draw from the uniform distribution on [0, 1) of the calling thread.
+inline double RandomUniform()
+{
+  RandomState* state = ThreadRandomState();
+  return (state != NULL) ? state->uniformDist(state->generator) :
+      randUniformDist(randGen);
+}
+
+//! Draw from the standard normal distribution of the calling thread.
+inline double RandomNormal()
+{
+  RandomState* state = ThreadRandomState();
+  return (state != NULL) ? state->normalDist(state->generator) :
+      randNormalDist(randGen);
+}
+
+} // namespace details
+
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
@@ -82,7 +228,7 @@ inline void CustomRandomSeed(const size_t seed)
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  return details::RandomUniform();
 }
 
 /**
@@ -90,7 +236,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * details::RandomUniform();
 }
 
 /**
@@ -109,7 +255,7 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive * details::RandomUniform());
 }
 
 /**
@@ -118,7 +264,7 @@ inline int RandInt(const int hiExclusive)
 inline int RandInt(const int lo, const int hiExclusive)
 {
   return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+                               * details::RandomUniform());
 }
 
 /**
@@ -126,7 +272,7 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  return details::RandomNormal();
 }
 
 /**
@@ -138,7 +284,7 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * details::RandomNormal() + mean;
 }
 
 /**
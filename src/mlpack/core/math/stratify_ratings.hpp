@@ -0,0 +1,71 @@
+/**
+ * @file core/math/stratify_ratings.hpp
+ *
+ * Partition a (user, item, rating) coordinate list into blocks that can be
+ * processed concurrently by stratified SGD without conflicting updates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_STRATIFY_RATINGS_HPP
+#define MLPACK_CORE_MATH_STRATIFY_RATINGS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Partition the ratings of a (user, item, rating) coordinate list into
+ * numStrata x numStrata blocks, in the style of distributed SGD (DSGD):
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-scale Matrix Factorization with Distributed Stochastic
+ *       Gradient Descent},
+ *   author={Gemulla, Rainer and Nijkamp, Erik and Haas, Peter J. and
+ *       Sismanis, Yannis},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The rating in column j of the data is placed in block
+ * strata[(user % numStrata) * numStrata + (item % numStrata)].  For a fixed
+ * s, the blocks (b, (b + s) % numStrata) with b = 0, ..., numStrata - 1 share
+ * no users and no items, so they can be processed in parallel without any
+ * synchronization.  Within each block, the ratings are stored in the order in
+ * which they appear in 'order'.
+ *
+ * @param data Coordinate list; the first row holds users and the second row
+ *     holds items.
+ * @param order Order in which the ratings should be visited.
+ * @param numStrata Number of user (and item) blocks.
+ * @param strata Output blocks of rating indices.
+ */
+inline void StratifyRatings(const arma::mat& data,
+                            const arma::Col<size_t>& order,
+                            const size_t numStrata,
+                            std::vector<std::vector<size_t>>& strata)
+{
+  strata.resize(numStrata * numStrata);
+  for (size_t i = 0; i < strata.size(); ++i)
+    strata[i].clear();
+
+  for (size_t j = 0; j < order.n_elem; ++j)
+  {
+    const size_t user = (size_t) data(0, order[j]);
+    const size_t item = (size_t) data(1, order[j]);
+    strata[(user % numStrata) * numStrata + (item % numStrata)].push_back(
+        order[j]);
+  }
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * @file core/metrics/distance_tile.hpp
+ *
+ * Computation of a whole block ("tile") of query-reference distances at once,
+ * used by dual-tree rules to evaluate the base cases of a pair of leaves.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_DISTANCE_TILE_HPP
+#define MLPACK_CORE_METRICS_DISTANCE_TILE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "lmetric.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * DistanceTile computes the distances between a set of query points and a
+ * contiguous block of reference points in one call.  This generic version
+ * simply evaluates the metric for every pair, and Enabled() returns false so
+ * that callers know that there is no benefit over evaluating the pairs one at
+ * a time.  Metrics that can do better (such as the Euclidean distance on dense
+ * data) specialize this class.
+ *
+ * @tparam MetricType Metric to compute distances with.
+ * @tparam MatType Type of the datasets.
+ */
+template<typename MetricType, typename MatType>
+class DistanceTile
+{
+ public:
+  //! Type of the elements of the dataset.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the tile object for the given query and reference sets.  The
+   * datasets and the metric are only referenced, so they must outlive this
+   * object.
+   */
+  DistanceTile(MetricType& metric,
+               const MatType& querySet,
+               const MatType& referenceSet) :
+      metric(metric),
+      querySet(querySet),
+      referenceSet(referenceSet)
+  { }
+
+  //! Return whether computing whole tiles is faster than single evaluations.
+  bool Enabled() const { return false; }
+
+  /**
+   * Compute bounds on the distances between the given query points and the
+   * reference points referenceBegin, ..., referenceBegin + referenceCount - 1.
+   * The distance that MetricType::Evaluate() returns for the pair (i, j) is
+   * guaranteed to lie within [lower(i, j), upper(i, j)].
+   *
+   * @param queryIndices Indices of the query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   * @param lower Lower bounds on the distances.
+   * @param upper Upper bounds on the distances.
+   */
+  void Bounds(const arma::uvec& queryIndices,
+              const size_t referenceBegin,
+              const size_t referenceCount,
+              arma::Mat<ElemType>& lower,
+              arma::Mat<ElemType>& upper)
+  {
+    Evaluate(queryIndices, referenceBegin, referenceCount, lower);
+    upper = lower;
+  }
+
+  /**
+   * Compute the distances between the given query points and the reference
+   * points referenceBegin, ..., referenceBegin + referenceCount - 1.
+   *
+   * @param queryIndices Indices of the query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   * @param distances Output distances.
+   */
+  void Evaluate(const arma::uvec& queryIndices,
+                const size_t referenceBegin,
+                const size_t referenceCount,
+                arma::Mat<ElemType>& distances)
+  {
+    distances.set_size(queryIndices.n_elem, referenceCount);
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      for (size_t i = 0; i < queryIndices.n_elem; ++i)
+      {
+        distances(i, j) = metric.Evaluate(querySet.col(queryIndices[i]),
+            referenceSet.col(referenceBegin + j));
+      }
+    }
+  }
+
+ private:
+  //! The instantiated metric.
+  MetricType& metric;
+  //! The query set.
+  const MatType& querySet;
+  //! The reference set.
+  const MatType& referenceSet;
+};
+
+/**
+ * Distance tiles for the (squared) Euclidean distance on dense data.  The
+ * points of a tile are first centered on the mean c of its reference points,
+ * and the squared distances are expanded as
+ *
+ * @f[
+ * \| q - r \|^2 = \| q - c \|^2 + \| r - c \|^2 - 2 (q - c)^T (r - c),
+ * @f]
+ *
+ * so that the cross terms of a whole tile are computed with a single matrix
+ * multiplication.
+ *
+ * The expansion suffers from cancellation when q and r are close compared to
+ * their distance to c.  Centering keeps these norms on the scale of the leaves
+ * instead of the scale of the dataset, so the tile distances are accurate
+ * unless the points are much closer than the size of the leaf; they are still
+ * not bitwise identical to LMetric::Evaluate().  Bounds() therefore widens
+ * every entry by a forward error bound, which lets callers use the tile to
+ * discard pairs safely and only evaluate the remaining pairs exactly.
+ */
+template<bool TakeRoot, typename eT>
+class DistanceTile<LMetric<2, TakeRoot>, arma::Mat<eT>>
+{
+ public:
+  //! Type of the elements of the dataset.
+  typedef eT ElemType;
+
+  //! Below this dimensionality, single evaluations are cheap enough.
+  static const size_t MinDimensionality = 8;
+
+  /**
+   * Create the tile object for the given query and reference sets.  The
+   * datasets are only referenced, so they must outlive this object.  Nothing
+   * is precomputed, since the norms depend on the center of each tile.
+   */
+  DistanceTile(LMetric<2, TakeRoot>& /* metric */,
+               const arma::Mat<eT>& querySet,
+               const arma::Mat<eT>& referenceSet) :
+      querySet(querySet),
+      referenceSet(referenceSet)
+  { }
+
+  //! Return whether computing whole tiles is faster than single evaluations.
+  bool Enabled() const { return querySet.n_rows >= MinDimensionality; }
+
+  /**
+   * Compute bounds on the distances between the given query points and the
+   * reference points referenceBegin, ..., referenceBegin + referenceCount - 1.
+   * The distance that LMetric::Evaluate() returns for the pair (i, j) is
+   * guaranteed to lie within [lower(i, j), upper(i, j)].
+   *
+   * @param queryIndices Indices of the query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   * @param lower Lower bounds on the distances.
+   * @param upper Upper bounds on the distances.
+   */
+  void Bounds(const arma::uvec& queryIndices,
+              const size_t referenceBegin,
+              const size_t referenceCount,
+              arma::Mat<eT>& lower,
+              arma::Mat<eT>& upper)
+  {
+    arma::Mat<eT> squared;
+    arma::Col<eT> queryNorms;
+    arma::Row<eT> referenceNorms;
+    SquaredDistances(queryIndices, referenceBegin, referenceCount, squared,
+        queryNorms, referenceNorms);
+
+    // Both the expansion and the direct evaluation of the distance have a
+    // rounding error of at most (d + 2) * eps * (||q - c||^2 + ||r - c||^2),
+    // up to a small constant.  Use a generous constant, since a loose bound
+    // only costs a few extra exact evaluations.
+    const eT gamma = 8 * (querySet.n_rows + 2) *
+        std::numeric_limits<eT>::epsilon();
+    arma::Mat<eT> error = arma::repmat(queryNorms, 1, referenceCount);
+    error.each_row() += referenceNorms;
+    error *= gamma;
+
+    lower = arma::clamp(squared - error, 0, std::numeric_limits<eT>::max());
+    upper = squared + error;
+    if (TakeRoot)
+    {
+      lower = arma::sqrt(lower);
+      upper = arma::sqrt(upper);
+    }
+  }
+
+  /**
+   * Compute the distances between the given query points and the reference
+   * points referenceBegin, ..., referenceBegin + referenceCount - 1.  The
+   * results are accurate up to the rounding error described in Bounds().
+   *
+   * @param queryIndices Indices of the query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   * @param distances Output distances.
+   */
+  void Evaluate(const arma::uvec& queryIndices,
+                const size_t referenceBegin,
+                const size_t referenceCount,
+                arma::Mat<eT>& distances)
+  {
+    arma::Col<eT> queryNorms;
+    arma::Row<eT> referenceNorms;
+    SquaredDistances(queryIndices, referenceBegin, referenceCount, distances,
+        queryNorms, referenceNorms);
+    distances = arma::clamp(distances, 0, std::numeric_limits<eT>::max());
+    if (TakeRoot)
+      distances = arma::sqrt(distances);
+  }
+
+ private:
+  //! Compute the expanded squared distances of a tile, and the squared norms
+  //! of its centered query and reference points.
+  void SquaredDistances(const arma::uvec& queryIndices,
+                        const size_t referenceBegin,
+                        const size_t referenceCount,
+                        arma::Mat<eT>& squared,
+                        arma::Col<eT>& queryNorms,
+                        arma::Row<eT>& referenceNorms)
+  {
+    // The reference points of a leaf are contiguous, so they can be used in
+    // place; the query points may have been filtered, so they are gathered.
+    arma::Mat<eT> queries = querySet.cols(queryIndices);
+    const arma::Mat<eT> references(const_cast<eT*>(referenceSet.colptr(
+        referenceBegin)), referenceSet.n_rows, referenceCount, false, true);
+
+    // Center both sides of the tile on the reference points, which costs as
+    // much as reading the tile, to avoid cancellation in the expansion.
+    const arma::Col<eT> center = arma::mean(references, 1);
+    queries.each_col() -= center;
+    arma::Mat<eT> centeredReferences = references;
+    centeredReferences.each_col() -= center;
+
+    queryNorms = arma::sum(arma::square(queries), 0).t();
+    referenceNorms = arma::sum(arma::square(centeredReferences), 0);
+
+    squared = -2 * queries.t() * centeredReferences;
+    squared.each_col() += queryNorms;
+    squared.each_row() += referenceNorms;
+  }
+
+  //! The query set.
+  const arma::Mat<eT>& querySet;
+  //! The reference set.
+  const arma::Mat<eT>& referenceSet;
+};
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
@@ -83,6 +83,29 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distance between two points, but allows the computation to
+   * stop early once the distance is known to be larger than the given bound.
+   * This is useful when the distance only matters if it can improve a current
+   * best candidate.  If the distance is at most the bound, it is returned
+   * exactly (the same value as Evaluate()); otherwise, some value larger than
+   * the bound is returned.  Early termination is only implemented for the L1
+   * and L2 distances on contiguous memory; otherwise Evaluate() is used.
+   *
+   * @tparam VecTypeA Type of first vector (generally arma::vec or
+   *      arma::sp_vec).
+   * @tparam VecTypeB Type of second vector.
+   * @param a First vector.
+   * @param b Second vector.
+   * @param bound Bound beyond which the exact distance is not needed.
+   * @return Distance between vectors a and b, if it is at most the bound.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateBounded(
+      const VecTypeA& a,
+      const VecTypeB& b,
+      const typename VecTypeA::elem_type bound);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const unsigned int /* version */) { }
@@ -14,6 +14,7 @@
 
 // In case it hasn't been included.
 #include "lmetric.hpp"
+#include "raw_distances.hpp"
 
 namespace mlpack {
 namespace metric {
@@ -35,6 +36,219 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
   return std::pow(sum, (1.0 / Power));
 }
 
+// Unless early termination is implemented, simply compute the whole distance.
+template<int Power, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<Power, TakeRoot>::EvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type /* bound */)
+{
+  return Evaluate(a, b);
+}
+
+// The L1, L2 and L-infinity specializations below use the loops in
+// raw_distances.hpp when both points are stored contiguously (for instance
+// dataset.col(i)), and Armadillo expressions otherwise.  The following
+// functions select between the two.
+
+//! Manhattan distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ManhattanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  return RawManhattanDistance(HasRawMemory<VecTypeA>::Memory(a),
+      HasRawMemory<VecTypeB>::Memory(b), a.n_elem);
+}
+
+//! Manhattan distance on any other vector type.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ManhattanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return arma::accu(abs(a - b));
+}
+
+//! Bounded Manhattan distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ManhattanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  return RawManhattanDistance(HasRawMemory<VecTypeA>::Memory(a),
+      HasRawMemory<VecTypeB>::Memory(b), a.n_elem, bound);
+}
+
+//! Bounded Manhattan distance on any other vector type (no early exit).
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ManhattanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type /* bound */,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return arma::accu(abs(a - b));
+}
+
+//! Squared Euclidean distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredEuclideanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  return RawSquaredEuclideanDistance(HasRawMemory<VecTypeA>::Memory(a),
+      HasRawMemory<VecTypeB>::Memory(b), a.n_elem);
+}
+
+//! Squared Euclidean distance on any other vector type.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredEuclideanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return accu(arma::square(a - b));
+}
+
+//! Bounded squared Euclidean distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredEuclideanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  return RawSquaredEuclideanDistance(HasRawMemory<VecTypeA>::Memory(a),
+      HasRawMemory<VecTypeB>::Memory(b), a.n_elem, bound);
+}
+
+//! Bounded squared Euclidean distance on any other vector type (no early
+//! exit).
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type SquaredEuclideanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type /* bound */,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return accu(arma::square(a - b));
+}
+
+//! Euclidean distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type EuclideanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  const typename VecTypeA::elem_type sum = RawSquaredEuclideanDistance(
+      HasRawMemory<VecTypeA>::Memory(a), HasRawMemory<VecTypeB>::Memory(b),
+      a.n_elem);
+
+  // If the sum overflowed, let Armadillo compute the norm robustly.
+  if (!std::isfinite(sum))
+    return arma::norm(a - b, 2);
+
+  return std::sqrt(sum);
+}
+
+//! Euclidean distance on any other vector type.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type EuclideanEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return arma::norm(a - b, 2);
+}
+
+//! Bounded Euclidean distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type EuclideanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  typedef typename VecTypeA::elem_type ElemType;
+
+  // Terminate on the squared distance.  The squared bound is enlarged by a few
+  // ulps, so that a distance at or below the bound is never cut off because of
+  // rounding in bound * bound.
+  const ElemType squaredBound = bound * bound *
+      (1 + 4 * std::numeric_limits<ElemType>::epsilon());
+  const ElemType sum = RawSquaredEuclideanDistance(
+      HasRawMemory<VecTypeA>::Memory(a), HasRawMemory<VecTypeB>::Memory(b),
+      a.n_elem, squaredBound);
+
+  // The sum is only partial if it exceeds the bound; otherwise it is the same
+  // sum that EuclideanEvaluate() computes.
+  if (!std::isfinite(sum))
+    return arma::norm(a - b, 2);
+
+  return std::sqrt(sum);
+}
+
+//! Bounded Euclidean distance on any other vector type (no early exit).
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type EuclideanEvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type /* bound */,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return arma::norm(a - b, 2);
+}
+
+//! Chebyshev distance on contiguous memory.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ChebyshevEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  RawCheckSameSize(a, b, "LMetric::Evaluate(): incompatible vector sizes");
+  return RawChebyshevDistance(HasRawMemory<VecTypeA>::Memory(a),
+      HasRawMemory<VecTypeB>::Memory(b), a.n_elem);
+}
+
+//! Chebyshev distance on any other vector type.
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type ChebyshevEvaluate(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename std::enable_if_t<
+        !UseRawDistance<VecTypeA, VecTypeB>::value>* = 0)
+{
+  return arma::as_scalar(arma::max(arma::abs(a - b)));
+}
+
 // L1-metric specializations; the root doesn't matter.
 template<>
 template<typename VecTypeA, typename VecTypeB>
@@ -42,7 +256,7 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return ManhattanEvaluate(a, b);
 }
 
 template<>
@@ -51,7 +265,27 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return ManhattanEvaluate(a, b);
+}
+
+template<>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<1, true>::EvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  return ManhattanEvaluateBounded(a, b, bound);
+}
+
+template<>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<1, false>::EvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  return ManhattanEvaluateBounded(a, b, bound);
 }
 
 // L2-metric specializations.
@@ -61,7 +295,7 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  return EuclideanEvaluate(a, b);
 }
 
 template<>
@@ -70,7 +304,27 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  return SquaredEuclideanEvaluate(a, b);
+}
+
+template<>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<2, true>::EvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  return EuclideanEvaluateBounded(a, b, bound);
+}
+
+template<>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LMetric<2, false>::EvaluateBounded(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    const typename VecTypeA::elem_type bound)
+{
+  return SquaredEuclideanEvaluateBounded(a, b, bound);
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -103,7 +357,7 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::as_scalar(arma::max(arma::abs(a - b)));
+  return ChebyshevEvaluate(a, b);
 }
 
 } // namespace metric
@@ -0,0 +1,315 @@
+/**
+ * @file core/metrics/raw_distances.hpp
+ *
+ * Distance and inner product loops on contiguous memory, used by LMetric and
+ * the kernels when both points are stored contiguously.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_RAW_DISTANCES_HPP
+#define MLPACK_CORE_METRICS_RAW_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * HasRawMemory<VecType>::value is true if the elements of a VecType are stored
+ * contiguously, in which case HasRawMemory<VecType>::Memory() returns a pointer
+ * to the first element.  This holds for dense vectors and for single columns
+ * of a dense matrix (such as dataset.col(i)), but not for rows of a matrix or
+ * for sparse or expression types.
+ */
+template<typename VecType>
+struct HasRawMemory
+{
+  static const bool value = false;
+};
+
+template<typename eT>
+struct HasRawMemory<arma::Col<eT>>
+{
+  static const bool value = true;
+  static const eT* Memory(const arma::Col<eT>& v) { return v.memptr(); }
+};
+
+template<typename eT>
+struct HasRawMemory<arma::Row<eT>>
+{
+  static const bool value = true;
+  static const eT* Memory(const arma::Row<eT>& v) { return v.memptr(); }
+};
+
+template<typename eT>
+struct HasRawMemory<arma::subview_col<eT>>
+{
+  static const bool value = true;
+  static const eT* Memory(const arma::subview_col<eT>& v)
+  {
+    return v.colptr(0);
+  }
+};
+
+/**
+ * UseRawDistance<VecTypeA, VecTypeB>::value is true if both vector types have
+ * contiguous memory with the same floating-point element type, so that the
+ * Raw*() functions below can be used on them.
+ */
+template<typename VecTypeA, typename VecTypeB>
+struct UseRawDistance
+{
+  static const bool value = HasRawMemory<VecTypeA>::value &&
+      HasRawMemory<VecTypeB>::value &&
+      std::is_same<typename VecTypeA::elem_type,
+                   typename VecTypeB::elem_type>::value &&
+      std::is_floating_point<typename VecTypeA::elem_type>::value;
+};
+
+/**
+ * Make sure that two vectors given to the Raw*() functions below have the same
+ * number of elements, since the loops only look at the length of the first
+ * one.  Like Armadillo's own size checks, this is skipped if ARMA_NO_DEBUG is
+ * defined.
+ *
+ * @param a First vector.
+ * @param b Second vector.
+ * @param message Error message of the std::logic_error thrown on mismatch.
+ */
+template<typename VecTypeA, typename VecTypeB>
+inline void RawCheckSameSize(const VecTypeA& a,
+                             const VecTypeB& b,
+                             const char* message)
+{
+  arma_debug_check(a.n_elem != b.n_elem, message);
+}
+
+/**
+ * The loops below keep four independent partial results, so that the compiler
+ * can vectorize them with whatever instruction set the library is compiled for
+ * (SSE, AVX2, AVX-512, NEON) without reassociating floating-point operations.
+ * The sums are accumulated in blocks of RawDistanceBlockSize elements; the
+ * bounded variants check the partial result once per block, which keeps the
+ * inner loop vectorizable and makes their results identical to those of the
+ * unbounded variants whenever the bound is not exceeded.
+ */
+static const size_t RawDistanceBlockSize = 32;
+
+//! Compute sum_i |a_i - b_i| over the range [begin, end).
+template<typename eT>
+inline eT RawManhattanSum(const eT* a, const eT* b, size_t begin,
+                          const size_t end)
+{
+  eT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (; begin + 4 <= end; begin += 4)
+  {
+    s0 += std::abs(a[begin] - b[begin]);
+    s1 += std::abs(a[begin + 1] - b[begin + 1]);
+    s2 += std::abs(a[begin + 2] - b[begin + 2]);
+    s3 += std::abs(a[begin + 3] - b[begin + 3]);
+  }
+  for (; begin < end; ++begin)
+    s0 += std::abs(a[begin] - b[begin]);
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+//! Compute sum_i (a_i - b_i)^2 over the range [begin, end).
+template<typename eT>
+inline eT RawSquaredEuclideanSum(const eT* a, const eT* b, size_t begin,
+                                 const size_t end)
+{
+  eT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (; begin + 4 <= end; begin += 4)
+  {
+    const eT d0 = a[begin] - b[begin];
+    const eT d1 = a[begin + 1] - b[begin + 1];
+    const eT d2 = a[begin + 2] - b[begin + 2];
+    const eT d3 = a[begin + 3] - b[begin + 3];
+    s0 += d0 * d0;
+    s1 += d1 * d1;
+    s2 += d2 * d2;
+    s3 += d3 * d3;
+  }
+  for (; begin < end; ++begin)
+  {
+    const eT d = a[begin] - b[begin];
+    s0 += d * d;
+  }
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * Compute the Manhattan (L1) distance between the n-element arrays a and b.
+ */
+template<typename eT>
+inline eT RawManhattanDistance(const eT* a, const eT* b, const size_t n)
+{
+  // Sum by blocks, so that the result is the same as the bounded version.
+  eT sum = 0;
+  for (size_t begin = 0; begin < n; begin += RawDistanceBlockSize)
+  {
+    sum += RawManhattanSum(a, b, begin,
+        std::min(begin + RawDistanceBlockSize, n));
+  }
+
+  return sum;
+}
+
+/**
+ * Compute the Manhattan (L1) distance between the n-element arrays a and b,
+ * giving up as soon as it is known to be larger than the given bound.  If the
+ * distance is at most the bound, it is returned exactly; otherwise, some value
+ * larger than the bound is returned.
+ */
+template<typename eT>
+inline eT RawManhattanDistance(const eT* a,
+                               const eT* b,
+                               const size_t n,
+                               const eT bound)
+{
+  eT sum = 0;
+  for (size_t begin = 0; begin < n; begin += RawDistanceBlockSize)
+  {
+    sum += RawManhattanSum(a, b, begin,
+        std::min(begin + RawDistanceBlockSize, n));
+    if (sum > bound)
+      break;
+  }
+
+  return sum;
+}
+
+/**
+ * Compute the squared Euclidean distance between the n-element arrays a and b.
+ */
+template<typename eT>
+inline eT RawSquaredEuclideanDistance(const eT* a, const eT* b, const size_t n)
+{
+  // Sum by blocks, so that the result is the same as the bounded version.
+  eT sum = 0;
+  for (size_t begin = 0; begin < n; begin += RawDistanceBlockSize)
+  {
+    sum += RawSquaredEuclideanSum(a, b, begin,
+        std::min(begin + RawDistanceBlockSize, n));
+  }
+
+  return sum;
+}
+
+/**
+ * Compute the squared Euclidean distance between the n-element arrays a and b,
+ * giving up as soon as it is known to be larger than the given bound.  If the
+ * distance is at most the bound, it is returned exactly; otherwise, some value
+ * larger than the bound is returned.
+ */
+template<typename eT>
+inline eT RawSquaredEuclideanDistance(const eT* a,
+                                      const eT* b,
+                                      const size_t n,
+                                      const eT bound)
+{
+  eT sum = 0;
+  for (size_t begin = 0; begin < n; begin += RawDistanceBlockSize)
+  {
+    sum += RawSquaredEuclideanSum(a, b, begin,
+        std::min(begin + RawDistanceBlockSize, n));
+    if (sum > bound)
+      break;
+  }
+
+  return sum;
+}
+
+/**
+ * Compute the Chebyshev (L-infinity) distance between the n-element arrays a
+ * and b.
+ */
+template<typename eT>
+inline eT RawChebyshevDistance(const eT* a, const eT* b, const size_t n)
+{
+  eT m0 = 0, m1 = 0, m2 = 0, m3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    m0 = std::max(m0, std::abs(a[i] - b[i]));
+    m1 = std::max(m1, std::abs(a[i + 1] - b[i + 1]));
+    m2 = std::max(m2, std::abs(a[i + 2] - b[i + 2]));
+    m3 = std::max(m3, std::abs(a[i + 3] - b[i + 3]));
+  }
+  for (; i < n; ++i)
+    m0 = std::max(m0, std::abs(a[i] - b[i]));
+
+  return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+/**
+ * Compute the inner product of the n-element arrays a and b.
+ */
+template<typename eT>
+inline eT RawDotProduct(const eT* a, const eT* b, const size_t n)
+{
+  eT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    s0 += a[i] * b[i];
+    s1 += a[i + 1] * b[i + 1];
+    s2 += a[i + 2] * b[i + 2];
+    s3 += a[i + 3] * b[i + 3];
+  }
+  for (; i < n; ++i)
+    s0 += a[i] * b[i];
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * Compute the inner product of the n-element arrays a and b together with
+ * their squared norms, in a single pass over the data.
+ *
+ * @param a First array.
+ * @param b Second array.
+ * @param n Number of elements.
+ * @param aa Output squared norm of a.
+ * @param bb Output squared norm of b.
+ * @return Inner product of a and b.
+ */
+template<typename eT>
+inline eT RawDotProductAndNorms(const eT* a,
+                                const eT* b,
+                                const size_t n,
+                                eT& aa,
+                                eT& bb)
+{
+  eT ab0 = 0, ab1 = 0, aa0 = 0, aa1 = 0, bb0 = 0, bb1 = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+  {
+    ab0 += a[i] * b[i];
+    ab1 += a[i + 1] * b[i + 1];
+    aa0 += a[i] * a[i];
+    aa1 += a[i + 1] * a[i + 1];
+    bb0 += b[i] * b[i];
+    bb1 += b[i + 1] * b[i + 1];
+  }
+  if (i < n)
+  {
+    ab0 += a[i] * b[i];
+    aa0 += a[i] * a[i];
+    bb0 += b[i] * b[i];
+  }
+
+  aa = aa0 + aa1;
+  bb = bb0 + bb1;
+  return ab0 + ab1;
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
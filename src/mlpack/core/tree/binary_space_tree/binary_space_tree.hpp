@@ -13,8 +13,15 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <mlpack/core/data/mapped_file.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <memory>
+
 #include "../statistic.hpp"
+#include "../node_arena.hpp"
 #include "midpoint_split.hpp"
+#include "split_traits.hpp"
+#include "flat_format.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -32,6 +39,20 @@ namespace tree /** Trees and tree-building procedures. */ {
  * This tree does take one runtime parameter in the constructor, which is the
  * max leaf size to be used.
  *
+ * The nodes below the root are held in a NodeArena owned by the root, so nodes
+ * built one after the other are contiguous in memory, and the whole tree is
+ * freed at once.  Copies of the tree and trees loaded from an archive allocate
+ * each node separately.
+ *
+ * A tree can be saved with SaveFlat() to a file that is loaded by mapping it
+ * into memory, without deserialization; the dataset of the loaded tree is the
+ * memory of the file.
+ *
+ * When OpenMP is available, the children of large nodes are built in parallel.
+ * With a split type that uses random numbers (such as the ones of VP trees and
+ * random projection trees), the tree built with more than one thread then
+ * depends on the scheduling of the threads.
+ *
  * @tparam MetricType The metric used for tree-building.  The BoundType may
  *     place restrictions on the metrics that can be used.
  * @tparam StatisticType Extra data contained in the node.  See statistic.hpp
@@ -88,6 +109,13 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! The arena that holds the nodes of the tree, if it was built in one.  If we
+  //! are the root of the tree, we own the arena and must delete it.
+  NodeArena<BinarySpaceTree>* arena;
+  //! The file that holds the memory of the dataset, if the tree was loaded
+  //! from a flat file.  If we are the root of the tree, we own the file and
+  //! must delete it.
+  data::MappedFile* mappedFile;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -308,6 +336,23 @@ class BinarySpaceTree
       Archive& ar,
       const typename std::enable_if_t<Archive::is_loading::value>* = 0);
 
+  /**
+   * Load a tree that was saved with SaveFlat().  The file is memory-mapped and
+   * the dataset of the tree is the memory of the file, so the dataset is
+   * neither read nor copied: its pages are read from disk when the tree uses
+   * them.  The nodes are rebuilt from the file in a single pass, and the
+   * statistics are computed again.  The tree must be of the same type as the
+   * tree that was saved; a std::runtime_error is thrown if the file does not
+   * match.
+   *
+   * @param filename Name of the file to load.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *     each new point, if they were saved with the tree; otherwise, it is
+   *     emptied.
+   */
+  BinarySpaceTree(const std::string& filename,
+                  std::vector<size_t>& oldFromNew);
+
   /**
    * Deletes this node, deallocating the memory for the children and calling
    * their destructors in turn.  This will invalidate any pointers or references
@@ -507,6 +552,22 @@ class BinarySpaceTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::vec& center) const { bound.Center(center); }
 
+  /**
+   * Save the tree to a file in the flat format described by FlatTreeHeader,
+   * which can be loaded without deserialization by the constructor that takes
+   * a filename.  This must be called on the root of the tree.  Only trees of
+   * dense matrices whose bound has a FlatBound specialization (HRectBound and
+   * BallBound) can be saved.  A std::runtime_error is thrown if the file cannot
+   * be written.
+   *
+   * @param filename Name of the file to write.
+   * @param oldFromNew The old position of each new point, to store with the
+   *     tree (optional).
+   */
+  void SaveFlat(const std::string& filename,
+                const std::vector<size_t>& oldFromNew =
+                    std::vector<size_t>()) const;
+
  private:
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -546,6 +607,56 @@ class BinarySpaceTree
    */
   void UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate);
 
+  /**
+   * Free the children of this node.  The nodes of a tree held in an arena are
+   * all freed by the root.
+   */
+  void FreeChildren();
+
+  /**
+   * Update the parts of the bound of the current node that depend on its
+   * sibling, once the sibling is built.  Nothing needs to be done for most
+   * bounds.
+   *
+   * @param boundToUpdate The bound to update.
+   */
+  template<typename BoundType2>
+  void UpdateSiblingBound(BoundType2& /* boundToUpdate */) { }
+
+  /**
+   * Update the hole of the bound of the current node, which is centered at the
+   * left sibling.  This method is designed for HollowBallBound only.
+   *
+   * @param boundToUpdate The bound to update.
+   */
+  void UpdateSiblingBound(bound::HollowBallBound<MetricType>& boundToUpdate)
+  { UpdateBound(boundToUpdate); }
+
+  /**
+   * Return whether the children of a node with the given number of points
+   * should be built in parallel.
+   */
+  static bool ParallelBuild(const size_t count)
+  {
+    return SplitTraits<Split>::IndependentChildren &&
+        (count >= ParallelBuildThreshold);
+  }
+
+  //! The minimum number of points in a node for its children to be built in
+  //! parallel.
+  static const size_t ParallelBuildThreshold = 10000;
+
+  /**
+   * Return the number of nodes in each block of the arena of a tree with the
+   * given number of points: about the number of nodes of the tree, within
+   * limits.
+   */
+  static size_t ArenaBlockSize(const size_t count, const size_t maxLeafSize)
+  {
+    const size_t nodes = 2 * count / std::max(maxLeafSize, (size_t) 1);
+    return std::min(std::max(nodes, (size_t) 64), (size_t) 4096);
+  }
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -15,7 +15,12 @@
 #include "binary_space_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <cstring>
+#include <fstream>
+#include <limits>
 #include <queue>
+#include <stack>
+#include <unordered_map>
 
 namespace mlpack {
 namespace tree {
@@ -39,11 +44,19 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL),
+    mappedFile(NULL)
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The children of large nodes are
+  // built in parallel tasks, but the root is split by the calling thread, with
+  // its random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -67,16 +80,24 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The children of large nodes are built in
+  // parallel tasks, but the root is split by the calling thread, with its
+  // random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -101,16 +122,24 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The children of large nodes are built in
+  // parallel tasks, but the root is split by the calling thread, with its
+  // random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -136,11 +165,19 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL),
+    mappedFile(NULL)
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The children of large nodes are
+  // built in parallel tasks, but the root is split by the calling thread, with
+  // its random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -164,16 +201,24 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The children of large nodes are built in
+  // parallel tasks, but the root is split by the calling thread, with its
+  // random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -198,16 +243,24 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The children of large nodes are built in
+  // parallel tasks, but the root is split by the calling thread, with its
+  // random number generator.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  #pragma omp parallel if (ParallelBuild(count))
+  {
+    #pragma omp master
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+  }
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -237,7 +290,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    arena(parent->arena),
+    mappedFile(NULL)
 {
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
@@ -266,7 +321,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena),
+    mappedFile(NULL)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -300,7 +357,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena),
+    mappedFile(NULL)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -342,7 +401,9 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -397,12 +458,11 @@ operator=(const BinarySpaceTree& other)
     return *this;
 
   // Freeing memory that will not be used anymore.
+  FreeChildren();
   delete dataset;
-  delete left;
-  delete right;
+  delete mappedFile;
+  mappedFile = NULL;
 
-  left = NULL;
-  right = NULL;
   parent = other.Parent();
   begin = other.Begin();
   count = other.Count();
@@ -469,9 +529,10 @@ operator=(BinarySpaceTree&& other)
     return *this;
 
   // Freeing memory that will not be used anymore.
+  FreeChildren();
   delete dataset;
-  delete left;
-  delete right;
+  delete mappedFile;
+  mappedFile = NULL;
 
   parent = other.Parent();
   left = other.Left();
@@ -484,6 +545,14 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  arena = other.arena;
+  mappedFile = other.mappedFile;
+
+  // Set new parent.
+  if (left)
+    left->parent = this;
+  if (right)
+    right->parent = this;
 
   other.left = NULL;
   other.right = NULL;
@@ -494,6 +563,8 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
+  other.mappedFile = NULL;
 
   return *this;
 }
@@ -520,7 +591,9 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    arena(other.arena),
+    mappedFile(other.mappedFile)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -533,6 +606,8 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
+  other.mappedFile = NULL;
 
   // Set new parent.
   if (left)
@@ -562,6 +637,168 @@ BinarySpaceTree(
   ar >> BOOST_SERIALIZATION_NVP(*this);
 }
 
+/**
+ * Load the tree from a flat file.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(const std::string& filename,
+                std::vector<size_t>& oldFromNew) :
+    BinarySpaceTree() // Create an empty BinarySpaceTree.
+{
+  typedef FlatBound<BoundType<MetricType>> FlatBoundType;
+
+  // From here on, the destructor frees whatever has been set up if an
+  // exception is thrown.
+  mappedFile = new data::MappedFile(filename);
+  char* memory = mappedFile->Data();
+
+  // Make sure that the file holds a tree of our type.
+  FlatTreeHeader header;
+  if (mappedFile->Size() < sizeof(FlatTreeHeader))
+  {
+    throw std::runtime_error("BinarySpaceTree: '" + filename + "' is not a "
+        "flat tree file");
+  }
+  std::memcpy(&header, memory, sizeof(FlatTreeHeader));
+  if (std::strncmp(header.magic, "mlpkbst", sizeof(header.magic)) != 0 ||
+      header.version != FlatTreeVersion)
+  {
+    throw std::runtime_error("BinarySpaceTree: '" + filename + "' is not a "
+        "flat tree file");
+  }
+  if (header.elemSize != sizeof(ElemType) ||
+      header.boundType != FlatBoundType::Id || header.numNodes == 0)
+  {
+    throw std::runtime_error("BinarySpaceTree: '" + filename + "' holds a "
+        "tree of another type");
+  }
+  if (header.fileSize > mappedFile->Size())
+  {
+    throw std::runtime_error("BinarySpaceTree: '" + filename + "' is "
+        "truncated");
+  }
+
+  // Make sure that every section lies within the file, so that nothing is
+  // read past the end of the mapping.
+  const uint64_t maxSize = std::numeric_limits<uint64_t>::max();
+  const size_t boundSize = FlatBoundType::Size(header.nRows);
+  if ((header.nCols != 0 && header.nRows > maxSize / header.nCols) ||
+      (boundSize != 0 && header.numNodes > maxSize / boundSize) ||
+      (header.mappingSize != 0 && header.mappingSize != header.nCols) ||
+      !FlatSectionFits<ElemType>(header.datasetOffset,
+          header.nRows * header.nCols, mappedFile->Size()) ||
+      !FlatSectionFits<FlatNode>(header.nodesOffset, header.numNodes,
+          mappedFile->Size()) ||
+      !FlatSectionFits<double>(header.boundsOffset,
+          header.numNodes * boundSize, mappedFile->Size()) ||
+      !FlatSectionFits<uint64_t>(header.mappingOffset, header.mappingSize,
+          mappedFile->Size()))
+  {
+    throw std::runtime_error("BinarySpaceTree: '" + filename + "' is "
+        "truncated or corrupt");
+  }
+
+  const FlatNode* flatNodes = reinterpret_cast<const FlatNode*>(memory +
+      header.nodesOffset);
+  const double* flatBounds = reinterpret_cast<const double*>(memory +
+      header.boundsOffset);
+
+  // Check the structure of the tree before anything is allocated: the points
+  // of every node must be in the dataset, and in depth-first order, every node
+  // except the root is the child of exactly one node that comes before it.  A
+  // node has either no children or two, which split its points between them.
+  std::vector<bool> hasParent(header.numNodes, false);
+  for (size_t i = 0; i < header.numNodes; ++i)
+  {
+    const FlatNode& flatNode = flatNodes[i];
+    bool valid = (flatNode.count <= header.nCols &&
+        flatNode.begin <= header.nCols - flatNode.count &&
+        (flatNode.left == 0) == (flatNode.right == 0));
+    const uint64_t children[2] = { flatNode.left, flatNode.right };
+    for (size_t c = 0; c < 2 && valid; ++c)
+    {
+      if (children[c] == 0)
+        continue;
+
+      if (children[c] <= i || children[c] >= header.numNodes ||
+          hasParent[children[c]])
+        valid = false;
+      else
+        hasParent[children[c]] = true;
+    }
+
+    if (valid && flatNode.left != 0)
+    {
+      const FlatNode& left = flatNodes[flatNode.left];
+      const FlatNode& right = flatNodes[flatNode.right];
+      valid = (left.begin == flatNode.begin && left.count <= flatNode.count &&
+          right.begin == flatNode.begin + left.count &&
+          right.count == flatNode.count - left.count);
+    }
+
+    if (!valid || (i > 0 && !hasParent[i]))
+    {
+      throw std::runtime_error("BinarySpaceTree: '" + filename + "' holds "
+          "an invalid tree");
+    }
+  }
+
+  // The dataset is used in place.
+  dataset = new MatType(reinterpret_cast<ElemType*>(memory +
+      header.datasetOffset), header.nRows, header.nCols, false, true);
+
+  // The nodes below the root are held in an arena, in the order of the file.
+  std::vector<BinarySpaceTree*> nodes(header.numNodes);
+  nodes[0] = this;
+  if (header.numNodes > 1)
+    arena = new NodeArena<BinarySpaceTree>(header.numNodes - 1);
+  for (size_t i = 1; i < header.numNodes; ++i)
+  {
+    nodes[i] = new (arena->Allocate()) BinarySpaceTree();
+    nodes[i]->arena = arena;
+  }
+
+  for (size_t i = 0; i < header.numNodes; ++i)
+  {
+    BinarySpaceTree& node = *nodes[i];
+    const FlatNode& flatNode = flatNodes[i];
+
+    node.begin = flatNode.begin;
+    node.count = flatNode.count;
+    node.parentDistance = flatNode.parentDistance;
+    node.furthestDescendantDistance = flatNode.furthestDescendantDistance;
+    node.minimumBoundDistance = flatNode.minimumBoundDistance;
+    node.dataset = dataset;
+    node.bound = BoundType<MetricType>(header.nRows);
+    FlatBoundType::Load(node.bound, flatBounds + i * boundSize);
+
+    if (flatNode.left != 0)
+    {
+      node.left = nodes[flatNode.left];
+      node.left->parent = &node;
+    }
+    if (flatNode.right != 0)
+    {
+      node.right = nodes[flatNode.right];
+      node.right->parent = &node;
+    }
+  }
+
+  // Build the statistics bottom-up.
+  for (size_t i = header.numNodes; i > 0; --i)
+    nodes[i - 1]->stat = StatisticType(*nodes[i - 1]);
+
+  const uint64_t* mapping = reinterpret_cast<const uint64_t*>(memory +
+      header.mappingOffset);
+  oldFromNew.assign(mapping, mapping + header.mappingSize);
+}
+
 /**
  * Deletes this node, deallocating the memory for the children and calling their
  * destructors in turn.  This will invalidate any pointers or references to any
@@ -576,12 +813,167 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  FreeChildren();
 
-  // If we're the root, delete the matrix.
+  // If we're the root, delete the matrix, and then the file that may hold its
+  // memory.
   if (!parent)
+  {
     delete dataset;
+    delete mappedFile;
+  }
+}
+
+/**
+ * Save the tree to a flat file.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    SaveFlat(const std::string& filename,
+             const std::vector<size_t>& oldFromNew) const
+{
+  typedef FlatBound<BoundType<MetricType>> FlatBoundType;
+
+  if (parent)
+  {
+    throw std::invalid_argument("BinarySpaceTree::SaveFlat(): only the root "
+        "of a tree can be saved");
+  }
+  if (!oldFromNew.empty() && oldFromNew.size() != dataset->n_cols)
+  {
+    throw std::invalid_argument("BinarySpaceTree::SaveFlat(): oldFromNew "
+        "must hold one index for each point");
+  }
+
+  // Number the nodes in depth-first order.
+  std::vector<const BinarySpaceTree*> nodes;
+  std::unordered_map<const BinarySpaceTree*, size_t> positions;
+  std::stack<const BinarySpaceTree*> stack;
+  stack.push(this);
+  while (!stack.empty())
+  {
+    const BinarySpaceTree* node = stack.top();
+    stack.pop();
+
+    positions[node] = nodes.size();
+    nodes.push_back(node);
+    if (node->right)
+      stack.push(node->right);
+    if (node->left)
+      stack.push(node->left);
+  }
+
+  const size_t boundSize = FlatBoundType::Size(dataset->n_rows);
+  std::vector<FlatNode> flatNodes(nodes.size());
+  std::vector<double> flatBounds(nodes.size() * boundSize);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const BinarySpaceTree& node = *nodes[i];
+    FlatNode& flatNode = flatNodes[i];
+
+    flatNode.begin = node.begin;
+    flatNode.count = node.count;
+    flatNode.left = node.left ? positions[node.left] : 0;
+    flatNode.right = node.right ? positions[node.right] : 0;
+    flatNode.parentDistance = node.parentDistance;
+    flatNode.furthestDescendantDistance = node.furthestDescendantDistance;
+    flatNode.minimumBoundDistance = node.minimumBoundDistance;
+    FlatBoundType::Save(node.bound, flatBounds.data() + i * boundSize);
+  }
+
+  const std::vector<uint64_t> mapping(oldFromNew.begin(), oldFromNew.end());
+
+  FlatTreeHeader header;
+  std::memset(&header, 0, sizeof(FlatTreeHeader));
+  std::strncpy(header.magic, "mlpkbst", sizeof(header.magic));
+  header.version = FlatTreeVersion;
+  header.elemSize = sizeof(ElemType);
+  header.boundType = FlatBoundType::Id;
+  header.nRows = dataset->n_rows;
+  header.nCols = dataset->n_cols;
+  header.numNodes = nodes.size();
+  header.mappingSize = mapping.size();
+  header.datasetOffset = FlatAlign(sizeof(FlatTreeHeader));
+  header.nodesOffset = FlatAlign(header.datasetOffset +
+      dataset->n_elem * sizeof(ElemType));
+  header.boundsOffset = FlatAlign(header.nodesOffset +
+      flatNodes.size() * sizeof(FlatNode));
+  header.mappingOffset = FlatAlign(header.boundsOffset +
+      flatBounds.size() * sizeof(double));
+  header.fileSize = header.mappingOffset + mapping.size() * sizeof(uint64_t);
+
+  std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("BinarySpaceTree::SaveFlat(): cannot open '" +
+        filename + "' for writing");
+  }
+
+  // Write each section, padded with zeros up to its offset.
+  const std::vector<char> zeros(FlatPageSize, 0);
+  uint64_t position = 0;
+  auto write = [&](const uint64_t offset, const void* data, const size_t size)
+  {
+    stream.write(zeros.data(), offset - position);
+    stream.write(static_cast<const char*>(data), size);
+    position = offset + size;
+  };
+
+  write(0, &header, sizeof(FlatTreeHeader));
+  write(header.datasetOffset, dataset->memptr(),
+      dataset->n_elem * sizeof(ElemType));
+  write(header.nodesOffset, flatNodes.data(),
+      flatNodes.size() * sizeof(FlatNode));
+  write(header.boundsOffset, flatBounds.data(),
+      flatBounds.size() * sizeof(double));
+  write(header.mappingOffset, mapping.data(),
+      mapping.size() * sizeof(uint64_t));
+
+  if (!stream)
+  {
+    throw std::runtime_error("BinarySpaceTree::SaveFlat(): cannot write '" +
+        filename + "'");
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    FreeChildren()
+{
+  if (arena)
+  {
+    // The root destroys every node of the arena at once, so the nodes must not
+    // delete their children themselves.
+    if (!parent)
+    {
+      arena->Apply([](BinarySpaceTree& node)
+      {
+        node.left = NULL;
+        node.right = NULL;
+      });
+      delete arena;
+    }
+
+    arena = NULL;
+  }
+  else
+  {
+    delete left;
+    delete right;
+  }
+
+  left = NULL;
+  right = NULL;
 }
 
 template<typename MetricType,
@@ -902,12 +1294,46 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   assert(splitCol > begin);
   assert(splitCol < begin + count);
 
+  // The root owns the arena that holds every other node of the tree.
+  if (!parent && !arena)
+    arena = new NodeArena<BinarySpaceTree>(ArenaBlockSize(count, maxLeafSize));
+
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  // by calling their constructors (which perform this splitting process).  The
+  // children hold disjoint columns of the dataset, so for large nodes the left
+  // child is built in a separate task.  Neither child is linked to this node
+  // before both are built.  The order in which tasks draw random numbers
+  // depends on the scheduling of the threads, so with a random split each
+  // child of a large node gets a random number generator of its own, seeded by
+  // this node.
+  const bool seedChildren = SplitTraits<Split>::UsesRandomNumbers &&
+      ParallelBuild(count);
+  const size_t leftSeed = seedChildren ? math::RandGen()() : 0;
+  const size_t rightSeed = seedChildren ? math::RandGen()() : 0;
+  std::unique_ptr<math::ArmaRandomSeedGuard> armaGuard(seedChildren ?
+      new math::ArmaRandomSeedGuard() : NULL);
+
+  BinarySpaceTree* leftChild = NULL;
+  #pragma omp task if (ParallelBuild(count)) shared(leftChild, splitter)
+  {
+    std::unique_ptr<math::LocalRandomSeed> localSeed(seedChildren ?
+        new math::LocalRandomSeed(leftSeed) : NULL);
+    leftChild = new (arena->Allocate()) BinarySpaceTree(this, begin,
+        splitCol - begin, splitter, maxLeafSize);
+  }
+
+  BinarySpaceTree* rightChild;
+  {
+    std::unique_ptr<math::LocalRandomSeed> localSeed(seedChildren ?
+        new math::LocalRandomSeed(rightSeed) : NULL);
+    rightChild = new (arena->Allocate()) BinarySpaceTree(this, splitCol,
+        begin + count - splitCol, splitter, maxLeafSize);
+  }
+  #pragma omp taskwait
+
+  left = leftChild;
+  right = rightChild;
+  right->UpdateSiblingBound(right->bound);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -970,12 +1396,47 @@ SplitNode(std::vector<size_t>& oldFromNew,
   assert(splitCol > begin);
   assert(splitCol < begin + count);
 
+  // The root owns the arena that holds every other node of the tree.
+  if (!parent && !arena)
+    arena = new NodeArena<BinarySpaceTree>(ArenaBlockSize(count, maxLeafSize));
+
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // by calling their constructors (which perform this splitting process).  The
+  // children hold disjoint columns of the dataset and disjoint entries of
+  // oldFromNew, so for large nodes the left child is built in a separate task.
+  // Neither child is linked to this node before both are built.  The order in
+  // which tasks draw random numbers depends on the scheduling of the threads,
+  // so with a random split each child of a large node gets a random number
+  // generator of its own, seeded by this node.
+  const bool seedChildren = SplitTraits<Split>::UsesRandomNumbers &&
+      ParallelBuild(count);
+  const size_t leftSeed = seedChildren ? math::RandGen()() : 0;
+  const size_t rightSeed = seedChildren ? math::RandGen()() : 0;
+  std::unique_ptr<math::ArmaRandomSeedGuard> armaGuard(seedChildren ?
+      new math::ArmaRandomSeedGuard() : NULL);
+
+  BinarySpaceTree* leftChild = NULL;
+  #pragma omp task if (ParallelBuild(count)) \
+      shared(leftChild, splitter, oldFromNew)
+  {
+    std::unique_ptr<math::LocalRandomSeed> localSeed(seedChildren ?
+        new math::LocalRandomSeed(leftSeed) : NULL);
+    leftChild = new (arena->Allocate()) BinarySpaceTree(this, begin,
+        splitCol - begin, oldFromNew, splitter, maxLeafSize);
+  }
+
+  BinarySpaceTree* rightChild;
+  {
+    std::unique_ptr<math::LocalRandomSeed> localSeed(seedChildren ?
+        new math::LocalRandomSeed(rightSeed) : NULL);
+    rightChild = new (arena->Allocate()) BinarySpaceTree(this, splitCol,
+        begin + count - splitCol, oldFromNew, splitter, maxLeafSize);
+  }
+  #pragma omp taskwait
+
+  left = leftChild;
+  right = rightChild;
+  right->UpdateSiblingBound(right->bound);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -1049,7 +1510,9 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    arena(NULL),
+    mappedFile(NULL)
 {
   // Nothing to do.
 }
@@ -1070,14 +1533,15 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (Archive::is_loading::value)
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    FreeChildren();
     if (!parent)
+    {
       delete dataset;
+      delete mappedFile;
+    }
 
     parent = NULL;
+    mappedFile = NULL;
     left = NULL;
     right = NULL;
   }
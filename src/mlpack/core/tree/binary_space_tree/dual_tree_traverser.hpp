@@ -18,6 +18,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "binary_space_tree.hpp"
+#include "../block_base_case.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -68,6 +69,21 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   size_t& NumBaseCases() { return numBaseCases; }
 
  private:
+  /**
+   * Compute the base cases between two leaves, one point pair at a time.
+   */
+  template<typename Rule = RuleType>
+  typename std::enable_if<!HasBlockBaseCase<Rule>::value>::type
+  LeafBaseCases(BinarySpaceTree& queryNode, BinarySpaceTree& referenceNode);
+
+  /**
+   * Compute the base cases between two leaves as one block, for rules that
+   * provide BlockBaseCase().
+   */
+  template<typename Rule = RuleType>
+  typename std::enable_if<HasBlockBaseCase<Rule>::value>::type
+  LeafBaseCases(BinarySpaceTree& queryNode, BinarySpaceTree& referenceNode);
+
   //! Reference to the rules with which the trees will be traversed.
   RuleType& rule;
 
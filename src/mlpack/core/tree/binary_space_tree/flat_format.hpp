@@ -0,0 +1,202 @@
+/**
+ * @file core/tree/binary_space_tree/flat_format.hpp
+ *
+ * Definition of the flat file format of BinarySpaceTree, which can be
+ * memory-mapped and used without deserialization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_FORMAT_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_FORMAT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/tree/ballbound.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The header of a flat tree file.  The file is laid out as
+ *
+ * [ header | dataset | nodes | bounds | oldFromNew ]
+ *
+ * where every section starts at a multiple of FlatPageSize bytes, so that the
+ * dataset can be used in place when the file is memory-mapped.  The dataset is
+ * stored column-major as it is held by the tree (with permuted points), the
+ * nodes are stored in depth-first order with the root first, the bounds hold
+ * FlatBound<BoundType>::Size() values of type double for every node, and
+ * oldFromNew holds the original index of every point, or is empty.  Every
+ * value is stored in the byte order of the machine that wrote the file.
+ */
+struct FlatTreeHeader
+{
+  //! The string "mlpkbst" and a terminating zero.
+  char magic[8];
+  //! The version of the format.
+  uint64_t version;
+  //! The size of an element of the dataset, in bytes.
+  uint64_t elemSize;
+  //! The identifier of the type of the bounds (see FlatBound).
+  uint64_t boundType;
+  //! The number of dimensions of the dataset.
+  uint64_t nRows;
+  //! The number of points of the dataset.
+  uint64_t nCols;
+  //! The number of nodes.
+  uint64_t numNodes;
+  //! The number of entries of oldFromNew (nCols or zero).
+  uint64_t mappingSize;
+  //! The offset of the dataset.
+  uint64_t datasetOffset;
+  //! The offset of the nodes.
+  uint64_t nodesOffset;
+  //! The offset of the bounds.
+  uint64_t boundsOffset;
+  //! The offset of oldFromNew.
+  uint64_t mappingOffset;
+  //! The size of the file, in bytes.
+  uint64_t fileSize;
+};
+
+//! The alignment of the sections of a flat tree file.
+static const size_t FlatPageSize = 4096;
+
+//! The version of the flat tree format.
+static const uint64_t FlatTreeVersion = 1;
+
+//! Return the first offset at or after the given one where a section can start.
+inline uint64_t FlatAlign(const uint64_t offset)
+{
+  return (offset + FlatPageSize - 1) / FlatPageSize * FlatPageSize;
+}
+
+/**
+ * Return whether a section of numElements elements of type T, starting at the
+ * given offset, is aligned for T and lies within a file of fileSize bytes.
+ */
+template<typename T>
+inline bool FlatSectionFits(const uint64_t offset,
+                            const uint64_t numElements,
+                            const uint64_t fileSize)
+{
+  if (offset % alignof(T) != 0 || offset > fileSize)
+    return false;
+
+  // Compare element counts, so that numElements * sizeof(T) cannot overflow.
+  return numElements <= (fileSize - offset) / sizeof(T);
+}
+
+/**
+ * A node of a flat tree file.  Children are given by their position in the
+ * node section; a position of zero means that there is no child (the root is
+ * nobody's child).
+ */
+struct FlatNode
+{
+  //! The index of the first point of the node.
+  uint64_t begin;
+  //! The number of points of the node.
+  uint64_t count;
+  //! The position of the left child.
+  uint64_t left;
+  //! The position of the right child.
+  uint64_t right;
+  //! The distance from the center of the node to the center of its parent.
+  double parentDistance;
+  //! The furthest descendant distance of the node.
+  double furthestDescendantDistance;
+  //! The minimum bound distance of the node.
+  double minimumBoundDistance;
+};
+
+/**
+ * Conversion of the bounds of a tree to and from an array of doubles, for the
+ * flat tree format.  Only the bounds that have a specialization can be stored
+ * in flat files.
+ *
+ * @tparam BoundType Type of the bound.
+ */
+template<typename BoundType>
+class FlatBound;
+
+/**
+ * A hyperrectangle is stored as the low and high end of every dimension,
+ * followed by the minimum width.
+ */
+template<typename MetricType, typename ElemType>
+class FlatBound<bound::HRectBound<MetricType, ElemType>>
+{
+ public:
+  //! The bound type.
+  typedef bound::HRectBound<MetricType, ElemType> Bound;
+
+  //! The identifier of the bound type in flat files.
+  static const uint64_t Id = 1;
+
+  //! Return the number of values of a bound with the given dimensionality.
+  static size_t Size(const size_t dim) { return 2 * dim + 1; }
+
+  //! Store the given bound into the given values.
+  static void Save(const Bound& bound, double* values)
+  {
+    for (size_t k = 0; k < bound.Dim(); ++k)
+    {
+      values[2 * k] = bound[k].Lo();
+      values[2 * k + 1] = bound[k].Hi();
+    }
+    values[2 * bound.Dim()] = bound.MinWidth();
+  }
+
+  //! Set the given bound, which has the right dimensionality, from the values.
+  static void Load(Bound& bound, const double* values)
+  {
+    for (size_t k = 0; k < bound.Dim(); ++k)
+    {
+      bound[k].Lo() = values[2 * k];
+      bound[k].Hi() = values[2 * k + 1];
+    }
+    bound.MinWidth() = values[2 * bound.Dim()];
+  }
+};
+
+/**
+ * A ball is stored as its center, followed by its radius.
+ */
+template<typename MetricType, typename VecType>
+class FlatBound<bound::BallBound<MetricType, VecType>>
+{
+ public:
+  //! The bound type.
+  typedef bound::BallBound<MetricType, VecType> Bound;
+
+  //! The identifier of the bound type in flat files.
+  static const uint64_t Id = 2;
+
+  //! Return the number of values of a bound with the given dimensionality.
+  static size_t Size(const size_t dim) { return dim + 1; }
+
+  //! Store the given bound into the given values.
+  static void Save(const Bound& bound, double* values)
+  {
+    for (size_t k = 0; k < bound.Dim(); ++k)
+      values[k] = bound.Center()[k];
+    values[bound.Dim()] = bound.Radius();
+  }
+
+  //! Set the given bound, which has the right dimensionality, from the values.
+  static void Load(Bound& bound, const double* values)
+  {
+    for (size_t k = 0; k < bound.Dim(); ++k)
+      bound.Center()[k] = values[k];
+    bound.Radius() = values[bound.Dim()];
+  }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
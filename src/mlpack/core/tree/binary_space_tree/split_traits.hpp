@@ -0,0 +1,98 @@
+/**
+ * @file core/tree/binary_space_tree/split_traits.hpp
+ *
+ * This file defines the SplitTraits class, which holds information about how
+ * the split types of the BinarySpaceTree may be used while building the tree
+ * in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+
+#include "vantage_point_split.hpp"
+#include "rp_tree_max_split.hpp"
+#include "rp_tree_mean_split.hpp"
+#include "ub_tree_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The SplitTraits class describes how an instantiated split type of the
+ * BinarySpaceTree behaves when sibling nodes are split concurrently.  The
+ * default values are correct for split types whose SplitNode() and
+ * PerformSplit() only depend on the points of the node being split; a split
+ * type that does something else should specialize this class.
+ *
+ * @tparam SplitType The instantiated split type.
+ */
+template<typename SplitType>
+class SplitTraits
+{
+ public:
+  /**
+   * If true, SplitNode() draws random numbers, so the children of a node that
+   * are built in parallel get random number generators of their own.
+   */
+  static const bool UsesRandomNumbers = false;
+
+  /**
+   * If true, the children of a node may be built concurrently.
+   */
+  static const bool IndependentChildren = true;
+};
+
+/**
+ * The vantage point is selected with random samples of the points.
+ */
+template<typename BoundType, typename MatType, size_t MaxNumSamples>
+class SplitTraits<VantagePointSplit<BoundType, MatType, MaxNumSamples>>
+{
+ public:
+  static const bool UsesRandomNumbers = true;
+  static const bool IndependentChildren = true;
+};
+
+/**
+ * The direction of the projection and the split value are random.
+ */
+template<typename BoundType, typename MatType>
+class SplitTraits<RPTreeMaxSplit<BoundType, MatType>>
+{
+ public:
+  static const bool UsesRandomNumbers = true;
+  static const bool IndependentChildren = true;
+};
+
+/**
+ * The direction of the projection and the samples of the points are random.
+ */
+template<typename BoundType, typename MatType>
+class SplitTraits<RPTreeMeanSplit<BoundType, MatType>>
+{
+ public:
+  static const bool UsesRandomNumbers = true;
+  static const bool IndependentChildren = true;
+};
+
+/**
+ * The splitter holds the addresses of every point, and sibling nodes adjust
+ * the addresses at their common boundary, so the children of a node are built
+ * one after the other.
+ */
+template<typename BoundType, typename MatType>
+class SplitTraits<UBTreeSplit<BoundType, MatType>>
+{
+ public:
+  static const bool UsesRandomNumbers = false;
+  static const bool IndependentChildren = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file core/tree/block_base_case.hpp
+ *
+ * Detection of rules that can compute the base cases between a set of query
+ * points and a whole reference leaf at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BLOCK_BASE_CASE_HPP
+#define MLPACK_CORE_TREE_BLOCK_BASE_CASE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace tree {
+
+// This gives us a HasBlockBaseCaseCheck<T, U> type (where U is a function
+// pointer) we can use with SFINAE to catch when a rule has a BlockBaseCase()
+// function.
+HAS_MEM_FUNC(BlockBaseCase, HasBlockBaseCaseCheck);
+
+/**
+ * HasBlockBaseCase<RuleType>::value is true if the rule provides
+ *
+ * @code
+ * void BlockBaseCase(const arma::uvec& queryIndices,
+ *                    const size_t referenceBegin,
+ *                    const size_t referenceCount);
+ * @endcode
+ *
+ * which must have the same effect as calling BaseCase(q, r) for every query
+ * index q in queryIndices and every r in referenceBegin, ...,
+ * referenceBegin + referenceCount - 1.  Traversers may use it when both nodes
+ * are leaves whose points are stored contiguously.
+ */
+template<typename RuleType>
+struct HasBlockBaseCase
+{
+  static const bool value = HasBlockBaseCaseCheck<RuleType,
+      void(RuleType::*)(const arma::uvec&, const size_t, const size_t)>::value;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -474,7 +474,8 @@ class CoverTree
    * Fill the vector of distances with the distances between the point specified
    * by pointIndex and each point in the indices array.  The distances of the
    * first pointSetSize points in indices are calculated (so, this does not
-   * necessarily need to use all of the points in the arrays).
+   * necessarily need to use all of the points in the arrays).  Large point
+   * sets are handled in parallel when OpenMP is available.
    *
    * @param pointIndex Point to build the distances for.
    * @param indices List of indices to compute distances for.
@@ -549,6 +550,10 @@ class CoverTree
    */
   void RemoveNewImplicitNodes();
 
+  //! The minimum number of points times dimensions for ComputeDistances() to
+  //! compute the distances in parallel.
+  static const size_t ParallelDistanceWork = 100000;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
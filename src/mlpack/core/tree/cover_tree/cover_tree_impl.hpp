@@ -1394,7 +1394,9 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   // For each point, rebuild the distances.  The indices do not need to be
   // modified.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for if (pointSetSize * dataset->n_rows >= \
+      ParallelDistanceWork)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -1484,126 +1486,110 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
 {
   const size_t originalSum = nearSetSize + farSetSize + usedSetSize;
 
+  // Sort the child's used set, so that each point of our near and far sets can
+  // be looked up with a binary search instead of a scan of the whole used set.
+  // The child's index array is not needed after this.
+  size_t* childUsedBegin = childIndices.memptr() + childFarSetSize;
+  size_t* childUsedEnd = childUsedBegin + childUsedSetSize;
+  std::sort(childUsedBegin, childUsedEnd);
+
   // Loop across the set.  We will swap points as we need.  It should be noted
   // that farSetSize and nearSetSize may change with each iteration of this loop
-  // (depending on if we make a swap or not).
-  size_t startChildUsedSet = 0; // Where to start in the child set.
-  for (size_t i = 0; i < nearSetSize; ++i)
+  // (depending on if we make a swap or not).  Every point is moved at most
+  // once, so we can stop when all of the child's used points have been found.
+  size_t numFound = 0;
+  for (size_t i = 0; i < nearSetSize && numFound < childUsedSetSize; ++i)
   {
     // Discover if this point was in the child's used set.
-    for (size_t j = startChildUsedSet; j < childUsedSetSize; ++j)
+    if (!std::binary_search(childUsedBegin, childUsedEnd, indices[i]))
+      continue;
+
+    // We have found a point; a swap is necessary.
+
+    // Since this point is from the near set, to preserve the near set, we
+    // must do a swap.
+    if (farSetSize > 0)
     {
-      if (childIndices[childFarSetSize + j] == indices[i])
+      if ((nearSetSize - 1) != i)
       {
-        // We have found a point; a swap is necessary.
-
-        // Since this point is from the near set, to preserve the near set, we
-        // must do a swap.
-        if (farSetSize > 0)
-        {
-          if ((nearSetSize - 1) != i)
-          {
-            // In this case it must be a three-way swap.
-            size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-            ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-            size_t tempNearIndex = indices[nearSetSize - 1];
-            ElemType tempNearDist = distances[nearSetSize - 1];
-
-            indices[nearSetSize + farSetSize - 1] = indices[i];
-            distances[nearSetSize + farSetSize - 1] = distances[i];
-
-            indices[nearSetSize - 1] = tempIndex;
-            distances[nearSetSize - 1] = tempDist;
-
-            indices[i] = tempNearIndex;
-            distances[i] = tempNearDist;
-          }
-          else
-          {
-            // We can do a two-way swap.
-            size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-            ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-            indices[nearSetSize + farSetSize - 1] = indices[i];
-            distances[nearSetSize + farSetSize - 1] = distances[i];
-
-            indices[i] = tempIndex;
-            distances[i] = tempDist;
-          }
-        }
-        else if ((nearSetSize - 1) != i)
-        {
-          // A two-way swap is possible.
-          size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-          ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-          indices[nearSetSize + farSetSize - 1] = indices[i];
-          distances[nearSetSize + farSetSize - 1] = distances[i];
-
-          indices[i] = tempIndex;
-          distances[i] = tempDist;
-        }
-        else
-        {
-          // No swap is necessary.
-        }
-
-        // We don't need to do a complete preservation of the child index set,
-        // but we want to make sure we only loop over points we haven't seen.
-        // So increment the child counter by 1 and move a point if we need.
-        if (j != startChildUsedSet)
-        {
-          childIndices[childFarSetSize + j] = childIndices[childFarSetSize +
-              startChildUsedSet];
-        }
-
-        // Update all counters from the swaps we have done.
-        ++startChildUsedSet;
-        --nearSetSize;
-        --i; // Since we moved a point out of the near set we must step back.
-
-        break; // Break out of this for loop; back to the first one.
+        // In this case it must be a three-way swap.
+        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+        size_t tempNearIndex = indices[nearSetSize - 1];
+        ElemType tempNearDist = distances[nearSetSize - 1];
+
+        indices[nearSetSize + farSetSize - 1] = indices[i];
+        distances[nearSetSize + farSetSize - 1] = distances[i];
+
+        indices[nearSetSize - 1] = tempIndex;
+        distances[nearSetSize - 1] = tempDist;
+
+        indices[i] = tempNearIndex;
+        distances[i] = tempNearDist;
+      }
+      else
+      {
+        // We can do a two-way swap.
+        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+        indices[nearSetSize + farSetSize - 1] = indices[i];
+        distances[nearSetSize + farSetSize - 1] = distances[i];
+
+        indices[i] = tempIndex;
+        distances[i] = tempDist;
       }
     }
+    else if ((nearSetSize - 1) != i)
+    {
+      // A two-way swap is possible.
+      size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+      ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+      indices[nearSetSize + farSetSize - 1] = indices[i];
+      distances[nearSetSize + farSetSize - 1] = distances[i];
+
+      indices[i] = tempIndex;
+      distances[i] = tempDist;
+    }
+    else
+    {
+      // No swap is necessary.
+    }
+
+    // Update all counters from the swaps we have done.
+    ++numFound;
+    --nearSetSize;
+    --i; // Since we moved a point out of the near set we must step back.
   }
 
   // Now loop over the far set.  This loop is different because we only require
   // a normal two-way swap instead of the three-way swap to preserve the near
   // set / far set ordering.
-  for (size_t i = 0; i < farSetSize; ++i)
+  for (size_t i = 0; i < farSetSize && numFound < childUsedSetSize; ++i)
   {
     // Discover if this point was in the child's used set.
-    for (size_t j = startChildUsedSet; j < childUsedSetSize; ++j)
-    {
-      if (childIndices[childFarSetSize + j] == indices[i + nearSetSize])
-      {
-        // We have found a point to swap.
+    if (!std::binary_search(childUsedBegin, childUsedEnd,
+        indices[i + nearSetSize]))
+      continue;
 
-        // Perform the swap.
-        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+    // We have found a point to swap.
 
-        indices[nearSetSize + farSetSize - 1] = indices[nearSetSize + i];
-        distances[nearSetSize + farSetSize - 1] = distances[nearSetSize + i];
+    // Perform the swap.
+    size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+    ElemType tempDist = distances[nearSetSize + farSetSize - 1];
 
-        indices[nearSetSize + i] = tempIndex;
-        distances[nearSetSize + i] = tempDist;
+    indices[nearSetSize + farSetSize - 1] = indices[nearSetSize + i];
+    distances[nearSetSize + farSetSize - 1] = distances[nearSetSize + i];
 
-        if (j != startChildUsedSet)
-        {
-          childIndices[childFarSetSize + j] = childIndices[childFarSetSize +
-              startChildUsedSet];
-        }
+    indices[nearSetSize + i] = tempIndex;
+    distances[nearSetSize + i] = tempDist;
 
-        // Update all counters from the swaps we have done.
-        ++startChildUsedSet;
-        --farSetSize;
-        --i;
-
-        break; // Break out of this for loop; back to the first one.
-      }
-    }
+    // Update all counters from the swaps we have done.
+    ++numFound;
+    --farSetSize;
+    --i;
   }
 
   // Update used set size.
@@ -0,0 +1,59 @@
+/**
+ * @file core/tree/disjoint_subtrees.hpp
+ *
+ * Split a tree into disjoint subtrees, so that dual-tree traversals can be run
+ * on the pieces of the query tree in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_DISJOINT_SUBTREES_HPP
+#define MLPACK_CORE_TREE_DISJOINT_SUBTREES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Collect disjoint subtrees of the given tree whose descendant points together
+ * are all the points of the tree.  Starting from the root, nodes are replaced
+ * by their children in breadth-first order until there are at least
+ * minSubtrees subtrees (or only leaves are left).  Traversing each subtree
+ * against the same reference tree is then equivalent to traversing the whole
+ * tree, as long as the rules only modify the statistics of query nodes.
+ *
+ * @param root Root of the tree to split.
+ * @param minSubtrees Number of subtrees to stop at.
+ * @param subtrees Vector to store the subtrees in.
+ */
+template<typename TreeType>
+void DisjointSubtrees(TreeType& root,
+                      const size_t minSubtrees,
+                      std::vector<TreeType*>& subtrees)
+{
+  subtrees.clear();
+  subtrees.push_back(&root);
+
+  size_t next = 0;
+  while (subtrees.size() < minSubtrees && next < subtrees.size())
+  {
+    TreeType* node = subtrees[next];
+    if (node->NumChildren() == 0)
+    {
+      ++next;
+      continue;
+    }
+
+    subtrees.erase(subtrees.begin() + next);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      subtrees.push_back(&node->Child(i));
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file core/tree/node_arena.hpp
+ *
+ * Definition of the NodeArena class, which holds the nodes of a tree in a few
+ * large blocks of memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_ARENA_HPP
+#define MLPACK_CORE_TREE_NODE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <deque>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * An arena that holds the nodes of a tree.  Memory is taken from blocks of a
+ * fixed number of nodes, and each thread fills its own block, so the nodes
+ * built by a thread during a depth-first construction are stored contiguously
+ * and in depth-first order.  Traversals then mostly follow memory order.
+ *
+ * The arena does not know how the nodes are linked: destroying the arena calls
+ * the destructor of every node it holds, in allocation order, and then frees
+ * the blocks, so the nodes must not destroy each other.
+ *
+ * Allocate() may be called concurrently by the threads of the OpenMP team that
+ * was running when the arena was created.
+ *
+ * @tparam NodeType Type of the nodes.
+ */
+template<typename NodeType>
+class NodeArena
+{
+ public:
+  /**
+   * Create an empty arena.
+   *
+   * @param blockSize Number of nodes in each block of memory.
+   */
+  NodeArena(const size_t blockSize = 256) :
+      blockSize(std::max(blockSize, (size_t) 1)),
+      #ifdef HAS_OPENMP
+      currentBlocks(std::max(omp_get_max_threads(), omp_get_num_threads()),
+          NULL)
+      #else
+      currentBlocks(1, NULL)
+      #endif
+  { /* Nothing to do. */ }
+
+  //! Destroy every node in the arena and free the memory.
+  ~NodeArena()
+  {
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+      for (size_t j = 0; j < blocks[i].used; ++j)
+        blocks[i].nodes[j].~NodeType();
+
+      ::operator delete(blocks[i].nodes);
+    }
+  }
+
+  //! The arena holds raw memory, so it cannot be copied.
+  NodeArena(const NodeArena&) = delete;
+  //! The arena holds raw memory, so it cannot be copied.
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  /**
+   * Return memory for one node, which must be constructed with placement new
+   * before the arena is destroyed.
+   */
+  void* Allocate()
+  {
+    #ifdef HAS_OPENMP
+    const size_t thread = omp_get_thread_num();
+    #else
+    const size_t thread = 0;
+    #endif
+
+    Block*& block = currentBlocks[thread];
+    if (!block || block->used == blockSize)
+    {
+      // The references to the elements of a deque stay valid when it grows.
+      #pragma omp critical(NodeArenaAllocate)
+      {
+        blocks.push_back(Block());
+        blocks.back().nodes = static_cast<NodeType*>(
+            ::operator new(blockSize * sizeof(NodeType)));
+        block = &blocks.back();
+      }
+    }
+
+    return block->nodes + block->used++;
+  }
+
+  /**
+   * Call the given function on every node of the arena, in allocation order.
+   *
+   * @param f Function that takes a reference to a node.
+   */
+  template<typename FunctionType>
+  void Apply(FunctionType f)
+  {
+    for (size_t i = 0; i < blocks.size(); ++i)
+      for (size_t j = 0; j < blocks[i].used; ++j)
+        f(blocks[i].nodes[j]);
+  }
+
+  //! Get the number of nodes in the arena.
+  size_t Size() const
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < blocks.size(); ++i)
+      size += blocks[i].used;
+    return size;
+  }
+
+  //! Get the number of nodes in each block of memory.
+  size_t BlockSize() const { return blockSize; }
+
+ private:
+  //! A block of memory for blockSize nodes.
+  struct Block
+  {
+    Block() : nodes(NULL), used(0) { }
+
+    //! The memory for the nodes.
+    NodeType* nodes;
+    //! The number of nodes constructed in the block.
+    size_t used;
+  };
+
+  //! The number of nodes in each block.
+  size_t blockSize;
+
+  //! All the blocks of memory.
+  std::deque<Block> blocks;
+
+  //! The block that each thread currently fills.
+  std::vector<Block*> currentBlocks;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
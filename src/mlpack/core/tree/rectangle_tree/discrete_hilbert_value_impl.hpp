@@ -47,10 +47,13 @@ DiscreteHilbertValue<TreeElemType>::DiscreteHilbertValue(const TreeType* tree) :
         new arma::Col<HilbertElemType>(tree->Dataset().n_rows)),
     ownsValueToInsert(tree->Parent() ? false : true)
 {
-  // Calculate the Hilbert value for all points.
+  // Calculate the Hilbert value for all points.  The first child of a node
+  // that is being bulk loaded gets its values when its first point is
+  // inserted.
   if (!tree->Parent()) // This is the root node.
     ownsLocalHilbertValues = true;
-  else if (tree->Parent()->Child(0).IsLeaf())
+  else if (tree->Parent()->NumChildren() > 0 &&
+           tree->Parent()->Child(0).IsLeaf())
   {
     // This is a leaf node.
     assert(tree->Parent()->NumChildren() > 0);
@@ -354,6 +357,13 @@ InsertPoint(TreeType *node,
     *valueToInsert = CalculateValue(pt);
   if (node->IsLeaf())
   {
+    if (!localHilbertValues)
+    {
+      localHilbertValues = new arma::Mat<HilbertElemType>(
+          node->Dataset().n_rows, node->MaxLeafSize() + 1);
+      ownsLocalHilbertValues = true;
+    }
+
     // Find an appropriate place.
     for (i = 0; i < numValues; ++i)
       if (CompareValues(localHilbertValues->col(i), *valueToInsert) > 0)
@@ -462,6 +472,13 @@ void DiscreteHilbertValue<TreeElemType>::UpdateLargestValue(TreeType* node)
 {
   if (!node->IsLeaf())
   {
+    // A node that was built as a leaf does not need its own values any more.
+    if (ownsLocalHilbertValues)
+    {
+      delete localHilbertValues;
+      ownsLocalHilbertValues = false;
+    }
+
     // Update the largest Hilbert value
     localHilbertValues = node->Child(node->NumChildren() -
         1).AuxiliaryInfo().HilbertValue().LocalHilbertValues();
@@ -0,0 +1,47 @@
+/**
+ * @file core/tree/rectangle_tree/guillotine_cut.hpp
+ *
+ * Definition of the GuillotineCut struct, which describes how the children of
+ * a bulk-loaded RectangleTree node are separated.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_GUILLOTINE_CUT_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_GUILLOTINE_CUT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A cut that separates the consecutive groups of points [firstGroup,
+ * splitGroup) and [splitGroup, lastGroup) with an axis-parallel hyperplane.
+ * Packing strategies that partition a node by successive cuts report them so
+ * that trees which keep a partition of space (the R++ tree) can split it in
+ * the same way.
+ *
+ * @tparam ElemType Type of the coordinates.
+ */
+template<typename ElemType>
+struct GuillotineCut
+{
+  //! The first group on the low side of the cut.
+  size_t firstGroup;
+  //! The first group on the high side of the cut.
+  size_t splitGroup;
+  //! One past the last group on the high side of the cut.
+  size_t lastGroup;
+  //! The dimension that the cut is orthogonal to.
+  size_t axis;
+  //! The coordinate of the cut.
+  ElemType value;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
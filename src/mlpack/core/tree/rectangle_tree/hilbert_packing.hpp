@@ -0,0 +1,121 @@
+/**
+ * @file core/tree/rectangle_tree/hilbert_packing.hpp
+ *
+ * Definition of the HilbertPacking class, which arranges points for the bulk
+ * loading of a RectangleTree along the Hilbert curve.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_PACKING_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_PACKING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "guillotine_cut.hpp"
+#include "discrete_hilbert_value.hpp"
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+// Forward declarations of the policies of R+ and R++ trees.
+template<typename SplitPolicyType,
+         template<typename> class SweepType>
+class RPlusTreeSplit;
+class RPlusTreeDescentHeuristic;
+class RPlusPlusTreeDescentHeuristic;
+
+/**
+ * IsRPlusTreeSplit<SplitType>::value is true if SplitType is the split policy
+ * of R+ or R++ trees.
+ */
+template<typename SplitType>
+struct IsRPlusTreeSplit
+{
+  static const bool value = false;
+};
+
+template<typename SplitPolicyType,
+         template<typename> class SweepType>
+struct IsRPlusTreeSplit<RPlusTreeSplit<SplitPolicyType, SweepType>>
+{
+  static const bool value = true;
+};
+
+/**
+ * Hilbert packing:
+ *
+ * @code
+ * @inproceedings{kamel1993hilbert,
+ *   title={On packing R-trees},
+ *   author={Kamel, I. and Faloutsos, C.},
+ *   booktitle={Proceedings of the Second International Conference on
+ *       Information and Knowledge Management},
+ *   pages={490--499},
+ *   year={1993}
+ * }
+ * @endcode
+ *
+ * The points are sorted once by their DiscreteHilbertValue, and every node
+ * holds a run of consecutive points.  The children of every node are then
+ * ordered by their largest Hilbert value, which the Hilbert R tree requires,
+ * so this is the packing to use for Hilbert R trees.  The tiles are not
+ * separated by cuts, so this packing must not be used for R+ and R++ trees.
+ *
+ * The Hilbert values are computed in parallel when OpenMP is available.
+ */
+class HilbertPacking
+{
+ public:
+  /**
+   * SupportsTree<SplitType, DescentType>::value is true if a RectangleTree
+   * with the given split and descent policies can be bulk loaded with Hilbert
+   * packing.  This holds for every tree except R+ and R++ trees, which need
+   * children that are separated by cuts.
+   */
+  template<typename SplitType, typename DescentType>
+  struct SupportsTree
+  {
+    static const bool value = !IsRPlusTreeSplit<SplitType>::value &&
+        !std::is_same<DescentType, RPlusTreeDescentHeuristic>::value &&
+        !std::is_same<DescentType, RPlusPlusTreeDescentHeuristic>::value;
+  };
+
+  /**
+   * Sort the points by their Hilbert value.
+   *
+   * @param data Dataset.
+   * @param indices Indices of the points that will be held by the tree.
+   */
+  template<typename MatType>
+  static void Initialize(const MatType& data, std::vector<size_t>& indices);
+
+  /**
+   * The points of every node are already in order, so nothing needs to be
+   * done.
+   *
+   * @param data Dataset.
+   * @param indices Indices of the points.
+   * @param groupBegins The position of the first point of each group in
+   *     indices, followed by the end of the node.
+   * @param cuts Vector to store the cuts in; it is left empty.
+   */
+  template<typename MatType>
+  static void Partition(
+      const MatType& /* data */,
+      std::vector<size_t>& /* indices */,
+      const std::vector<size_t>& /* groupBegins */,
+      std::vector<GuillotineCut<typename MatType::elem_type>>& cuts)
+  {
+    cuts.clear();
+  }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hilbert_packing_impl.hpp"
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file core/tree/rectangle_tree/hilbert_packing_impl.hpp
+ *
+ * Implementation of the HilbertPacking class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_PACKING_IMPL_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_PACKING_IMPL_HPP
+
+#include "hilbert_packing.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+void HilbertPacking::Initialize(const MatType& data,
+                                std::vector<size_t>& indices)
+{
+  typedef DiscreteHilbertValue<typename MatType::elem_type> HilbertValue;
+  typedef typename HilbertValue::HilbertElemType HilbertElemType;
+
+  // Compute every Hilbert value once, so that the comparisons are cheap.
+  arma::Mat<HilbertElemType> values(data.n_rows, indices.size());
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) indices.size(); ++i)
+    values.col(i) = HilbertValue::CalculateValue(data.col(indices[i]));
+
+  std::vector<size_t> order(indices.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+
+  const size_t dim = values.n_rows;
+  std::stable_sort(order.begin(), order.end(),
+      [&values, dim](const size_t a, const size_t b)
+      {
+        const HilbertElemType* valueA = values.colptr(a);
+        const HilbertElemType* valueB = values.colptr(b);
+        for (size_t k = 0; k < dim; ++k)
+        {
+          if (valueA[k] != valueB[k])
+            return valueA[k] < valueB[k];
+        }
+        return false;
+      });
+
+  std::vector<size_t> sortedIndices(indices.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    sortedIndices[i] = indices[order[i]];
+
+  indices.swap(sortedIndices);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
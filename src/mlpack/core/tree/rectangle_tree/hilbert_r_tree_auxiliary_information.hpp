@@ -117,6 +117,21 @@ class HilbertRTreeAuxiliaryInformation
    */
   bool UpdateAuxiliaryInfo(TreeType* node);
 
+  /**
+   * The Hilbert R tree does not keep a partition of space, so nothing needs to
+   * be done when a node is divided by a cut.
+   *
+   * @param * (treeOne) The first subtree.
+   * @param * (treeTwo) The second subtree.
+   * @param * (axis) The axis along which the split is performed.
+   * @param * (cut) The coordinate at which the node is split.
+   */
+  void SplitAuxiliaryInfo(TreeType* /* treeOne */,
+                          TreeType* /* treeTwo */,
+                          size_t /* axis */,
+                          ElemType /* cut */)
+  { }
+
   //! Clear memory.
   void NullifyData();
 
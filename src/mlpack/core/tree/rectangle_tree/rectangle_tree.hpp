@@ -20,6 +20,7 @@
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
+#include "guillotine_cut.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -156,6 +157,58 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset.  The points are arranged by the given packing strategy
+   * (STRPacking or HilbertPacking), and the nodes are built top-down and
+   * filled as evenly as the maximum fills allow, instead of inserting the
+   * points one by one.  Points may still be inserted and deleted afterwards.
+   * Hilbert R trees must be bulk loaded with HilbertPacking, and R+ and R++
+   * trees with STRPacking; other combinations fail to compile.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param packing The packing strategy.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename PackingType>
+  RectangleTree(const MatType& data,
+                const PackingType& packing,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                typename std::enable_if_t<
+                    !std::is_arithmetic<PackingType>::value>* = 0);
+
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset, and taking ownership of the given dataset.  See the
+   * constructor above for the details.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param packing The packing strategy.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename PackingType>
+  RectangleTree(MatType&& data,
+                const PackingType& packing,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                typename std::enable_if_t<
+                    !std::is_arithmetic<PackingType>::value>* = 0);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -564,6 +617,31 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Bulk load every point of the dataset into this empty root node.
+   */
+  template<typename PackingType>
+  void BulkLoad();
+
+  /**
+   * Build the subtree of a bulk-loaded node of the given height, which holds
+   * the given range of indices.  The points are inserted through the given
+   * path from the root, so that the auxiliary information of every node sees
+   * them as it would during InsertPoint().
+   *
+   * @param indices Indices of the points, in the order given by the packing.
+   * @param first The position of the first index held by this node.
+   * @param numIndices The number of indices held by this node.
+   * @param height The number of levels below this node.
+   * @param path The ancestors of this node, starting with the root.
+   */
+  template<typename PackingType>
+  void BulkLoadNode(std::vector<size_t>& indices,
+                    const size_t first,
+                    const size_t numIndices,
+                    const size_t height,
+                    std::vector<RectangleTree*>& path);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -121,6 +121,204 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename PackingType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const PackingType& /* packing */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              typename std::enable_if_t<
+                  !std::is_arithmetic<PackingType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<PackingType>();
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename PackingType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const PackingType& /* packing */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              typename std::enable_if_t<
+                  !std::is_arithmetic<PackingType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<PackingType>();
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename PackingType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::BulkLoad()
+{
+  static_assert(PackingType::template SupportsTree<SplitType,
+      DescentType>::value, "RectangleTree: this packing cannot bulk load this "
+      "type of tree; Hilbert R trees must be bulk loaded with HilbertPacking, "
+      "and R+ and R++ trees with STRPacking.");
+
+  std::vector<size_t> indices(dataset->n_cols);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  PackingType::Initialize(*dataset, indices);
+
+  // Use the smallest height for which full nodes would hold every point.
+  size_t height = 0;
+  const size_t fanout = std::max(maxNumChildren, (size_t) 2);
+  for (size_t capacity = std::max(maxLeafSize, (size_t) 1);
+       capacity < indices.size(); capacity *= fanout)
+    ++height;
+
+  std::vector<RectangleTree*> path;
+  BulkLoadNode<PackingType>(indices, 0, indices.size(), height, path);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename PackingType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoadNode(std::vector<size_t>& indices,
+             const size_t first,
+             const size_t numIndices,
+             const size_t height,
+             std::vector<RectangleTree*>& path)
+{
+  path.push_back(this);
+
+  if (height == 0)
+  {
+    // Insert the points as InsertPoint() would, but without descending the
+    // tree or splitting nodes.
+    for (size_t i = first; i < first + numIndices; ++i)
+    {
+      const size_t point = indices[i];
+      for (size_t j = 0; j < path.size(); ++j)
+      {
+        RectangleTree* node = path[j];
+        node->bound |= dataset->col(point);
+        node->numDescendants++;
+
+        if (node != this)
+          node->auxiliaryInfo.HandlePointInsertion(node, point);
+        else if (!auxiliaryInfo.HandlePointInsertion(this, point))
+          points[count++] = point;
+      }
+    }
+  }
+  else
+  {
+    // Divide the points evenly among as few children as the capacity of the
+    // subtrees below allows.
+    size_t capacity = std::max(maxLeafSize, (size_t) 1);
+    for (size_t h = 1; h < height; ++h)
+      capacity *= std::max(maxNumChildren, (size_t) 2);
+
+    const size_t numGroups = std::max((size_t) 1,
+        std::min((numIndices + capacity - 1) / capacity, maxNumChildren));
+    std::vector<size_t> groupBegins(numGroups + 1);
+    for (size_t g = 0; g <= numGroups; ++g)
+      groupBegins[g] = first + (g * numIndices) / numGroups;
+
+    std::vector<GuillotineCut<ElemType>> cuts;
+    PackingType::Partition(*dataset, indices, groupBegins, cuts);
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      RectangleTree* child = new RectangleTree(this);
+      children[numChildren++] = child;
+    }
+
+    // Let the auxiliary information of the children follow the cuts, larger
+    // ranges first.  Before a range is cut, its first child holds the
+    // information of the whole range.
+    std::sort(cuts.begin(), cuts.end(),
+        [](const GuillotineCut<ElemType>& a, const GuillotineCut<ElemType>& b)
+        {
+          return (a.lastGroup - a.firstGroup) > (b.lastGroup - b.firstGroup);
+        });
+    for (size_t c = 0; c < cuts.size(); ++c)
+    {
+      RectangleTree* treeOne = children[cuts[c].firstGroup];
+      RectangleTree* treeTwo = children[cuts[c].splitGroup];
+      treeOne->AuxiliaryInfo().SplitAuxiliaryInfo(treeOne, treeTwo,
+          cuts[c].axis, cuts[c].value);
+    }
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      children[g]->template BulkLoadNode<PackingType>(indices, groupBegins[g],
+          groupBegins[g + 1] - groupBegins[g], height - 1, path);
+    }
+  }
+
+  path.pop_back();
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
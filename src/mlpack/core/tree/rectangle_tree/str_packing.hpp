@@ -0,0 +1,154 @@
+/**
+ * @file core/tree/rectangle_tree/str_packing.hpp
+ *
+ * Definition of the STRPacking class, which arranges points for the bulk
+ * loading of a RectangleTree with the Sort-Tile-Recursive algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_STR_PACKING_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_STR_PACKING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "guillotine_cut.hpp"
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+// Forward declarations of the policies of Hilbert R trees.
+template<size_t splitOrder>
+class HilbertRTreeSplit;
+class HilbertRTreeDescentHeuristic;
+
+/**
+ * IsHilbertRTreeSplit<SplitType>::value is true if SplitType is the split
+ * policy of Hilbert R trees.
+ */
+template<typename SplitType>
+struct IsHilbertRTreeSplit
+{
+  static const bool value = false;
+};
+
+template<size_t splitOrder>
+struct IsHilbertRTreeSplit<HilbertRTreeSplit<splitOrder>>
+{
+  static const bool value = true;
+};
+
+/**
+ * Sort-Tile-Recursive packing:
+ *
+ * @code
+ * @inproceedings{leutenegger1997str,
+ *   title={STR: A simple and efficient algorithm for R-tree packing},
+ *   author={Leutenegger, S.T. and Lopez, M.A. and Edgington, J.},
+ *   booktitle={Proceedings of the 13th International Conference on Data
+ *       Engineering},
+ *   pages={497--506},
+ *   year={1997}
+ * }
+ * @endcode
+ *
+ * The points of a node are divided among k children by cutting them into
+ * about k^(1/d) slabs along one dimension, then cutting every slab into tiles
+ * along the next dimension, and so on.  The tiling is applied top-down, to the
+ * points of every node, so the children of a node never overlap (except for
+ * points that lie on a cut), and the tiling is a sequence of cuts, which is
+ * what the R+ and R++ trees need.  Dimensions are taken in order of decreasing
+ * spread.
+ *
+ * Slabs are found with partial sorts, and the slabs of large nodes are tiled
+ * in parallel when OpenMP is available.
+ */
+class STRPacking
+{
+ public:
+  /**
+   * SupportsTree<SplitType, DescentType>::value is true if a RectangleTree
+   * with the given split and descent policies can be bulk loaded with STR
+   * packing.  This holds for every tree except Hilbert R trees, whose children
+   * must be ordered by Hilbert value.
+   */
+  template<typename SplitType, typename DescentType>
+  struct SupportsTree
+  {
+    static const bool value = !IsHilbertRTreeSplit<SplitType>::value &&
+        !std::is_same<DescentType, HilbertRTreeDescentHeuristic>::value;
+  };
+
+  /**
+   * Prepare the order of the points.  Nothing needs to be done for STR, since
+   * every node is tiled separately.
+   *
+   * @param data Dataset.
+   * @param indices Indices of the points that will be held by the tree.
+   */
+  template<typename MatType>
+  static void Initialize(const MatType& /* data */,
+                         std::vector<size_t>& /* indices */) { }
+
+  /**
+   * Reorder the points of a node, so that each group of consecutive points
+   * given by groupBegins forms one tile, and report the cuts between the
+   * tiles.
+   *
+   * @param data Dataset.
+   * @param indices Indices of the points; only the range of the node is
+   *     modified.
+   * @param groupBegins The position of the first point of each group in
+   *     indices, followed by the end of the node.
+   * @param cuts Vector to store the cuts in.
+   */
+  template<typename MatType>
+  static void Partition(
+      const MatType& data,
+      std::vector<size_t>& indices,
+      const std::vector<size_t>& groupBegins,
+      std::vector<GuillotineCut<typename MatType::elem_type>>& cuts);
+
+ private:
+  /**
+   * Tile the given groups, cutting them into slabs along the dimension of the
+   * given level first.
+   */
+  template<typename MatType, typename ElemType>
+  static void Tile(const MatType& data,
+                   std::vector<size_t>& indices,
+                   const std::vector<size_t>& groupBegins,
+                   const arma::uvec& dimensions,
+                   const size_t level,
+                   const size_t firstGroup,
+                   const size_t lastGroup,
+                   std::vector<GuillotineCut<ElemType>>& cuts);
+
+  /**
+   * Cut the given groups into slabs of slabSize groups along the dimension of
+   * the given level, and tile every slab along the next dimensions.
+   */
+  template<typename MatType, typename ElemType>
+  static void Slabs(const MatType& data,
+                    std::vector<size_t>& indices,
+                    const std::vector<size_t>& groupBegins,
+                    const arma::uvec& dimensions,
+                    const size_t level,
+                    const size_t firstGroup,
+                    const size_t lastGroup,
+                    const size_t slabSize,
+                    std::vector<GuillotineCut<ElemType>>& cuts);
+
+  //! The minimum number of points in a range for its halves to be tiled in
+  //! parallel.
+  static const size_t ParallelThreshold = 10000;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "str_packing_impl.hpp"
+
+#endif
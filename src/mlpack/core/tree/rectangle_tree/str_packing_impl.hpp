@@ -0,0 +1,150 @@
+/**
+ * @file core/tree/rectangle_tree/str_packing_impl.hpp
+ *
+ * Implementation of the STRPacking class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_STR_PACKING_IMPL_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_STR_PACKING_IMPL_HPP
+
+#include "str_packing.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+void STRPacking::Partition(
+    const MatType& data,
+    std::vector<size_t>& indices,
+    const std::vector<size_t>& groupBegins,
+    std::vector<GuillotineCut<typename MatType::elem_type>>& cuts)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numGroups = groupBegins.size() - 1;
+  cuts.resize(numGroups - 1);
+  if (numGroups <= 1)
+    return;
+
+  // Find the spread of the points in each dimension.
+  arma::Col<ElemType> minValues(data.n_rows);
+  arma::Col<ElemType> maxValues(data.n_rows);
+  minValues.fill(std::numeric_limits<ElemType>::max());
+  maxValues.fill(std::numeric_limits<ElemType>::lowest());
+  for (size_t i = groupBegins.front(); i < groupBegins.back(); ++i)
+  {
+    for (size_t k = 0; k < data.n_rows; ++k)
+    {
+      minValues[k] = std::min(minValues[k], data(k, indices[i]));
+      maxValues[k] = std::max(maxValues[k], data(k, indices[i]));
+    }
+  }
+
+  const arma::uvec dimensions = arma::sort_index(maxValues - minValues,
+      "descend");
+
+  #pragma omp parallel if (groupBegins.back() - groupBegins.front() >= \
+      ParallelThreshold)
+  {
+    #pragma omp single
+    Tile(data, indices, groupBegins, dimensions, 0, 0, numGroups, cuts);
+  }
+}
+
+template<typename MatType, typename ElemType>
+void STRPacking::Tile(
+    const MatType& data,
+    std::vector<size_t>& indices,
+    const std::vector<size_t>& groupBegins,
+    const arma::uvec& dimensions,
+    const size_t level,
+    const size_t firstGroup,
+    const size_t lastGroup,
+    std::vector<GuillotineCut<ElemType>>& cuts)
+{
+  const size_t numGroups = lastGroup - firstGroup;
+  if (numGroups <= 1)
+    return;
+
+  // With r dimensions left, there are about numGroups^(1 / r) slabs; along the
+  // last dimension every group is a slab.
+  const size_t remaining = dimensions.n_elem - level;
+  const size_t numSlabs = (remaining == 1) ? numGroups : std::max((size_t) 2,
+      (size_t) std::ceil(std::pow((double) numGroups, 1.0 / remaining)));
+  const size_t slabSize = (numGroups + numSlabs - 1) / numSlabs;
+
+  Slabs(data, indices, groupBegins, dimensions, level, firstGroup, lastGroup,
+      slabSize, cuts);
+}
+
+template<typename MatType, typename ElemType>
+void STRPacking::Slabs(
+    const MatType& data,
+    std::vector<size_t>& indices,
+    const std::vector<size_t>& groupBegins,
+    const arma::uvec& dimensions,
+    const size_t level,
+    const size_t firstGroup,
+    const size_t lastGroup,
+    const size_t slabSize,
+    std::vector<GuillotineCut<ElemType>>& cuts)
+{
+  const size_t numSlabs = (lastGroup - firstGroup + slabSize - 1) / slabSize;
+  if (numSlabs <= 1)
+  {
+    if (level + 1 < dimensions.n_elem)
+    {
+      Tile(data, indices, groupBegins, dimensions, level + 1, firstGroup,
+          lastGroup, cuts);
+    }
+    return;
+  }
+
+  // Cut the slabs in two halves along this dimension.  A partial sort is
+  // enough to put every point on the right side of the cut.
+  const size_t splitGroup = firstGroup + (numSlabs / 2) * slabSize;
+  const size_t dim = dimensions[level];
+  std::vector<size_t>::iterator first = indices.begin() +
+      groupBegins[firstGroup];
+  std::vector<size_t>::iterator middle = indices.begin() +
+      groupBegins[splitGroup];
+  std::vector<size_t>::iterator last = indices.begin() +
+      groupBegins[lastGroup];
+  std::nth_element(first, middle, last,
+      [&data, dim](const size_t a, const size_t b)
+      {
+        return data(dim, a) < data(dim, b);
+      });
+
+  ElemType lowMax = std::numeric_limits<ElemType>::lowest();
+  for (std::vector<size_t>::iterator it = first; it != middle; ++it)
+    lowMax = std::max(lowMax, data(dim, *it));
+  const ElemType highMin = data(dim, *middle);
+
+  // Each group boundary is cut exactly once.
+  GuillotineCut<ElemType>& cut = cuts[splitGroup - 1];
+  cut.firstGroup = firstGroup;
+  cut.splitGroup = splitGroup;
+  cut.lastGroup = lastGroup;
+  cut.axis = dim;
+  cut.value = (lowMax + highMin) / 2;
+
+  // The halves hold disjoint ranges of points.
+  #pragma omp task if (last - first >= (ptrdiff_t) ParallelThreshold) \
+      shared(data, indices, groupBegins, dimensions, cuts)
+  Slabs(data, indices, groupBegins, dimensions, level, firstGroup, splitGroup,
+      slabSize, cuts);
+
+  Slabs(data, indices, groupBegins, dimensions, level, splitGroup, lastGroup,
+      slabSize, cuts);
+  #pragma omp taskwait
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -156,6 +156,21 @@ class XTreeAuxiliaryInformation
     return false;
   }
 
+  /**
+   * The X tree does not keep a partition of space, so nothing needs to be done
+   * when a node is divided by a cut.
+   *
+   * @param * (treeOne) The first subtree.
+   * @param * (treeTwo) The second subtree.
+   * @param * (axis) The axis along which the split is performed.
+   * @param * (cut) The coordinate at which the node is split.
+   */
+  void SplitAuxiliaryInfo(TreeType* /* treeOne */,
+                          TreeType* /* treeTwo */,
+                          size_t /* axis */,
+                          typename TreeType::ElemType /* cut */)
+  { }
+
   /**
    * Nullify the auxiliary information in order to prevent an invalid free.
    */
@@ -163,6 +163,52 @@ class FFN
                arma::mat responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on the given sparse input data using the
+   * given optimizer.  This is useful for very high-dimensional and very sparse
+   * features (e.g. one-hot or bag-of-words encodings) that would not fit into
+   * memory as a dense matrix.  The sparse predictors are never densified; the
+   * first layer of the network must be a Linear layer, which computes its
+   * output and gradient directly from the nonzero input elements.
+   *
+   * This will use the existing model parameters as a starting point for the
+   * optimization. If this is not what you want, then you should access the
+   * parameters vector directly with Parameters() and modify it as desired.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Sparse input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(arma::sp_mat predictors,
+               arma::mat responses,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the feedforward network on the given sparse input data. By default,
+   * the RMSProp optimization algorithm is used, but others can be specified
+   * (such as ens::SGD).  The first layer of the network must be a Linear
+   * layer.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Sparse input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType = ens::RMSProp, typename... CallbackTypes>
+  double Train(arma::sp_mat predictors,
+               arma::mat responses,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -176,6 +222,15 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Predict the responses to a given set of sparse predictors.  The first
+   * layer of the network must be a Linear layer.
+   *
+   * @param predictors Sparse input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   */
+  void Predict(arma::sp_mat predictors, arma::mat& results);
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -324,6 +379,11 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get the matrix of sparse data points (if trained on sparse data).
+  const arma::sp_mat& SparsePredictors() const { return sparsePredictors; }
+  //! Modify the matrix of sparse data points (if trained on sparse data).
+  arma::sp_mat& SparsePredictors() { return sparsePredictors; }
+
   /**
    * Reset the module infomration (weights/parameters).
    */
@@ -402,6 +462,71 @@ class FFN
    */
   void ResetData(arma::mat predictors, arma::mat responses);
 
+  /**
+   * Prepare the network for the given sparse data.
+   * This function won't actually trigger training process.
+   *
+   * @param predictors Sparse input data variables.
+   * @param responses Outputs results from input data variables.
+   */
+  void ResetData(arma::sp_mat predictors, arma::mat responses);
+
+  /**
+   * Run the forward pass of the first layer of the network.
+   *
+   * @param input Input data of the network.
+   */
+  template<typename InputType>
+  void InputLayerForward(const InputType& input);
+
+  /**
+   * Run the forward pass of the first layer of the network on sparse input.
+   * The first layer has to be a Linear layer.
+   *
+   * @param input Sparse input data of the network.
+   */
+  void InputLayerForward(const arma::sp_mat& input);
+
+  /**
+   * Compute the gradient of the first layer of the network.
+   *
+   * @param input Input data of the network.
+   */
+  template<typename InputType>
+  void InputLayerGradient(const InputType& input);
+
+  /**
+   * Compute the gradient of the first layer of the network on sparse input.
+   * The first layer has to be a Linear layer.
+   *
+   * @param input Sparse input data of the network.
+   */
+  void InputLayerGradient(const arma::sp_mat& input);
+
+  /**
+   * Return the first layer of the network as a Linear layer, or throw an
+   * exception if the network can't be used with sparse input.
+   */
+  Linear<>& SparseInputLayer();
+
+  /**
+   * Run the forward pass on the given batch of the stored (dense or sparse)
+   * predictors.
+   *
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  void ForwardBatch(const size_t begin, const size_t batchSize);
+
+  /**
+   * Compute the gradients of all layers for the given batch of the stored
+   * (dense or sparse) predictors.
+   *
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  void GradientBatch(const size_t begin, const size_t batchSize);
+
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
    * backward pass for module.
@@ -455,6 +580,10 @@ class FFN
   //! The matrix of data points (predictors).
   arma::mat predictors;
 
+  //! The matrix of sparse data points, used instead of predictors when the
+  //! network is trained on sparse data.
+  arma::sp_mat sparsePredictors;
+
   //! The matrix of responses to the input data points.
   arma::mat responses;
 
@@ -59,6 +59,26 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
 {
   numFunctions = responses.n_cols;
   this->predictors = std::move(predictors);
+  this->sparsePredictors.reset();
+  this->responses = std::move(responses);
+  this->deterministic = false;
+  ResetDeterministic();
+
+  if (!reset)
+    ResetParameters();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
+    arma::sp_mat predictors, arma::mat responses)
+{
+  // Make sure the network can take sparse input before doing anything else.
+  SparseInputLayer();
+
+  numFunctions = responses.n_cols;
+  this->sparsePredictors = std::move(predictors);
+  this->predictors.reset();
   this->responses = std::move(responses);
   this->deterministic = false;
   ResetDeterministic();
@@ -149,6 +169,55 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+      arma::sp_mat predictors,
+      arma::mat responses,
+      OptimizerType& optimizer,
+      CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer,
+      this->sparsePredictors.n_cols);
+
+  // Train the model.
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    arma::sp_mat predictors,
+    arma::mat responses,
+    CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  OptimizerType optimizer;
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer,
+      this->sparsePredictors.n_cols);
+
+  // Train the model.
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -246,6 +315,35 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
+    arma::sp_mat predictors, arma::mat& results)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // Like the dense overload, the points are passed through the network one at
+  // a time; extracting a single sparse column only copies its nonzeros.
+  arma::mat resultsTemp;
+  for (size_t i = 0; i < predictors.n_cols; ++i)
+  {
+    Forward(arma::sp_mat(predictors.col(i)));
+
+    resultsTemp = boost::apply_visitor(outputParameterVisitor,
+        network.back());
+    if (i == 0)
+      results.set_size(resultsTemp.n_elem, predictors.n_cols);
+    results.col(i) = resultsTemp.col(0);
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -280,7 +378,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     const arma::mat& parameters)
 {
   double res = 0;
-  for (size_t i = 0; i < predictors.n_cols; ++i)
+  for (size_t i = 0; i < numFunctions; ++i)
     res += Evaluate(parameters, i, 1, true);
 
   return res;
@@ -303,7 +401,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  ForwardBatch(begin, batchSize);
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
       responses.cols(begin, begin + batchSize - 1));
@@ -331,7 +429,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
 EvaluateWithGradient(const arma::mat& parameters, GradType& gradient)
 {
   double res = 0;
-  for (size_t i = 0; i < predictors.n_cols; ++i)
+  for (size_t i = 0; i < numFunctions; ++i)
     res += EvaluateWithGradient(parameters, i, gradient, 1);
 
   return res;
@@ -364,7 +462,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  ForwardBatch(begin, batchSize);
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
       responses.cols(begin, begin + batchSize - 1));
@@ -381,7 +479,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   Backward();
   ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  GradientBatch(begin, batchSize);
 
   return res;
 }
@@ -401,7 +499,20 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  math::ShuffleData(predictors, responses, predictors, responses);
+  if (sparsePredictors.n_cols > 0)
+  {
+    // The sparse overload of ShuffleData() only handles vector labels, so
+    // shuffle the point indices alongside the data and permute the responses
+    // with them.
+    arma::urowvec indices = arma::linspace<arma::urowvec>(0,
+        sparsePredictors.n_cols - 1, sparsePredictors.n_cols);
+    math::ShuffleData(sparsePredictors, indices, sparsePredictors, indices);
+    responses = responses.cols(indices);
+  }
+  else
+  {
+    math::ShuffleData(predictors, responses, predictors, responses);
+  }
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -446,9 +557,7 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
-  boost::apply_visitor(ForwardVisitor(input,
-      boost::apply_visitor(outputParameterVisitor, network.front())),
-      network.front());
+  InputLayerForward(input);
 
   if (!reset)
   {
@@ -522,8 +631,7 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Gradient(const InputType& input)
 {
-  boost::apply_visitor(GradientVisitor(input,
-      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+  InputLayerGradient(input);
 
   for (size_t i = 1; i < network.size() - 1; ++i)
   {
@@ -537,6 +645,86 @@ void FFN<OutputLayerType, InitializationRuleType,
       network[network.size() - 1]);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename InputType>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::InputLayerForward(const InputType& input)
+{
+  boost::apply_visitor(ForwardVisitor(input,
+      boost::apply_visitor(outputParameterVisitor, network.front())),
+      network.front());
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::InputLayerForward(const arma::sp_mat& input)
+{
+  Linear<>& layer = SparseInputLayer();
+  layer.Forward(input, layer.OutputParameter());
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename InputType>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::InputLayerGradient(const InputType& input)
+{
+  boost::apply_visitor(GradientVisitor(input,
+      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::InputLayerGradient(const arma::sp_mat& input)
+{
+  Linear<>& layer = SparseInputLayer();
+  layer.Gradient(input, boost::apply_visitor(deltaVisitor, network[1]),
+      layer.Gradient());
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+Linear<>& FFN<OutputLayerType, InitializationRuleType,
+              CustomLayers...>::SparseInputLayer()
+{
+  Linear<>** layer = network.empty() ? NULL :
+      boost::get<Linear<>*>(&network.front());
+  if (layer == NULL)
+  {
+    throw std::invalid_argument("FFN: sparse input requires the first layer "
+        "of the network to be a Linear layer");
+  }
+
+  return **layer;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ForwardBatch(const size_t begin,
+                                        const size_t batchSize)
+{
+  if (sparsePredictors.n_cols > 0)
+    Forward(arma::sp_mat(sparsePredictors.cols(begin, begin + batchSize - 1)));
+  else
+    Forward(predictors.cols(begin, begin + batchSize - 1));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::GradientBatch(const size_t begin,
+                                         const size_t batchSize)
+{
+  if (sparsePredictors.n_cols > 0)
+    Gradient(arma::sp_mat(sparsePredictors.cols(begin, begin + batchSize - 1)));
+  else
+    Gradient(predictors.cols(begin, begin + batchSize - 1));
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename Archive>
@@ -605,6 +793,7 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(reset, network.reset);
   std::swap(this->network, network.network);
   std::swap(predictors, network.predictors);
+  std::swap(sparsePredictors, network.sparsePredictors);
   std::swap(responses, network.responses);
   std::swap(parameter, network.parameter);
   std::swap(numFunctions, network.numFunctions);
@@ -626,6 +815,7 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(network.height),
     reset(network.reset),
     predictors(network.predictors),
+    sparsePredictors(network.sparsePredictors),
     responses(network.responses),
     parameter(network.parameter),
     numFunctions(network.numFunctions),
@@ -655,6 +845,7 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(network.height),
     reset(network.reset),
     predictors(std::move(network.predictors)),
+    sparsePredictors(std::move(network.sparsePredictors)),
     responses(std::move(network.responses)),
     parameter(std::move(network.parameter)),
     numFunctions(network.numFunctions),
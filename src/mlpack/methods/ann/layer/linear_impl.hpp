@@ -116,6 +116,24 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
   output.each_col() += bias;
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
+    const arma::SpMat<eT>& input, arma::Mat<eT>& output)
+{
+  output = arma::repmat(bias, 1, input.n_cols);
+
+  // Walk the compressed columns directly; every nonzero input feature adds a
+  // scaled column of the weight matrix to the output.
+  input.sync();
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    for (size_t j = input.col_ptrs[i]; j < input.col_ptrs[i + 1]; ++j)
+      output.col(i) += input.values[j] * weight.col(input.row_indices[j]);
+  }
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename eT>
@@ -140,6 +158,36 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
+    const arma::SpMat<eT>& input,
+    const arma::Mat<eT>& error,
+    arma::Mat<eT>& gradient)
+{
+  // Alias the weight part of the gradient; the outer product error * input.t()
+  // only has nonzero columns for the features that are active in the batch, so
+  // only those columns are accumulated.
+  arma::Mat<eT> weightGradient(gradient.memptr(), outSize, inSize, false,
+      true);
+  weightGradient.zeros();
+
+  input.sync();
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    for (size_t j = input.col_ptrs[i]; j < input.col_ptrs[i + 1]; ++j)
+    {
+      weightGradient.col(input.row_indices[j]) +=
+          input.values[j] * error.col(i);
+    }
+  }
+
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(error, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename Archive>
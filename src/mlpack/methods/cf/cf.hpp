@@ -17,6 +17,7 @@
 #define MLPACK_METHODS_CF_CF_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/amf/amf.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
@@ -31,6 +32,38 @@
 
 namespace mlpack {
 namespace cf /** Collaborative filtering. **/ {
+HAS_MEM_FUNC(GetWeightedRatings, HasGetWeightedRatingsCheck);
+HAS_MEM_FUNC(W, HasWCheck);
+HAS_MEM_FUNC(H, HasHCheck);
+
+/**
+ * 'value' is true if the DecompositionPolicy class has a member
+ * GetWeightedRatings(const arma::Mat<size_t>&, const arma::mat&, arma::mat&)
+ * const.
+ */
+template<typename DecompositionPolicy>
+struct HasGetWeightedRatings
+{
+  static const bool value = HasGetWeightedRatingsCheck<DecompositionPolicy,
+      void(DecompositionPolicy::*)(const arma::Mat<size_t>&,
+                                   const arma::mat&,
+                                   arma::mat&) const>::value;
+};
+
+/**
+ * 'value' is true if the DecompositionPolicy class has the members
+ * const arma::mat& W() const and const arma::mat& H() const.
+ */
+template<typename DecompositionPolicy>
+struct HasFactors
+{
+  static const bool value =
+      HasWCheck<DecompositionPolicy,
+          const arma::mat&(DecompositionPolicy::*)() const>::value &&
+      HasHCheck<DecompositionPolicy,
+          const arma::mat&(DecompositionPolicy::*)() const>::value;
+};
+
 /**
  * This class implements Collaborative Filtering (CF). This implementation
  * presently supports Alternating Least Squares (ALS) for collaborative
@@ -200,6 +233,8 @@ class CFType
 
   /**
    * Generates the given number of recommendations for the specified users.
+   * Users are processed in blocks (in parallel, if OpenMP is available); the
+   * ratings for each block are computed at once with GetWeightedRatings().
    *
    * @tparam NeighborSearchPolicy The policy used to search neighbors of
    *     query set in referece set.
@@ -256,6 +291,54 @@ class CFType
   void Predict(const arma::Mat<size_t>& combinations,
                arma::vec& predictions) const;
 
+  /**
+   * Get the weighted sums of the predicted ratings of the given neighbors for
+   * a block of users.  Column i of the result is the sum over j of
+   * weights(j, i) times the predicted (normalized) ratings of user
+   * neighborhood(j, i).  This is how GetRecommendations() computes the ratings
+   * of a block of users.
+   *
+   * If the decomposition policy has a GetWeightedRatings() method with the
+   * same signature, it is used.  Otherwise, if the policy has W() and H()
+   * methods, the predicted ratings are assumed to be W * H, and the weights
+   * are folded into H so that the block is computed with one matrix product;
+   * a policy whose predictions are not W * H (for instance because they have
+   * bias terms, like BiasSVDPolicy) must then provide GetWeightedRatings().
+   * Otherwise, the ratings of every neighbor are computed with
+   * GetRatingOfUser().
+   *
+   * @param neighborhood Neighbors of each user in the block.
+   * @param weights Interpolation weights of each neighbor.
+   * @param ratings Resulting rating matrix (one column per user).
+   */
+  template<typename PolicyType = DecompositionPolicy>
+  void GetWeightedRatings(
+      const arma::Mat<size_t>& neighborhood,
+      const arma::mat& weights,
+      arma::mat& ratings,
+      const typename std::enable_if<
+          HasGetWeightedRatings<PolicyType>::value>::type* = 0) const;
+
+  //! Get the weighted ratings as W * H (see above).
+  template<typename PolicyType = DecompositionPolicy>
+  void GetWeightedRatings(
+      const arma::Mat<size_t>& neighborhood,
+      const arma::mat& weights,
+      arma::mat& ratings,
+      const typename std::enable_if<
+          !HasGetWeightedRatings<PolicyType>::value &&
+          HasFactors<PolicyType>::value>::type* = 0) const;
+
+  //! Get the weighted ratings with GetRatingOfUser() (see above).
+  template<typename PolicyType = DecompositionPolicy>
+  void GetWeightedRatings(
+      const arma::Mat<size_t>& neighborhood,
+      const arma::mat& weights,
+      arma::mat& ratings,
+      const typename std::enable_if<
+          !HasGetWeightedRatings<PolicyType>::value &&
+          !HasFactors<PolicyType>::value>::type* = 0) const;
+
   /**
    * Serialize the CFType model to the given archive.
    */
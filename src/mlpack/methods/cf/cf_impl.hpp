@@ -201,72 +201,107 @@ GetRecommendations(const size_t numRecs,
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
   recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
   recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
 
   // Initialization of an InterpolationPolicy object should be put ahead of the
   // following loop, because the initialization may takes a relatively long
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
+  // Calculate interpolation weights for every queried user.  This is done
+  // serially because interpolation policies may cache intermediate results.
+  arma::mat weights(neighborhood.n_rows, users.n_elem);
   for (size_t i = 0; i < users.n_elem; ++i)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
         neighborhood.col(i), similarities.col(i), cleanedData);
+  }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
-    {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
+  // Users are processed in blocks, so that the ratings of a whole block can be
+  // computed with a single matrix product.  The block size is chosen to keep
+  // the dense rating block of each thread at a reasonable size.
+  const size_t maxBlockSize = 256;
+  const size_t blockSize = std::max((size_t) 1, std::min(maxBlockSize,
+      (size_t) (1 << 22) / std::max((size_t) 1, (size_t) cleanedData.n_rows)));
+  const size_t numBlocks = (users.n_elem + blockSize - 1) / blockSize;
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+  // Make sure the CSC representation is up to date before the matrix is read
+  // concurrently.
+  cleanedData.sync();
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
+  // Default candidate: the smallest possible value and invalid item number.
+  const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+
+  #pragma omp parallel
+  {
+    // Each thread reuses its rating block and candidate heap.
+    arma::mat ratings;
+    std::vector<Candidate> pqueue;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
     {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      const size_t begin = block * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) users.n_elem);
+
+      // First, calculate the weighted sum of neighborhood values for the whole
+      // block.
+      GetWeightedRatings(neighborhood.cols(begin, end - 1),
+          weights.cols(begin, end - 1), ratings);
+
+      for (size_t i = begin; i < end; ++i)
       {
-        Candidate c = std::make_pair(realRating, j);
-        pqueue.pop();
-        pqueue.push(c);
+        const size_t user = users(i);
+        const arma::vec userRatings(ratings.colptr(i - begin), ratings.n_rows,
+            false, true);
+
+        // Let's build the list of candidate recomendations for the given user.
+        // pqueue is a heap whose front is the worst candidate.
+        pqueue.assign(numRecs, def);
+
+        // Items the user has already rated are the nonzero entries in the
+        // user's column, whose row indices are sorted.
+        size_t ratedIndex = cleanedData.col_ptrs[user];
+        const size_t ratedEnd = cleanedData.col_ptrs[user + 1];
+
+        // Look through the ratings column corresponding to the current user.
+        for (size_t j = 0; j < userRatings.n_rows; ++j)
+        {
+          // Ensure that the user hasn't already rated the item.
+          // The algorithm omits rating of zero. Thus, when normalizing
+          // original ratings in Normalize(), if normalized rating equals zero,
+          // it is set to the smallest positive double value.
+          while (ratedIndex < ratedEnd &&
+              cleanedData.row_indices[ratedIndex] < j)
+            ++ratedIndex;
+          if (ratedIndex < ratedEnd && cleanedData.row_indices[ratedIndex] == j)
+            continue; // The user already rated the item.
+
+          // Is the estimated value better than the worst candidate?
+          // Denormalize rating before comparison.
+          double realRating = normalization.Denormalize(user, j,
+              userRatings[j]);
+          if (numRecs > 0 && realRating > pqueue.front().first)
+          {
+            std::pop_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+            pqueue.back() = std::make_pair(realRating, j);
+            std::push_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+          }
+        }
+
+        // Sorting the heap with the same comparator gives decreasing order.
+        std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+        for (size_t p = 0; p < numRecs; ++p)
+          recommendations(p, i) = pqueue[p].second;
       }
     }
+  }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (numRecs > 0 && recommendations(numRecs - 1, i) == def.second)
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -421,6 +456,65 @@ CleanData(const arma::mat& data, arma::sp_mat& cleanedData)
   cleanedData = arma::sp_mat(locations, values, maxItemID, maxUserID);
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename PolicyType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetWeightedRatings(const arma::Mat<size_t>& neighborhood,
+                   const arma::mat& weights,
+                   arma::mat& ratings,
+                   const typename std::enable_if<
+                       HasGetWeightedRatings<PolicyType>::value>::type*) const
+{
+  decomposition.GetWeightedRatings(neighborhood, weights, ratings);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename PolicyType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetWeightedRatings(const arma::Mat<size_t>& neighborhood,
+                   const arma::mat& weights,
+                   arma::mat& ratings,
+                   const typename std::enable_if<
+                       !HasGetWeightedRatings<PolicyType>::value &&
+                       HasFactors<PolicyType>::value>::type*) const
+{
+  const arma::mat& h = decomposition.H();
+  arma::mat combined(h.n_rows, neighborhood.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < neighborhood.n_cols; ++i)
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      combined.col(i) += weights(j, i) * h.col(neighborhood(j, i));
+
+  ratings = decomposition.W() * combined;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename PolicyType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetWeightedRatings(const arma::Mat<size_t>& neighborhood,
+                   const arma::mat& weights,
+                   arma::mat& ratings,
+                   const typename std::enable_if<
+                       !HasGetWeightedRatings<PolicyType>::value &&
+                       !HasFactors<PolicyType>::value>::type*) const
+{
+  ratings.zeros(cleanedData.n_rows, neighborhood.n_cols);
+  arma::vec neighborRatings;
+  for (size_t i = 0; i < neighborhood.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    {
+      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
+      ratings.col(i) += weights(j, i) * neighborRatings;
+    }
+  }
+}
+
 //! Serialize the model.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -24,11 +24,14 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_als_method.hpp>
 
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/similarity_interpolation.hpp>
 
+#include <mlpack/methods/cf/neighbor_search_policies/spill_search.hpp>
+
 #include <mlpack/methods/cf/neighbor_search_policies/cosine_search.hpp>
 #include <mlpack/methods/cf/neighbor_search_policies/lmetric_search.hpp>
 #include <mlpack/methods/cf/neighbor_search_policies/pearson_search.hpp>
@@ -90,6 +93,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'ImplicitALS' -- Weighted ALS for implicit feedback, using parallel "
+    "conjugate gradient solves\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -97,6 +102,14 @@ BINDING_LONG_DESC(
     " - 'cosine'  -- Cosine Search Algorithm\n"
     " - 'euclidean'  -- Euclidean Search Algorithm\n"
     " - 'pearson'  -- Pearson Search Algorithm\n"
+    " - 'spill'  -- Approximate Euclidean Search with a spill tree\n"
+    "\n"
+    "For the 'spill' neighbor search, the " +
+    PRINT_PARAM_STRING("spill_overlap") + " parameter controls the trade-off "
+    "between recall and search time; it is given relative to the average "
+    "standard deviation of the user factors.  Moderate values give more "
+    "accurate but slower searches than 0; once the overlap is comparable to "
+    "the width of the tree nodes, the search becomes exact (and slow)."
     "\n\n"
     "The following weight interpolation algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("interpolation") + " parameter:"
@@ -193,6 +206,8 @@ PARAM_STRING_IN("interpolation", "Algorithm used for weight interpolation.",
 
 PARAM_STRING_IN("neighbor_search", "Algorithm used for neighbor search.",
     "S", "euclidean");
+PARAM_DOUBLE_IN("spill_overlap", "Relative overlap of the spill tree used by "
+    "the 'spill' neighbor search.", "O", 0.1);
 
 template <typename NeighborSearchType,
           typename InterpolationType>
@@ -263,7 +278,8 @@ void ComputeRecommendations(CFModel* cf,
 {
   //  Verifying the Neighbor Search algorithms
   RequireParamInSet<string>("neighbor_search", { "cosine",
-      "euclidean", "pearson" }, true, "unknown neighbor search algorithm");
+      "euclidean", "pearson", "spill" }, true,
+      "unknown neighbor search algorithm");
 
   //  Taking Neighbor Search alternatives
   const string neighborSearchAlgorithm = IO::GetParam<string>
@@ -283,6 +299,11 @@ void ComputeRecommendations(CFModel* cf,
   {
     ComputeRecommendations<PearsonSearch>(cf, numRecs, recommendations);
   }
+  else if (neighborSearchAlgorithm == "spill")
+  {
+    SpillSearch::Defaults defaults(IO::GetParam<double>("spill_overlap"));
+    ComputeRecommendations<SpillSearch>(cf, numRecs, recommendations);
+  }
 }
 
 template <typename NeighborSearchType,
@@ -343,7 +364,8 @@ void ComputeRMSE(CFModel* cf)
 {
   //  Verifying the Neighbor Search algorithms
   RequireParamInSet<string>("neighbor_search", { "cosine",
-      "euclidean", "pearson" }, true, "unknown neighbor search algorithm");
+      "euclidean", "pearson", "spill" }, true,
+      "unknown neighbor search algorithm");
 
   //  Taking Neighbor Search alternatives
   const string neighborSearchAlgorithm = IO::GetParam<string>
@@ -361,6 +383,11 @@ void ComputeRMSE(CFModel* cf)
   {
     ComputeRMSE<PearsonSearch>(cf);
   }
+  else if (neighborSearchAlgorithm == "spill")
+  {
+    SpillSearch::Defaults defaults(IO::GetParam<double>("spill_overlap"));
+    ComputeRMSE<SpillSearch>(cf);
+  }
 }
 
 void PerformAction(CFModel* c)
@@ -465,6 +492,10 @@ void AssembleFactorizerType(const std::string& algorithm,
         "when max_iterations is reached");
     PerformAction<SVDPlusPlusPolicy>(dataset, rank, maxIterations, minResidue);
   }
+  else if (algorithm == "ImplicitALS")
+  {
+    PerformAction<ImplicitALSPolicy>(dataset, rank, maxIterations, minResidue);
+  }
 }
 
 static void mlpackMain()
@@ -488,13 +519,17 @@ static void mlpackMain()
 
   RequireParamInSet<string>("algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "ImplicitALS" }, true,
+      "unknown algorithm");
 
   ReportIgnoredParam({{ "iteration_only_termination", true }}, "min_residue");
 
   RequireParamValue<int>("recommendations", [](int x) { return x > 0; }, true,
         "recommendations must be positive");
 
+  RequireParamValue<double>("spill_overlap", [](double x) { return x >= 0; },
+      true, "spill_overlap must be non-negative");
+
   // Either load from a model, or train a model.
   if (IO::HasParam("training"))
   {
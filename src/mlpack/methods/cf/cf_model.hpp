@@ -24,6 +24,7 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_als_method.hpp>
 
 #include <mlpack/methods/cf/normalization/no_normalization.hpp>
 #include <mlpack/methods/cf/normalization/overall_mean_normalization.hpp>
@@ -125,7 +126,8 @@ class CFModel
    * cf holds an instance of the CFType class for the current
    * decompositionPolicy and normalizationType. It is initialized every time
    * Train() is executed. We access to the contained value through the visitor
-   * classes defined above.
+   * classes defined above.  New types must be appended at the end, so that
+   * the indices of the types in previously saved models do not change.
    */
   boost::variant<CFType<NMFPolicy, NoNormalization>*,
                  CFType<BatchSVDPolicy, NoNormalization>*,
@@ -170,7 +172,13 @@ class CFModel
                  CFType<SVDCompletePolicy, ZScoreNormalization>*,
                  CFType<SVDIncompletePolicy, ZScoreNormalization>*,
                  CFType<BiasSVDPolicy, ZScoreNormalization>*,
-                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*> cf;
+                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*,
+
+                 CFType<ImplicitALSPolicy, NoNormalization>*,
+                 CFType<ImplicitALSPolicy, ItemMeanNormalization>*,
+                 CFType<ImplicitALSPolicy, UserMeanNormalization>*,
+                 CFType<ImplicitALSPolicy, OverallMeanNormalization>*,
+                 CFType<ImplicitALSPolicy, ZScoreNormalization>*> cf;
 
  public:
   //! Create an empty CF model.
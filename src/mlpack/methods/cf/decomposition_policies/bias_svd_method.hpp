@@ -106,6 +106,31 @@ class BiasSVDPolicy
     rating = w * h.col(user) + p + q(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of the given neighbors for
+   * a block of users, like CFType::GetWeightedRatings(), including the user
+   * and item biases.
+   */
+  void GetWeightedRatings(const arma::Mat<size_t>& neighborhood,
+                          const arma::mat& weights,
+                          arma::mat& ratings) const
+  {
+    arma::mat combined(h.n_rows, neighborhood.n_cols, arma::fill::zeros);
+    arma::rowvec userBias(neighborhood.n_cols, arma::fill::zeros);
+    for (size_t i = 0; i < neighborhood.n_cols; ++i)
+    {
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        combined.col(i) += weights(j, i) * h.col(neighborhood(j, i));
+        userBias(i) += weights(j, i) * q(neighborhood(j, i));
+      }
+    }
+
+    // The item bias is scaled by the total weight of each neighborhood.
+    ratings = w * combined + p * arma::sum(weights, 0);
+    ratings.each_row() += userBias;
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
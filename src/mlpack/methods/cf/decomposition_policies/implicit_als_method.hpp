@@ -0,0 +1,345 @@
+/**
+ * @file methods/cf/decomposition_policies/implicit_als_method.hpp
+ *
+ * Implementation of the weighted alternating least squares method for implicit
+ * feedback, for use in Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of weighted alternating least squares for implicit feedback
+ * data, as described in the following paper:
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative Filtering for Implicit Feedback Datasets},
+ *   author={Hu, Yifan and Koren, Yehuda and Volinsky, Chris},
+ *   booktitle={2008 Eighth IEEE International Conference on Data Mining},
+ *   pages={263--272},
+ *   year={2008},
+ *   organization={IEEE}
+ * }
+ * @endcode
+ *
+ * Each nonzero entry r_ui of the sparse item-user matrix is an observed
+ * interaction (e.g. a click count).  It is turned into a binary preference
+ * p_ui = 1 with confidence c_ui = 1 + alpha * r_ui, while all unobserved
+ * entries have preference 0 and confidence 1.  The weighted squared loss over
+ * all entries is minimized by alternately solving for the user and item
+ * factors.
+ *
+ * Each of the per-user (and per-item) least squares problems is solved
+ * approximately with a few steps of the conjugate gradient method, warm-started
+ * from the previous solution, as suggested in the following paper:
+ *
+ * @code
+ * @inproceedings{takacs2011applications,
+ *   title={Applications of the Conjugate Gradient Method for Implicit
+ *       Feedback Collaborative Filtering},
+ *   author={Tak{\'a}cs, G{\'a}bor and Pil{\'a}szy, Istv{\'a}n and Tikk,
+ *       Domonkos},
+ *   booktitle={Proceedings of the Fifth ACM Conference on Recommender
+ *       Systems},
+ *   pages={297--300},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The contribution of the unobserved entries is the same for every user, so
+ * it is computed once per sweep as the Gram matrix of the fixed factors; each
+ * solve then only touches the nonzero entries of one column of the sparse
+ * matrix.  The solves are independent and are run in parallel with OpenMP.
+ *
+ * Negative values in the rating matrix are treated as observations with no
+ * additional confidence, so this policy should be used with NoNormalization.
+ *
+ * An example of how to use ImplicitALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::sp_mat data; // data is a sparse (item, user) count table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ImplicitALSPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ImplicitALSPolicy
+{
+ public:
+  /**
+   * Use weighted alternating least squares to perform collaborative filtering
+   * on implicit feedback data.
+   *
+   * @param alpha Scaling of the confidence of observed entries.
+   * @param lambda Regularization parameter.
+   * @param cgSteps Number of conjugate gradient steps for each least squares
+   *     problem.
+   */
+  ImplicitALSPolicy(const double alpha = 40.0,
+                    const double lambda = 0.1,
+                    const size_t cgSteps = 3) :
+      alpha(alpha),
+      lambda(lambda),
+      cgSteps(cgSteps)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using weighted
+   * alternating least squares.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix (cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Residue required to terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    // The item factors are kept column-major (one column per item) during
+    // training, so that each solve reads contiguous memory.
+    arma::mat wt = 0.01 * arma::randu<arma::mat>(rank, cleanedData.n_rows);
+    h = 0.01 * arma::randu<arma::mat>(rank, cleanedData.n_cols);
+
+    // Each item solve needs the users that interacted with the item.
+    const arma::sp_mat itemData = cleanedData.t();
+    cleanedData.sync();
+    itemData.sync();
+
+    size_t iteration = 0;
+    while (maxIterations == 0 || iteration < maxIterations)
+    {
+      const arma::mat oldH = h;
+      const arma::mat oldWt = wt;
+
+      // Solve for the users with the items fixed, then the other way around.
+      Sweep(cleanedData, wt, h);
+      Sweep(itemData, h, wt);
+      ++iteration;
+
+      const double residue = (arma::norm(h - oldH, "fro") +
+          arma::norm(wt - oldWt, "fro")) /
+          (arma::norm(oldH, "fro") + arma::norm(oldWt, "fro"));
+      Log::Info << "ImplicitALSPolicy: iteration " << iteration << ", residue "
+          << residue << "." << std::endl;
+
+      if (!mit && residue < minResidue)
+        break;
+    }
+
+    w = wt.t();
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the confidence scaling.
+  double Alpha() const { return alpha; }
+  //! Modify the confidence scaling.
+  double& Alpha() { return alpha; }
+
+  //! Get regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the number of conjugate gradient steps per solve.
+  size_t CGSteps() const { return cgSteps; }
+  //! Modify the number of conjugate gradient steps per solve.
+  size_t& CGSteps() { return cgSteps; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(alpha);
+    ar & BOOST_SERIALIZATION_NVP(lambda);
+    ar & BOOST_SERIALIZATION_NVP(cgSteps);
+    ar & BOOST_SERIALIZATION_NVP(w);
+    ar & BOOST_SERIALIZATION_NVP(h);
+  }
+
+ private:
+  /**
+   * Solve for every column of the given factors with the other factors fixed.
+   * Column j of 'factors' corresponds to column j of 'data', and the rows of
+   * 'data' index the columns of 'fixed'.
+   *
+   * @param data Sparse interaction matrix (must be synced).
+   * @param fixed Factors that are held fixed.
+   * @param factors Factors to solve for; used as the starting point.
+   */
+  void Sweep(const arma::sp_mat& data,
+             const arma::mat& fixed,
+             arma::mat& factors) const
+  {
+    // The unobserved entries contribute Y^T Y for every column, so compute it
+    // once.
+    arma::mat gram = fixed * fixed.t();
+    gram.diag() += lambda;
+
+    #pragma omp parallel
+    {
+      // Per-thread work vectors for the conjugate gradient method.
+      arma::vec r(fixed.n_rows), p(fixed.n_rows), ap(fixed.n_rows);
+
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+      {
+        const size_t begin = data.col_ptrs[j];
+        const size_t end = data.col_ptrs[j + 1];
+        arma::vec x(factors.colptr(j), factors.n_rows, false, true);
+
+        // Compute the residual r = b - A x, where
+        //   A = Y^T Y + lambda I + sum_i (c_i - 1) y_i y_i^T,
+        //   b = sum_i c_i y_i.
+        r = -gram * x;
+        for (size_t k = begin; k < end; ++k)
+        {
+          const double extra = Confidence(data.values[k]) - 1.0;
+          const arma::vec y(const_cast<double*>(fixed.colptr(
+              data.row_indices[k])), fixed.n_rows, false, true);
+          r += (1.0 + extra - extra * arma::dot(y, x)) * y;
+        }
+
+        p = r;
+        double rsOld = arma::dot(r, r);
+        for (size_t step = 0; step < cgSteps; ++step)
+        {
+          if (rsOld < 1e-20)
+            break;
+
+          ap = gram * p;
+          for (size_t k = begin; k < end; ++k)
+          {
+            const double extra = Confidence(data.values[k]) - 1.0;
+            const arma::vec y(const_cast<double*>(fixed.colptr(
+                data.row_indices[k])), fixed.n_rows, false, true);
+            ap += extra * arma::dot(y, p) * y;
+          }
+
+          const double stepSize = rsOld / arma::dot(p, ap);
+          x += stepSize * p;
+          r -= stepSize * ap;
+
+          const double rsNew = arma::dot(r, r);
+          p = r + (rsNew / rsOld) * p;
+          rsOld = rsNew;
+        }
+      }
+    }
+  }
+
+  //! Get the confidence of an observed entry.
+  double Confidence(const double value) const
+  {
+    return 1.0 + alpha * std::max(value, 0.0);
+  }
+
+  //! Scaling of the confidence of observed entries.
+  double alpha;
+  //! Regularization parameter.
+  double lambda;
+  //! Number of conjugate gradient steps per solve.
+  size_t cgSteps;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
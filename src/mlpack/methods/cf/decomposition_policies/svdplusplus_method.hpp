@@ -141,6 +141,48 @@ class SVDPlusPlusPolicy
     rating = w * userVec + p + q(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of the given neighbors for
+   * a block of users, like CFType::GetWeightedRatings(), including the biases
+   * and the implicit feedback.
+   */
+  void GetWeightedRatings(const arma::Mat<size_t>& neighborhood,
+                          const arma::mat& weights,
+                          arma::mat& ratings) const
+  {
+    arma::mat combined(h.n_rows, neighborhood.n_cols, arma::fill::zeros);
+    arma::rowvec userBias(neighborhood.n_cols, arma::fill::zeros);
+    arma::vec userVec(h.n_rows);
+    for (size_t i = 0; i < neighborhood.n_cols; ++i)
+    {
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        const size_t user = neighborhood(j, i);
+
+        // Compute the implicit user vector just like GetRatingOfUser().
+        userVec.zeros();
+        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+        size_t implicitCount = 0;
+        for (; it != it_end; ++it)
+        {
+          userVec += y.col(it.row());
+          implicitCount += 1;
+        }
+        if (implicitCount != 0)
+          userVec /= std::sqrt(implicitCount);
+        userVec += h.col(user);
+
+        combined.col(i) += weights(j, i) * userVec;
+        userBias(i) += weights(j, i) * q(user);
+      }
+    }
+
+    // The item bias is scaled by the total weight of each neighborhood.
+    ratings = w * combined + p * arma::sum(weights, 0);
+    ratings.each_row() += userBias;
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
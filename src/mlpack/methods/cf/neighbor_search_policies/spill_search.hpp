@@ -0,0 +1,204 @@
+/**
+ * @file methods/cf/neighbor_search_policies/spill_search.hpp
+ *
+ * Approximate nearest neighbor search with Euclidean distance, using defeatist
+ * search on a hybrid spill tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_SPILL_SEARCH_HPP
+#define MLPACK_METHODS_CF_SPILL_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Approximate nearest neighbor search with Euclidean distance.  Exact kd-tree
+ * search degrades to brute force when the latent factors have many dimensions,
+ * so instead this policy builds a hybrid spill tree on the reference set and
+ * performs greedy (defeatist) single-tree search with neighbor::SpillKNN.
+ * Similarities are calculated from Euclidean distance in the same way as
+ * EuclideanSearch.
+ *
+ * The overlap between sibling nodes of the spill tree controls the trade-off
+ * between recall and search time.  With an overlap of zero, a query only looks
+ * at a single leaf, and moderate overlaps let each query see the points near
+ * the splits, at the cost of a bigger tree.  The effect is not monotonic,
+ * though: when an overlapping split would put more than rho of the points of a
+ * node in one child, the node is split without overlap and searched with
+ * backtracking instead, so once the overlap is comparable to the width of the
+ * nodes, more and more of the tree is searched exactly, and a very large
+ * overlap amounts to exact search.  The overlap is given relative to the
+ * average standard deviation of the dimensions of the reference set, so that
+ * the same value can be used regardless of the scale of the data.
+ *
+ * The parameters of the spill tree belong to each SpillSearch object and are
+ * given to its constructor.  The decomposition policies of CFType construct
+ * their neighbor search policy from the reference set alone, so the defaults
+ * of the constructor can be changed for the calling thread with a
+ * SpillSearch::Defaults object:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<> cf(data);
+ *
+ * // Generate 10 recommendations for all users, with an overlap of 0.3.
+ * {
+ *   SpillSearch::Defaults defaults(0.3);
+ *   cf.template GetRecommendations<SpillSearch>(10, recommendations);
+ * }
+ * @endcode
+ */
+class SpillSearch
+{
+ public:
+  //! The type of the underlying approximate neighbor search.
+  typedef neighbor::SpillKNN NeighborSearchType;
+
+  /**
+   * Defaults sets the default parameters of the SpillSearch objects
+   * constructed on the calling thread, for as long as it lives.  It must be
+   * destroyed on the thread that created it.
+   */
+  class Defaults
+  {
+   public:
+    /**
+     * Set the default parameters of the spill tree on the calling thread.
+     *
+     * @param overlap Overlap of the spill tree, relative to the average
+     *     standard deviation of the dimensions of the reference set.
+     * @param leafSize Maximum leaf size of the spill tree.
+     * @param rho Balance threshold of the spill tree.
+     */
+    Defaults(const double overlap,
+             const size_t leafSize = 20,
+             const double rho = 0.7) :
+        overlap(overlap),
+        leafSize(leafSize),
+        rho(rho),
+        previous(Current())
+    {
+      Current() = this;
+    }
+
+    //! Go back to the defaults that were used before.
+    ~Defaults() { Current() = previous; }
+
+    //! The defaults cannot be copied.
+    Defaults(const Defaults&) = delete;
+    //! The defaults cannot be copied.
+    Defaults& operator=(const Defaults&) = delete;
+
+    //! Get the innermost defaults of the calling thread, or NULL if there are
+    //! none.
+    static Defaults*& Current()
+    {
+      static thread_local Defaults* current = NULL;
+      return current;
+    }
+
+    //! The default overlap.
+    double overlap;
+    //! The default maximum leaf size.
+    size_t leafSize;
+    //! The default balance threshold.
+    double rho;
+
+   private:
+    //! The defaults that were used before.
+    Defaults* previous;
+  };
+
+  /**
+   * Constructor with reference set.  A spill tree is built on the reference
+   * set with the parameters of the innermost Defaults object of the calling
+   * thread, or with an overlap of 0.1, a leaf size of 20 and a rho of 0.7 if
+   * there is none.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  SpillSearch(const arma::mat& referenceSet) :
+      SpillSearch(referenceSet,
+                  Defaults::Current() ? Defaults::Current()->overlap : 0.1,
+                  Defaults::Current() ? Defaults::Current()->leafSize : 20,
+                  Defaults::Current() ? Defaults::Current()->rho : 0.7)
+  { }
+
+  /**
+   * Constructor with reference set and parameters.  A spill tree is built on
+   * the reference set with the given overlap, leaf size and rho.
+   *
+   * @param referenceSet Set of reference points.
+   * @param overlap Overlap of the spill tree, relative to the average standard
+   *     deviation of the dimensions of the reference set.
+   * @param leafSize Maximum leaf size of the spill tree.
+   * @param rho Balance threshold of the spill tree.
+   */
+  SpillSearch(const arma::mat& referenceSet,
+              const double overlap,
+              const size_t leafSize = 20,
+              const double rho = 0.7) :
+      overlap(overlap),
+      leafSize(leafSize),
+      rho(rho),
+      neighborSearch(neighbor::GREEDY_SINGLE_TREE_MODE)
+  {
+    // Convert the relative overlap into the scale of the reference set.
+    double tau = 0.0;
+    if (overlap > 0.0 && referenceSet.n_cols > 1)
+      tau = overlap * arma::mean(arma::stddev(referenceSet, 0, 1));
+
+    NeighborSearchType::Tree tree(referenceSet, tau, leafSize, rho);
+    neighborSearch.Train(std::move(tree));
+  }
+
+  /**
+   * Given a set of query points, find the nearest k neighbors, and return
+   * similarities. Similarities are non-negative and no larger than one.
+   *
+   * @param query A set of query points.
+   * @param k Number of neighbors to search.
+   * @param neighbors Nearest neighbors.
+   * @param similarities Similarities between query point and its neighbors.
+   */
+  void Search(const arma::mat& query, const size_t k,
+              arma::Mat<size_t>& neighbors, arma::mat& similarities)
+  {
+    neighborSearch.Search(query, k, neighbors, similarities);
+
+    // Calculate similarities from Euclidean distance. We restrict that
+    // similarities are not larger than one.
+    similarities = 1.0 / (1.0 + similarities);
+  }
+
+  //! Get the overlap of the spill tree, relative to the data scale.
+  double Overlap() const { return overlap; }
+  //! Get the maximum leaf size of the spill tree.
+  size_t LeafSize() const { return leafSize; }
+  //! Get the balance threshold of the spill tree.
+  double Rho() const { return rho; }
+
+ private:
+  //! The overlap of the spill tree, relative to the data scale.
+  double overlap;
+  //! The maximum leaf size of the spill tree.
+  size_t leafSize;
+  //! The balance threshold of the spill tree.
+  double rho;
+  //! NeighborSearch object.
+  NeighborSearchType neighborSearch;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
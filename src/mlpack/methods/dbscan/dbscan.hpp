@@ -15,7 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
-#include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
@@ -44,6 +44,12 @@ namespace dbscan {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * Points within epsilon of each other are merged with a ConcurrentUnionFind
+ * object, so when OpenMP is available the merging is done in parallel (as is
+ * the search, with the default RangeSearch class).  Since each cluster is
+ * numbered by its smallest point, the assignments do not depend on the number
+ * of threads or on the order in which points are processed.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -57,12 +63,16 @@ class DBSCAN
    * Construct the DBSCAN object with the given parameters.  The batchMode
    * parameter should be set to false in the case where RAM issues will be
    * encountered (i.e. if the dataset is very large or if epsilon is large).
-   * When batchMode is false, each point will be searched iteratively, which
-   * could be slower but will use less memory.
+   * When batchMode is false, the points are searched in blocks of 10000, so
+   * that only the neighborhoods of one block are held in memory at a time;
+   * each block is still searched and merged in parallel when OpenMP is
+   * available, but the tree cannot be traversed as efficiently as with one
+   * batch search.
    *
    * @param epsilon Size of range query.
    * @param minPoints Minimum number of points for each cluster.
-   * @param batchMode If true, all points are searched in batch.
+   * @param batchMode If true, all points are searched in one batch; otherwise,
+   *     they are searched block by block.
    * @param rangeSearch Optional instantiated RangeSearch object.
    * @param pointSelector OptionL instantiated PointSelectionPolicy object.
    */
@@ -120,7 +130,8 @@ class DBSCAN
   //! itself) for the point to be a core-point.
   size_t minPoints;
 
-  //! Whether or not to perform the search in batch mode.  If false, single
+  //! Whether or not to perform the search in batch mode.  If false, the points
+  //! are searched block by block.
   bool batchMode;
 
   //! Instantiated range search policy.
@@ -131,17 +142,17 @@ class DBSCAN
 
   /**
    * Performs DBSCAN clustering on the data, returning the number of clusters and
-   * also the list of cluster assignments.  This searches each point iteratively,
-   * and can save on RAM usage.  It may be slower than the batch search with a
-   * dual-tree algorithm.
+   * also the list of cluster assignments.  This searches the points in small
+   * blocks, and can save on RAM usage.  It may be slower than the batch search
+   * with a dual-tree algorithm.
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf ConcurrentUnionFind structure that will be modified.
    */
   template<typename MatType>
   void PointwiseCluster(const MatType& data,
-                        emst::UnionFind& uf);
+                        emst::ConcurrentUnionFind& uf);
 
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters
@@ -150,11 +161,11 @@ class DBSCAN
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param uf ConcurrentUnionFind structure that will be modified.
    */
   template<typename MatType>
   void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+                    emst::ConcurrentUnionFind& uf);
 };
 
 } // namespace dbscan
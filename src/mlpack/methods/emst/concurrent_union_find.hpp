@@ -0,0 +1,110 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ *
+ * A union-find data structure that can be used by several threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A lock-free Union-Find data structure, which has the same interface as
+ * UnionFind but allows any number of threads to call Find() and Union()
+ * concurrently.  The parent of each element is stored atomically; Find()
+ * shortens the paths it follows (path halving) and Union() links the two
+ * roots, both with compare-and-swap operations, so that a thread that loses a
+ * race simply retries.
+ *
+ * The root of a component is always linked below the other root if it has the
+ * larger index, so the representative returned by Find() is the smallest
+ * element of the component.  In particular, it does not depend on the order
+ * in which unions were performed.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i);
+  }
+
+  /**
+   * Returns the component containing an element.  Since the representative of
+   * a component is its smallest element, this is also the smallest element
+   * connected to x.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load();
+      if (p == x)
+        return x;
+
+      const size_t grandparent = parent[p].load();
+      if (grandparent == p)
+        return p;
+
+      // Path halving: make x point to its grandparent.  If another thread
+      // changed the parent of x in the meantime, the exchange fails, which is
+      // harmless.
+      parent[x].compare_exchange_weak(p, grandparent);
+      x = grandparent;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.
+   *
+   * @param x one component
+   * @param y the other component
+   * @return true if x and y were in different components; when several threads
+   *     union the same two components, exactly one of them gets true.
+   */
+  bool Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+
+    while (xRoot != yRoot)
+    {
+      // Link the root with the larger index below the other one.
+      if (xRoot < yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = xRoot;
+      if (parent[xRoot].compare_exchange_strong(expected, yRoot))
+        return true;
+
+      // Another thread linked xRoot first; try again from the new roots.
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+    }
+
+    return false;
+  }
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
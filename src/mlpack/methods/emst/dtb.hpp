@@ -27,6 +27,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "concurrent_union_find.hpp"
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
@@ -102,8 +103,8 @@ class DualTreeBoruvka
   //! Edges.
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
-  //! Connections.
-  UnionFind connections;
+  //! Connections.  These are shared by all threads during each round.
+  ConcurrentUnionFind connections;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -112,6 +113,10 @@ class DualTreeBoruvka
   //! List of edge distances.
   arma::vec neighborsDistances;
 
+  //! Core distances of the points (in the order of data), if the MST of the
+  //! mutual reachability graph is computed; otherwise empty.
+  arma::vec coreDistances;
+
   //! Total distance of the tree.
   double totalDist;
 
@@ -171,16 +176,48 @@ class DualTreeBoruvka
    * index of the edge; the second row will contain the greater index of the
    * edge; and the third row will contain the distance between the two edges.
    *
+   * Each round is parallelized with OpenMP (if available): the query side
+   * of the traversal is split into disjoint subtrees, each thread collects
+   * candidate edges for the subtrees it handles, and the candidates are
+   * merged before the components are joined.
+   *
    * @param results Matrix which results will be stored in.
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Compute the minimum spanning tree of the mutual reachability graph of the
+   * dataset, in which the length of the edge between points a and b is
+   * max(d(a, b), core(a), core(b)).  This is used by HDBSCAN.  The results
+   * have the same form as for ComputeMST(arma::mat&), with the third row
+   * holding mutual reachability distances.
+   *
+   * @param results Matrix which results will be stored in.
+   * @param coreDistances Core distance of each point.  If this object built
+   *     its own tree, these are given in the order of the original dataset;
+   *     if a pre-built tree was given, they are in the order of the tree's
+   *     dataset.
+   */
+  void ComputeMST(arma::mat& results, const arma::vec& coreDistances);
+
  private:
   /**
    * Adds a single edge to the edge list
    */
   void AddEdge(const size_t e1, const size_t e2, const double distance);
 
+  /**
+   * Find the candidate edge of every component in one iteration, in parallel.
+   *
+   * @param queryNodes Disjoint subtrees whose points cover the dataset (not
+   *     used in naive mode).
+   * @param baseCases Incremented by the number of base cases performed.
+   * @param scores Incremented by the number of node combinations scored.
+   */
+  void FindCandidateEdges(const std::vector<Tree*>& queryNodes,
+                          size_t& baseCases,
+                          size_t& scores);
+
   /**
    * Adds all the edges found in one iteration to the list of neighbors.
    */
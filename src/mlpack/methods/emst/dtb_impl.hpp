@@ -13,6 +13,11 @@
 #define MLPACK_METHODS_EMST_DTB_IMPL_HPP
 
 #include "dtb_rules.hpp"
+#include <mlpack/core/tree/disjoint_subtrees.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
 
 namespace mlpack {
 namespace emst {
@@ -123,23 +128,26 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 
   totalDist = 0; // Reset distance.
 
-  typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  // Split the query side of the traversal into disjoint subtrees whose points
+  // cover the dataset, so that the threads can work on them independently.
+  // A few subtrees per thread balance the load.
+  std::vector<Tree*> queryNodes;
+  if (!naive)
+  {
+    #ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+    #else
+    const size_t numThreads = 1;
+    #endif
+    tree::DisjointSubtrees(*tree, (numThreads == 1) ? 1 : 4 * numThreads,
+        queryNodes);
+  }
+
+  size_t baseCases = 0;
+  size_t scores = 0;
   while (edges.size() < (data.n_cols - 1))
   {
-    if (naive)
-    {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
-    }
-    else
-    {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
-    }
+    FindCandidateEdges(queryNodes, baseCases, scores);
 
     AddAllEdges();
 
@@ -148,8 +156,8 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << baseCases << " cumulative base cases." << std::endl;
+      Log::Info << scores << " cumulative node combinations scored."
           << std::endl;
     }
   }
@@ -161,6 +169,108 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   Log::Info << "Total spanning tree length: " << totalDist << std::endl;
 }
 
+/**
+ * Compute the minimum spanning tree of the mutual reachability graph.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
+    arma::mat& results,
+    const arma::vec& coreDistances)
+{
+  if (coreDistances.n_elem != data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "DualTreeBoruvka::ComputeMST(): number of core distances ("
+        << coreDistances.n_elem << ") is not equal to the number of points ("
+        << data.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The tree may have rearranged the points.
+  if (!naive && ownTree && tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    this->coreDistances.set_size(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      this->coreDistances[i] = coreDistances[oldFromNew[i]];
+  }
+  else
+  {
+    this->coreDistances = coreDistances;
+  }
+
+  ComputeMST(results);
+}
+
+/**
+ * Find the candidate edge of every component in one iteration.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::FindCandidateEdges(
+    const std::vector<Tree*>& queryNodes,
+    size_t& baseCases,
+    size_t& scores)
+{
+  typedef DTBRules<MetricType, Tree, ConcurrentUnionFind> RuleType;
+
+  #pragma omp parallel
+  {
+    // Each thread collects the best candidate edge of every component among
+    // the queries it handles; the candidates are merged at the end.  The
+    // components do not change during a round, so Find() is safe to call
+    // from all threads.
+    arma::vec threadDistances(data.n_cols);
+    threadDistances.fill(DBL_MAX);
+    arma::Col<size_t> threadInComponent(data.n_cols);
+    arma::Col<size_t> threadOutComponent(data.n_cols);
+
+    RuleType rules(data, connections, threadDistances, threadInComponent,
+        threadOutComponent, metric, coreDistances);
+
+    if (naive)
+    {
+      // Full O(N^2) traversal.
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+        for (size_t j = 0; j < data.n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
+    else
+    {
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) queryNodes.size(); ++i)
+        traverser.Traverse(*queryNodes[i], *tree);
+    }
+
+    #pragma omp critical
+    {
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        if (threadDistances[i] < neighborsDistances[i])
+        {
+          neighborsDistances[i] = threadDistances[i];
+          neighborsInComponent[i] = threadInComponent[i];
+          neighborsOutComponent[i] = threadOutComponent[i];
+        }
+      }
+
+      baseCases += rules.BaseCases();
+      scores += rules.Scores();
+    }
+  }
+}
+
 /**
  * Adds a single edge to the edge list
  */
@@ -195,19 +305,38 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
+  // Collect the components before any of them are joined.
+  std::vector<size_t> components;
   for (size_t i = 0; i < data.n_cols; ++i)
+    if (connections.Find(i) == i)
+      components.push_back(i);
+
+  // Join every component with the endpoint of its candidate edge.  Two
+  // components may propose the same edge (and, with ties, the proposals may
+  // form a cycle), but Union() only succeeds once for each pair of components,
+  // so every edge that joins two components is kept exactly once.
+  std::vector<char> added(components.size(), 0);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) components.size(); ++i)
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
-    {
-      // totalDist = totalDist + dist;
-      // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
-    }
+    const size_t component = components[i];
+    if (connections.Union(neighborsInComponent[component],
+                          neighborsOutComponent[component]))
+      added[i] = 1;
+  }
+
+  // Add the edges in a deterministic order.
+  for (size_t i = 0; i < components.size(); ++i)
+  {
+    if (!added[i])
+      continue;
+
+    const size_t component = components[i];
+    // totalDist = totalDist + dist;
+    // changed to make this agree with the cover tree code
+    totalDist += neighborsDistances[component];
+    AddEdge(neighborsInComponent[component],
+        neighborsOutComponent[component], neighborsDistances[component]);
   }
 }
 
@@ -15,23 +15,69 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/metrics/distance_tile.hpp>
 
 namespace mlpack {
 namespace emst {
 
-template<typename MetricType, typename TreeType>
+/**
+ * The rules for one round of the DualTreeBoruvka algorithm, which find the
+ * shortest edge leaving each component.  If core distances are given, the
+ * length of an edge (a, b) is the mutual reachability distance
+ * max(d(a, b), core(a), core(b)) instead of d(a, b); since this is never
+ * smaller than d(a, b), the distance bounds of the tree remain valid for
+ * pruning.
+ *
+ * @tparam MetricType The metric to use.
+ * @tparam TreeType The type of tree to traverse.
+ * @tparam UnionFindType The union-find structure that holds the components
+ *     (UnionFind or ConcurrentUnionFind).
+ */
+template<typename MetricType,
+         typename TreeType,
+         typename UnionFindType = UnionFind>
 class DTBRules
 {
  public:
+  /**
+   * Construct the rules.
+   *
+   * @param dataSet The data points.
+   * @param connections The components found so far.
+   * @param neighborsDistances Length of the candidate edge of each component.
+   * @param neighborsInComponent Endpoint of the candidate edge of each
+   *     component inside the component.
+   * @param neighborsOutComponent Endpoint of the candidate edge of each
+   *     component outside the component.
+   * @param metric The instantiated metric.
+   * @param coreDistances Core distance of each point, or an empty vector to
+   *     use plain distances.
+   */
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
+           UnionFindType& connections,
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
-           MetricType& metric);
+           MetricType& metric,
+           const arma::vec& coreDistances);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Perform the base cases between the given query points and a contiguous
+   * block of reference points, as if BaseCase() was called for each pair.  If
+   * the metric supports it, a tile of distance bounds is computed at once, and
+   * only the pairs that could shorten the candidate edge of their component
+   * are evaluated exactly.
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void BlockBaseCase(const arma::uvec& queryIndices,
+                     const size_t referenceBegin,
+                     const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -102,7 +148,7 @@ class DTBRules
   const arma::mat& dataSet;
 
   //! Stores the tree structure so far
-  UnionFind& connections;
+  UnionFindType& connections;
 
   //! The distance to the candidate nearest neighbor for each component.
   arma::vec& neighborsDistances;
@@ -118,6 +164,9 @@ class DTBRules
   //! The instantiated metric.
   MetricType& metric;
 
+  //! The core distance of each point (empty if plain distances are used).
+  const arma::vec& coreDistances;
+
   /**
    * Update the bound for the given query node.
    */
@@ -129,6 +178,9 @@ class DTBRules
   size_t baseCases;
   //! The number of node combinations that have been scored.
   size_t scores;
+
+  //! Used to compute blocks of distances in BlockBaseCase().
+  metric::DistanceTile<MetricType, arma::mat> distanceTile;
 }; // class DTBRules
 
 } // namespace emst
@@ -15,14 +15,15 @@
 namespace mlpack {
 namespace emst {
 
-template<typename MetricType, typename TreeType>
-DTBRules<MetricType, TreeType>::
+template<typename MetricType, typename TreeType, typename UnionFindType>
+DTBRules<MetricType, TreeType, UnionFindType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
+         UnionFindType& connections,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
-         MetricType& metric)
+         MetricType& metric,
+         const arma::vec& coreDistances)
 :
   dataSet(dataSet),
   connections(connections),
@@ -30,16 +31,19 @@ DTBRules(const arma::mat& dataSet,
   neighborsInComponent(neighborsInComponent),
   neighborsOutComponent(neighborsOutComponent),
   metric(metric),
+  coreDistances(coreDistances),
   baseCases(0),
-  scores(0)
+  scores(0),
+  distanceTile(metric, dataSet, dataSet)
 {
   // Nothing else to do.
 }
 
-template<typename MetricType, typename TreeType>
+template<typename MetricType, typename TreeType, typename UnionFindType>
 inline force_inline
-double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
-                                                const size_t referenceIndex)
+double DTBRules<MetricType, TreeType, UnionFindType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
 {
   // Check if the points are in the same component at this iteration.
   // If not, return the distance between them.  Also, store a better result as
@@ -56,6 +60,11 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
     ++baseCases;
     double distance = metric.Evaluate(dataSet.col(queryIndex),
                                       dataSet.col(referenceIndex));
+    if (coreDistances.n_elem > 0)
+    {
+      distance = std::max(distance, std::max(coreDistances[queryIndex],
+          coreDistances[referenceIndex]));
+    }
 
     if (distance < neighborsDistances[queryComponentIndex])
     {
@@ -75,9 +84,48 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   return newUpperBound;
 }
 
-template<typename MetricType, typename TreeType>
-double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
-                                             TreeType& referenceNode)
+template<typename MetricType, typename TreeType, typename UnionFindType>
+void DTBRules<MetricType, TreeType, UnionFindType>::BlockBaseCase(
+    const arma::uvec& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  if (!distanceTile.Enabled())
+  {
+    for (size_t i = 0; i < queryIndices.n_elem; ++i)
+      for (size_t j = 0; j < referenceCount; ++j)
+        BaseCase(queryIndices[i], referenceBegin + j);
+    return;
+  }
+
+  arma::mat lower, upper;
+  distanceTile.Bounds(queryIndices, referenceBegin, referenceCount, lower,
+      upper);
+
+  for (size_t i = 0; i < queryIndices.n_elem; ++i)
+  {
+    const size_t queryIndex = queryIndices[i];
+    const size_t queryComponentIndex = connections.Find(queryIndex);
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      const size_t referenceIndex = referenceBegin + j;
+      if (connections.Find(referenceIndex) == queryComponentIndex)
+        continue;
+
+      // A pair can only be used if it may be shorter than the current
+      // candidate edge of the query's component.
+      if (lower(i, j) >= neighborsDistances[queryComponentIndex])
+        ++baseCases;
+      else
+        BaseCase(queryIndex, referenceIndex);
+    }
+  }
+}
+
+template<typename MetricType, typename TreeType, typename UnionFindType>
+double DTBRules<MetricType, TreeType, UnionFindType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   size_t queryComponentIndex = connections.Find(queryIndex);
 
@@ -89,7 +137,11 @@ double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
     return DBL_MAX;
 
   const arma::vec queryPoint = dataSet.unsafe_col(queryIndex);
-  const double distance = referenceNode.MinDistance(queryPoint);
+  double distance = referenceNode.MinDistance(queryPoint);
+
+  // No edge from the query can be shorter than its core distance.
+  if (coreDistances.n_elem > 0)
+    distance = std::max(distance, coreDistances[queryIndex]);
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
@@ -97,10 +149,11 @@ double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
       ? DBL_MAX : distance;
 }
 
-template<typename MetricType, typename TreeType>
-double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
-                                               TreeType& /* referenceNode */,
-                                               const double oldScore)
+template<typename MetricType, typename TreeType, typename UnionFindType>
+double DTBRules<MetricType, TreeType, UnionFindType>::Rescore(
+    const size_t queryIndex,
+    TreeType& /* referenceNode */,
+    const double oldScore)
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
@@ -108,9 +161,10 @@ double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
       ? DBL_MAX : oldScore;
 }
 
-template<typename MetricType, typename TreeType>
-double DTBRules<MetricType, TreeType>::Score(TreeType& queryNode,
-                                             TreeType& referenceNode)
+template<typename MetricType, typename TreeType, typename UnionFindType>
+double DTBRules<MetricType, TreeType, UnionFindType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
   // If all the queries belong to the same component as all the references
   // then we prune.
@@ -128,10 +182,11 @@ double DTBRules<MetricType, TreeType>::Score(TreeType& queryNode,
   return (bound < distance) ? DBL_MAX : distance;
 }
 
-template<typename MetricType, typename TreeType>
-double DTBRules<MetricType, TreeType>::Rescore(TreeType& queryNode,
-                                               TreeType& /* referenceNode */,
-                                               const double oldScore) const
+template<typename MetricType, typename TreeType, typename UnionFindType>
+double DTBRules<MetricType, TreeType, UnionFindType>::Rescore(
+    TreeType& queryNode,
+    TreeType& /* referenceNode */,
+    const double oldScore) const
 {
   const double bound = CalculateBound(queryNode);
   return (oldScore > bound) ? DBL_MAX : oldScore;
@@ -139,8 +194,8 @@ double DTBRules<MetricType, TreeType>::Rescore(TreeType& queryNode,
 
 // Calculate the bound for a given query node in its current state and update
 // it.
-template<typename MetricType, typename TreeType>
-inline double DTBRules<MetricType, TreeType>::CalculateBound(
+template<typename MetricType, typename TreeType, typename UnionFindType>
+inline double DTBRules<MetricType, TreeType, UnionFindType>::CalculateBound(
     TreeType& queryNode) const
 {
   double worstPointBound = -DBL_MAX;
@@ -16,7 +16,8 @@
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
-#include <boost/heap/priority_queue.hpp>
+#include <mlpack/methods/neighbor_search/candidate_arena.hpp>
+#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
 
 namespace mlpack {
 namespace fastmks {
@@ -134,30 +135,12 @@ class FastMKSRules
   //! The query dataset.
   const typename TreeType::Mat& querySet;
 
-  //! Candidate represents a possible candidate point (value, index).
-  typedef std::pair<double, size_t> Candidate;
-
-  //! Compare two candidates based on the value.
-  struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2) const
-    {
-      return c1.first > c2.first;
-    };
-  };
-
-  //! Use a min heap to represent the list of candidate points.
-  //! We will use a boost::heap::priority_queue instead of a std::priority_queue
-  //! because we need to iterate over all the candidates and std::priority_queue
-  //! doesn't provide that interface.
-  typedef boost::heap::priority_queue<Candidate,
-      boost::heap::compare<CandidateCmp>> CandidateList;
-
-  //! Set of candidates for each point.
-  std::vector<CandidateList> candidates;
-
   //! Number of points to search for.
   const size_t k;
 
+  //! Set of candidates for each point, sorted by decreasing kernel value.
+  neighbor::CandidateArena<neighbor::FurthestNeighborSort> candidates;
+
   //! Cached query set self-kernels (|| q || for each q).
   arma::vec queryKernels;
   //! Cached reference set self-kernels (|| r || for each r).
@@ -27,6 +27,7 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
+    candidates(k, querySet.n_cols, -DBL_MAX),
     kernel(kernel),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
@@ -49,19 +50,6 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
   // dereference null pointers.
   traversalInfo.LastQueryNode() = (TreeType*) this;
   traversalInfo.LastReferenceNode() = (TreeType*) this;
-
-  // Let's build the list of candidate points for each query point.
-  // It will be initialized with k candidates: (-DBL_MAX, size_t() - 1)
-  // The list of candidates will be updated when visiting new points with the
-  // BaseCase() method.
-  const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-
-  CandidateList pqueue;
-  pqueue.reserve(k);
-  for (size_t i = 0; i < k; ++i)
-    pqueue.push(def);
-  std::vector<CandidateList> tmp(querySet.n_cols, pqueue);
-  candidates.swap(tmp);
 }
 
 template<typename KernelType, typename TreeType>
@@ -69,19 +57,7 @@ void FastMKSRules<KernelType, TreeType>::GetResults(
     arma::Mat<size_t>& indices,
     arma::mat& products)
 {
-  indices.set_size(k, querySet.n_cols);
-  products.set_size(k, querySet.n_cols);
-
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-  {
-    CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; ++j)
-    {
-      indices(k - j, i) = pqueue.top().second;
-      products(k - j, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-  }
+  candidates.GetResults(indices, products);
 }
 
 template<typename KernelType, typename TreeType>
@@ -129,7 +105,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
                                                  TreeType& referenceNode)
 {
   // Compare with the current best.
-  const double bestKernel = candidates[queryIndex].top().first;
+  const double bestKernel = candidates.WorstDistance(queryIndex);
 
   // See if we can perform a parent-child prune.
   const double furthestDist = referenceNode.FurthestDescendantDistance();
@@ -412,7 +388,7 @@ double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
                                                    TreeType& /*referenceNode*/,
                                                    const double oldScore) const
 {
-  const double bestKernel = candidates[queryIndex].top().first;
+  const double bestKernel = candidates.WorstDistance(queryIndex);
 
   return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
 }
@@ -459,11 +435,11 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t point = queryNode.Point(i);
-    const CandidateList& candidatesPoints = candidates[point];
-    if (candidatesPoints.top().first < worstPointKernel)
-      worstPointKernel = candidatesPoints.top().first;
+    const double pointKernel = candidates.WorstDistance(point);
+    if (pointKernel < worstPointKernel)
+      worstPointKernel = pointKernel;
 
-    if (candidatesPoints.top().first == -DBL_MAX)
+    if (pointKernel == -DBL_MAX)
       continue; // Avoid underflow.
 
     // This should be (queryDescendantDistance + centroidDistance) for any tree
@@ -478,11 +454,12 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
     // where p_j^*(p_q) is the j'th kernel candidate for query point p_q and
     // k_j^*(p_q) is K(p_q, p_j^*(p_q)).
     double worstPointCandidateKernel = DBL_MAX;
-    typedef typename CandidateList::const_iterator iter;
-    for (iter it = candidatesPoints.begin(); it != candidatesPoints.end(); ++it)
+    const double* candidateKernels = candidates.Distances().colptr(point);
+    const size_t* candidateIndices = candidates.Indices().colptr(point);
+    for (size_t j = 0; j < k; ++j)
     {
-      const double candidateKernel = it->first - queryDescendantDistance *
-          referenceKernels[it->second];
+      const double candidateKernel = candidateKernels[j] -
+          queryDescendantDistance * referenceKernels[candidateIndices[j]];
       if (candidateKernel < worstPointCandidateKernel)
         worstPointCandidateKernel = candidateKernel;
     }
@@ -529,13 +506,7 @@ inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
     const size_t index,
     const double product)
 {
-  CandidateList& pqueue = candidates[queryIndex];
-  if (product > pqueue.top().first)
-  {
-    Candidate c = std::make_pair(product, index);
-    pqueue.pop();
-    pqueue.push(c);
-  }
+  candidates.Insert(queryIndex, index, product);
 }
 
 } // namespace fastmks
@@ -0,0 +1,174 @@
+/**
+ * @file methods/hdbscan/hdbscan.hpp
+ *
+ * An implementation of the HDBSCAN hierarchical density-based clustering
+ * method, built on the dual-tree Boruvka minimum spanning tree algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+#include <mlpack/methods/emst/union_find.hpp>
+
+namespace mlpack {
+namespace hdbscan /** Hierarchical density-based clustering. */ {
+
+/**
+ * HDBSCAN (Hierarchical DBSCAN) is a clustering technique described in the
+ * following paper:
+ *
+ * @code
+ * @inproceedings{campello2013density,
+ *   title={Density-based clustering based on hierarchical density
+ *       estimates},
+ *   author={Campello, R.J.G.B. and Moulavi, D. and Sander, J.},
+ *   booktitle={Pacific-Asia Conference on Knowledge Discovery and Data Mining
+ *       (PAKDD 2013)},
+ *   pages={160--172},
+ *   year={2013}
+ * }
+ * @endcode
+ *
+ * Unlike DBSCAN, HDBSCAN does not need a radius: it considers the DBSCAN
+ * clusterings for all radii at once, and picks the clusters that persist over
+ * the widest range of densities, so it can find clusters of different
+ * densities in the same dataset.  The algorithm proceeds as follows:
+ *
+ *  - The core distance of each point, the distance to its (minPoints - 1)'th
+ *    nearest neighbor, is computed with NeighborSearch.
+ *  - The minimum spanning tree of the mutual reachability graph, in which the
+ *    edge between a and b has length max(d(a, b), core(a), core(b)), is
+ *    computed with DualTreeBoruvka.
+ *  - The spanning tree is turned into a single-linkage hierarchy, which is
+ *    condensed by only considering splits where both sides have at least
+ *    minClusterSize points as the birth of new clusters; smaller sides are
+ *    points that fall out of their cluster.
+ *  - The clusters with the largest total stability (excess of mass) are
+ *    selected, such that no selected cluster contains another.
+ *
+ * Points that do not belong to any selected cluster are considered noise.
+ *
+ * @tparam MetricType The metric to use.
+ * @tparam TreeType The type of tree to use for the nearest neighbor search and
+ *     the minimum spanning tree computation.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class HDBSCAN
+{
+ public:
+  /**
+   * Construct the HDBSCAN object with the given parameters.
+   *
+   * @param minClusterSize Minimum number of points in a cluster (at least 2).
+   * @param minPoints Number of points (including the point itself) that
+   *     define the core distance of a point.  If 0, minClusterSize is used.
+   * @param allowSingleCluster If true, the whole dataset may be returned as a
+   *     single cluster; otherwise, the root of the hierarchy is never
+   *     selected.
+   * @param naive If true, brute-force computation is used instead of trees.
+   */
+  HDBSCAN(const size_t minClusterSize,
+          const size_t minPoints = 0,
+          const bool allowSingleCluster = false,
+          const bool naive = false);
+
+  /**
+   * Performs HDBSCAN clustering on the data, returning the number of clusters
+   * and also the list of cluster assignments.  If assignments[i] == SIZE_MAX,
+   * then the point is considered "noise".
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   */
+  size_t Cluster(const arma::mat& data,
+                 arma::Row<size_t>& assignments);
+
+  /**
+   * Performs HDBSCAN clustering on the data, returning the number of clusters,
+   * the centroid of each cluster and also the list of cluster assignments.
+   * If assignments[i] == SIZE_MAX, then the point is considered "noise".
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   * @param centroids Matrix in which centroids are stored.
+   */
+  size_t Cluster(const arma::mat& data,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& centroids);
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinClusterSize() const { return minClusterSize; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinClusterSize() { return minClusterSize; }
+
+  //! Get the number of points that define the core distance (0 means
+  //! MinClusterSize()).
+  size_t MinPoints() const { return minPoints; }
+  //! Modify the number of points that define the core distance.
+  size_t& MinPoints() { return minPoints; }
+
+  //! Get whether the whole dataset may be a single cluster.
+  bool AllowSingleCluster() const { return allowSingleCluster; }
+  //! Modify whether the whole dataset may be a single cluster.
+  bool& AllowSingleCluster() { return allowSingleCluster; }
+
+  //! Get whether brute-force computation is used.
+  bool Naive() const { return naive; }
+  //! Modify whether brute-force computation is used.
+  bool& Naive() { return naive; }
+
+ private:
+  //! Minimum number of points in a cluster.
+  size_t minClusterSize;
+
+  //! Number of points that define the core distance (0 means
+  //! minClusterSize).
+  size_t minPoints;
+
+  //! Whether the whole dataset may be returned as a single cluster.
+  bool allowSingleCluster;
+
+  //! Whether brute-force computation is used.
+  bool naive;
+
+  /**
+   * Compute the core distance of every point: the distance to its
+   * (minPoints - 1)'th nearest neighbor.
+   *
+   * @param data Dataset.
+   * @param coreDistances Vector to store the core distances in.
+   */
+  void CoreDistances(const arma::mat& data, arma::vec& coreDistances) const;
+
+  /**
+   * Turn a minimum spanning tree into the condensed cluster hierarchy, and
+   * select the most stable clusters.
+   *
+   * @param mst Minimum spanning tree, as returned by DualTreeBoruvka (edges
+   *     sorted by increasing length).
+   * @param numPoints Number of points.
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  size_t ExtractClusters(const arma::mat& mst,
+                         const size_t numPoints,
+                         arma::Row<size_t>& assignments) const;
+};
+
+} // namespace hdbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "hdbscan_impl.hpp"
+
+#endif
@@ -0,0 +1,297 @@
+/**
+ * @file methods/hdbscan/hdbscan_impl.hpp
+ *
+ * Implementation of HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+
+#include "hdbscan.hpp"
+
+namespace mlpack {
+namespace hdbscan {
+
+/**
+ * Construct the HDBSCAN object with the given parameters.
+ */
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+HDBSCAN<MetricType, TreeType>::HDBSCAN(const size_t minClusterSize,
+                                       const size_t minPoints,
+                                       const bool allowSingleCluster,
+                                       const bool naive) :
+    minClusterSize(minClusterSize),
+    minPoints(minPoints),
+    allowSingleCluster(allowSingleCluster),
+    naive(naive)
+{
+  if (minClusterSize < 2)
+  {
+    throw std::invalid_argument("HDBSCAN::HDBSCAN(): minClusterSize must be "
+        "at least 2!");
+  }
+}
+
+/**
+ * Performs HDBSCAN clustering on the data, returning number of clusters,
+ * the centroid of each cluster and also the list of cluster assignments.
+ */
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, TreeType>::Cluster(const arma::mat& data,
+                                              arma::Row<size_t>& assignments,
+                                              arma::mat& centroids)
+{
+  const size_t numClusters = Cluster(data, assignments);
+
+  // Now calculate the centroids.
+  centroids.zeros(data.n_rows, numClusters);
+
+  arma::Row<size_t> counts;
+  counts.zeros(numClusters);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (assignments[i] != SIZE_MAX)
+    {
+      centroids.col(assignments[i]) += data.col(i);
+      ++counts[assignments[i]];
+    }
+  }
+
+  // Every selected cluster has at least minClusterSize points.
+  for (size_t i = 0; i < numClusters; ++i)
+    centroids.col(i) /= counts[i];
+
+  return numClusters;
+}
+
+/**
+ * Performs HDBSCAN clustering on the data, returning the number of clusters
+ * and also the list of cluster assignments.
+ */
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, TreeType>::Cluster(const arma::mat& data,
+                                              arma::Row<size_t>& assignments)
+{
+  // With fewer than two points there is no hierarchy, and a single point can
+  // never form a cluster.
+  if (data.n_cols < 2)
+  {
+    assignments.set_size(data.n_cols);
+    assignments.fill(SIZE_MAX);
+    return 0;
+  }
+
+  Log::Info << "Computing core distances." << std::endl;
+  arma::vec coreDistances;
+  CoreDistances(data, coreDistances);
+
+  Log::Info << "Computing minimum spanning tree of the mutual reachability "
+      << "graph." << std::endl;
+  emst::DualTreeBoruvka<MetricType, arma::mat, TreeType> dtb(data, naive);
+  arma::mat mst;
+  dtb.ComputeMST(mst, coreDistances);
+
+  const size_t numClusters = ExtractClusters(mst, data.n_cols, assignments);
+
+  Log::Info << numClusters << " clusters found." << std::endl;
+
+  return numClusters;
+}
+
+/**
+ * Compute the core distance of every point.
+ */
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void HDBSCAN<MetricType, TreeType>::CoreDistances(
+    const arma::mat& data,
+    arma::vec& coreDistances) const
+{
+  // The point itself counts as the first of the minPoints points, and the
+  // monochromatic search does not return it.
+  const size_t points = (minPoints == 0) ? minClusterSize : minPoints;
+  const size_t k = std::min(points - 1, (size_t) data.n_cols - 1);
+  if (k == 0)
+  {
+    coreDistances.zeros(data.n_cols);
+    return;
+  }
+
+  typedef neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType,
+      arma::mat, TreeType> KNNType;
+  KNNType knn(data, naive ? neighbor::NAIVE_MODE : neighbor::DUAL_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(k, neighbors, distances);
+
+  coreDistances = distances.row(k - 1).t();
+}
+
+/**
+ * Turn a minimum spanning tree into the condensed cluster hierarchy, and
+ * select the most stable clusters.
+ */
+template<typename MetricType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, TreeType>::ExtractClusters(
+    const arma::mat& mst,
+    const size_t numPoints,
+    arma::Row<size_t>& assignments) const
+{
+  // Build the single-linkage hierarchy: the points are nodes 0, ...,
+  // numPoints - 1, and merging the components joined by the i'th (shortest)
+  // edge creates node numPoints + i.
+  const size_t numMerges = numPoints - 1;
+  arma::Col<size_t> left(numMerges), right(numMerges);
+  arma::Col<size_t> sizes(numPoints + numMerges);
+  sizes.subvec(0, numPoints - 1).fill(1);
+
+  emst::UnionFind components(numPoints);
+  arma::Col<size_t> componentNode = arma::regspace<arma::Col<size_t>>(0,
+      numPoints - 1);
+  for (size_t i = 0; i < numMerges; ++i)
+  {
+    const size_t a = components.Find((size_t) mst(0, i));
+    const size_t b = components.Find((size_t) mst(1, i));
+
+    left[i] = componentNode[a];
+    right[i] = componentNode[b];
+    sizes[numPoints + i] = sizes[left[i]] + sizes[right[i]];
+
+    components.Union(a, b);
+    componentNode[components.Find(a)] = numPoints + i;
+  }
+
+  // Condense the hierarchy, walking down from the root.  A merge where both
+  // sides have at least minClusterSize points is the birth of two new
+  // clusters; otherwise the larger side (if large enough) continues the
+  // current cluster, and the points of the smaller sides fall out of it.  Each
+  // cluster's stability is the sum, over its points, of the difference
+  // between the density (1 / distance) at which the point leaves the cluster
+  // and the density at which the cluster was born.
+  std::vector<size_t> clusterParent(1, SIZE_MAX);
+  std::vector<double> clusterBirth(1, 0.0);
+  std::vector<double> stability(1, 0.0);
+  arma::Col<size_t> pointCluster(numPoints);
+
+  std::vector<std::pair<size_t, size_t>> stack;
+  stack.push_back(std::make_pair(numPoints + numMerges - 1, 0));
+  std::vector<size_t> subtree;
+  while (!stack.empty())
+  {
+    const size_t node = stack.back().first;
+    const size_t cluster = stack.back().second;
+    stack.pop_back();
+
+    const size_t merge = node - numPoints;
+    const double distance = mst(2, merge);
+    const double lambda = (distance > 0.0) ? 1.0 / distance : DBL_MAX;
+
+    const size_t children[2] = { left[merge], right[merge] };
+    const bool split = (sizes[children[0]] >= minClusterSize) &&
+        (sizes[children[1]] >= minClusterSize);
+    for (size_t c = 0; c < 2; ++c)
+    {
+      const size_t child = children[c];
+      if (split)
+      {
+        stability[cluster] += (lambda - clusterBirth[cluster]) * sizes[child];
+
+        clusterParent.push_back(cluster);
+        clusterBirth.push_back(lambda);
+        stability.push_back(0.0);
+        stack.push_back(std::make_pair(child, clusterParent.size() - 1));
+      }
+      else if (sizes[child] >= minClusterSize)
+      {
+        stack.push_back(std::make_pair(child, cluster));
+      }
+      else
+      {
+        stability[cluster] += (lambda - clusterBirth[cluster]) * sizes[child];
+
+        // All points below this child fall out of the cluster.
+        subtree.push_back(child);
+        while (!subtree.empty())
+        {
+          const size_t n = subtree.back();
+          subtree.pop_back();
+          if (n < numPoints)
+          {
+            pointCluster[n] = cluster;
+          }
+          else
+          {
+            subtree.push_back(left[n - numPoints]);
+            subtree.push_back(right[n - numPoints]);
+          }
+        }
+      }
+    }
+  }
+
+  // Select the clusters bottom-up: a cluster is selected if it is at least as
+  // stable as its selected descendants together.  Children always have larger
+  // indices than their parents.
+  const size_t numClusters = clusterParent.size();
+  std::vector<double> childStability(numClusters, 0.0);
+  std::vector<char> hasChildren(numClusters, 0);
+  std::vector<char> selected(numClusters, 0);
+  for (size_t c = numClusters - 1; c > 0; --c)
+  {
+    if (hasChildren[c] && childStability[c] > stability[c])
+      stability[c] = childStability[c];
+    else
+      selected[c] = 1;
+
+    childStability[clusterParent[c]] += stability[c];
+    hasChildren[clusterParent[c]] = 1;
+  }
+
+  if (allowSingleCluster)
+    selected[0] = !hasChildren[0] || (stability[0] >= childStability[0]);
+
+  // Number the selected clusters top-down, and give every other cluster the
+  // label of its selected ancestor, if any.  Descendants of a selected
+  // cluster are not selected themselves.
+  std::vector<size_t> clusterLabel(numClusters, SIZE_MAX);
+  size_t numLabels = 0;
+  for (size_t c = 0; c < numClusters; ++c)
+  {
+    const size_t parentLabel = (c == 0) ? SIZE_MAX :
+        clusterLabel[clusterParent[c]];
+    if (parentLabel != SIZE_MAX)
+      clusterLabel[c] = parentLabel;
+    else if (selected[c])
+      clusterLabel[c] = numLabels++;
+  }
+
+  assignments.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    assignments[i] = clusterLabel[pointCluster[i]];
+
+  return numLabels;
+}
+
+} // namespace hdbscan
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file methods/hdbscan/hdbscan_main.cpp
+ *
+ * Implementation of program to run HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include "hdbscan.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+using namespace mlpack::metric;
+using namespace mlpack::tree;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_NAME("HDBSCAN clustering");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of HDBSCAN clustering.  Given a dataset, this can "
+    "compute and return a clustering of that dataset, without a radius "
+    "parameter.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program implements the HDBSCAN (hierarchical DBSCAN) algorithm for "
+    "clustering.  Unlike DBSCAN, no search radius is needed: the clusters "
+    "that are stable over the widest range of densities are chosen, so that "
+    "clusters of different densities can be found in the same dataset.  The "
+    "minimum spanning tree of the mutual reachability graph is computed with "
+    "the dual-tree Boruvka algorithm."
+    "\n\n"
+    "The input dataset to be clustered may be specified with the " +
+    PRINT_PARAM_STRING("input") + " parameter; the minimum number of points "
+    "in a cluster may be specified with the " +
+    PRINT_PARAM_STRING("min_cluster_size") + " parameter, and the number of "
+    "neighbors (including the point itself) that define the density around "
+    "each point may be specified with the " +
+    PRINT_PARAM_STRING("min_samples") + " parameter (if it is 0, the value of "
+    + PRINT_PARAM_STRING("min_cluster_size") + " is used).  If " +
+    PRINT_PARAM_STRING("allow_single_cluster") + " is specified, the whole "
+    "dataset may be returned as a single cluster."
+    "\n\n"
+    "The " + PRINT_PARAM_STRING("assignments") + " and " +
+    PRINT_PARAM_STRING("centroids") + " output parameters may be "
+    "used to save the output of the clustering. " +
+    PRINT_PARAM_STRING("assignments") + " contains the cluster assignments of "
+    "each point (noise points are given the largest representable value), and "
+    + PRINT_PARAM_STRING("centroids") + " contains the centroids of each "
+    "cluster."
+    "\n\n"
+    "The computation may be controlled with the " +
+    PRINT_PARAM_STRING("tree_type") + " and " + PRINT_PARAM_STRING("naive") +
+    " parameters.  " + PRINT_PARAM_STRING("tree_type") + " can be 'kd', "
+    "'ball' or 'cover', and " + PRINT_PARAM_STRING("naive") + " will force "
+    "brute-force computation.");
+
+// Example.
+BINDING_EXAMPLE(
+    "An example usage to run HDBSCAN on the dataset in " +
+    PRINT_DATASET("input") + " with a minimum cluster size of 10 is given "
+    "below:"
+    "\n\n" +
+    PRINT_CALL("hdbscan", "input", "input", "min_cluster_size", 10,
+        "assignments", "assignments"));
+
+// See also...
+BINDING_SEE_ALSO("@dbscan", "#dbscan");
+BINDING_SEE_ALSO("@emst", "#emst");
+BINDING_SEE_ALSO("Density-based clustering based on hierarchical density "
+        "estimates (pdf)",
+        "https://doi.org/10.1007/978-3-642-37456-2_14");
+BINDING_SEE_ALSO("mlpack::hdbscan::HDBSCAN class documentation",
+        "@doxygen/classmlpack_1_1hdbscan_1_1HDBSCAN.html");
+
+PARAM_MATRIX_IN_REQ("input", "Input dataset to cluster.", "i");
+PARAM_UROW_OUT("assignments", "Output matrix for assignments of each "
+    "point.", "a");
+PARAM_MATRIX_OUT("centroids", "Matrix to save output centroids to.", "C");
+
+PARAM_INT_IN("min_cluster_size", "Minimum number of points for a cluster.",
+    "m", 5);
+PARAM_INT_IN("min_samples", "Number of neighbors (including the point "
+    "itself) that define the core distance of a point; 0 means the value of "
+    "min_cluster_size.", "s", 0);
+PARAM_FLAG("allow_single_cluster", "If set, the whole dataset may be "
+    "returned as a single cluster.", "A");
+
+PARAM_STRING_IN("tree_type", "The type of tree to use ('kd', 'ball', "
+    "'cover').", "t", "kd");
+PARAM_FLAG("naive", "If set, brute-force computation (not tree-based) will "
+    "be used.", "N");
+
+// Actually run the clustering, and process the output.
+template<typename HDBSCANType>
+void RunHDBSCAN()
+{
+  arma::mat dataset = std::move(IO::GetParam<arma::mat>("input"));
+  arma::Row<size_t> assignments;
+
+  HDBSCANType h((size_t) IO::GetParam<int>("min_cluster_size"),
+      (size_t) IO::GetParam<int>("min_samples"),
+      IO::HasParam("allow_single_cluster"), IO::HasParam("naive"));
+
+  // If possible, avoid the overhead of calculating centroids.
+  if (IO::HasParam("centroids"))
+  {
+    arma::mat centroids;
+
+    h.Cluster(dataset, assignments, centroids);
+
+    IO::GetParam<arma::mat>("centroids") = std::move(centroids);
+  }
+  else
+  {
+    h.Cluster(dataset, assignments);
+  }
+
+  if (IO::HasParam("assignments"))
+    IO::GetParam<arma::Row<size_t>>("assignments") = std::move(assignments);
+}
+
+static void mlpackMain()
+{
+  RequireAtLeastOnePassed({ "assignments", "centroids" }, false,
+      "no output will be saved");
+
+  ReportIgnoredParam({{ "naive", true }}, "tree_type");
+
+  RequireParamInSet<string>("tree_type", { "kd", "ball", "cover" }, true,
+      "unknown tree type");
+
+  // A cluster needs at least two points.
+  RequireParamValue<int>("min_cluster_size", [](int x) { return x >= 2; },
+      true, "min_cluster_size must be at least 2");
+
+  RequireParamValue<int>("min_samples", [](int x) { return x >= 0; },
+      true, "min_samples must be non-negative");
+
+  const string treeType = IO::GetParam<string>("tree_type");
+  if (IO::HasParam("naive") || treeType == "kd")
+    RunHDBSCAN<HDBSCAN<EuclideanDistance, KDTree>>();
+  else if (treeType == "ball")
+    RunHDBSCAN<HDBSCAN<EuclideanDistance, BallTree>>();
+  else if (treeType == "cover")
+    RunHDBSCAN<HDBSCAN<EuclideanDistance, StandardCoverTree>>();
+}
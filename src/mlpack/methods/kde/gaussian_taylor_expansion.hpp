@@ -0,0 +1,252 @@
+/**
+ * @file methods/kde/gaussian_taylor_expansion.hpp
+ *
+ * Truncated Taylor expansion of the Gaussian kernel around the center of a set
+ * of points, as used by the improved fast Gauss transform.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_GAUSSIAN_TAYLOR_EXPANSION_HPP
+#define MLPACK_METHODS_KDE_GAUSSIAN_TAYLOR_EXPANSION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * The far-field expansion of the improved fast Gauss transform:
+ *
+ * @code
+ * @article{yang2005efficient,
+ *   title={Efficient kernel machines using the improved fast Gauss transform},
+ *   author={Yang, C. and Duraiswami, R. and Davis, L.S.},
+ *   journal={Advances in Neural Information Processing Systems},
+ *   volume={17},
+ *   pages={1561--1568},
+ *   year={2005}
+ * }
+ * @endcode
+ *
+ * With h = sqrt(2) * bandwidth, u = (q - c) / h and v = (x - c) / h for a
+ * query point q, a reference point x and a center c, the Gaussian kernel is
+ *
+ *   K(q, x) = exp(-|u|^2) exp(-|v|^2) exp(2 u^T v),
+ *
+ * and the last factor is expanded as the sum over the multi-indices alpha of
+ * (2^|alpha| / alpha!) u^alpha v^alpha.  Truncating the expansion at order p
+ * (that is, keeping the terms with |alpha| < p) separates query and reference
+ * points, so the sum of the kernel values of every point of a reference node
+ * is obtained from the moments of the node in O(terms) time per query point.
+ * The error of a single kernel value is at most
+ *
+ *   (2^p / p!) (|u| |v|)^p exp(-(|u| - |v|)^2).
+ *
+ * Terms are stored in graded order, so an expansion of order p is a prefix of
+ * any expansion of higher order.
+ */
+class GaussianTaylorExpansion
+{
+ public:
+  //! The largest order that will be considered for an expansion.
+  static constexpr size_t MaxOrder = 12;
+
+  /**
+   * Create the expansion for the given bandwidth and dimensionality.
+   *
+   * @param bandwidth Bandwidth of the Gaussian kernel.
+   * @param dimensionality Dimensionality of the points.
+   */
+  GaussianTaylorExpansion(const double bandwidth = 1.0,
+                          const size_t dimensionality = 0) :
+      scale(std::sqrt(2.0) * bandwidth),
+      dimensionality(dimensionality),
+      coefficientOrder(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Return the number of terms of an expansion of the given order: the number
+   * of monomials of degree less than the order.  This saturates at SIZE_MAX.
+   */
+  size_t NumTerms(const size_t order) const
+  {
+    // C(order - 1 + dimensionality, dimensionality), built up incrementally.
+    double terms = 1.0;
+    for (size_t k = 1; k < order; ++k)
+      terms = terms * (k + dimensionality) / k;
+
+    return (terms >= (double) SIZE_MAX) ? SIZE_MAX : (size_t) (terms + 0.5);
+  }
+
+  /**
+   * Return an upper bound on the error of a single kernel value, when a
+   * reference point at most the given radius away from the center is
+   * approximated with an expansion of the given order, for query points whose
+   * distance to the center is in the given range.
+   *
+   * @param order Order of the expansion.
+   * @param centerDistances Range of distances from the query points to the
+   *     center.
+   * @param radius Largest distance from a reference point to the center.
+   */
+  double ErrorBound(const size_t order,
+                    const math::Range& centerDistances,
+                    const double radius) const
+  {
+    const double a = centerDistances.Hi() / scale;
+    const double b = radius / scale;
+    const double gap = std::max(centerDistances.Lo() / scale - b, 0.0);
+
+    double bound = std::exp(-gap * gap);
+    for (size_t k = 1; k <= order; ++k)
+      bound *= 2.0 * a * b / k;
+
+    return bound;
+  }
+
+  /**
+   * Compute the moments of the given points around the given center, up to
+   * the given order, with the coefficients of the expansion included.
+   *
+   * @param node Node whose descendants are expanded.
+   * @param dataset Dataset holding the descendants of the node.
+   * @param center Center of the expansion.
+   * @param order Order of the expansion.
+   * @param moments Vector to store the moments in.
+   */
+  template<typename TreeType>
+  void Moments(TreeType& node,
+               const arma::mat& dataset,
+               const arma::vec& center,
+               const size_t order,
+               arma::vec& moments)
+  {
+    Coefficients(order);
+    const size_t terms = NumTerms(order);
+
+    moments.zeros(terms);
+    arma::vec monomials(terms);
+    for (size_t i = 0; i < node.NumDescendants(); ++i)
+    {
+      const arma::vec v = (dataset.col(node.Descendant(i)) - center) / scale;
+      Monomials(v, order, monomials);
+      moments += std::exp(-arma::dot(v, v)) * monomials;
+    }
+
+    moments %= coefficients.head(terms);
+  }
+
+  /**
+   * Evaluate the expansion with the given moments at a query point; this
+   * approximates the sum of the kernel values between the query point and
+   * each expanded point.
+   *
+   * @param moments Moments of the expanded points, from Moments(), of at
+   *     least the given order.
+   * @param center Center of the expansion.
+   * @param order Order of the expansion.
+   * @param query Query point.
+   */
+  double Evaluate(const arma::vec& moments,
+                  const arma::vec& center,
+                  const size_t order,
+                  const arma::vec& query)
+  {
+    const arma::vec u = (query - center) / scale;
+    Monomials(u, order, queryMonomials);
+    return std::exp(-arma::dot(u, u)) *
+        arma::dot(moments.head(queryMonomials.n_elem), queryMonomials);
+  }
+
+ private:
+  //! sqrt(2) times the bandwidth of the kernel.
+  double scale;
+
+  //! Dimensionality of the points.
+  size_t dimensionality;
+
+  //! The coefficients 2^|alpha| / alpha! of each term.
+  arma::vec coefficients;
+
+  //! The order that the coefficients were computed for.
+  size_t coefficientOrder;
+
+  //! Workspace for the monomials of query points.
+  arma::vec queryMonomials;
+
+  /**
+   * Compute the monomials of the given point up to the given order, in graded
+   * order: each monomial of degree k is the product of one of degree k - 1
+   * and a coordinate.  heads[i] is the first monomial of the previous degree
+   * that may be multiplied by coordinate i without creating duplicates.
+   */
+  void Monomials(const arma::vec& point,
+                 const size_t order,
+                 arma::vec& monomials) const
+  {
+    monomials.set_size(NumTerms(order));
+    monomials[0] = 1.0;
+
+    std::vector<size_t> heads(dimensionality, 0);
+    size_t t = 1;
+    for (size_t k = 1, tail = 1; k < order; ++k, tail = t)
+    {
+      for (size_t i = 0; i < dimensionality; ++i)
+      {
+        const size_t head = heads[i];
+        heads[i] = t;
+        for (size_t j = head; j < tail; ++j, ++t)
+          monomials[t] = point[i] * monomials[j];
+      }
+    }
+  }
+
+  /**
+   * Compute the coefficients of the terms up to the given order, in the same
+   * order as Monomials().  The coefficient of a term is twice the coefficient
+   * of the term it was built from, divided by the new power of the
+   * coordinate it was multiplied by.
+   */
+  void Coefficients(const size_t order)
+  {
+    if (order <= coefficientOrder)
+      return;
+
+    const size_t terms = NumTerms(order);
+    coefficients.set_size(terms);
+    std::vector<size_t> powers(terms);
+    coefficients[0] = 1.0;
+    powers[0] = 0;
+
+    // heads[dimensionality] bounds the monomials built from the last
+    // coordinate.
+    std::vector<size_t> heads(dimensionality + 1, 0);
+    heads[dimensionality] = SIZE_MAX;
+    size_t t = 1;
+    for (size_t k = 1, tail = 1; k < order; ++k, tail = t)
+    {
+      for (size_t i = 0; i < dimensionality; ++i)
+      {
+        const size_t head = heads[i];
+        heads[i] = t;
+        for (size_t j = head; j < tail; ++j, ++t)
+        {
+          // Monomials before heads[i + 1] were last multiplied by coordinate
+          // i, so they already contain it.
+          powers[t] = (j < heads[i + 1]) ? powers[j] + 1 : 1;
+          coefficients[t] = 2.0 * coefficients[j] / powers[t];
+        }
+      }
+    }
+
+    coefficientOrder = order;
+  }
+};
+
+} // namespace kde
+} // namespace mlpack
+
+#endif
@@ -55,6 +55,9 @@ struct KDEDefaultParams
 
   //! Monte Carlo break coefficient.
   static constexpr double mcBreakCoef = 0.4;
+
+  //! Whether to use Taylor expansions of the kernel when possible.
+  static constexpr bool seriesExpansion = false;
 };
 
 /**
@@ -64,6 +67,13 @@ struct KDEDefaultParams
  * This implementation performs this estimation using a tree-independent
  * dual-tree algorithm. Details about this algorithm are available in KDERules.
  *
+ * When the Gaussian kernel is used with the Euclidean distance, nodes can also
+ * be approximated with a truncated Taylor expansion of the kernel around their
+ * center (the improved fast Gauss transform; see GaussianTaylorExpansion).
+ * The order of each expansion is chosen so that the error tolerances are still
+ * met, so this mostly helps with small bandwidths and large reference sets,
+ * where the kernel varies too much over a node to prune it otherwise.
+ *
  * @tparam KernelType Kernel function to use for KDE calculations.
  * @tparam MetricType Metric to use for KDE calculations.
  * @tparam MatType Type of data to use.
@@ -110,6 +120,9 @@ class KDE
    * @param mcBreakCoef Coefficient to control what fraction of the node's
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
+   * @param seriesExpansion Whether to use Taylor expansions of the kernel
+   *                        when possible (Gaussian kernel and Euclidean
+   *                        distance only).
    */
   KDE(const double relError = KDEDefaultParams::relError,
       const double absError = KDEDefaultParams::absError,
@@ -120,7 +133,8 @@ class KDE
       const double mcProb = KDEDefaultParams::mcProb,
       const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
       const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-      const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+      const double mcBreakCoef = KDEDefaultParams::mcBreakCoef,
+      const bool seriesExpansion = KDEDefaultParams::seriesExpansion);
 
   /**
    * Construct KDE object as a copy of the given model. This may be
@@ -173,6 +187,30 @@ class KDE
    */
   void Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences);
 
+  /**
+   * Add points to the reference set of a trained model, without rebuilding
+   * the reference tree.  The new points are put in a separate small tree;
+   * whenever a tree is at least as large as the tree added before it, the two
+   * are merged, so that there are only a logarithmic number of added trees and
+   * each point is part of a logarithmic number of rebuilds.  Once the added
+   * points outnumber the points of the reference tree, all the trees are
+   * rebuilt into one (unless the reference tree was given by the user, in
+   * which case it is never modified).
+   *
+   * The error tolerances are split between the trees in proportion to their
+   * size, and the probability of failure of Monte Carlo estimations evenly,
+   * so the guarantees hold for the whole reference set.
+   *
+   * The added points follow the original reference points, in the order they
+   * were added, in the results of the monochromatic Evaluate().  If the model
+   * is not trained yet, this is the same as Train().
+   *
+   * - Use std::move if the new points are no longer needed.
+   *
+   * @param newPoints Points to add to the reference set.
+   */
+  void AddReferencePoints(MatType newPoints);
+
   /**
    * Estimate density of each point in the query set given the data of the
    * reference set. The result is stored in an estimations vector.
@@ -235,6 +273,13 @@ class KDE
   //! Get the reference tree.
   Tree* ReferenceTree() { return referenceTree; }
 
+  //! Get the trees holding the points added with AddReferencePoints() that
+  //! have not been merged into the reference tree yet, oldest first.
+  const std::vector<Tree*>& AddedTrees() const { return addedTrees; }
+
+  //! Get the total number of reference points, including the added ones.
+  size_t NumReferencePoints() const;
+
   //! Get relative error tolerance.
   double RelativeError() const { return relError; }
 
@@ -290,6 +335,12 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get whether Taylor expansions of the kernel are being used or not.
+  bool SeriesExpansion() const { return seriesExpansion; }
+
+  //! Modify whether Taylor expansions of the kernel are being used or not.
+  bool& SeriesExpansion() { return seriesExpansion; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version);
@@ -307,6 +358,14 @@ class KDE
   //! Permutations of reference points.
   std::vector<size_t>* oldFromNewReferences;
 
+  //! Trees built on points added with AddReferencePoints(), oldest first.
+  //! Their sizes are strictly decreasing.  These are always owned by the
+  //! model.
+  std::vector<Tree*> addedTrees;
+
+  //! Permutations of the points of each added tree.
+  std::vector<std::vector<size_t>> addedOldFromNew;
+
   //! Relative error tolerance.
   double relError;
 
@@ -341,12 +400,60 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! If true Taylor expansions of the kernel will be used when possible.
+  bool seriesExpansion;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Delete the added trees.
+  void ClearAddedTrees();
+
+  //! Get the points of a tree in their original order.
+  static MatType OriginalDataset(const Tree& tree,
+                                 const std::vector<size_t>* oldFromNew);
+
+  /**
+   * Add the (unnormalized) contributions of the points of a reference tree to
+   * the estimations of the points of a query tree, with a dual-tree
+   * traversal.
+   *
+   * @param queryTree Tree of the query points.
+   * @param referenceTree Tree of the reference points.
+   * @param estimations Estimations of the query points, in the order of the
+   *     query tree dataset.
+   * @param sameSet Whether both trees are the same.
+   * @param scores Incremented by the number of scores.
+   * @param baseCases Incremented by the number of base cases.
+   */
+  void DualTreeEvaluate(Tree* queryTree,
+                        Tree* referenceTree,
+                        arma::vec& estimations,
+                        const bool sameSet,
+                        size_t& scores,
+                        size_t& baseCases);
+
+  /**
+   * Add the (unnormalized) contributions of the points of a reference tree to
+   * the estimations of the query points, with single-tree traversals.
+   *
+   * @param querySet Query points.
+   * @param referenceTree Tree of the reference points.
+   * @param estimations Estimations of the query points.
+   * @param sameSet Whether the query points are the reference tree dataset.
+   * @param scores Incremented by the number of scores.
+   * @param baseCases Incremented by the number of base cases.
+   */
+  void SingleTreeEvaluate(const MatType& querySet,
+                          Tree* referenceTree,
+                          arma::vec& estimations,
+                          const bool sameSet,
+                          size_t& scores,
+                          size_t& baseCases);
 };
 
 } // namespace kde
@@ -377,7 +484,7 @@ struct version<mlpack::kde::KDE<KernelType,
                                 DualTreeTraversalType,
                                 SingleTreeTraversalType>>
 {
-  typedef mpl::int_<1> type;
+  typedef mpl::int_<3> type;
   typedef mpl::integral_c_tag tag;
   BOOST_STATIC_CONSTANT(int, value = version::type::value);
   BOOST_MPL_ASSERT((boost::mpl::less<boost::mpl::int_<1>,
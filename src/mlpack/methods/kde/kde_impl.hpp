@@ -61,7 +61,8 @@ KDE(const double relError,
     const double mcProb,
     const size_t initialSampleSize,
     const double mcEntryCoef,
-    const double mcBreakCoef) :
+    const double mcBreakCoef,
+    const bool seriesExpansion) :
     kernel(kernel),
     metric(metric),
     referenceTree(nullptr),
@@ -72,7 +73,8 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    seriesExpansion(seriesExpansion)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -106,7 +108,8 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    seriesExpansion(other.seriesExpansion)
 {
   if (trained)
   {
@@ -122,6 +125,11 @@ KDE(const KDE& other) :
       referenceTree = other.referenceTree;
     }
   }
+
+  // Added trees are always owned.
+  addedOldFromNew = other.addedOldFromNew;
+  for (size_t i = 0; i < other.addedTrees.size(); ++i)
+    addedTrees.push_back(new Tree(*other.addedTrees[i]));
 }
 
 template<typename KernelType,
@@ -143,6 +151,8 @@ KDE(KDE&& other) :
     metric(std::move(other.metric)),
     referenceTree(other.referenceTree),
     oldFromNewReferences(other.oldFromNewReferences),
+    addedTrees(std::move(other.addedTrees)),
+    addedOldFromNew(std::move(other.addedOldFromNew)),
     relError(other.relError),
     absError(other.absError),
     ownsReferenceTree(other.ownsReferenceTree),
@@ -152,12 +162,15 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    seriesExpansion(other.seriesExpansion)
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
   other.referenceTree = nullptr;
   other.oldFromNewReferences = nullptr;
+  other.addedTrees.clear();
+  other.addedOldFromNew.clear();
   other.relError = KDEDefaultParams::relError;
   other.absError = KDEDefaultParams::absError;
   other.ownsReferenceTree = false;
@@ -168,6 +181,7 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.seriesExpansion = KDEDefaultParams::seriesExpansion;
 }
 
 template<typename KernelType,
@@ -198,12 +212,16 @@ operator=(KDE other)
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  ClearAddedTrees();
 
   // Move the other object.
   this->kernel = std::move(other.kernel);
   this->metric = std::move(other.metric);
   this->referenceTree = std::move(other.referenceTree);
   this->oldFromNewReferences = std::move(other.oldFromNewReferences);
+  this->addedTrees = std::move(other.addedTrees);
+  this->addedOldFromNew = std::move(other.addedOldFromNew);
+  other.addedTrees.clear();
   this->relError = other.relError;
   this->absError = other.absError;
   this->ownsReferenceTree = other.ownsReferenceTree;
@@ -214,6 +232,7 @@ operator=(KDE other)
   this->initialSampleSize = other.initialSampleSize;
   this->mcEntryCoef = other.mcEntryCoef;
   this->mcBreakCoef = other.mcBreakCoef;
+  this->seriesExpansion = other.seriesExpansion;
 
   return *this;
 }
@@ -239,6 +258,7 @@ KDE<KernelType,
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  ClearAddedTrees();
 }
 
 template<typename KernelType,
@@ -269,6 +289,7 @@ Train(MatType referenceSet)
     delete referenceTree;
     delete oldFromNewReferences;
   }
+  ClearAddedTrees();
 
   this->ownsReferenceTree = true;
   Timer::Start("building_reference_tree");
@@ -307,6 +328,7 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
     delete this->referenceTree;
     delete this->oldFromNewReferences;
   }
+  ClearAddedTrees();
 
   this->ownsReferenceTree = false;
   this->referenceTree = referenceTree;
@@ -314,6 +336,107 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
   this->trained = true;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+AddReferencePoints(MatType newPoints)
+{
+  if (!trained)
+  {
+    Train(std::move(newPoints));
+    return;
+  }
+
+  if (newPoints.n_cols == 0)
+    return;
+
+  if (newPoints.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot add points to KDE model: new points "
+                                "and referenceSet dimensions don't match");
+  }
+
+  Timer::Start("building_reference_tree");
+  addedOldFromNew.push_back(std::vector<size_t>());
+  addedTrees.push_back(BuildTree<Tree>(std::move(newPoints),
+                                       addedOldFromNew.back()));
+
+  // Merge the newest trees while they are not smaller than the tree before
+  // them.  Merged points keep the order in which they were added.
+  while (addedTrees.size() > 1 &&
+         addedTrees[addedTrees.size() - 1]->Dataset().n_cols >=
+         addedTrees[addedTrees.size() - 2]->Dataset().n_cols)
+  {
+    const size_t last = addedTrees.size() - 1;
+    MatType merged = arma::join_rows(
+        OriginalDataset(*addedTrees[last - 1], &addedOldFromNew[last - 1]),
+        OriginalDataset(*addedTrees[last], &addedOldFromNew[last]));
+
+    delete addedTrees[last];
+    delete addedTrees[last - 1];
+    addedTrees.resize(last - 1);
+    addedOldFromNew.resize(last - 1);
+
+    addedOldFromNew.push_back(std::vector<size_t>());
+    addedTrees.push_back(BuildTree<Tree>(std::move(merged),
+                                         addedOldFromNew.back()));
+  }
+  Timer::Stop("building_reference_tree");
+
+  // If the added points outnumber the reference points, rebuild everything
+  // into a single tree.  A tree given by the user is never modified.
+  const size_t referencePoints = referenceTree->Dataset().n_cols;
+  if (ownsReferenceTree &&
+      NumReferencePoints() - referencePoints >= referencePoints)
+  {
+    MatType merged = OriginalDataset(*referenceTree, oldFromNewReferences);
+    for (size_t i = 0; i < addedTrees.size(); ++i)
+    {
+      merged = arma::join_rows(merged,
+          OriginalDataset(*addedTrees[i], &addedOldFromNew[i]));
+    }
+
+    Train(std::move(merged));
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+size_t KDE<KernelType,
+           MetricType,
+           MatType,
+           TreeType,
+           DualTreeTraversalType,
+           SingleTreeTraversalType>::
+NumReferencePoints() const
+{
+  if (!trained)
+    return 0;
+
+  size_t numPoints = referenceTree->Dataset().n_cols;
+  for (size_t i = 0; i < addedTrees.size(); ++i)
+    numPoints += addedTrees[i]->Dataset().n_cols;
+
+  return numPoints;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -379,36 +502,21 @@ Evaluate(MatType querySet, arma::vec& estimations)
 
     Timer::Start("computing_kde");
 
-    // Evaluate.
-    typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
-
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
-
-    // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    estimations /= referenceTree->Dataset().n_cols;
+    // Evaluate against the reference tree and every added tree.
+    size_t scores = 0, baseCases = 0;
+    SingleTreeEvaluate(querySet, referenceTree, estimations, false, scores,
+        baseCases);
+    for (size_t i = 0; i < addedTrees.size(); ++i)
+    {
+      SingleTreeEvaluate(querySet, addedTrees[i], estimations, false, scores,
+          baseCases);
+    }
+
+    estimations /= NumReferencePoints();
     Timer::Stop("computing_kde");
 
-    Log::Info << rules.Scores() << " node combinations were scored."
-              << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
-              << std::endl;
+    Log::Info << scores << " node combinations were scored." << std::endl;
+    Log::Info << baseCases << " base cases were calculated." << std::endl;
   }
 }
 
@@ -465,45 +573,26 @@ Evaluate(Tree* queryTree,
                                 "dual-tree");
   }
 
-  // Clean accumulated alpha if Monte Carlo estimations are available.
-  if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
-  {
-    Timer::Start("cleaning_query_tree");
-    KDECleanRules<Tree> cleanRules;
-    SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
-    cleanTraverser.Traverse(0, *queryTree);
-    Timer::Stop("cleaning_query_tree");
-  }
-
   Timer::Start("computing_kde");
 
-  // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            queryTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            false);
+  // Evaluate against the reference tree and every added tree.
+  size_t scores = 0, baseCases = 0;
+  DualTreeEvaluate(queryTree, referenceTree, estimations, false, scores,
+      baseCases);
+  for (size_t i = 0; i < addedTrees.size(); ++i)
+  {
+    DualTreeEvaluate(queryTree, addedTrees[i], estimations, false, scores,
+        baseCases);
+  }
 
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
-  estimations /= referenceTree->Dataset().n_cols;
+  estimations /= NumReferencePoints();
   Timer::Stop("computing_kde");
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -531,57 +620,63 @@ Evaluate(arma::vec& estimations)
 
   // Get estimations vector ready.
   estimations.clear();
-  estimations.set_size(referenceTree->Dataset().n_cols);
+  estimations.set_size(NumReferencePoints());
   estimations.fill(arma::fill::zeros);
 
-  // Clean accumulated alpha if Monte Carlo estimations are available.
-  if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
-  {
-    Timer::Start("cleaning_query_tree");
-    KDECleanRules<Tree> cleanRules;
-    SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
-    cleanTraverser.Traverse(0, *referenceTree);
-    Timer::Stop("cleaning_query_tree");
-  }
+  // The reference tree comes first, followed by the added trees.
+  std::vector<Tree*> trees(1, referenceTree);
+  trees.insert(trees.end(), addedTrees.begin(), addedTrees.end());
 
   Timer::Start("computing_kde");
+  size_t scores = 0, baseCases = 0, offset = 0;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    const size_t numPoints = trees[t]->Dataset().n_cols;
+    arma::vec treeEstimations(numPoints, arma::fill::zeros);
 
-  // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            referenceTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            true);
+    // The points of this tree are queries against every tree; a point is
+    // never evaluated against itself.
+    for (size_t r = 0; r < trees.size(); ++r)
+    {
+      if (mode == DUAL_TREE_MODE)
+      {
+        DualTreeEvaluate(trees[t], trees[r], treeEstimations, (t == r),
+            scores, baseCases);
+      }
+      else if (mode == SINGLE_TREE_MODE)
+      {
+        // Clean accumulated alpha if Monte Carlo estimations are available.
+        if (monteCarlo &&
+            std::is_same<KernelType, kernel::GaussianKernel>::value)
+        {
+          Timer::Start("cleaning_query_tree");
+          KDECleanRules<Tree> cleanRules;
+          SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(
+              cleanRules);
+          cleanTraverser.Traverse(0, *trees[r]);
+          Timer::Stop("cleaning_query_tree");
+        }
 
-  if (mode == DUAL_TREE_MODE)
-  {
-    // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
-    traverser.Traverse(*referenceTree, *referenceTree);
-  }
-  else if (mode == SINGLE_TREE_MODE)
-  {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+        SingleTreeEvaluate(trees[t]->Dataset(), trees[r], treeEstimations,
+            (t == r), scores, baseCases);
+      }
+    }
+
+    // Rearrange if necessary.
+    if (t == 0 && oldFromNewReferences)
+      RearrangeEstimations(*oldFromNewReferences, treeEstimations);
+    else if (t > 0)
+      RearrangeEstimations(addedOldFromNew[t - 1], treeEstimations);
+
+    estimations.subvec(offset, offset + numPoints - 1) = treeEstimations;
+    offset += numPoints;
   }
 
-  estimations /= referenceTree->Dataset().n_cols;
-  // Rearrange if necessary.
-  RearrangeEstimations(*oldFromNewReferences, estimations);
+  estimations /= NumReferencePoints();
   Timer::Stop("computing_kde");
 
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -739,6 +834,13 @@ serialize(Archive& ar, const unsigned int version)
     mcBreakCoef = KDEDefaultParams::mcBreakCoef;
   }
 
+  // Backward compatibility: Old versions of KDE did not use Taylor
+  // expansions.
+  if (version > 1)
+    ar & BOOST_SERIALIZATION_NVP(seriesExpansion);
+  else if (Archive::is_loading::value)
+    seriesExpansion = KDEDefaultParams::seriesExpansion;
+
   // If we are loading, clean up memory if necessary.
   if (Archive::is_loading::value)
   {
@@ -749,6 +851,8 @@ serialize(Archive& ar, const unsigned int version)
     }
     // After loading tree, we own it.
     ownsReferenceTree = true;
+
+    ClearAddedTrees();
   }
 
   // Serialize the rest of values.
@@ -756,6 +860,25 @@ serialize(Archive& ar, const unsigned int version)
   ar & BOOST_SERIALIZATION_NVP(metric);
   ar & BOOST_SERIALIZATION_NVP(referenceTree);
   ar & BOOST_SERIALIZATION_NVP(oldFromNewReferences);
+
+  // Backward compatibility: Old versions of KDE did not have added trees.
+  if (version > 2)
+  {
+    size_t numAddedTrees = addedTrees.size();
+    ar & BOOST_SERIALIZATION_NVP(numAddedTrees);
+    if (Archive::is_loading::value)
+    {
+      addedTrees.resize(numAddedTrees, nullptr);
+      addedOldFromNew.resize(numAddedTrees);
+    }
+
+    for (size_t i = 0; i < numAddedTrees; ++i)
+    {
+      ar & boost::serialization::make_nvp("addedTree", addedTrees[i]);
+      ar & boost::serialization::make_nvp("addedOldFromNew",
+          addedOldFromNew[i]);
+    }
+  }
 }
 
 template<typename KernelType,
@@ -816,5 +939,177 @@ RearrangeEstimations(const std::vector<size_t>& oldFromNew,
   }
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ClearAddedTrees()
+{
+  for (size_t i = 0; i < addedTrees.size(); ++i)
+    delete addedTrees[i];
+
+  addedTrees.clear();
+  addedOldFromNew.clear();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+MatType KDE<KernelType,
+            MetricType,
+            MatType,
+            TreeType,
+            DualTreeTraversalType,
+            SingleTreeTraversalType>::
+OriginalDataset(const Tree& tree, const std::vector<size_t>* oldFromNew)
+{
+  if (!tree::TreeTraits<Tree>::RearrangesDataset || !oldFromNew ||
+      oldFromNew->empty())
+    return tree.Dataset();
+
+  MatType original(tree.Dataset().n_rows, tree.Dataset().n_cols);
+  for (size_t i = 0; i < oldFromNew->size(); ++i)
+    original.col((*oldFromNew)[i]) = tree.Dataset().col(i);
+
+  return original;
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+DualTreeEvaluate(Tree* queryTree,
+                 Tree* referenceTree,
+                 arma::vec& estimations,
+                 const bool sameSet,
+                 size_t& scores,
+                 size_t& baseCases)
+{
+  // The absolute error tolerance is shared between all the reference points,
+  // whichever tree they are in.
+  const double treeAbsError = absError * referenceTree->Dataset().n_cols /
+      NumReferencePoints();
+
+  // The probability of failure of the Monte Carlo estimations is split evenly
+  // between the reference trees too, so that (by the union bound) mcProb holds
+  // for the whole reference set.
+  const double treeMCProb = 1.0 - (1.0 - mcProb) / (1 + addedTrees.size());
+
+  // Clean accumulated alpha if Monte Carlo estimations are available.
+  if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
+  {
+    Timer::Start("cleaning_query_tree");
+    KDECleanRules<Tree> cleanRules;
+    SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
+    cleanTraverser.Traverse(0, *queryTree);
+    Timer::Stop("cleaning_query_tree");
+  }
+
+  typedef KDERules<MetricType, KernelType, Tree> RuleType;
+  RuleType rules = RuleType(referenceTree->Dataset(),
+                            queryTree->Dataset(),
+                            estimations,
+                            relError,
+                            treeAbsError,
+                            treeMCProb,
+                            initialSampleSize,
+                            mcEntryCoef,
+                            mcBreakCoef,
+                            metric,
+                            kernel,
+                            monteCarlo,
+                            seriesExpansion,
+                            sameSet);
+
+  // Create traverser.
+  DualTreeTraversalType<RuleType> traverser(rules);
+  traverser.Traverse(*queryTree, *referenceTree);
+
+  scores += rules.Scores();
+  baseCases += rules.BaseCases();
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+SingleTreeEvaluate(const MatType& querySet,
+                   Tree* referenceTree,
+                   arma::vec& estimations,
+                   const bool sameSet,
+                   size_t& scores,
+                   size_t& baseCases)
+{
+  // The absolute error tolerance is shared between all the reference points,
+  // whichever tree they are in.
+  const double treeAbsError = absError * referenceTree->Dataset().n_cols /
+      NumReferencePoints();
+
+  // The probability of failure of the Monte Carlo estimations is split evenly
+  // between the reference trees too.
+  const double treeMCProb = 1.0 - (1.0 - mcProb) / (1 + addedTrees.size());
+
+  typedef KDERules<MetricType, KernelType, Tree> RuleType;
+  RuleType rules = RuleType(referenceTree->Dataset(),
+                            querySet,
+                            estimations,
+                            relError,
+                            treeAbsError,
+                            treeMCProb,
+                            initialSampleSize,
+                            mcEntryCoef,
+                            mcBreakCoef,
+                            metric,
+                            kernel,
+                            monteCarlo,
+                            seriesExpansion,
+                            sameSet);
+
+  // Create traverser.
+  SingleTreeTraversalType<RuleType> traverser(rules);
+
+  // Traverse for each point.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    traverser.Traverse(i, *referenceTree);
+
+  scores += rules.Scores();
+  baseCases += rules.BaseCases();
+}
+
 } // namespace kde
 } // namespace mlpack
@@ -114,7 +114,17 @@ BINDING_EXAMPLE(
         0.2, "kernel", "gaussian", "tree", "kd-tree", "rel_error",
         0.05, "predictions", "out_data", "monte_carlo", "", "mc_probability",
         0.95, "initial_sample_size", 200, "mc_entry_coef", 3.5, "mc_break_coef",
-        0.6));
+        0.6) +
+    "\n\n"
+    "With a Gaussian kernel, nodes may also be approximated with Taylor "
+    "expansions of the kernel (the improved fast Gauss transform) by "
+    "specifying " + PRINT_PARAM_STRING("series_expansion") + ".  This keeps "
+    "the error guarantees, and is mostly useful with small bandwidths and "
+    "large datasets.  The following example uses it:"
+    "\n\n" +
+    PRINT_CALL("kde", "reference", "ref_data", "query", "qu_data", "bandwidth",
+        0.05, "kernel", "gaussian", "rel_error", 0.05, "predictions",
+        "out_data", "series_expansion", ""));
 
 // See also...
 BINDING_SEE_ALSO("@knn", "#knn");
@@ -126,6 +136,9 @@ BINDING_SEE_ALSO("Fast High-dimensional Kernel Summations Using the Monte Carlo"
         " Multipole Method", "http://papers.nips.cc/paper/3539-fast-high-"
         "dimensional-kernel-summations-using-the-monte-carlo-multipole-method."
         "pdf");
+BINDING_SEE_ALSO("Efficient Kernel Machines Using the Improved Fast Gauss "
+        "Transform", "http://papers.nips.cc/paper/2550-efficient-kernel-"
+        "machines-using-the-improved-fast-gauss-transform.pdf");
 BINDING_SEE_ALSO("mlpack::kde::KDE C++ class documentation",
         "@doxygen/classmlpack_1_1kde_1_1KDE.html");
 
@@ -185,6 +198,9 @@ PARAM_DOUBLE_IN("mc_break_coef",
                 "the limit for the sample size before it recurses.",
                 "c",
                 KDEDefaultParams::mcBreakCoef);
+PARAM_FLAG("series_expansion",
+           "Whether to use Taylor expansions of the kernel when possible.",
+           "T");
 
 // Output predictions options.
 PARAM_COL_OUT("predictions", "Vector to store density predictions.",
@@ -206,6 +222,7 @@ static void mlpackMain()
   const int initialSampleSize = IO::GetParam<int>("initial_sample_size");
   const double mcEntryCoef = IO::GetParam<double>("mc_entry_coef");
   const double mcBreakCoef = IO::GetParam<double>("mc_break_coef");
+  const bool seriesExpansion = IO::GetParam<bool>("series_expansion");
 
   // Initialize results vector.
   arma::vec estimations;
@@ -225,6 +242,11 @@ static void mlpackMain()
     ReportIgnoredParam("monte_carlo",
                        "Monte Carlo only works with Gaussian kernel");
   }
+  if (seriesExpansion && kernelStr != "gaussian")
+  {
+    ReportIgnoredParam("series_expansion",
+                       "Taylor expansions only work with Gaussian kernel");
+  }
 
   // Requirements for parameter values.
   RequireParamInSet<string>("kernel", { "gaussian", "epanechnikov",
@@ -306,6 +328,7 @@ static void mlpackMain()
   kde->MCInitialSampleSize(initialSampleSize);
   kde->MCEntryCoefficient(mcEntryCoef);
   kde->MCBreakCoefficient(mcBreakCoef);
+  kde->SeriesExpansion(seriesExpansion);
 
   // Evaluation.
   if (IO::HasParam("query"))
@@ -171,6 +171,28 @@ class TrainVisitor : public boost::static_visitor<void>
   TrainVisitor(arma::mat&& referenceSet);
 };
 
+/**
+ * AddReferencePointsVisitor adds reference points to a trained KDEType.
+ */
+class AddReferencePointsVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! The points to add.
+  arma::mat&& newPoints;
+
+ public:
+  //! Default AddReferencePointsVisitor on some KDEType.
+  template<typename KernelType,
+           template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void operator()(KDEType<KernelType, TreeType>* kde) const;
+
+  //! AddReferencePointsVisitor constructor. Takes ownership of the given
+  //! points.
+  AddReferencePointsVisitor(arma::mat&& newPoints);
+};
+
 /**
  * BandwidthVisitor modifies the bandwidth of a KDEType kernel.
  */
@@ -340,6 +362,28 @@ class MCBreakCoefVisitor : public boost::static_visitor<void>
   MCBreakCoefVisitor(const double breakCoef);
 };
 
+/**
+ * SeriesExpansionVisitor activates or deactivates Taylor expansions of the
+ * kernel for a given KDEType.
+ */
+class SeriesExpansionVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! Whether to use Taylor expansions or not.
+  const bool seriesExpansion;
+
+ public:
+  //! Default SeriesExpansionVisitor on some KDEType.
+  template<typename KernelType,
+           template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void operator()(KDEType<KernelType, TreeType>* kde) const;
+
+  //! SeriesExpansionVisitor constructor.
+  SeriesExpansionVisitor(const bool seriesExpansion);
+};
+
 /**
  * ModeVisitor exposes the Mode() method of the KDEType.
  */
@@ -412,6 +456,9 @@ class KDEModel
   //! Break coefficient for Monte Carlo estimations.
   double mcBreakCoef;
 
+  //! Whether Taylor expansions of the kernel will be used.
+  bool seriesExpansion;
+
   /**
    * kdeModel holds an instance of each possible combination of KernelType and
    * TreeType. It is initialized using BuildModel.
@@ -466,6 +513,8 @@ class KDEModel
    * @param mcBreakCoef Coefficient to control what fraction of the node's
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
+   * @param seriesExpansion Whether to use Taylor expansions of the kernel when
+   *                        possible (Gaussian kernel only).
    */
   KDEModel(const double bandwidth = 1.0,
            const double relError = KDEDefaultParams::relError,
@@ -476,7 +525,8 @@ class KDEModel
            const double mcProb = KDEDefaultParams::mcProb,
            const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
            const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef,
+           const bool seriesExpansion = KDEDefaultParams::seriesExpansion);
 
   //! Copy constructor of the given model.
   KDEModel(const KDEModel& other);
@@ -560,6 +610,12 @@ class KDEModel
   //! Modify Monte Carlo break coefficient.
   void MCBreakCoefficient(const double newBreakCoef);
 
+  //! Get whether the model is using Taylor expansions or not.
+  bool SeriesExpansion() const { return seriesExpansion; }
+
+  //! Modify whether the model is using Taylor expansions or not.
+  void SeriesExpansion(const bool newSeriesExpansion);
+
   //! Get the mode of the model.
   KDEMode Mode() const;
 
@@ -576,6 +632,15 @@ class KDEModel
    */
   void BuildModel(arma::mat&& referenceSet);
 
+  /**
+   * Add points to the reference set of the model, without rebuilding the
+   * reference tree.  Takes possession of the points to avoid a copy, so they
+   * will not be usable after this.
+   *
+   * @param newPoints Set of points to add.
+   */
+  void AddReferencePoints(arma::mat&& newPoints);
+
   /**
    * Perform kernel density estimation on the given query set.
    * Takes possession of the query set to avoid a copy, so the query set
@@ -609,7 +674,7 @@ class KDEModel
 } // namespace mlpack
 
 //! Set the serialization version of the KDEModel class.
-BOOST_TEMPLATE_CLASS_VERSION(template<>, mlpack::kde::KDEModel, 1);
+BOOST_TEMPLATE_CLASS_VERSION(template<>, mlpack::kde::KDEModel, 2);
 
 #include "kde_model_impl.hpp"
 
@@ -30,7 +30,8 @@ inline KDEModel::KDEModel(const double bandwidth,
                           const double mcProb,
                           const size_t initialSampleSize,
                           const double mcEntryCoef,
-                          const double mcBreakCoef) :
+                          const double mcBreakCoef,
+                          const bool seriesExpansion) :
   bandwidth(bandwidth),
   relError(relError),
   absError(absError),
@@ -40,7 +41,8 @@ inline KDEModel::KDEModel(const double bandwidth,
   mcProb(mcProb),
   initialSampleSize(initialSampleSize),
   mcEntryCoef(mcEntryCoef),
-  mcBreakCoef(mcBreakCoef)
+  mcBreakCoef(mcBreakCoef),
+  seriesExpansion(seriesExpansion)
 {
   // Nothing to do.
 }
@@ -56,7 +58,8 @@ inline KDEModel::KDEModel(const KDEModel& other) :
   mcProb(other.mcProb),
   initialSampleSize(other.initialSampleSize),
   mcEntryCoef(other.mcEntryCoef),
-  mcBreakCoef(other.mcBreakCoef)
+  mcBreakCoef(other.mcBreakCoef),
+  seriesExpansion(other.seriesExpansion)
 {
   // Nothing to do.
 }
@@ -73,6 +76,7 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   initialSampleSize(other.initialSampleSize),
   mcEntryCoef(other.mcEntryCoef),
   mcBreakCoef(other.mcBreakCoef),
+  seriesExpansion(other.seriesExpansion),
   kdeModel(std::move(other.kdeModel))
 {
   // Reset other model.
@@ -86,6 +90,7 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.seriesExpansion = KDEDefaultParams::seriesExpansion;
   other.kdeModel = decltype(other.kdeModel)();
 }
 
@@ -102,6 +107,7 @@ inline KDEModel& KDEModel::operator=(KDEModel other)
   initialSampleSize = other.initialSampleSize;
   mcEntryCoef = other.mcEntryCoef;
   mcBreakCoef = other.mcBreakCoef;
+  seriesExpansion = other.seriesExpansion;
   kdeModel = std::move(other.kdeModel);
   return *this;
 }
@@ -264,11 +270,22 @@ inline void KDEModel::BuildModel(arma::mat&& referenceSet)
   MCBreakCoefVisitor breakCoefficientVisitor(mcBreakCoef);
   boost::apply_visitor(breakCoefficientVisitor, kdeModel);
 
+  // Set whether to use Taylor expansions or not.
+  SeriesExpansionVisitor seriesVisitor(seriesExpansion);
+  boost::apply_visitor(seriesVisitor, kdeModel);
+
   // Train the model.
   TrainVisitor train(std::move(referenceSet));
   boost::apply_visitor(train, kdeModel);
 }
 
+// Add reference points to the model.
+inline void KDEModel::AddReferencePoints(arma::mat&& newPoints)
+{
+  AddReferencePointsVisitor add(std::move(newPoints));
+  boost::apply_visitor(add, kdeModel);
+}
+
 // Perform bichromatic evaluation.
 inline void KDEModel::Evaluate(arma::mat&& querySet, arma::vec& estimations)
 {
@@ -363,6 +380,26 @@ void TrainVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
     throw std::runtime_error("no KDE model initialized");
 }
 
+// Add reference points.
+AddReferencePointsVisitor::AddReferencePointsVisitor(arma::mat&& newPoints) :
+    newPoints(std::move(newPoints))
+{}
+
+// Default add reference points.
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void AddReferencePointsVisitor::operator()(KDEType<KernelType, TreeType>* kde)
+    const
+{
+  Log::Info << "Adding reference points to KDE model..." << std::endl;
+  if (kde)
+    kde->AddReferencePoints(std::move(newPoints));
+  else
+    throw std::runtime_error("no KDE model initialized");
+}
+
 // Modify kernel bandwidth.
 BandwidthVisitor::BandwidthVisitor(const double bandwidth) :
     bandwidth(bandwidth)
@@ -507,6 +544,26 @@ void MCBreakCoefVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
     throw std::runtime_error("no KDE model initialized");
 }
 
+// Set whether to use Taylor expansions.
+inline SeriesExpansionVisitor::SeriesExpansionVisitor(
+    const bool seriesExpansion) :
+    seriesExpansion(seriesExpansion)
+{}
+
+// Use or not Taylor expansions.
+template<typename KernelType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void SeriesExpansionVisitor::operator()(KDEType<KernelType, TreeType>* kde)
+    const
+{
+  if (kde)
+    kde->SeriesExpansion() = seriesExpansion;
+  else
+    throw std::runtime_error("no KDE model initialized");
+}
+
 // Delete model.
 template<typename KDEType>
 void DeleteVisitor::operator()(KDEType* kde) const
@@ -566,6 +623,13 @@ void KDEModel::serialize(Archive& ar, const unsigned int version)
     mcBreakCoef = KDEDefaultParams::mcBreakCoef;
   }
 
+  // Backward compatibility: Old versions of KDEModel did not use Taylor
+  // expansions.
+  if (version > 1)
+    ar & BOOST_SERIALIZATION_NVP(seriesExpansion);
+  else if (Archive::is_loading::value)
+    seriesExpansion = KDEDefaultParams::seriesExpansion;
+
   if (Archive::is_loading::value)
     boost::apply_visitor(DeleteVisitor(), kdeModel);
 
@@ -636,6 +700,14 @@ void KDEModel::MCBreakCoefficient(const double newBreakCoef)
   boost::apply_visitor(mcBreakCoefVisitor, kdeModel);
 }
 
+// Modify whether Taylor expansions will be used.
+inline void KDEModel::SeriesExpansion(const bool newSeriesExpansion)
+{
+  seriesExpansion = newSeriesExpansion;
+  SeriesExpansionVisitor seriesExpansionVisitor(newSeriesExpansion);
+  boost::apply_visitor(seriesExpansionVisitor, kdeModel);
+}
+
 } // namespace kde
 } // namespace mlpack
 
@@ -14,6 +14,11 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/metrics/distance_tile.hpp>
+
+#include <unordered_map>
+
+#include "gaussian_taylor_expansion.hpp"
 
 namespace mlpack {
 namespace kde {
@@ -43,6 +48,9 @@ class KDERules
    * @param kernel Instantiated kernel.
    * @param monteCarlo If true Monte Carlo estimations will be applied when
    *                   possible.
+   * @param seriesExpansion If true Taylor expansions of the kernel will be
+   *                        applied when possible (Gaussian kernel and
+   *                        Euclidean distance only).
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
    */
@@ -58,11 +66,26 @@ class KDERules
            MetricType& metric,
            KernelType& kernel,
            const bool monteCarlo,
+           const bool seriesExpansion,
            const bool sameSet);
 
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Perform the base cases between the given query points and a contiguous
+   * block of reference points, as if BaseCase() was called for each pair.  If
+   * the metric supports it, all the distances of the block are computed at
+   * once.
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void BlockBaseCase(const arma::uvec& queryIndices,
+                     const size_t referenceBegin,
+                     const size_t referenceCount);
+
   //! SingleTree Rescore.
   double Score(const size_t queryIndex, TreeType& referenceNode);
 
@@ -109,6 +132,60 @@ class KDERules
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
+  //! The Taylor expansion of the kernel around the center of a reference
+  //! node.
+  struct NodeExpansion
+  {
+    //! Center of the expansion.
+    arma::vec center;
+    //! Order that the moments were computed for (0 if not computed yet).
+    size_t order;
+    //! Moments of the descendants of the node.
+    arma::vec moments;
+  };
+
+  //! Get the expansion of a reference node, creating it if needed.
+  NodeExpansion& Expansion(TreeType& referenceNode);
+
+  /**
+   * Find the lowest order of the expansion of the reference node for which
+   * the error of each kernel value is at most the given tolerance, for query
+   * points at the given distances from the center.  Returns 0 if there is no
+   * such order, or if the expansion would not be cheaper than computing the
+   * kernel values of the node.
+   */
+  size_t SeriesOrder(TreeType& referenceNode,
+                     const math::Range& centerDistances,
+                     const double tolerance,
+                     double& error);
+
+  /**
+   * Try to estimate the contribution of the reference node to the density of
+   * a query point with a Taylor expansion.  On success the estimation is
+   * added to the density, the error bound of each kernel value is stored in
+   * error, and true is returned.
+   */
+  bool SeriesEstimate(const size_t queryIndex,
+                      TreeType& referenceNode,
+                      const double tolerance,
+                      double& error);
+
+  //! Same as above, for every descendant of a query node.
+  bool SeriesEstimate(TreeType& queryNode,
+                      TreeType& referenceNode,
+                      const double tolerance,
+                      double& error);
+
+  //! Get the bandwidth of a Gaussian kernel.
+  static double Bandwidth(const kernel::GaussianKernel& kernel)
+  {
+    return kernel.Bandwidth();
+  }
+
+  //! Other kernels are never expanded.
+  template<typename OtherKernelType>
+  static double Bandwidth(const OtherKernelType& /* kernel */) { return 1.0; }
+
   //! The reference set.
   const arma::mat& referenceSet;
 
@@ -158,6 +235,15 @@ class KDERules
   //! Whether reference and query sets are the same.
   const bool sameSet;
 
+  //! Whether Taylor expansions are going to be applied.
+  const bool seriesExpansion;
+
+  //! Taylor expansion of the Gaussian kernel.
+  GaussianTaylorExpansion expansion;
+
+  //! Expansions of the reference nodes that have been used so far.
+  std::unordered_map<const TreeType*, NodeExpansion> nodeExpansions;
+
   //! Whether the kernel used for the rule is the Gaussian Kernel.
   constexpr static bool kernelIsGaussian =
       std::is_same<KernelType, kernel::GaussianKernel>::value;
@@ -179,6 +265,9 @@ class KDERules
 
   //! The number of scores.
   size_t scores;
+
+  //! Used to compute blocks of distances in BlockBaseCase().
+  metric::DistanceTile<MetricType, arma::mat> distanceTile;
 };
 
 /**
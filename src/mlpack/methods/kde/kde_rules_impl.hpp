@@ -36,6 +36,7 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     MetricType& metric,
     KernelType& kernel,
     const bool monteCarlo,
+    const bool seriesExpansion,
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
@@ -50,11 +51,15 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     kernel(kernel),
     monteCarlo(monteCarlo),
     sameSet(sameSet),
+    seriesExpansion(seriesExpansion && kernelIsGaussian &&
+        std::is_same<MetricType, metric::EuclideanDistance>::value),
+    expansion(Bandwidth(kernel), referenceSet.n_rows),
     absErrorTol(absError / referenceSet.n_cols),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    distanceTile(metric, querySet, referenceSet)
 {
   // Initialize accumError.
   accumError = arma::vec(querySet.n_cols, arma::fill::zeros);
@@ -96,6 +101,52 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+void KDERules<MetricType, KernelType, TreeType>::BlockBaseCase(
+    const arma::uvec& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  if (!distanceTile.Enabled())
+  {
+    for (size_t i = 0; i < queryIndices.n_elem; ++i)
+      for (size_t j = 0; j < referenceCount; ++j)
+        BaseCase(queryIndices[i], referenceBegin + j);
+    return;
+  }
+
+  // Every pair contributes to the density, so the distances of the tile are
+  // used directly.  The tile is centered on the reference leaf, so they are
+  // accurate relative to the size of the leaf.
+  arma::mat tileDistances;
+  distanceTile.Evaluate(queryIndices, referenceBegin, referenceCount,
+      tileDistances);
+
+  for (size_t i = 0; i < queryIndices.n_elem; ++i)
+  {
+    const size_t queryIndex = queryIndices[i];
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      const size_t referenceIndex = referenceBegin + j;
+
+      // Skip the pairs that BaseCase() would skip.
+      if ((sameSet && (queryIndex == referenceIndex)) ||
+          ((lastQueryIndex == queryIndex) &&
+           (lastReferenceIndex == referenceIndex)))
+        continue;
+
+      const double kernelValue = kernel.Evaluate(tileDistances(i, j));
+      densities(queryIndex) += kernelValue;
+      accumError(queryIndex) += 2 * relError * kernelValue;
+      ++baseCases;
+
+      lastQueryIndex = queryIndex;
+      lastReferenceIndex = referenceIndex;
+      traversalInfo.LastBaseCase() = tileDistances(i, j);
+    }
+  }
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename KernelType, typename TreeType>
 inline double KDERules<MetricType, KernelType, TreeType>::
@@ -104,7 +155,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   // Auxiliary variables.
   const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
   const size_t refNumDesc = referenceNode.NumDescendants();
-  double score, minDistance, maxDistance, depthAlpha;
+  double score, minDistance, maxDistance, depthAlpha, seriesError;
   // Calculations are not duplicated.
   bool alreadyDidRefPoint0 = false;
 
@@ -184,6 +235,24 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     if (kernelIsGaussian && monteCarlo)
       accumMCAlpha(queryIndex) += depthAlpha;
   }
+  else if (seriesExpansion &&
+           !alreadyDidRefPoint0 &&
+           (!sameSet || minDistance > 0.0) &&
+           SeriesEstimate(queryIndex, referenceNode,
+               errorTolerance + pointAccumErrorTol / 2, seriesError))
+  {
+    // The Taylor expansion is accurate enough, so don't explore this tree
+    // branch.
+    score = DBL_MAX;
+
+    // Subtract used error tolerance or add extra available tolerance.
+    accumError(queryIndex) -= refNumDesc * (2 * seriesError -
+        2 * errorTolerance);
+
+    // Store not used alpha for Monte Carlo.
+    if (monteCarlo)
+      accumMCAlpha(queryIndex) += depthAlpha;
+  }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
            kernelIsGaussian)
@@ -310,7 +379,7 @@ Score(TreeType& queryNode, TreeType& referenceNode)
 {
   kde::KDEStat& queryStat = queryNode.Stat();
   const size_t refNumDesc = referenceNode.NumDescendants();
-  double score, minDistance, maxDistance, depthAlpha;
+  double score, minDistance, maxDistance, depthAlpha, seriesError;
   // Calculations are not duplicated.
   bool alreadyDidRefPoint0 = false;
 
@@ -393,6 +462,24 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     if (kernelIsGaussian && monteCarlo)
       queryStat.AccumAlpha() += depthAlpha;
   }
+  else if (seriesExpansion &&
+           !alreadyDidRefPoint0 &&
+           (!sameSet || minDistance > 0.0) &&
+           SeriesEstimate(queryNode, referenceNode,
+               errorTolerance + pointAccumErrorTol / 2, seriesError))
+  {
+    // The Taylor expansion is accurate enough for every query point, so
+    // prune.
+    score = DBL_MAX;
+
+    // Subtract used error tolerance or add extra available tolerance.
+    queryStat.AccumError() -= refNumDesc * (2 * seriesError -
+        2 * errorTolerance);
+
+    // Store not used alpha for Monte Carlo.
+    if (monteCarlo)
+      queryStat.AccumAlpha() += depthAlpha;
+  }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
            kernelIsGaussian)
@@ -573,6 +660,102 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+typename KDERules<MetricType, KernelType, TreeType>::NodeExpansion&
+KDERules<MetricType, KernelType, TreeType>::Expansion(TreeType& referenceNode)
+{
+  typename std::unordered_map<const TreeType*, NodeExpansion>::iterator it =
+      nodeExpansions.find(&referenceNode);
+  if (it != nodeExpansions.end())
+    return it->second;
+
+  // The moments are only computed once an order is known.
+  NodeExpansion& nodeExpansion = nodeExpansions[&referenceNode];
+  referenceNode.Center(nodeExpansion.center);
+  nodeExpansion.order = 0;
+  return nodeExpansion;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+size_t KDERules<MetricType, KernelType, TreeType>::SeriesOrder(
+    TreeType& referenceNode,
+    const math::Range& centerDistances,
+    const double tolerance,
+    double& error)
+{
+  const double radius = referenceNode.FurthestDescendantDistance();
+  for (size_t order = 1; order <= GaussianTaylorExpansion::MaxOrder; ++order)
+  {
+    // Evaluating the expansion takes one operation per term, and the number
+    // of terms only grows with the order.
+    if (expansion.NumTerms(order) > referenceNode.NumDescendants())
+      return 0;
+
+    error = expansion.ErrorBound(order, centerDistances, radius);
+    if (error <= tolerance)
+      return order;
+  }
+
+  return 0;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+bool KDERules<MetricType, KernelType, TreeType>::SeriesEstimate(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    const double tolerance,
+    double& error)
+{
+  NodeExpansion& nodeExpansion = Expansion(referenceNode);
+  const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
+                                          nodeExpansion.center);
+  const size_t order = SeriesOrder(referenceNode,
+      math::Range(distance, distance), tolerance, error);
+  if (order == 0)
+    return false;
+
+  if (nodeExpansion.order < order)
+  {
+    expansion.Moments(referenceNode, referenceSet, nodeExpansion.center, order,
+        nodeExpansion.moments);
+    nodeExpansion.order = order;
+  }
+
+  densities(queryIndex) += expansion.Evaluate(nodeExpansion.moments,
+      nodeExpansion.center, order, querySet.unsafe_col(queryIndex));
+  return true;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+bool KDERules<MetricType, KernelType, TreeType>::SeriesEstimate(
+    TreeType& queryNode,
+    TreeType& referenceNode,
+    const double tolerance,
+    double& error)
+{
+  NodeExpansion& nodeExpansion = Expansion(referenceNode);
+  const size_t order = SeriesOrder(referenceNode,
+      queryNode.RangeDistance(nodeExpansion.center), tolerance, error);
+  if (order == 0)
+    return false;
+
+  if (nodeExpansion.order < order)
+  {
+    expansion.Moments(referenceNode, referenceSet, nodeExpansion.center, order,
+        nodeExpansion.moments);
+    nodeExpansion.order = order;
+  }
+
+  for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+  {
+    const size_t queryIndex = queryNode.Descendant(i);
+    densities(queryIndex) += expansion.Evaluate(nodeExpansion.moments,
+        nodeExpansion.center, order, querySet.unsafe_col(queryIndex));
+  }
+
+  return true;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
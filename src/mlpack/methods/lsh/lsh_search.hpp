@@ -51,8 +51,10 @@
 
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
+#include <mlpack/methods/neighbor_search/candidate_arena.hpp>
 
 #include <queue>
+#include <unordered_map>
 
 namespace mlpack {
 namespace neighbor {
@@ -249,6 +251,42 @@ class LSHSearch
               const size_t numTablesToSearch = 0,
               size_t T = 0);
 
+  /**
+   * Add the given points to the reference set and hash them into the existing
+   * tables, without retraining.  The new points get the indices
+   * ReferenceSet().n_cols, ..., ReferenceSet().n_cols + points.n_cols - 1 (as
+   * of before the call).  The points are placed into free space of their
+   * buckets when possible, and otherwise held aside until the next
+   * compaction; as during training, points that would exceed the maximum
+   * bucket size are dropped.  Since the reference set is stored in a single
+   * matrix, it is copied on each call, so it is best to insert points in
+   * batches.
+   *
+   * @param points Points to add to the reference set.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Remove the given points from the model, so that they will not be returned
+   * by Search() anymore.  The points are only marked as removed (tombstones);
+   * they stay in the reference set so that the indices of all other points
+   * remain valid, and they are purged from the buckets by the next compaction.
+   * Removing a point twice has no effect.
+   *
+   * @param indices Indices of the reference points to remove.
+   */
+  void Remove(const arma::Col<size_t>& indices);
+
+  /**
+   * Rewrite the buckets of the second hash table, purging removed points and
+   * merging the points that Insert() could not place in their buckets, and
+   * leaving some free space in each bucket for future insertions.  This is
+   * done automatically by Insert() and Remove() when the number of pending
+   * changes exceeds CompactionThreshold() times the number of points in the
+   * buckets, but it can also be called manually.
+   */
+  void Compact();
+
   /**
    * Compute the recall (% of neighbors found) given the neighbors returned by
    * LSHSearch::Search and a "ground truth" set of neighbors.  The recall
@@ -290,9 +328,29 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  //! Get the fraction of pending changes that triggers a compaction.
+  double CompactionThreshold() const { return compactionThreshold; }
+  //! Modify the fraction of pending changes that triggers a compaction.
+  double& CompactionThreshold() { return compactionThreshold; }
+
+  //! Return whether the given reference point has been removed.
+  bool IsRemoved(const size_t index) const { return removedPoints[index]; }
+
+  /**
+   * Get the second hash table as one vector of point indices per non-empty
+   * bucket.  The buckets are stored packed in a single array internally (see
+   * BucketOffsets() and BucketPoints()), so this assembles a copy.
+   */
+  std::vector<arma::Col<size_t>> SecondHashTable() const;
+
+  //! Get the offset of each non-empty bucket in BucketPoints(); bucket i holds
+  //! BucketContentSize()[i] points starting at BucketOffsets()[i].
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+  //! Get the packed contents of all non-empty buckets.
+  const arma::Col<uint32_t>& BucketPoints() const { return bucketPoints; }
+  //! Get the number of points in each non-empty bucket.
+  const arma::Col<size_t>& BucketContentSize() const
+      { return bucketContentSize; }
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -313,9 +371,13 @@ class LSHSearch
    * the potential neighbor candidates.
    *
    * @param queryPoint The query point currently being processed.
-   * @param referenceIndices The list of neighbor candidates obtained from
-   *    hashing the query into all the hash tables and eventually into
+   * @param referenceIndices The list of distinct neighbor candidates obtained
+   *    from hashing the query into all the hash tables and eventually into
    *    multiple buckets of the second hash table.
+   * @param visited Scratch bitset with one bit per reference point, used to
+   *    discard duplicate candidates.  It must be all zeros (or empty) when
+   *    passed, and it is all zeros again on return, so one buffer can be
+   *    reused for many queries.
    * @param numTablesToSearch The number of tables to perform the search in. If
    *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
@@ -323,10 +385,41 @@ class LSHSearch
    */
   template<typename VecType>
   void ReturnIndicesFromTable(const VecType& queryPoint,
-                              arma::uvec& referenceIndices,
+                              std::vector<size_t>& referenceIndices,
+                              std::vector<uint64_t>& visited,
                               size_t numTablesToSearch,
                               const size_t T) const;
 
+  /**
+   * Compute the second hash value of the given points in every table.  The
+   * points are hashed in blocks, in parallel.
+   *
+   * @param points Points to hash.
+   * @param secondHashVectors Output hash values; the value of point j in
+   *     table i is stored in (i, j).
+   */
+  void HashPoints(const MatType& points,
+                  arma::Mat<size_t>& secondHashVectors) const;
+
+  /**
+   * Pack the current contents of the buckets (the packed buckets and the
+   * overflow buckets, without removed points) into a new packed layout.
+   *
+   * @param slack If true, leave free space in each bucket for insertions.
+   * @param offsets Output bucket offsets (see bucketOffsets).
+   * @param points Output bucket contents (see bucketPoints).
+   * @param sizes Output bucket sizes (see bucketContentSize).
+   * @param rows Output bucket of each hash value (see bucketRowInHashTable).
+   */
+  void PackBuckets(const bool slack,
+                   arma::Col<size_t>& offsets,
+                   arma::Col<uint32_t>& points,
+                   arma::Col<size_t>& sizes,
+                   arma::Col<size_t>& rows) const;
+
+  //! Compact the buckets if enough changes are pending.
+  void CompactIfNeeded();
+
   /**
    * This is a helper function that computes the distance of the query to the
    * neighbor candidates and appropriately stores the best 'k' candidates.  This
@@ -341,7 +434,7 @@ class LSHSearch
    * @param distances Matrix holding output distances.
    */
   void BaseCase(const size_t queryIndex,
-                const arma::uvec& referenceIndices,
+                const std::vector<size_t>& referenceIndices,
                 const size_t k,
                 arma::Mat<size_t>& neighbors,
                 arma::mat& distances) const;
@@ -361,7 +454,7 @@ class LSHSearch
    * @param distances Matrix holding output distances.
    */
   void BaseCase(const size_t queryIndex,
-                const arma::uvec& referenceIndices,
+                const std::vector<size_t>& referenceIndices,
                 const size_t k,
                 const MatType& querySet,
                 arma::Mat<size_t>& neighbors,
@@ -450,35 +543,43 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! For each non-empty bucket of the second hash table (< secondHashSize of
+  //! them), the offset of its points in bucketPoints.  Has one extra element
+  //! at the end, holding the total size of bucketPoints.
+  arma::Col<size_t> bucketOffsets;
+
+  //! The contents of all non-empty buckets, packed one after the other; each
+  //! bucket holds (<= bucketSize) elements.  Point indices are stored with 32
+  //! bits to halve the memory traffic of the search.
+  arma::Col<uint32_t> bucketPoints;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
+  //! The number of elements present in each non-empty bucket.
   arma::Col<size_t> bucketContentSize;
 
-  //! For a particular hash value, points to the row in secondHashTable
-  //! corresponding to this value. Length secondHashSize.
+  //! For a particular hash value, points to the non-empty bucket (the index
+  //! into bucketOffsets and bucketContentSize) corresponding to this value, or
+  //! secondHashSize if the bucket is empty.  Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
-  //! The number of distance evaluations.
-  size_t distanceEvaluations;
+  //! Points added by Insert() that did not fit into their packed bucket,
+  //! indexed by second hash value.  Emptied by compaction.
+  std::unordered_map<size_t, std::vector<uint32_t>> overflowBuckets;
 
-  //! Candidate represents a possible candidate neighbor (distance, index).
-  typedef std::pair<double, size_t> Candidate;
+  //! The number of points in overflowBuckets.
+  size_t numOverflowPoints;
 
-  //! Compare two candidates based on the distance.
-  struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
-    {
-      return !SortPolicy::IsBetter(c2.first, c1.first);
-    };
-  };
+  //! Whether each reference point has been removed.
+  std::vector<bool> removedPoints;
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
+  //! The number of points removed since the last compaction (whose entries
+  //! may still be in the buckets).
+  size_t numPendingRemovals;
+
+  //! The fraction of pending changes that triggers a compaction.
+  double compactionThreshold;
+
+  //! The number of distance evaluations.
+  size_t distanceEvaluations;
 }; // class LSHSearch
 
 } // namespace neighbor
@@ -486,7 +587,7 @@ class LSHSearch
 
 //! Set the serialization version of the LSHSearch class.
 BOOST_TEMPLATE_CLASS_VERSION(template<typename SortPolicy>,
-    mlpack::neighbor::LSHSearch<SortPolicy>, 1);
+    mlpack::neighbor::LSHSearch<SortPolicy>, 3);
 
 // Include implementation.
 #include "lsh_search_impl.hpp"
@@ -32,6 +32,9 @@ LSHSearch(MatType referenceSet,
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
+  numOverflowPoints(0),
+  numPendingRemovals(0),
+  compactionThreshold(0.1),
   distanceEvaluations(0)
 {
   // Pass work to training function.
@@ -52,6 +55,9 @@ LSHSearch(MatType referenceSet,
   hashWidth(hashWidthIn),
   secondHashSize(secondHashSize),
   bucketSize(bucketSize),
+  numOverflowPoints(0),
+  numPendingRemovals(0),
+  compactionThreshold(0.1),
   distanceEvaluations(0)
 {
   // Pass work to training function.
@@ -67,6 +73,9 @@ LSHSearch<SortPolicy, MatType>::LSHSearch() :
     hashWidth(0),
     secondHashSize(99901),
     bucketSize(500),
+    numOverflowPoints(0),
+    numPendingRemovals(0),
+    compactionThreshold(0.1),
     distanceEvaluations(0)
 {
 }
@@ -83,9 +92,15 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
+    bucketOffsets(other.bucketOffsets),
+    bucketPoints(other.bucketPoints),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
+    overflowBuckets(other.overflowBuckets),
+    numOverflowPoints(other.numOverflowPoints),
+    removedPoints(other.removedPoints),
+    numPendingRemovals(other.numPendingRemovals),
+    compactionThreshold(other.compactionThreshold),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Nothing to do.
@@ -103,9 +118,15 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketPoints(std::move(other.bucketPoints)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
+    overflowBuckets(std::move(other.overflowBuckets)),
+    numOverflowPoints(other.numOverflowPoints),
+    removedPoints(std::move(other.removedPoints)),
+    numPendingRemovals(other.numPendingRemovals),
+    compactionThreshold(other.compactionThreshold),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Reset other model to defaults.
@@ -114,6 +135,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
   other.hashWidth = 0;
   other.secondHashSize = 99901;
   other.bucketSize = 500;
+  other.numOverflowPoints = 0;
+  other.numPendingRemovals = 0;
   other.distanceEvaluations = 0;
 }
 
@@ -131,9 +154,15 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
+  bucketOffsets = other.bucketOffsets;
+  bucketPoints = other.bucketPoints;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
+  overflowBuckets = other.overflowBuckets;
+  numOverflowPoints = other.numOverflowPoints;
+  removedPoints = other.removedPoints;
+  numPendingRemovals = other.numPendingRemovals;
+  compactionThreshold = other.compactionThreshold;
   distanceEvaluations = other.distanceEvaluations;
 
   return *this;
@@ -153,9 +182,15 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketPoints = std::move(other.bucketPoints);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
+  overflowBuckets = std::move(other.overflowBuckets);
+  numOverflowPoints = other.numOverflowPoints;
+  removedPoints = std::move(other.removedPoints);
+  numPendingRemovals = other.numPendingRemovals;
+  compactionThreshold = other.compactionThreshold;
   distanceEvaluations = other.distanceEvaluations;
 
   // Reset other model to defaults.
@@ -164,6 +199,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   other.hashWidth = 0;
   other.secondHashSize = 99901;
   other.bucketSize = 500;
+  other.numOverflowPoints = 0;
+  other.numPendingRemovals = 0;
   other.distanceEvaluations = 0;
 
   return *this;
@@ -219,13 +256,6 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   secondHashWeights = arma::floor(arma::randu(numProj) *
                                   (double) secondHashSize);
 
-  // Instead of putting the points in the row corresponding to the bucket, we
-  // chose the next empty row and keep track of the row in which the bucket
-  // lies. This allows us to stack together and slice out the empty buckets at
-  // the end of the hashing.
-  bucketRowInHashTable.set_size(secondHashSize);
-  bucketRowInHashTable.fill(secondHashSize);
-
   // Step II: The offsets for all projections in all tables.
   // Since the 'offsets' are in [0, hashWidth], we obtain the 'offsets'
   // as randu(numProj, numTables) * hashWidth.
@@ -253,100 +283,157 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
         "tables provided must be equal to numProj");
   }
 
-  // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
-
-  for (size_t i = 0; i < numTables; ++i)
+  // The packed buckets store point indices with 32 bits.
+  if (this->referenceSet.n_cols > std::numeric_limits<uint32_t>::max())
   {
-    // Step IV: create the 'numProj'-dimensional key for each point in each
-    // table.
-
-    // The following code performs the task of hashing each point to a
-    // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
-    // 'referenceSet.n_cols') key matrix.
-    //
-    // For a single table, let the 'numProj' projections be denoted by 'proj_i'
-    // and the corresponding offset be 'offset_i'.  Then the key of a single
-    // point is obtained as:
-    // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
-    arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
-    hashMat /= hashWidth;
-
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
-    // Now we hash every key, point ID to its corresponding bucket.  We must
-    // also normalize the hashes to the range [0, secondHashSize).
-    arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
-    for (size_t j = 0; j < unmodVector.n_elem; ++j)
-    {
-      double shs = (double) secondHashSize; // Convenience cast.
-      if (unmodVector[j] >= 0.0)
-      {
-        const size_t key = size_t(fmod(unmodVector[j], shs));
-        secondHashVectors(i, j) = key;
-      }
-      else
-      {
-        const double mod = fmod(-unmodVector[j], shs);
-        const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
-        secondHashVectors(i, j) = key;
-      }
-    }
+    std::ostringstream oss;
+    oss << "LSHSearch::Train(): the reference set has "
+        << this->referenceSet.n_cols << " points, but at most "
+        << std::numeric_limits<uint32_t>::max() << " are supported!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
   }
 
-  // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
-  arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
+  // Step IV and V: hash every point into every table.  The second hash
+  // vector for table i will be held in row i.
+  const size_t numPoints = this->referenceSet.n_cols;
+  arma::Mat<size_t> secondHashVectors;
+  HashPoints(this->referenceSet, secondHashVectors);
+
+  // Step VI: Pack the buckets of the second hash table.  Every non-empty
+  // bucket gets a row, in increasing order of the hash value; the contents of
+  // the rows are stored one after the other in bucketPoints.
+  std::vector<char> occupied(secondHashSize, 0);
   for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
-    secondHashBinCounts[secondHashVectors[i]]++;
+    occupied[secondHashVectors[i]] = 1;
+
+  bucketRowInHashTable.set_size(secondHashSize);
+  size_t numRowsInTable = 0;
+  for (size_t h = 0; h < secondHashSize; ++h)
+    bucketRowInHashTable[h] = occupied[h] ? numRowsInTable++ : secondHashSize;
 
-  // Enforce the maximum bucket size.
+  // Count the points of each table that fall in each row.  Every table is
+  // handled by a single thread, so no synchronization is needed.
+  arma::Mat<size_t> tableCounts(numRowsInTable, numTables, arma::fill::zeros);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; ++i)
+  {
+    for (size_t j = 0; j < numPoints; ++j)
+      tableCounts(bucketRowInHashTable[secondHashVectors(i, j)], i)++;
+  }
+
+  // A bucket holds the points of table 0 first, then those of table 1, and so
+  // on, up to the maximum bucket size.  Turn the counts into the position
+  // where the points of each table start within each bucket, and compute the
+  // offset of each bucket.
   const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
-  secondHashBinCounts.transform([effectiveBucketSize](size_t val)
-      { return std::min(val, effectiveBucketSize); });
+  bucketContentSize.set_size(numRowsInTable);
+  bucketOffsets.set_size(numRowsInTable + 1);
+  bucketOffsets[0] = 0;
+  for (size_t r = 0; r < numRowsInTable; ++r)
+  {
+    size_t total = 0;
+    for (size_t i = 0; i < numTables; ++i)
+    {
+      const size_t count = tableCounts(r, i);
+      tableCounts(r, i) = total;
+      total += count;
+    }
 
-  const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
+    bucketContentSize[r] = std::min(total, effectiveBucketSize);
+    bucketOffsets[r + 1] = bucketOffsets[r] + bucketContentSize[r];
+  }
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
-  size_t currentRow = 0;
-  for (size_t i = 0; i < numTables; ++i)
+  // Now fill the buckets; again, each table is handled by a single thread, and
+  // the tables write to disjoint positions.
+  bucketPoints.set_size(bucketOffsets[numRowsInTable]);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
-    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    for (size_t j = 0; j < numPoints; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      const size_t position = tableCounts(row, i)++;
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
-    } // Loop over all points in the reference set.
-  } // Loop over tables.
+      // Points beyond the maximum bucket size are dropped.
+      if (position < bucketContentSize[row])
+        bucketPoints[bucketOffsets[row] + position] = (uint32_t) j;
+    }
+  }
 
   Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
-            << "maximum length of " << arma::max(secondHashBinCounts) << ", "
-            << "totaling " << arma::accu(secondHashBinCounts) << " elements."
-            << std::endl;
+            << "maximum length of " << (numRowsInTable == 0 ? 0 :
+            arma::max(bucketContentSize)) << ", totaling "
+            << bucketPoints.n_elem << " elements." << std::endl;
+
+  // There are no pending changes.
+  overflowBuckets.clear();
+  numOverflowPoints = 0;
+  removedPoints.assign(numPoints, false);
+  numPendingRemovals = 0;
+}
+
+// Hash the given points into every table.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::HashPoints(
+    const MatType& points,
+    arma::Mat<size_t>& secondHashVectors) const
+{
+  const size_t numPoints = points.n_cols;
+  secondHashVectors.set_size(numTables, numPoints);
+
+  // The points are hashed in blocks, so that only the projections of one block
+  // of points are held in memory at a time.  The blocks are independent, so
+  // they are hashed in parallel.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (numPoints + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, numPoints) - 1;
+
+    for (size_t i = 0; i < numTables; ++i)
+    {
+      // Step IV: create the 'numProj'-dimensional key for each point in each
+      // table.
+
+      // The following code performs the task of hashing each point to a
+      // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
+      // 'blockSize') key matrix.
+      //
+      // For a single table, let the 'numProj' projections be denoted by
+      // 'proj_i' and the corresponding offset be 'offset_i'.  Then the key of a
+      // single point is obtained as:
+      // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
+      arma::mat hashMat = projections.slice(i).t() *
+          points.cols(begin, end);
+      hashMat.each_col() += offsets.unsafe_col(i);
+      hashMat /= hashWidth;
+
+      // Step V: Hash the key of every point to its bucket.  We must also
+      // normalize the hashes to the range [0, secondHashSize).
+      arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
+      for (size_t j = 0; j < unmodVector.n_elem; ++j)
+      {
+        double shs = (double) secondHashSize; // Convenience cast.
+        if (unmodVector[j] >= 0.0)
+        {
+          const size_t key = size_t(fmod(unmodVector[j], shs));
+          secondHashVectors(i, begin + j) = key;
+        }
+        else
+        {
+          const double mod = fmod(-unmodVector[j], shs);
+          const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
+          secondHashVectors(i, begin + j) = key;
+        }
+      }
+    }
+  }
 }
 
 // Base case where the query set is the reference set.  (So, we can't return
@@ -355,44 +442,39 @@ template<typename SortPolicy, typename MatType>
 inline force_inline
 void LSHSearch<SortPolicy, MatType>::BaseCase(
     const size_t queryIndex,
-    const arma::uvec& referenceIndices,
+    const std::vector<size_t>& referenceIndices,
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances) const
 {
-  // Let's build the list of candidate neighbors for the given query point.
-  // It will be initialized with k candidates:
+  // The candidate neighbors are kept sorted directly in the output column of
+  // the query point.  It is initialized with k candidates:
   // (WorstDistance, referenceSet.n_cols)
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      referenceSet.n_cols);
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
+  double* candidateDistances = distances.colptr(queryIndex);
+  size_t* candidateIndices = neighbors.colptr(queryIndex);
+  std::fill(candidateDistances, candidateDistances + k,
+      SortPolicy::WorstDistance());
+  std::fill(candidateIndices, candidateIndices + k, referenceSet.n_cols);
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  for (size_t j = 0; j < referenceIndices.size(); ++j)
   {
     const size_t referenceIndex = referenceIndices[j];
     // If the points are the same, skip this point.
     if (queryIndex == referenceIndex)
       continue;
 
-    const double distance = metric::EuclideanDistance::Evaluate(
-        referenceSet.col(queryIndex),
-        referenceSet.col(referenceIndex));
+    // For nearest neighbor search, the distance computation can stop as soon
+    // as it is known that the point cannot beat the current worst candidate.
+    const double distance = std::is_same<SortPolicy,
+        NearestNeighborSort>::value ?
+        metric::EuclideanDistance::EvaluateBounded(referenceSet.col(queryIndex),
+            referenceSet.col(referenceIndex), candidateDistances[k - 1]) :
+        metric::EuclideanDistance::Evaluate(referenceSet.col(queryIndex),
+            referenceSet.col(referenceIndex));
 
-    Candidate c = std::make_pair(distance, referenceIndex);
     // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
-    {
-      pqueue.pop();
-      pqueue.push(c);
-    }
-  }
-
-  for (size_t j = 1; j <= k; ++j)
-  {
-    neighbors(k - j, queryIndex) = pqueue.top().second;
-    distances(k - j, queryIndex) = pqueue.top().first;
-    pqueue.pop();
+    CandidateArena<SortPolicy>::Insert(candidateDistances, candidateIndices, k,
+        referenceIndex, distance);
   }
 }
 
@@ -401,41 +483,36 @@ template<typename SortPolicy, typename MatType>
 inline force_inline
 void LSHSearch<SortPolicy, MatType>::BaseCase(
     const size_t queryIndex,
-    const arma::uvec& referenceIndices,
+    const std::vector<size_t>& referenceIndices,
     const size_t k,
     const MatType& querySet,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances) const
 {
-  // Let's build the list of candidate neighbors for the given query point.
-  // It will be initialized with k candidates:
+  // The candidate neighbors are kept sorted directly in the output column of
+  // the query point.  It is initialized with k candidates:
   // (WorstDistance, referenceSet.n_cols)
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      referenceSet.n_cols);
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
+  double* candidateDistances = distances.colptr(queryIndex);
+  size_t* candidateIndices = neighbors.colptr(queryIndex);
+  std::fill(candidateDistances, candidateDistances + k,
+      SortPolicy::WorstDistance());
+  std::fill(candidateIndices, candidateIndices + k, referenceSet.n_cols);
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  for (size_t j = 0; j < referenceIndices.size(); ++j)
   {
     const size_t referenceIndex = referenceIndices[j];
-    const double distance = metric::EuclideanDistance::Evaluate(
-        querySet.col(queryIndex),
-        referenceSet.col(referenceIndex));
+    // For nearest neighbor search, the distance computation can stop as soon
+    // as it is known that the point cannot beat the current worst candidate.
+    const double distance = std::is_same<SortPolicy,
+        NearestNeighborSort>::value ?
+        metric::EuclideanDistance::EvaluateBounded(querySet.col(queryIndex),
+            referenceSet.col(referenceIndex), candidateDistances[k - 1]) :
+        metric::EuclideanDistance::Evaluate(querySet.col(queryIndex),
+            referenceSet.col(referenceIndex));
 
-    Candidate c = std::make_pair(distance, referenceIndex);
     // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
-    {
-      pqueue.pop();
-      pqueue.push(c);
-    }
-  }
-
-  for (size_t j = 1; j <= k; ++j)
-  {
-    neighbors(k - j, queryIndex) = pqueue.top().second;
-    distances(k - j, queryIndex) = pqueue.top().first;
-    pqueue.pop();
+    CandidateArena<SortPolicy>::Insert(candidateDistances, candidateIndices, k,
+        referenceIndex, distance);
   }
 }
 
@@ -706,7 +783,8 @@ template<typename SortPolicy, typename MatType>
 template<typename VecType>
 void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     const VecType& queryPoint,
-    arma::uvec& referenceIndices,
+    std::vector<size_t>& referenceIndices,
+    std::vector<uint64_t>& visited,
     size_t numTablesToSearch,
     const size_t T) const
 {
@@ -768,90 +846,67 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     }
   }
 
-  // Count number of points hashed in the same bucket as the query.
-  size_t maxNumPoints = 0;
-  for (size_t i = 0; i < numTablesToSearch; ++i)
+  // Collect the distinct points of all the probed buckets.  A point is marked
+  // in 'visited' the first time it is seen, so duplicates are discarded
+  // without sorting; the marks are removed again below, so the buffer can be
+  // reused by the next query without clearing all of it.
+  const size_t numWords = (referenceSet.n_cols + 63) / 64;
+  if (visited.size() != numWords)
+    visited.assign(numWords, 0);
+
+  referenceIndices.clear();
+  for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
   {
-    for (size_t p = 0; p < T + 1; ++p)
+    for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
     {
-      const size_t hashInd = hashMat(p, i); // find query's bucket
+      const size_t hashInd = hashMat(p, i); // Find the query's bucket.
       const size_t tableRow = bucketRowInHashTable[hashInd];
-      if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
-    }
-  }
+      if (tableRow >= secondHashSize)
+        continue; // The bucket is empty.
 
-  // There are two ways to proceed here:
-  // Either allocate a maxNumPoints-size vector, place all candidates, and run
-  // unique on the vector to discard duplicates.
-  // Or allocate a referenceSet.n_cols size vector (i.e. number of reference
-  // points) of zeros, and mark found indices as 1.
-  // Option 1 runs faster for small maxNumPoints but worse for larger values, so
-  // we choose based on a heuristic.
-  const float cutoff = 0.1;
-  const float selectivity = static_cast<float>(maxNumPoints) /
-      static_cast<float>(referenceSet.n_cols);
-
-  if (selectivity > cutoff)
-  {
-    // Heuristic: larger maxNumPoints means we should use find() because it
-    // should be faster.
-    // Reference points hashed in the same bucket as the query are set to >0.
-    arma::Col<size_t> refPointsConsidered;
-    refPointsConsidered.zeros(referenceSet.n_cols);
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // for all tables
-    {
-      for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
+      const uint32_t* points = bucketPoints.memptr() + bucketOffsets[tableRow];
+      for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
       {
-        // get the sequence code
-        size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
-
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+        const size_t point = points[j];
+        const uint64_t bit = uint64_t(1) << (point % 64);
+        if (!(visited[point / 64] & bit) && !removedPoints[point])
         {
-          // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          visited[point / 64] |= bit;
+          referenceIndices.push_back(point);
         }
       }
     }
-
-    // Only keep reference points found in at least one bucket.
-    referenceIndices = arma::find(refPointsConsidered > 0);
-    return;
   }
-  else
-  {
-    // Heuristic: smaller maxNumPoints means we should use unique() because it
-    // should be faster.
-    // Allocate space for the query's potential neighbors.
-    arma::uvec refPointsConsideredSmall;
-    refPointsConsideredSmall.zeros(maxNumPoints);
-
-    // Retrieve candidates.
-    size_t start = 0;
 
-    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables
+  // Points inserted since the last compaction may be held aside.
+  if (numOverflowPoints > 0)
+  {
+    for (size_t i = 0; i < numTablesToSearch; ++i)
     {
       for (size_t p = 0; p < T + 1; ++p)
       {
-        const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
+        typename std::unordered_map<size_t, std::vector<uint32_t>>::
+            const_iterator it = overflowBuckets.find(hashMat(p, i));
+        if (it == overflowBuckets.end())
+          continue;
 
-        if (tableRow < secondHashSize)
+        for (size_t j = 0; j < it->second.size(); ++j)
         {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
+          const size_t point = it->second[j];
+          const uint64_t bit = uint64_t(1) << (point % 64);
+          if (!(visited[point / 64] & bit) && !removedPoints[point])
+          {
+            visited[point / 64] |= bit;
+            referenceIndices.push_back(point);
+          }
+        }
       }
     }
-
-    // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
-    return;
   }
+
+  // Every marked word only holds marks of points in referenceIndices.
+  for (size_t j = 0; j < referenceIndices.size(); ++j)
+    visited[referenceIndices[j] / 64] = 0;
 }
 
 // Search for nearest neighbors in a given query set.
@@ -912,28 +967,31 @@ void LSHSearch<SortPolicy, MatType>::Search(
   Timer::Start("computing_neighbors");
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    // Candidate buffers, reused by all the queries of this thread.
+    std::vector<size_t> refIndices;
+    std::vector<uint64_t> visited;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      ReturnIndicesFromTable(querySet.col(i), refIndices, visited,
+          numTablesToSearch, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.size();
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -978,28 +1036,31 @@ Search(const size_t k,
   Timer::Start("computing_neighbors");
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    // Candidate buffers, reused by all the queries of this thread.
+    std::vector<size_t> refIndices;
+    std::vector<uint64_t> visited;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      ReturnIndicesFromTable(referenceSet.col(i), refIndices, visited,
+          numTablesToSearch, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.size();
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1010,6 +1071,249 @@ Search(const size_t k,
       std::endl;
 }
 
+// Add points to the model.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Insert(const MatType& points)
+{
+  if (projections.n_slices == 0)
+  {
+    throw std::invalid_argument("LSHSearch::Insert(): the model must be "
+        "trained before points can be inserted!");
+  }
+
+  if (points.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Insert(): dimensionality of new points ("
+        << points.n_rows << ") is not equal to the dimensionality the model "
+        << "was trained on (" << referenceSet.n_rows << ")!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t first = referenceSet.n_cols;
+  if (first + points.n_cols > std::numeric_limits<uint32_t>::max())
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Insert(): the reference set would have "
+        << first + points.n_cols << " points, but at most "
+        << std::numeric_limits<uint32_t>::max() << " are supported!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Mat<size_t> secondHashVectors;
+  HashPoints(points, secondHashVectors);
+
+  referenceSet = arma::join_rows(referenceSet, points);
+  removedPoints.resize(referenceSet.n_cols, false);
+
+  // Put every point in its bucket in every table, in the same order as
+  // Train() does.  A point goes into the free space at the end of its packed
+  // bucket if there is any (and if no other points of the bucket are held
+  // aside, so that the order is kept); otherwise it is held aside in the
+  // overflow buckets.
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      const size_t hashInd = secondHashVectors(i, j);
+      const size_t row = bucketRowInHashTable[hashInd];
+      const size_t packedSize = (row < secondHashSize) ?
+          bucketContentSize[row] : 0;
+
+      typename std::unordered_map<size_t, std::vector<uint32_t>>::iterator it =
+          overflowBuckets.find(hashInd);
+      const size_t overflowSize = (it == overflowBuckets.end()) ? 0 :
+          it->second.size();
+
+      // Enforce the maximum bucket size.  Removed points keep their entries
+      // until the next compaction, but they do not count.
+      size_t liveSize = packedSize + overflowSize;
+      if (liveSize >= effectiveBucketSize && numPendingRemovals > 0)
+      {
+        if (row < secondHashSize)
+        {
+          const uint32_t* bucket = bucketPoints.memptr() + bucketOffsets[row];
+          for (size_t k = 0; k < packedSize; ++k)
+            if (removedPoints[bucket[k]])
+              --liveSize;
+        }
+        for (size_t k = 0; k < overflowSize; ++k)
+          if (removedPoints[it->second[k]])
+            --liveSize;
+      }
+      if (liveSize >= effectiveBucketSize)
+        continue;
+
+      if (row < secondHashSize && overflowSize == 0 &&
+          bucketOffsets[row] + packedSize < bucketOffsets[row + 1])
+      {
+        bucketPoints[bucketOffsets[row] + packedSize] = (uint32_t) (first + j);
+        ++bucketContentSize[row];
+      }
+      else
+      {
+        overflowBuckets[hashInd].push_back((uint32_t) (first + j));
+        ++numOverflowPoints;
+      }
+    }
+  }
+
+  CompactIfNeeded();
+}
+
+// Remove points from the model.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Remove(const arma::Col<size_t>& indices)
+{
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    if (indices[i] >= referenceSet.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "LSHSearch::Remove(): cannot remove point " << indices[i]
+          << "; the reference set only has " << referenceSet.n_cols
+          << " points!" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    if (!removedPoints[indices[i]])
+    {
+      removedPoints[indices[i]] = true;
+      ++numPendingRemovals;
+    }
+  }
+
+  CompactIfNeeded();
+}
+
+// Compact the buckets if there are enough pending changes.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::CompactIfNeeded()
+{
+  // Every removed point may occupy one entry per table.
+  const double pendingChanges = (double) numOverflowPoints +
+      (double) numPendingRemovals * numTables;
+  if (pendingChanges > compactionThreshold * bucketPoints.n_elem)
+    Compact();
+}
+
+// Compact the buckets.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Compact()
+{
+  arma::Col<size_t> offsets, sizes, rows;
+  arma::Col<uint32_t> points;
+  PackBuckets(true, offsets, points, sizes, rows);
+
+  bucketOffsets = std::move(offsets);
+  bucketPoints = std::move(points);
+  bucketContentSize = std::move(sizes);
+  bucketRowInHashTable = std::move(rows);
+
+  overflowBuckets.clear();
+  numOverflowPoints = 0;
+  numPendingRemovals = 0;
+}
+
+// Pack the contents of the buckets.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::PackBuckets(
+    const bool slack,
+    arma::Col<size_t>& offsets,
+    arma::Col<uint32_t>& points,
+    arma::Col<size_t>& sizes,
+    arma::Col<size_t>& rows) const
+{
+  // Count the points that remain in each bucket.
+  arma::Col<size_t> counts(secondHashSize, arma::fill::zeros);
+  for (size_t h = 0; h < secondHashSize; ++h)
+  {
+    const size_t row = bucketRowInHashTable[h];
+    if (row >= secondHashSize)
+      continue;
+
+    const uint32_t* bucket = bucketPoints.memptr() + bucketOffsets[row];
+    for (size_t j = 0; j < bucketContentSize[row]; ++j)
+      if (!removedPoints[bucket[j]])
+        ++counts[h];
+  }
+
+  typedef typename std::unordered_map<size_t, std::vector<uint32_t>>::
+      const_iterator OverflowIterator;
+  for (OverflowIterator it = overflowBuckets.begin();
+       it != overflowBuckets.end(); ++it)
+  {
+    for (size_t j = 0; j < it->second.size(); ++j)
+      if (!removedPoints[it->second[j]])
+        ++counts[it->first];
+  }
+
+  // Number the non-empty buckets in increasing order of hash value, as
+  // Train() does, and give each of them its space; with slack, a quarter of
+  // the size (but at least one entry) is left free.
+  rows.set_size(secondHashSize);
+  size_t numRows = 0;
+  for (size_t h = 0; h < secondHashSize; ++h)
+    rows[h] = (counts[h] > 0) ? numRows++ : secondHashSize;
+
+  sizes.set_size(numRows);
+  offsets.set_size(numRows + 1);
+  offsets[0] = 0;
+  for (size_t h = 0; h < secondHashSize; ++h)
+  {
+    if (rows[h] == secondHashSize)
+      continue;
+
+    const size_t r = rows[h];
+    sizes[r] = counts[h];
+    offsets[r + 1] = offsets[r] + counts[h] +
+        (slack ? counts[h] / 4 + 1 : 0);
+  }
+
+  // Fill the buckets: first the packed points, then the ones held aside.
+  points.zeros(offsets[numRows]);
+  for (size_t h = 0; h < secondHashSize; ++h)
+  {
+    if (rows[h] == secondHashSize)
+      continue;
+
+    uint32_t* out = points.memptr() + offsets[rows[h]];
+    const size_t row = bucketRowInHashTable[h];
+    if (row < secondHashSize)
+    {
+      const uint32_t* bucket = bucketPoints.memptr() + bucketOffsets[row];
+      for (size_t j = 0; j < bucketContentSize[row]; ++j)
+        if (!removedPoints[bucket[j]])
+          *out++ = bucket[j];
+    }
+
+    OverflowIterator it = overflowBuckets.find(h);
+    if (it != overflowBuckets.end())
+    {
+      for (size_t j = 0; j < it->second.size(); ++j)
+        if (!removedPoints[it->second[j]])
+          *out++ = it->second[j];
+    }
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+std::vector<arma::Col<size_t>>
+LSHSearch<SortPolicy, MatType>::SecondHashTable() const
+{
+  std::vector<arma::Col<size_t>> secondHashTable(bucketContentSize.n_elem);
+  for (size_t i = 0; i < bucketContentSize.n_elem; ++i)
+  {
+    secondHashTable[i].set_size(bucketContentSize[i]);
+    for (size_t j = 0; j < bucketContentSize[i]; ++j)
+      secondHashTable[i][j] = bucketPoints[bucketOffsets[i] + j];
+  }
+
+  return secondHashTable;
+}
+
 template<typename SortPolicy, typename MatType>
 double LSHSearch<SortPolicy, MatType>::ComputeRecall(
     const arma::Mat<size_t>& foundNeighbors,
@@ -1071,78 +1375,132 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar & BOOST_SERIALIZATION_NVP(secondHashSize);
   ar & BOOST_SERIALIZATION_NVP(secondHashWeights);
   ar & BOOST_SERIALIZATION_NVP(bucketSize);
-  // needs specific handling for new version
 
-  // Backward compatibility: in older versions of LSHSearch, the secondHashTable
-  // was stored as an arma::Mat<size_t>.  So we need to properly load that, then
-  // prune it down to size.
-  if (version == 0)
+  // Backward compatibility: versions 0 and 1 of LSHSearch stored the second
+  // hash table as one vector per non-empty bucket.  Load it in that form, then
+  // pack it.
+  if (version < 2)
   {
-    arma::Mat<size_t> tmpSecondHashTable;
-    ar & BOOST_SERIALIZATION_NVP(tmpSecondHashTable);
-
-    // The old secondHashTable was stored in row-major format, so we transpose
-    // it.
-    tmpSecondHashTable = tmpSecondHashTable.t();
+    std::vector<arma::Col<size_t>> secondHashTable;
 
-    secondHashTable.resize(tmpSecondHashTable.n_cols);
-    for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
+    // Backward compatibility: in older versions of LSHSearch, the
+    // secondHashTable was stored as an arma::Mat<size_t>.  So we need to
+    // properly load that, then prune it down to size.
+    if (version == 0)
     {
-      // Find length of each column.  We know we are at the end of the list when
-      // the value referenceSet.n_cols is seen.
+      arma::Mat<size_t> tmpSecondHashTable;
+      ar & BOOST_SERIALIZATION_NVP(tmpSecondHashTable);
 
-      size_t len = 0;
-      for (; len < tmpSecondHashTable.n_rows; ++len)
-        if (tmpSecondHashTable(len, i) == referenceSet.n_cols)
-          break;
+      // The old secondHashTable was stored in row-major format, so we
+      // transpose it.
+      tmpSecondHashTable = tmpSecondHashTable.t();
 
-      // Set the size of the new column correctly.
-      secondHashTable[i].set_size(len);
-      for (size_t j = 0; j < len; ++j)
-        secondHashTable[i](j) = tmpSecondHashTable(j, i);
+      secondHashTable.resize(tmpSecondHashTable.n_cols);
+      for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
+      {
+        // Find length of each column.  We know we are at the end of the list
+        // when the value referenceSet.n_cols is seen.
+
+        size_t len = 0;
+        for (; len < tmpSecondHashTable.n_rows; ++len)
+          if (tmpSecondHashTable(len, i) == referenceSet.n_cols)
+            break;
+
+        // Set the size of the new column correctly.
+        secondHashTable[i].set_size(len);
+        for (size_t j = 0; j < len; ++j)
+          secondHashTable[i](j) = tmpSecondHashTable(j, i);
+      }
     }
-  }
-  else
-  {
-    size_t tables;
-    if (Archive::is_saving::value)
-      tables = secondHashTable.size();
-    ar & BOOST_SERIALIZATION_NVP(tables);
-
-    // Set size of second hash table if needed.
-    if (Archive::is_loading::value)
+    else
     {
-      secondHashTable.clear();
+      size_t tables;
+      ar & BOOST_SERIALIZATION_NVP(tables);
       secondHashTable.resize(tables);
+
+      ar & BOOST_SERIALIZATION_NVP(secondHashTable);
     }
 
-    ar & BOOST_SERIALIZATION_NVP(secondHashTable);
-  }
+    // Backward compatibility: old versions of LSHSearch held bucketContentSize
+    // for all possible buckets (of size secondHashSize), but now we hold a
+    // compressed representation.
+    if (version == 0)
+    {
+      // The vector was stored in the old uncompressed form.  So we need to
+      // shrink it.  But we can't do that until we have bucketRowInHashTable,
+      // so we also have to load that.
+      arma::Col<size_t> tmpBucketContentSize;
+      ar & BOOST_SERIALIZATION_NVP(tmpBucketContentSize);
+      ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
+
+      // Compress into a smaller vector by just dropping all of the zeros.
+      bucketContentSize.set_size(secondHashTable.size());
+      for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
+        if (tmpBucketContentSize[i] > 0)
+          bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
+    }
+    else
+    {
+      ar & BOOST_SERIALIZATION_NVP(bucketContentSize);
+      ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
+    }
 
-  // Backward compatibility: old versions of LSHSearch held bucketContentSize
-  // for all possible buckets (of size secondHashSize), but now we hold a
-  // compressed representation.
-  if (version == 0)
-  {
-    // The vector was stored in the old uncompressed form.  So we need to shrink
-    // it.  But we can't do that until we have bucketRowInHashTable, so we also
-    // have to load that.
-    arma::Col<size_t> tmpBucketContentSize;
-    ar & BOOST_SERIALIZATION_NVP(tmpBucketContentSize);
-    ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
+    // Now pack the buckets.
+    bucketOffsets.set_size(secondHashTable.size() + 1);
+    bucketOffsets[0] = 0;
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      bucketOffsets[i + 1] = bucketOffsets[i] + bucketContentSize[i];
 
-    // Compress into a smaller vector by just dropping all of the zeros.
-    bucketContentSize.set_size(secondHashTable.size());
-    for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
-      if (tmpBucketContentSize[i] > 0)
-        bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
+    bucketPoints.set_size(bucketOffsets[secondHashTable.size()]);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        bucketPoints[bucketOffsets[i] + j] = (uint32_t) secondHashTable[i][j];
+  }
+  else if (Archive::is_saving::value && (numOverflowPoints > 0 ||
+      numPendingRemovals > 0 || (bucketOffsets.n_elem > 0 &&
+      bucketOffsets[bucketOffsets.n_elem - 1] != arma::accu(bucketContentSize))))
+  {
+    // Points have been inserted or removed since the buckets were last
+    // packed, so save a packed copy; this keeps the format of the archive the
+    // same as that of a freshly trained model.
+    arma::Col<size_t> packedOffsets, packedContentSize, packedRows;
+    arma::Col<uint32_t> packedPoints;
+    PackBuckets(false, packedOffsets, packedPoints, packedContentSize,
+        packedRows);
+
+    ar & boost::serialization::make_nvp("bucketOffsets", packedOffsets);
+    ar & boost::serialization::make_nvp("bucketPoints", packedPoints);
+    ar & boost::serialization::make_nvp("bucketContentSize",
+        packedContentSize);
+    ar & boost::serialization::make_nvp("bucketRowInHashTable", packedRows);
   }
   else
   {
+    ar & BOOST_SERIALIZATION_NVP(bucketOffsets);
+    ar & BOOST_SERIALIZATION_NVP(bucketPoints);
     ar & BOOST_SERIALIZATION_NVP(bucketContentSize);
     ar & BOOST_SERIALIZATION_NVP(bucketRowInHashTable);
   }
 
+  // Removed points are not part of the saved buckets, so a loaded model has
+  // nothing pending, but it still has to know which points were removed.
+  // Older versions had no removed points.
+  if (version >= 3)
+  {
+    ar & BOOST_SERIALIZATION_NVP(removedPoints);
+  }
+  else if (Archive::is_loading::value)
+  {
+    removedPoints.assign(referenceSet.n_cols, false);
+  }
+
+  if (Archive::is_loading::value)
+  {
+    overflowBuckets.clear();
+    numOverflowPoints = 0;
+    numPendingRemovals = 0;
+  }
+
   ar & BOOST_SERIALIZATION_NVP(distanceEvaluations);
 }
 
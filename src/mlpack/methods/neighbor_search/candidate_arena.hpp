@@ -0,0 +1,170 @@
+/**
+ * @file methods/neighbor_search/candidate_arena.hpp
+ *
+ * Flat storage of the k best candidates of every query point, shared by the
+ * neighbor search rules.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_CANDIDATE_ARENA_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_CANDIDATE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The CandidateArena stores the k best candidates (distance and index) of
+ * every query point in two contiguous k x n matrices, instead of one
+ * priority queue object per query point.  Each column is kept sorted, with the
+ * best candidate in the first row and the worst candidate in the last row, so
+ * the pruning bound of a query is a single lookup and the final results need
+ * no extraction step.
+ *
+ * Candidates are only inserted if they are strictly better than the current
+ * worst candidate; candidates with equal distances keep the order in which
+ * they were inserted.  For small k the insertion position is found with a
+ * linear scan from the end of the column, and for larger k with a binary
+ * search.
+ *
+ * @tparam SortPolicy The sort policy for distances; only IsBetter() and
+ *     WorstDistance() are used.
+ */
+template<typename SortPolicy>
+class CandidateArena
+{
+ public:
+  //! Up to this k, the insertion position is found with a linear scan.
+  static const size_t LinearScanLimit = 16;
+
+  /**
+   * Create the arena for the given number of queries, with every candidate
+   * initialized to (worstDistance, size_t() - 1).
+   *
+   * @param k Number of candidates per query point.
+   * @param numQueries Number of query points.
+   * @param worstDistance Distance of the initial (invalid) candidates.
+   */
+  CandidateArena(const size_t k,
+                 const size_t numQueries,
+                 const double worstDistance = SortPolicy::WorstDistance()) :
+      k(k)
+  {
+    distances.set_size(k, numQueries);
+    distances.fill(worstDistance);
+    indices.set_size(k, numQueries);
+    indices.fill(size_t() - 1);
+  }
+
+  //! Get the distance of the worst (k'th best) candidate of the given query.
+  double WorstDistance(const size_t queryIndex) const
+  {
+    return distances(k - 1, queryIndex);
+  }
+
+  /**
+   * Insert a candidate for the given query point, if it is strictly better
+   * than the current worst candidate.
+   *
+   * @param queryIndex Index of the query point.
+   * @param index Index of the candidate point.
+   * @param distance Distance of the candidate point.
+   * @return Whether the candidate was inserted.
+   */
+  bool Insert(const size_t queryIndex, const size_t index,
+              const double distance)
+  {
+    return Insert(distances.colptr(queryIndex), indices.colptr(queryIndex), k,
+        index, distance);
+  }
+
+  /**
+   * Insert a candidate into a single sorted candidate list of length k, given
+   * as raw distance and index arrays, if it is strictly better than the last
+   * (worst) candidate.  This allows callers that handle one query at a time to
+   * work directly on columns of their output matrices.
+   *
+   * @param d Candidate distances, sorted best first.
+   * @param n Candidate indices.
+   * @param k Number of candidates.
+   * @param index Index of the candidate point.
+   * @param distance Distance of the candidate point.
+   * @return Whether the candidate was inserted.
+   */
+  static bool Insert(double* d,
+                     size_t* n,
+                     const size_t k,
+                     const size_t index,
+                     const double distance)
+  {
+    if (SortPolicy::IsBetter(d[k - 1], distance))
+      return false;
+
+    // Find the first candidate that is strictly worse than the new one.
+    size_t pos;
+    if (k <= LinearScanLimit)
+    {
+      pos = k - 1;
+      while (pos > 0 && !SortPolicy::IsBetter(d[pos - 1], distance))
+        --pos;
+    }
+    else
+    {
+      size_t lo = 0, hi = k - 1;
+      while (lo < hi)
+      {
+        const size_t mid = (lo + hi) / 2;
+        if (SortPolicy::IsBetter(d[mid], distance))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      pos = lo;
+    }
+
+    // Shift the worse candidates down, dropping the last one.
+    std::copy_backward(d + pos, d + k - 1, d + k);
+    std::copy_backward(n + pos, n + k - 1, n + k);
+    d[pos] = distance;
+    n[pos] = index;
+    return true;
+  }
+
+  //! Get the number of candidates per query point.
+  size_t K() const { return k; }
+
+  //! Get the candidate distances (sorted best first in each column).
+  const arma::mat& Distances() const { return distances; }
+  //! Get the candidate indices (sorted best first in each column).
+  const arma::Mat<size_t>& Indices() const { return indices; }
+
+  /**
+   * Move the candidates into the given matrices; the arena is empty
+   * afterwards.
+   *
+   * @param neighbors Matrix to store the candidate indices in.
+   * @param distances Matrix to store the candidate distances in.
+   */
+  void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances)
+  {
+    neighbors = std::move(this->indices);
+    distances = std::move(this->distances);
+  }
+
+ private:
+  //! Number of candidates per query point.
+  size_t k;
+  //! Candidate distances; column i holds the candidates of query point i.
+  arma::mat distances;
+  //! Candidate indices; column i holds the candidates of query point i.
+  arma::Mat<size_t> indices;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -12,6 +12,7 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/chunk_reader.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
@@ -50,7 +51,12 @@ BINDING_LONG_DESC(
     "points using kd-trees or cover trees (cover tree support is experimental "
     "and may be slow). You may specify a separate set of "
     "reference points and query points, or just a reference set which will be "
-    "used as both the reference and query set.");
+    "used as both the reference and query set."
+    "\n\n"
+    "Query sets that are too large to fit in memory can be given as a file "
+    "with the " + PRINT_PARAM_STRING("query_file") + " parameter instead of "
+    "the " + PRINT_PARAM_STRING("query") + " parameter; the file is then read "
+    "and searched " + PRINT_PARAM_STRING("chunk_size") + " points at a time.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -97,6 +103,11 @@ PARAM_MODEL_OUT(KNNModel, "output_model", "If specified, the kNN model will be "
 // The user may specify a query file of query points and a number of nearest
 // neighbors to search for.
 PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
+PARAM_STRING_IN("query_file", "File containing query points, which is read in "
+    "chunks so that it does not need to fit in memory (optional; an "
+    "alternative to 'query').", "", "");
+PARAM_INT_IN("chunk_size", "Number of query points read at a time from the "
+    "query file.", "", 65536);
 PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 
 // The user may specify the type of tree to use, and a few parameters for tree
@@ -161,6 +172,14 @@ static void mlpackMain()
   ReportIgnoredParam({{ "k", false }}, "true_neighbors");
   ReportIgnoredParam({{ "k", false }}, "true_distances");
   ReportIgnoredParam({{ "k", false }}, "query");
+  ReportIgnoredParam({{ "k", false }}, "query_file");
+  ReportIgnoredParam({{ "query_file", false }}, "chunk_size");
+  if (IO::HasParam("query_file"))
+    RequireOnlyOnePassed({ "query", "query_file" }, true);
+
+  // Sanity check on chunk size.
+  RequireParamValue<int>("chunk_size", [](int x) { return x > 0; },
+      true, "chunk size must be positive");
 
   // Sanity check on leaf size.
   RequireParamValue<int>("leaf_size", [](int x) { return x > 0; },
@@ -323,7 +342,8 @@ static void mlpackMain()
 
     // Sanity check on k value: must not be equal to the number of reference
     // points when query data has not been provided.
-    if (!IO::HasParam("query") && k == knn->Dataset().n_cols)
+    if (!IO::HasParam("query") && !IO::HasParam("query_file") &&
+        k == knn->Dataset().n_cols)
     {
       // Clean memory if needed before crashing.
       const size_t referencePoints = knn->Dataset().n_cols;
@@ -339,9 +359,102 @@ static void mlpackMain()
     arma::mat distances;
 
     if (IO::HasParam("query"))
+    {
       knn->Search(std::move(queryData), k, neighbors, distances);
+    }
+    else if (IO::HasParam("query_file"))
+    {
+      // The query set is read and searched one chunk at a time, so that only
+      // the results have to fit in memory.  When the number of points is known
+      // in advance (binary and HDF5 files), the results of every chunk are
+      // written in place; otherwise (text files) they are kept until the end.
+      const string queryFile = IO::GetParam<string>("query_file");
+      Log::Info << "Using query data from '" << queryFile << "'." << endl;
+
+      vector<arma::Mat<size_t>> chunkNeighbors;
+      vector<arma::mat> chunkDistances;
+      size_t numQueries = 0;
+      bool inPlace = false;
+      try
+      {
+        data::ChunkReader<double> reader(queryFile,
+            (size_t) IO::GetParam<int>("chunk_size"));
+        if (reader.Dimensionality() != knn->Dataset().n_rows)
+        {
+          ostringstream oss;
+          oss << "Query has invalid dimensions(" << reader.Dimensionality()
+              << "); should be " << knn->Dataset().n_rows << "!";
+          throw invalid_argument(oss.str());
+        }
+
+        inPlace = (reader.NumPoints() != 0);
+        if (inPlace)
+        {
+          neighbors.set_size(k, reader.NumPoints());
+          distances.set_size(k, reader.NumPoints());
+        }
+
+        arma::mat chunk;
+        while (reader.Next(chunk))
+        {
+          if (inPlace)
+          {
+            const size_t begin = numQueries;
+            numQueries += chunk.n_cols;
+            if (numQueries > neighbors.n_cols)
+            {
+              throw runtime_error("Query file holds more points than "
+                  "expected!");
+            }
+
+            // Search into the columns of the results.
+            arma::Mat<size_t> neighborsChunk(neighbors.colptr(begin), k,
+                chunk.n_cols, false, true);
+            arma::mat distancesChunk(distances.colptr(begin), k, chunk.n_cols,
+                false, true);
+            knn->Search(std::move(chunk), k, neighborsChunk, distancesChunk);
+          }
+          else
+          {
+            chunkNeighbors.emplace_back();
+            chunkDistances.emplace_back();
+            knn->Search(std::move(chunk), k, chunkNeighbors.back(),
+                chunkDistances.back());
+            numQueries += chunkNeighbors.back().n_cols;
+          }
+        }
+
+        if (inPlace && numQueries != neighbors.n_cols)
+          throw runtime_error("Query file holds fewer points than expected!");
+      }
+      catch (exception& e)
+      {
+        // Clean memory if needed before crashing.
+        if (IO::HasParam("reference"))
+          delete knn;
+        Log::Fatal << e.what() << endl;
+      }
+
+      if (!inPlace)
+      {
+        neighbors.set_size(k, numQueries);
+        distances.set_size(k, numQueries);
+        size_t begin = 0;
+        for (size_t i = 0; i < chunkNeighbors.size(); ++i)
+        {
+          const size_t end = begin + chunkNeighbors[i].n_cols;
+          neighbors.cols(begin, end - 1) = chunkNeighbors[i];
+          distances.cols(begin, end - 1) = chunkDistances[i];
+          chunkNeighbors[i].reset();
+          chunkDistances[i].reset();
+          begin = end;
+        }
+      }
+    }
     else
+    {
       knn->Search(k, neighbors, distances);
+    }
     Log::Info << "Search complete." << endl;
 
     // Calculate the effective error, if desired.
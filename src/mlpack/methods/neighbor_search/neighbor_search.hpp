@@ -206,6 +206,26 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Save the reference tree and the original indices of its points to a flat
+   * file that LoadFlat() can memory-map.  This is only available for trees
+   * that can be saved with BinarySpaceTree::SaveFlat() (such as kd-trees and
+   * ball trees), and not in naive mode.
+   *
+   * @param filename Name of the file to write.
+   */
+  void SaveFlat(const std::string& filename) const;
+
+  /**
+   * Set the reference tree to the tree saved in the given flat file by
+   * SaveFlat().  The file is memory-mapped instead of deserialized, so the
+   * reference set is read from disk as it is searched.  Results are given with
+   * the original indices of the reference points.
+   *
+   * @param filename Name of the file to load.
+   */
+  void LoadFlat(const std::string& filename);
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -373,6 +373,54 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
   this->referenceSet = &this->referenceTree->Dataset();
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SaveFlat(
+    const std::string& filename) const
+{
+  if (!referenceTree)
+    throw std::invalid_argument("cannot save a reference tree in naive mode");
+
+  referenceTree->SaveFlat(filename, oldFromNewReferences);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::LoadFlat(
+    const std::string& filename)
+{
+  if (searchMode == NAIVE_MODE)
+    throw std::invalid_argument("cannot load a reference tree when naive "
+        "search (without trees) is desired");
+
+  // Load the tree first, so that nothing changes if the file cannot be used.
+  std::vector<size_t> oldFromNew;
+  Tree* tree = new Tree(filename, oldFromNew);
+
+  if (this->referenceTree)
+    delete this->referenceTree;
+  else
+    delete this->referenceSet;
+
+  this->referenceTree = tree;
+  this->referenceSet = &this->referenceTree->Dataset();
+  oldFromNewReferences = std::move(oldFromNew);
+}
+
 /**
  * Computes the best neighbors and stores them in resultingNeighbors and
  * distances.
@@ -14,6 +14,9 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/metrics/distance_tile.hpp>
+
+#include "candidate_arena.hpp"
 
 #include <queue>
 
@@ -73,6 +76,21 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Perform the base cases between the given query points and a contiguous
+   * block of reference points, as if BaseCase() was called for each pair.  If
+   * the metric supports it, a tile of distance bounds is computed at once, and
+   * only the pairs that could improve the candidate lists are evaluated
+   * exactly.
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void BlockBaseCase(const arma::uvec& queryIndices,
+                     const size_t referenceBegin,
+                     const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -168,23 +186,8 @@ class NeighborSearchRules
   //! The query set.
   const typename TreeType::Mat& querySet;
 
-  //! Candidate represents a possible candidate neighbor (distance, index).
-  typedef std::pair<double, size_t> Candidate;
-
-  //! Compare two candidates based on the distance.
-  struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
-    {
-      return !SortPolicy::IsBetter(c2.first, c1.first);
-    };
-  };
-
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
-
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! The k candidate neighbors of every query point.
+  CandidateArena<SortPolicy> candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -214,6 +217,9 @@ class NeighborSearchRules
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  //! Used to compute blocks of distances in BlockBaseCase().
+  metric::DistanceTile<MetricType, typename TreeType::Mat> distanceTile;
+
   /**
    * Recalculate the bound for a given query node.
    */
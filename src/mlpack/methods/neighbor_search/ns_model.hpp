@@ -402,6 +402,38 @@ class NSModel
 
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
+
+  /**
+   * Save the reference tree to a flat file that LoadFlat() can memory-map (see
+   * NeighborSearch::SaveFlat()).  Only kd-trees and ball trees without a random
+   * basis can be saved this way.
+   *
+   * @param filename Name of the file to write.
+   */
+  void SaveFlat(const std::string& filename) const;
+
+  /**
+   * Replace the reference tree with the one in the given flat file, which must
+   * have been written by SaveFlat() for a model with the same tree type.  The
+   * file is memory-mapped instead of deserialized, so this takes about the same
+   * time for any size of model.
+   *
+   * @param filename Name of the file to load.
+   * @param searchMode Search mode to use; it cannot be NAIVE_MODE.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  void LoadFlat(const std::string& filename,
+                const NeighborSearchMode searchMode = DUAL_TREE_MODE,
+                const double epsilon = 0);
+
+ private:
+  //! Load the reference tree of the given type from the given flat file.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void LoadFlatTree(const std::string& filename,
+                    const NeighborSearchMode searchMode,
+                    const double epsilon);
 };
 
 } // namespace neighbor
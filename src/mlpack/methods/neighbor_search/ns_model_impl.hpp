@@ -635,6 +635,84 @@ std::string NSModel<SortPolicy>::TreeName() const
   }
 }
 
+//! Save the reference tree to a flat file.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::SaveFlat(const std::string& filename) const
+{
+  // The random basis is not a part of the tree.
+  if (randomBasis)
+  {
+    throw std::invalid_argument("NSModel::SaveFlat(): models with a random "
+        "basis cannot be saved to flat files");
+  }
+
+  switch (treeType)
+  {
+    case KD_TREE:
+      boost::get<NSType<SortPolicy, tree::KDTree>*>(nSearch)->SaveFlat(
+          filename);
+      break;
+    case BALL_TREE:
+      boost::get<NSType<SortPolicy, tree::BallTree>*>(nSearch)->SaveFlat(
+          filename);
+      break;
+    default:
+      throw std::invalid_argument("NSModel::SaveFlat(): only kd-trees and "
+          "ball trees can be saved to flat files");
+  }
+}
+
+//! Load the reference tree from a flat file.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::LoadFlat(const std::string& filename,
+                                   const NeighborSearchMode searchMode,
+                                   const double epsilon)
+{
+  if (randomBasis)
+  {
+    throw std::invalid_argument("NSModel::LoadFlat(): models with a random "
+        "basis cannot be loaded from flat files");
+  }
+
+  switch (treeType)
+  {
+    case KD_TREE:
+      LoadFlatTree<tree::KDTree>(filename, searchMode, epsilon);
+      break;
+    case BALL_TREE:
+      LoadFlatTree<tree::BallTree>(filename, searchMode, epsilon);
+      break;
+    default:
+      throw std::invalid_argument("NSModel::LoadFlat(): only kd-trees and "
+          "ball trees can be loaded from flat files");
+  }
+}
+
+template<typename SortPolicy>
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void NSModel<SortPolicy>::LoadFlatTree(const std::string& filename,
+                                       const NeighborSearchMode searchMode,
+                                       const double epsilon)
+{
+  // Keep the current model if the file cannot be used.
+  NSType<SortPolicy, TreeType>* ns = new NSType<SortPolicy, TreeType>(
+      searchMode, epsilon);
+  try
+  {
+    ns->LoadFlat(filename);
+  }
+  catch (...)
+  {
+    delete ns;
+    throw;
+  }
+
+  boost::apply_visitor(DeleteVisitor(), nSearch);
+  nSearch = ns;
+}
+
 } // namespace neighbor
 } // namespace mlpack
 
@@ -0,0 +1,231 @@
+/**
+ * @file methods/preprocess/pipeline.hpp
+ *
+ * A preprocessing pipeline that chains imputation, one-hot encoding and
+ * scaling, and applies them in one pass over the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PREPROCESS_PIPELINE_HPP
+#define MLPACK_METHODS_PREPROCESS_PIPELINE_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/column_blocks.hpp>
+#include <mlpack/core/data/one_hot_encoding.hpp>
+#include "scaling_model.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A preprocessing pipeline, which applies the following steps to every point,
+ * in this order:
+ *
+ *  - imputation: the missing values of some dimensions (the given value, or
+ *    NaN) are replaced with the mean or the median of the dimension, or with a
+ *    custom value, like Imputer with MeanImputation, MedianImputation or
+ *    CustomImputation;
+ *  - one-hot encoding: some dimensions are replaced with one dimension for
+ *    every category, like OneHotEncoding();
+ *  - scaling: the encoded points are scaled with a ScalingModel.
+ *
+ * Every step is optional.  Fit() learns the parameters of the steps on a
+ * training set; Transform() then applies the steps to a dataset one block of
+ * columns at a time, in parallel, so that the data only goes through the
+ * memory once instead of once per step.  The pipeline can be serialized, and
+ * PipelineModel attaches it to a trained model.
+ *
+ * @code
+ * arma::mat data;
+ * data::DatasetInfo info;
+ * data::Load("train.csv", data, info);
+ *
+ * data::Pipeline pipeline;
+ * // Replace the missing values (NaN) of dimension 2 with its median.
+ * pipeline.AddImputation(2, NAN, data::Pipeline::MEDIAN_IMPUTATION);
+ * // Encode the categorical dimensions.
+ * pipeline.AddOneHotEncoding(info);
+ * // Standardize the encoded data.
+ * pipeline.AddScaling(data::ScalingModel::STANDARD_SCALER);
+ *
+ * pipeline.Fit(data);
+ * arma::mat output;
+ * pipeline.Transform(data, output);
+ * @endcode
+ *
+ * Categories of an encoded dimension that were not seen by Fit() are encoded
+ * as zeros in every dimension of their category.  Encoded dimensions should
+ * not hold NaN values, so they should be imputed if they have missing values.
+ */
+class Pipeline
+{
+ public:
+  //! The ways to compute the value that replaces the missing values.
+  enum ImputationTypes
+  {
+    MEAN_IMPUTATION,
+    MEDIAN_IMPUTATION,
+    CUSTOM_IMPUTATION
+  };
+
+  /**
+   * Create an empty pipeline, which does not change the data.
+   */
+  Pipeline();
+
+  /**
+   * Replace the missing values of the given dimension.  NaN values are
+   * always considered missing.
+   *
+   * @param dimension Dimension to impute.
+   * @param missingValue Value that marks a missing value.
+   * @param imputationType How to compute the value that replaces the missing
+   *     values.
+   * @param customValue Value that replaces the missing values, for
+   *     CUSTOM_IMPUTATION.
+   */
+  void AddImputation(const size_t dimension,
+                     const double missingValue,
+                     const ImputationTypes imputationType,
+                     const double customValue = 0.0);
+
+  /**
+   * One-hot encode the given dimension.
+   *
+   * @param dimension Dimension to encode.
+   */
+  void AddOneHotEncoding(const size_t dimension);
+
+  /**
+   * One-hot encode all the dimensions marked `Datatype::categorical` in the
+   * given data::DatasetInfo.
+   *
+   * @param datasetInfo DatasetInfo object that has information about data.
+   */
+  void AddOneHotEncoding(const data::DatasetInfo& datasetInfo);
+
+  /**
+   * Scale the encoded data with the given scaler.
+   *
+   * @param scalerType Type of the scaler (see ScalingModel::ScalerTypes).
+   * @param minValue Lower range of scaling, for the MIN_MAX_SCALER.
+   * @param maxValue Upper range of scaling, for the MIN_MAX_SCALER.
+   * @param epsilon Regularization parameter, for PCA_WHITENING and
+   *     ZCA_WHITENING.
+   */
+  void AddScaling(const size_t scalerType,
+                  const int minValue = 0,
+                  const int maxValue = 1,
+                  const double epsilon = 0.00005);
+
+  /**
+   * Learn the parameters of every step on the given dataset.
+   *
+   * @param input Dataset to fit.
+   */
+  void Fit(const arma::mat& input);
+
+  /**
+   * Apply every step to the given dataset.  Fit() must have been called.
+   *
+   * @param input Dataset to transform.
+   * @param output Matrix to store the transformed dataset in.
+   */
+  void Transform(const arma::mat& input, arma::mat& output);
+
+  //! Get the dimensionality of the input of the pipeline (0 before Fit()).
+  size_t InputDimensionality() const { return dimensionality; }
+
+  //! Get the dimensionality of the output of the pipeline (0 before Fit()).
+  size_t OutputDimensionality() const
+  {
+    return offsets.is_empty() ? 0 : offsets[offsets.n_elem - 1];
+  }
+
+  //! Get the dimensions that are imputed.
+  const arma::Col<size_t>& ImputedDimensions() const
+  { return imputedDimensions; }
+  //! Get the value that replaces the missing values of every imputed
+  //! dimension (only available after Fit()).
+  const arma::vec& FillValues() const { return fillValues; }
+
+  //! Get the dimensions that are one-hot encoded.
+  const arma::Col<size_t>& EncodedDimensions() const
+  { return encodedDimensions; }
+
+  //! Get whether the encoded data is scaled.
+  bool Scaling() const { return scaling; }
+  //! Get the scaling model.
+  const ScalingModel& Scaler() const { return scaler; }
+
+  //! Serialize the pipeline.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * Impute the given columns of the given dataset in place.
+   *
+   * @param data Dataset to impute.
+   * @param begin First column to impute.
+   * @param end One past the last column to impute.
+   */
+  void ImputeColumns(arma::mat& data,
+                     const size_t begin,
+                     const size_t end) const;
+
+  /**
+   * One-hot encode the given columns of the given dataset into the output,
+   * whose columns must be zero.
+   *
+   * @param data Dataset to encode.
+   * @param begin First column to encode.
+   * @param end One past the last column to encode.
+   * @param output Matrix to store the encoded columns in.
+   * @param outputBegin Column of the output where the first column is stored.
+   */
+  void EncodeColumns(const arma::mat& data,
+                     const size_t begin,
+                     const size_t end,
+                     arma::mat& output,
+                     const size_t outputBegin) const;
+
+  //! The dimensions that are imputed.
+  arma::Col<size_t> imputedDimensions;
+  //! The value that marks a missing value, for every imputed dimension.
+  arma::vec missingValues;
+  //! The imputation type of every imputed dimension.
+  arma::Col<size_t> imputationTypes;
+  //! The value that replaces the missing values of every imputed dimension.
+  arma::vec fillValues;
+
+  //! The dimensions that are one-hot encoded.
+  arma::Col<size_t> encodedDimensions;
+  //! The mapping from categories to rows of every dimension (empty for the
+  //! dimensions that are not encoded).
+  std::vector<details::CategoryMap<double>> mappings;
+  //! Whether every dimension is encoded.
+  std::vector<char> encoded;
+  //! The offset of every dimension in the output, followed by the
+  //! dimensionality of the output.
+  arma::Col<size_t> offsets;
+
+  //! Whether the encoded data is scaled.
+  bool scaling;
+  //! The scaling model.
+  ScalingModel scaler;
+
+  //! The dimensionality of the input.
+  size_t dimensionality;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "pipeline_impl.hpp"
+
+#endif
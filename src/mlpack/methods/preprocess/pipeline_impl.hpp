@@ -0,0 +1,316 @@
+/**
+ * @file methods/preprocess/pipeline_impl.hpp
+ *
+ * Implementation of the Pipeline class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PREPROCESS_PIPELINE_IMPL_HPP
+#define MLPACK_METHODS_PREPROCESS_PIPELINE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "pipeline.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline Pipeline::Pipeline() :
+    scaling(false),
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+inline void Pipeline::AddImputation(const size_t dimension,
+                                    const double missingValue,
+                                    const ImputationTypes imputationType,
+                                    const double customValue)
+{
+  if (arma::any(imputedDimensions == dimension))
+  {
+    std::ostringstream oss;
+    oss << "Pipeline::AddImputation(): dimension " << dimension << " is "
+        << "already imputed";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t n = imputedDimensions.n_elem;
+  imputedDimensions.resize(n + 1);
+  missingValues.resize(n + 1);
+  imputationTypes.resize(n + 1);
+  fillValues.resize(n + 1);
+
+  imputedDimensions[n] = dimension;
+  missingValues[n] = missingValue;
+  imputationTypes[n] = imputationType;
+  // The other fill values are computed by Fit().
+  fillValues[n] = customValue;
+}
+
+inline void Pipeline::AddOneHotEncoding(const size_t dimension)
+{
+  if (arma::any(encodedDimensions == dimension))
+    return;
+
+  encodedDimensions.resize(encodedDimensions.n_elem + 1);
+  encodedDimensions[encodedDimensions.n_elem - 1] = dimension;
+}
+
+inline void Pipeline::AddOneHotEncoding(const data::DatasetInfo& datasetInfo)
+{
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+      AddOneHotEncoding(i);
+  }
+}
+
+inline void Pipeline::AddScaling(const size_t scalerType,
+                                 const int minValue,
+                                 const int maxValue,
+                                 const double epsilon)
+{
+  scaler = ScalingModel(minValue, maxValue, epsilon);
+  scaler.ScalerType() = scalerType;
+  scaling = true;
+}
+
+inline void Pipeline::Fit(const arma::mat& input)
+{
+  if ((!imputedDimensions.is_empty() &&
+       arma::max(imputedDimensions) >= input.n_rows) ||
+      (!encodedDimensions.is_empty() &&
+       arma::max(encodedDimensions) >= input.n_rows))
+  {
+    std::ostringstream oss;
+    oss << "Pipeline::Fit(): the pipeline uses dimensions that the data (of "
+        << "dimensionality " << input.n_rows << ") does not have";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Compute the values that replace the missing values.  The dimensions are
+  // independent, so they are handled in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) imputedDimensions.n_elem; ++i)
+  {
+    if (imputationTypes[i] == CUSTOM_IMPUTATION)
+      continue;
+
+    arma::vec values(input.n_cols);
+    size_t numValues = 0;
+    for (size_t col = 0; col < input.n_cols; ++col)
+    {
+      const double value = input(imputedDimensions[i], col);
+      if (!(value == missingValues[i] || std::isnan(value)))
+        values[numValues++] = value;
+    }
+
+    if (numValues == 0)
+      fillValues[i] = std::numeric_limits<double>::quiet_NaN();
+    else if (imputationTypes[i] == MEAN_IMPUTATION)
+      fillValues[i] = arma::mean(values.head(numValues));
+    else
+      fillValues[i] = arma::median(values.head(numValues));
+  }
+
+  for (size_t i = 0; i < imputedDimensions.n_elem; ++i)
+  {
+    if (imputationTypes[i] != CUSTOM_IMPUTATION && std::isnan(fillValues[i]))
+    {
+      std::ostringstream oss;
+      oss << "Pipeline::Fit(): dimension " << imputedDimensions[i] << " has "
+          << "no valid values to impute from";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  dimensionality = input.n_rows;
+
+  // The encoding and the scaling are learned on the imputed data.
+  arma::mat imputed(input);
+  ForEachColumnBlock(imputed.n_rows, imputed.n_cols,
+      [&](const size_t /* block */, const size_t begin, const size_t end)
+      {
+        ImputeColumns(imputed, begin, end);
+      });
+
+  details::OneHotEncodingMappings(imputed, encodedDimensions, mappings, encoded,
+      offsets);
+
+  if (scaling)
+  {
+    arma::mat encodedData(offsets[dimensionality], imputed.n_cols,
+        arma::fill::zeros);
+    ForEachColumnBlock(encodedData.n_rows, imputed.n_cols,
+        [&](const size_t /* block */, const size_t begin, const size_t end)
+        {
+          EncodeColumns(imputed, begin, end, encodedData, begin);
+        });
+    scaler.Fit(encodedData);
+  }
+}
+
+inline void Pipeline::Transform(const arma::mat& input, arma::mat& output)
+{
+  if (offsets.is_empty())
+  {
+    throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+  }
+
+  if (input.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "Pipeline::Transform(): the data has dimensionality "
+        << input.n_rows << " but the pipeline was fitted on data of "
+        << "dimensionality " << dimensionality;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The output may have a different size, so it cannot replace the input in
+  // place.
+  if (&input == &output)
+  {
+    arma::mat transformed;
+    Transform(input, transformed);
+    output = std::move(transformed);
+    return;
+  }
+
+  // The whitening matrix is only built once, and not for every block.
+  arma::mat whitening;
+  arma::vec whiteningMean;
+  const bool whiten = scaling && scaler.Whitening(whitening, whiteningMean);
+
+  // Every block goes through every step before the next one is read.
+  const size_t outputDimensionality = offsets[dimensionality];
+  output.set_size(outputDimensionality, input.n_cols);
+  ForEachColumnBlock(std::max(dimensionality, outputDimensionality),
+      input.n_cols,
+      [&](const size_t /* block */, const size_t begin, const size_t end)
+      {
+        arma::mat block = input.cols(begin, end - 1);
+        ImputeColumns(block, 0, block.n_cols);
+
+        if (scaling)
+        {
+          arma::mat encodedBlock(outputDimensionality, block.n_cols,
+              arma::fill::zeros);
+          EncodeColumns(block, 0, block.n_cols, encodedBlock, 0);
+
+          if (whiten)
+          {
+            output.cols(begin, end - 1) = whitening *
+                (encodedBlock.each_col() - whiteningMean);
+          }
+          else
+          {
+            arma::mat scaledBlock;
+            scaler.Transform(encodedBlock, scaledBlock);
+            output.cols(begin, end - 1) = scaledBlock;
+          }
+        }
+        else
+        {
+          output.cols(begin, end - 1).zeros();
+          EncodeColumns(block, 0, block.n_cols, output, begin);
+        }
+      });
+}
+
+inline void Pipeline::ImputeColumns(arma::mat& data,
+                                    const size_t begin,
+                                    const size_t end) const
+{
+  for (size_t col = begin; col < end; ++col)
+  {
+    for (size_t i = 0; i < imputedDimensions.n_elem; ++i)
+    {
+      double& value = data(imputedDimensions[i], col);
+      if (value == missingValues[i] || std::isnan(value))
+        value = fillValues[i];
+    }
+  }
+}
+
+inline void Pipeline::EncodeColumns(const arma::mat& data,
+                                    const size_t begin,
+                                    const size_t end,
+                                    arma::mat& output,
+                                    const size_t outputBegin) const
+{
+  for (size_t col = begin; col < end; ++col)
+  {
+    const size_t outputCol = outputBegin + (col - begin);
+    for (size_t row = 0; row < data.n_rows; ++row)
+    {
+      const double value = data(row, col);
+      if (encoded[row])
+      {
+        // Unknown categories are left at zero.
+        details::CategoryMap<double>::const_iterator it =
+            mappings[row].find(value);
+        if (it != mappings[row].end())
+          output(offsets[row] + it->second, outputCol) = 1.0;
+      }
+      else
+      {
+        output(offsets[row], outputCol) = value;
+      }
+    }
+  }
+}
+
+template<typename Archive>
+void Pipeline::serialize(Archive& ar, const unsigned int /* version */)
+{
+  // Text and XML archives cannot hold NaN, which is a common missing value,
+  // so NaN missing values are stored as flags.
+  arma::vec storedMissingValues(missingValues);
+  arma::Col<size_t> nanMissingValues(missingValues.n_elem);
+  for (size_t i = 0; i < missingValues.n_elem; ++i)
+  {
+    nanMissingValues[i] = std::isnan(missingValues[i]) ? 1 : 0;
+    if (nanMissingValues[i])
+      storedMissingValues[i] = 0.0;
+  }
+
+  ar & BOOST_SERIALIZATION_NVP(dimensionality);
+  ar & BOOST_SERIALIZATION_NVP(imputedDimensions);
+  ar & BOOST_SERIALIZATION_NVP(storedMissingValues);
+  ar & BOOST_SERIALIZATION_NVP(nanMissingValues);
+  ar & BOOST_SERIALIZATION_NVP(imputationTypes);
+  ar & BOOST_SERIALIZATION_NVP(fillValues);
+  ar & BOOST_SERIALIZATION_NVP(encodedDimensions);
+  ar & BOOST_SERIALIZATION_NVP(mappings);
+  ar & BOOST_SERIALIZATION_NVP(offsets);
+  ar & BOOST_SERIALIZATION_NVP(scaling);
+  ar & BOOST_SERIALIZATION_NVP(scaler);
+
+  if (Archive::is_loading::value)
+  {
+    missingValues = storedMissingValues;
+    for (size_t i = 0; i < missingValues.n_elem; ++i)
+    {
+      if (nanMissingValues[i])
+        missingValues[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Only the encoded dimensions are stored, and the mappings are empty if
+    // the pipeline was not fitted.
+    encoded.assign(mappings.size(), 0);
+    for (size_t i = 0; i < encodedDimensions.n_elem; ++i)
+    {
+      if (encodedDimensions[i] < encoded.size())
+        encoded[encodedDimensions[i]] = 1;
+    }
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file methods/preprocess/pipeline_model.hpp
+ *
+ * A model that is trained on, and applied to, the output of a preprocessing
+ * Pipeline.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PREPROCESS_PIPELINE_MODEL_HPP
+#define MLPACK_METHODS_PREPROCESS_PIPELINE_MODEL_HPP
+
+#include <mlpack/core.hpp>
+#include "pipeline.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * PipelineModel attaches a preprocessing Pipeline to a model, so that the
+ * model can be trained on and applied to raw data: Train() fits the pipeline
+ * and trains the model on the transformed data, and Classify() and Predict()
+ * transform the data with the pipeline before they call the same function of
+ * the model.  Both are serialized together.
+ *
+ * @code
+ * data::Pipeline pipeline;
+ * pipeline.AddOneHotEncoding(info);
+ * pipeline.AddScaling(data::ScalingModel::STANDARD_SCALER);
+ *
+ * data::PipelineModel<regression::LinearRegression> model(pipeline);
+ * model.Train(data, responses);
+ * data::Save("model.bin", "model", model);
+ *
+ * // Later, in a scoring job...
+ * arma::rowvec predictions;
+ * model.Predict(queries, predictions);
+ * @endcode
+ *
+ * @tparam ModelType Type of the model.
+ */
+template<typename ModelType>
+class PipelineModel
+{
+ public:
+  /**
+   * Create the model with the given pipeline (which does not need to be
+   * fitted) and model.
+   *
+   * @param pipeline Preprocessing pipeline.
+   * @param model Model.
+   */
+  PipelineModel(Pipeline pipeline = Pipeline(),
+                ModelType model = ModelType()) :
+      pipeline(std::move(pipeline)),
+      model(std::move(model))
+  { /* Nothing to do. */ }
+
+  /**
+   * Fit the pipeline on the given data, and train the model on the
+   * transformed data with the given extra arguments.
+   *
+   * @param data Raw training data.
+   * @param args Other arguments of the Train() function of the model.
+   * @return What the Train() function of the model returns.
+   */
+  template<typename... Args>
+  auto Train(const arma::mat& data, Args&&... args)
+      -> decltype(std::declval<ModelType&>().Train(data,
+          std::forward<Args>(args)...))
+  {
+    pipeline.Fit(data);
+    arma::mat transformed;
+    pipeline.Transform(data, transformed);
+    return model.Train(transformed, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Transform the given data with the pipeline, and classify it with the
+   * model.
+   *
+   * @param data Raw data to classify.
+   * @param args Other arguments of the Classify() function of the model.
+   */
+  template<typename... Args>
+  auto Classify(const arma::mat& data, Args&&... args)
+      -> decltype(std::declval<ModelType&>().Classify(data,
+          std::forward<Args>(args)...))
+  {
+    arma::mat transformed;
+    pipeline.Transform(data, transformed);
+    return model.Classify(transformed, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Transform the given data with the pipeline, and make predictions for it
+   * with the model.
+   *
+   * @param data Raw data to make predictions for.
+   * @param args Other arguments of the Predict() function of the model.
+   */
+  template<typename... Args>
+  auto Predict(const arma::mat& data, Args&&... args)
+      -> decltype(std::declval<ModelType&>().Predict(data,
+          std::forward<Args>(args)...))
+  {
+    arma::mat transformed;
+    pipeline.Transform(data, transformed);
+    return model.Predict(transformed, std::forward<Args>(args)...);
+  }
+
+  //! Get the preprocessing pipeline.
+  const data::Pipeline& Preprocessing() const { return pipeline; }
+  //! Modify the preprocessing pipeline.
+  data::Pipeline& Preprocessing() { return pipeline; }
+
+  //! Get the model.
+  const ModelType& Model() const { return model; }
+  //! Modify the model.
+  ModelType& Model() { return model; }
+
+  //! Serialize the pipeline and the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(pipeline);
+    ar & BOOST_SERIALIZATION_NVP(model);
+  }
+
+ private:
+  //! The preprocessing pipeline.
+  data::Pipeline pipeline;
+  //! The model.
+  ModelType model;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
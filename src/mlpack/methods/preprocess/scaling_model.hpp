@@ -77,6 +77,17 @@ class ScalingModel
   template<typename MatType>
   void Transform(const MatType& input, MatType& output);
 
+  /**
+   * If the scaler is PCA_WHITENING or ZCA_WHITENING, store its whitening
+   * matrix and mean, so that Transform(input) is whitening * (input - mean),
+   * and return true; otherwise, return false.  This lets the matrix be built
+   * once for many calls.
+   *
+   * @param whitening Matrix to store the whitening matrix in.
+   * @param mean Vector to store the mean in.
+   */
+  bool Whitening(arma::mat& whitening, arma::vec& mean) const;
+
   // Fit to intialize the scaling parameter.
   template<typename MatType>
   void Fit(const MatType& input);
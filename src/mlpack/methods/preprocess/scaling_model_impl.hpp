@@ -19,7 +19,7 @@
 namespace mlpack {
 namespace data {
 
-ScalingModel::ScalingModel(const int minvalue,
+inline ScalingModel::ScalingModel(const int minvalue,
                            const int maxvalue,
                            double epsilonvalue) :
     scalerType(0),
@@ -37,7 +37,7 @@ ScalingModel::ScalingModel(const int minvalue,
 }
 
 //! Copy constructor.
-ScalingModel::ScalingModel(const ScalingModel& other) :
+inline ScalingModel::ScalingModel(const ScalingModel& other) :
     scalerType(other.scalerType),
     minmaxscale(other.minmaxscale == NULL ? NULL :
         new data::MinMaxScaler(*other.minmaxscale)),
@@ -59,7 +59,7 @@ ScalingModel::ScalingModel(const ScalingModel& other) :
 }
 
 //! Move constructor.
-ScalingModel::ScalingModel(ScalingModel&& other) :
+inline ScalingModel::ScalingModel(ScalingModel&& other) :
     scalerType(other.scalerType),
     minmaxscale(other.minmaxscale),
     maxabsscale(other.maxabsscale),
@@ -84,7 +84,7 @@ ScalingModel::ScalingModel(ScalingModel&& other) :
 }
 
 //! Copy assignment operator.
-ScalingModel& ScalingModel::operator= (const ScalingModel& other)
+inline ScalingModel& ScalingModel::operator= (const ScalingModel& other)
 {
   if (this == &other)
   {
@@ -123,7 +123,7 @@ ScalingModel& ScalingModel::operator= (const ScalingModel& other)
   return *this;
 }
 
-ScalingModel::~ScalingModel()
+inline ScalingModel::~ScalingModel()
 {
   delete minmaxscale;
   delete maxabsscale;
@@ -203,6 +203,24 @@ void ScalingModel::Transform(const MatType& input, MatType& output)
   }
 }
 
+inline bool ScalingModel::Whitening(arma::mat& whitening, arma::vec& mean) const
+{
+  if (scalerType == ScalerTypes::PCA_WHITENING)
+  {
+    whitening = pcascale->Whitening();
+    mean = pcascale->ItemMean();
+    return true;
+  }
+  else if (scalerType == ScalerTypes::ZCA_WHITENING)
+  {
+    whitening = zcascale->Whitening();
+    mean = zcascale->ItemMean();
+    return true;
+  }
+
+  return false;
+}
+
 template<typename MatType>
 void ScalingModel::InverseTransform(const MatType& input, MatType& output)
 {
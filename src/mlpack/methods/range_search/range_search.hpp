@@ -309,6 +309,30 @@ class RangeSearch
   //! The total number of scores during the last search.
   size_t scores;
 
+  /**
+   * Perform the traversals of a search, in parallel if OpenMP is available.
+   * In naive and single-tree mode, the query points are split between the
+   * threads; in dual-tree mode, the query tree is split into disjoint subtrees.
+   * Each thread has its own rules, so every query point's results are written
+   * by one thread only.  Single-tree scoring with trees whose first point is
+   * the centroid caches distances in the reference nodes, so in that case the
+   * search is serial.
+   *
+   * @param querySet Set of query points (the dataset of queryTree in
+   *      dual-tree mode).
+   * @param queryTree Tree built on the query points (dual-tree mode only).
+   * @param range Range of distances in which to search.
+   * @param neighbors Neighbors of each query point (already sized).
+   * @param distances Distances of each query point (already sized).
+   * @param sameSet Whether the query set is the reference set.
+   */
+  void Traverse(const MatType& querySet,
+                Tree* queryTree,
+                const math::Range& range,
+                std::vector<std::vector<size_t>>& neighbors,
+                std::vector<std::vector<double>>& distances,
+                const bool sameSet);
+
   //! For access to mappings when building models.
   friend class TrainVisitor;
 };
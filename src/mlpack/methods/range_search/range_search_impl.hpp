@@ -18,6 +18,12 @@
 // The rules for traversal.
 #include "range_search_rules.hpp"
 
+#include <mlpack/core/tree/disjoint_subtrees.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace range {
 
@@ -321,38 +327,13 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(querySet.n_cols);
 
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-
   // Reset counts.
   baseCases = 0;
   scores = 0;
 
-  if (naive)
-  {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-
-    // The naive brute-force solution.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
-  }
-  else if (singleMode)
+  if (naive || singleMode)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    Traverse(querySet, NULL, range, *neighborPtr, *distancePtr, false);
   }
   else // Dual-tree recursion.
   {
@@ -363,15 +344,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Timer::Stop("range_search/tree_building");
     Timer::Start("range_search/computing_neighbors");
 
-    // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-    traverser.Traverse(*queryTree, *referenceTree);
-
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    Traverse(queryTree->Dataset(), queryTree, range, *neighborPtr,
+        *distancePtr, false);
 
     // Clean up tree memory.
     delete queryTree;
@@ -483,21 +457,12 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distances.clear();
   distances.resize(querySet.n_cols);
 
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
-
-  // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-  traverser.Traverse(*queryTree, *referenceTree);
+  baseCases = 0;
+  scores = 0;
+  Traverse(querySet, queryTree, range, *neighborPtr, distances, false);
 
   Timer::Stop("range_search/computing_neighbors");
 
-  baseCases = rules.BaseCases();
-  scores = rules.Scores();
-
   // Do we need to map indices?
   if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
   {
@@ -550,43 +515,11 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(referenceSet->n_cols);
 
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
-
-  if (naive)
-  {
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-
-    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
-    scores = 0;
-  }
-  else if (singleMode)
-  {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
-  }
-  else // Dual-tree recursion.
-  {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-    traverser.Traverse(*referenceTree, *referenceTree);
-
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
-  }
+  // Don't return the query in the results.
+  baseCases = 0;
+  scores = 0;
+  Traverse(*referenceSet, referenceTree, range, *neighborPtr, *distancePtr,
+      true);
 
   Timer::Stop("range_search/computing_neighbors");
 
@@ -618,6 +551,90 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Traverse(
+    const MatType& querySet,
+    Tree* queryTree,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances,
+    const bool sameSet)
+{
+  typedef RangeSearchRules<MetricType, Tree> RuleType;
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // In dual-tree mode, split the query tree so that each thread can traverse
+  // a part of it; a few subtrees per thread balance the load.
+  std::vector<Tree*> queryNodes;
+  if (!naive && !singleMode)
+  {
+    tree::DisjointSubtrees(*queryTree, (numThreads == 1) ? 1 : 4 * numThreads,
+        queryNodes);
+  }
+
+  const bool parallel = naive || !singleMode ||
+      !tree::TreeTraits<Tree>::FirstPointIsCentroid;
+
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+  #pragma omp parallel if (parallel)
+  {
+    RuleType rules(*referenceSet, querySet, range, neighbors, distances,
+        metric, sameSet);
+
+    if (naive)
+    {
+      // The naive brute-force solution.
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
+    else if (singleMode)
+    {
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+    }
+    else
+    {
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) queryNodes.size(); ++i)
+        traverser.Traverse(*queryNodes[i], *referenceTree);
+    }
+
+    #pragma omp critical
+    {
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+  }
+
+  if (naive)
+  {
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else
+  {
+    baseCases += totalBaseCases;
+    scores += totalScores;
+  }
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/metrics/distance_tile.hpp>
 
 namespace mlpack {
 namespace range {
@@ -57,6 +58,20 @@ class RangeSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Perform the base cases between the given query points and a contiguous
+   * block of reference points, as if BaseCase() was called for each pair.  If
+   * the metric supports it, a tile of distance bounds is computed at once, and
+   * only the pairs that may lie within the range are evaluated exactly.
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void BlockBaseCase(const arma::uvec& queryIndices,
+                     const size_t referenceBegin,
+                     const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -160,6 +175,9 @@ class RangeSearchRules
   size_t baseCases;
   //! THe number of scores.
   size_t scores;
+
+  //! Used to compute blocks of distances in BlockBaseCase().
+  metric::DistanceTile<MetricType, arma::mat> distanceTile;
 };
 
 } // namespace range
@@ -37,7 +37,8 @@ RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    distanceTile(metric, querySet, referenceSet)
 {
   // Nothing to do.
 }
@@ -75,6 +76,42 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename MetricType, typename TreeType>
+void RangeSearchRules<MetricType, TreeType>::BlockBaseCase(
+    const arma::uvec& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  if (!distanceTile.Enabled())
+  {
+    for (size_t i = 0; i < queryIndices.n_elem; ++i)
+      for (size_t j = 0; j < referenceCount; ++j)
+        BaseCase(queryIndices[i], referenceBegin + j);
+    return;
+  }
+
+  arma::mat lower, upper;
+  distanceTile.Bounds(queryIndices, referenceBegin, referenceCount, lower,
+      upper);
+
+  for (size_t i = 0; i < queryIndices.n_elem; ++i)
+  {
+    const size_t queryIndex = queryIndices[i];
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      const size_t referenceIndex = referenceBegin + j;
+      if (sameSet && (queryIndex == referenceIndex))
+        continue;
+
+      // Only evaluate the pairs whose distance may lie within the range.
+      if (upper(i, j) < range.Lo() || lower(i, j) > range.Hi())
+        ++baseCases;
+      else
+        BaseCase(queryIndex, referenceIndex);
+    }
+  }
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename TreeType>
 double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
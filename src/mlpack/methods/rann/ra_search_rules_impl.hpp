@@ -33,6 +33,7 @@ RASearchRules(const arma::mat& referenceSet,
               const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(k, querySet.n_cols),
     k(k),
     metric(metric),
     sampleAtLeaves(sampleAtLeaves),
@@ -70,20 +71,6 @@ RASearchRules(const arma::mat& referenceSet,
   Log::Info << "Minimum samples required per query: " << numSamplesReqd <<
     ", sampling ratio: " << samplingRatio << std::endl;
 
-  // Let's build the list of candidate neighbors for each query point.
-  // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
-  // The list of candidates will be updated when visiting new points with the
-  // BaseCase() method.
-  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
-      size_t() - 1);
-
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
-
   if (naive) // No tree traversal; just do naive sampling here.
   {
     // Sample enough points.
@@ -102,19 +89,8 @@ void RASearchRules<SortPolicy, MetricType, TreeType>::GetResults(
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
 {
-  neighbors.set_size(k, querySet.n_cols);
-  distances.set_size(k, querySet.n_cols);
-
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-  {
-    CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; ++j)
-    {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-  }
+  // The candidates are already sorted, best first.
+  candidates.GetResults(neighbors, distances);
 };
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -148,7 +124,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double distance = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates.WorstDistance(queryIndex);
 
   return Score(queryIndex, referenceNode, distance, bestDistance);
 }
@@ -162,7 +138,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double distance = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode, baseCaseResult);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates.WorstDistance(queryIndex);
 
   return Score(queryIndex, referenceNode, distance, bestDistance);
 }
@@ -274,7 +250,7 @@ Rescore(const size_t queryIndex,
     return oldScore;
 
   // Just check the score again against the distances.
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates.WorstDistance(queryIndex);
 
   // If this is better than the best distance we've seen so far,
   // maybe there will be something down this node.
@@ -374,7 +350,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates.WorstDistance(queryNode.Point(i))
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -413,7 +389,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates.WorstDistance(queryNode.Point(i))
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -627,7 +603,7 @@ Rescore(TreeType& queryNode,
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates.WorstDistance(queryNode.Point(i))
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -812,14 +788,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
-  Candidate c = std::make_pair(distance, neighbor);
-
-  if (CandidateCmp()(c, pqueue.top()))
-  {
-    pqueue.pop();
-    pqueue.push(c);
-  }
+  candidates.Insert(queryIndex, neighbor, distance);
 }
 
 } // namespace neighbor
@@ -151,6 +151,11 @@ namespace ens {
       mlpack::svd::RegularizedSVDFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  /**
+   * Like the generic ParallelSGD, each iteration visits threadShareSize
+   * examples per thread, but the examples are scheduled so that no two threads
+   * update the parameters of the same user or item at the same time.
+   */
   template <>
   template <>
   inline double ParallelSGD<ExponentialBackoff>::Optimize(
@@ -14,6 +14,7 @@
 
 #include "regularized_svd_function.hpp"
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/stratify_ratings.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -231,7 +232,22 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
       (function.NumFunctions() - 1), function.NumFunctions());
 
-  const arma::mat data = function.Dataset();
+  const arma::mat& data = function.Dataset();
+
+  // As in the generic ParallelSGD, each iteration visits threadShareSize
+  // ratings per thread: the first numThreads * threadShareSize ratings of the
+  // visitation order.  These are partitioned into numThreads user blocks and
+  // numThreads item blocks, so that every thread processes one block at a
+  // time.  The result is reproducible for a given random seed and number of
+  // threads.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numStrata = numThreads;
+  const size_t numVisited = std::min(function.NumFunctions(),
+      numThreads * threadShareSize);
+  std::vector<std::vector<size_t>> strata;
 
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
@@ -272,47 +288,46 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
 
     if (shuffle) // Determine order of visitation.
       std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+          mlpack::math::RandGen());
+
+    // Partition the ratings so that concurrently processed blocks never share
+    // a user or an item.  This avoids atomic updates, which serialize heavily
+    // on popular items.
+    const arma::Col<size_t> visited(visitationOrder.memptr(), numVisited,
+        false, true);
+    mlpack::math::StratifyRatings(data, visited, numStrata, strata);
 
-    #pragma omp parallel
+    for (size_t s = 0; s < numStrata; ++s)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) numStrata; ++b)
       {
-        const size_t numUsers = function.NumUsers();
+        const std::vector<size_t>& stratum =
+            strata[b * numStrata + (b + s) % numStrata];
+        for (size_t k = 0; k < stratum.size(); ++k)
+        {
+          const size_t numUsers = function.NumUsers();
 
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, stratum[k]);
+          const size_t item = data(1, stratum[k]) + numUsers;
 
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        double ratingError = rating - arma::dot(iterate.col(user),
-            iterate.col(item));
+          // Prediction error for the example.
+          const double rating = data(2, stratum[k]);
+          double ratingError = rating - arma::dot(iterate.col(user),
+              iterate.col(item));
 
-        double lambda = function.Lambda();
+          double lambda = function.Lambda();
 
-        arma::mat userUpdate = stepSize * (lambda * iterate.col(user) -
-            ratingError * iterate.col(item));
-        arma::mat itemUpdate = stepSize * (lambda * iterate.col(item) -
-            ratingError * iterate.col(user));
+          arma::vec userUpdate = stepSize * (lambda * iterate.col(user) -
+              ratingError * iterate.col(item));
+          arma::vec itemUpdate = stepSize * (lambda * iterate.col(item) -
+              ratingError * iterate.col(user));
 
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < iterate.n_rows; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemUpdate(i);
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.
+          iterate.col(user) -= userUpdate;
+          iterate.col(item) -= itemUpdate;
         }
       }
     }
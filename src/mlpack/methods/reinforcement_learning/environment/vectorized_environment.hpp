@@ -0,0 +1,144 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ *
+ * Wrapper that steps several copies of an RL environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * A set of independent copies of an environment that are stepped together.
+ * Each copy holds its own current state; stepping takes one action per copy,
+ * so that an agent can select the actions of every copy with a single batched
+ * forward pass of its network.  Copies whose state is terminal are not stepped
+ * any more, until InitialSample() is called again.
+ *
+ * @tparam EnvironmentType A type of Environment that is being wrapped.
+ */
+template <typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Create the given number of copies of the given environment.
+   *
+   * @param numEnvironments Number of copies of the environment.
+   * @param environment The environment to copy.
+   */
+  VectorizedEnvironment(const size_t numEnvironments,
+                        const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvironments, environment),
+      states(numEnvironments)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Reset every copy of the environment to an initial state.
+   */
+  void InitialSample()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+      states[i] = environments[i].InitialSample();
+  }
+
+  /**
+   * Check whether the current state of the given copy is terminal.
+   *
+   * @param i Index of the copy.
+   */
+  bool IsTerminal(const size_t i) const
+  {
+    return environments[i].IsTerminal(states[i]);
+  }
+
+  /**
+   * Check whether the current state of every copy is terminal.
+   */
+  bool AllTerminal() const
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      if (!IsTerminal(i))
+        return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Take the given action in each copy whose current state is not terminal,
+   * and advance it to the next state.  The reward of the copies that were not
+   * stepped is 0.
+   *
+   * @param actions The action to take in each copy.
+   * @param rewards Vector to store the reward of each copy in.
+   */
+  void Sample(const std::vector<Action>& actions, arma::rowvec& rewards)
+  {
+    rewards.zeros(environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      if (IsTerminal(i))
+        continue;
+
+      State nextState;
+      rewards[i] = environments[i].Sample(states[i], actions[i], nextState);
+      states[i] = std::move(nextState);
+    }
+  }
+
+  /**
+   * Encode the current state of the given copies as the columns of a matrix.
+   *
+   * @param indices Indices of the copies.
+   * @param encodedStates Matrix to store the encoded states in.
+   */
+  void Encode(const std::vector<size_t>& indices,
+              arma::mat& encodedStates) const
+  {
+    encodedStates.set_size(State::dimension, indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+      encodedStates.col(i) = states[indices[i]].Encode();
+  }
+
+  //! Get the number of copies of the environment.
+  size_t Size() const { return environments.size(); }
+
+  //! Get the given copy of the environment.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+  //! Modify the given copy of the environment.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the current state of the given copy.
+  const State& CurrentState(const size_t i) const { return states[i]; }
+  //! Modify the current state of the given copy.
+  State& CurrentState(const size_t i) { return states[i]; }
+
+ private:
+  //! The copies of the environment.
+  std::vector<EnvironmentType> environments;
+
+  //! The current state of each copy.
+  std::vector<State> states;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "environment/vectorized_environment.hpp"
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
 #include "training_config.hpp"
@@ -104,12 +105,36 @@ class QLearning
    */
   void SelectAction();
 
+  /**
+   * Select an action for each of the given states, with a single forward pass
+   * of the learning network.
+   *
+   * @param states Encoded states, one per column.
+   * @param actions Vector to store the selected actions in.
+   */
+  void SelectActions(const arma::mat& states, std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Execute an episode in each copy of the given vectorized environment.  The
+   * copies are stepped in lockstep: at each step, the actions of all the
+   * copies that have not reached a terminal state are selected with one
+   * forward pass, and their transitions are stored for replay.  The agent is
+   * trained once per stored transition, as in Episode().
+   *
+   * Transitions of the copies are interleaved in the replay buffer, so this
+   * requires a single-step replay method.
+   *
+   * @param environments Copies of the environment to run the episodes in.
+   * @return Return of the episode of each copy.
+   */
+  arma::vec Episode(VectorizedEnvironment<EnvironmentType>& environments);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -336,6 +336,35 @@ void QLearning<
   action = policy.Sample(actionValue, deterministic, config.NoisyQLearning());
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::SelectActions(const arma::mat& states,
+                 std::vector<ActionType>& actions)
+{
+  // Get the action values of every state at once.
+  arma::mat actionValues;
+  learningNetwork.Predict(states, actionValues);
+
+  // Select an action for each state according to the behavior policy.
+  actions.resize(states.n_cols);
+  for (size_t i = 0; i < states.n_cols; ++i)
+  {
+    actions[i] = policy.Sample(actionValues.unsafe_col(i), deterministic,
+        config.NoisyQLearning());
+  }
+}
+
 template <
   typename EnvironmentType,
   typename NetworkType,
@@ -385,6 +414,95 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+arma::vec QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Episode(
+    VectorizedEnvironment<EnvironmentType>& environments)
+{
+  // Transitions of the copies are interleaved, so n-step transitions would
+  // mix the trajectories of different copies.
+  if (replayMethod.NSteps() != 1)
+  {
+    throw std::invalid_argument("QLearning::Episode(): vectorized environments "
+        "require a single-step replay method");
+  }
+
+  // Get the initial state of every copy.
+  environments.InitialSample();
+
+  // Track the return of the episode of each copy.
+  arma::vec returns(environments.Size(), arma::fill::zeros);
+
+  std::vector<ActionType> actions(environments.Size());
+  std::vector<ActionType> activeActions;
+  std::vector<StateType> activeStates;
+  std::vector<size_t> active;
+  arma::mat encodedStates;
+  arma::rowvec rewards;
+  while (true)
+  {
+    // Find the copies that have not reached a terminal state yet.
+    active.clear();
+    for (size_t i = 0; i < environments.Size(); ++i)
+    {
+      if (!environments.IsTerminal(i))
+        active.push_back(i);
+    }
+
+    if (active.empty())
+      break;
+
+    // Select the actions of all the active copies with one forward pass.
+    environments.Encode(active, encodedStates);
+    SelectActions(encodedStates, activeActions);
+
+    activeStates.clear();
+    for (size_t j = 0; j < active.size(); ++j)
+    {
+      actions[active[j]] = activeActions[j];
+      activeStates.push_back(environments.CurrentState(active[j]));
+    }
+
+    // Interact with the environments to advance to the next states.
+    environments.Sample(actions, rewards);
+
+    for (size_t j = 0; j < active.size(); ++j)
+    {
+      const size_t i = active[j];
+      returns[i] += rewards[i];
+      totalSteps++;
+
+      // Store the transition for replay.
+      replayMethod.Store(activeStates[j], actions[i], rewards[i],
+          environments.CurrentState(i), environments.IsTerminal(i),
+          config.Discount());
+
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      if (config.IsCategorical())
+        TrainCategoricalAgent();
+      else
+        TrainAgent();
+    }
+
+    // Keep the last selected action available through Action().
+    action = activeActions.back();
+  }
+
+  return returns;
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -165,6 +165,13 @@ namespace ens {
       mlpack::svd::SVDPlusPlusFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  /**
+   * Like the generic ParallelSGD, each iteration visits threadShareSize
+   * examples per thread, but the examples are scheduled so that no two threads
+   * update the parameters of the same user or item at the same time.  The
+   * implicit item vectors are shared between blocks, so their updates are
+   * buffered by each block and applied serially after each stratum.
+   */
   template <>
   template <>
   inline double ParallelSGD<ExponentialBackoff>::Optimize(
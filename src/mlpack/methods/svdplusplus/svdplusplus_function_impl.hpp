@@ -15,6 +15,8 @@
 
 #include "svdplusplus_function.hpp"
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/stratify_ratings.hpp>
+#include <unordered_map>
 
 namespace mlpack {
 namespace svd {
@@ -406,8 +408,8 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
       (function.NumFunctions() - 1), function.NumFunctions());
 
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
+  const arma::mat& data = function.Dataset();
+  const arma::sp_mat& implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
   const size_t numItems = function.NumItems();
   const double lambda = function.Lambda();
@@ -415,6 +417,25 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // As in the generic ParallelSGD, each iteration visits threadShareSize
+  // ratings per thread: the first numThreads * threadShareSize ratings of the
+  // visitation order.  These are partitioned into numThreads user blocks and
+  // numThreads item blocks, so that every thread processes one block at a
+  // time.  The implicit item vectors of a user may belong to any item block, so
+  // their updates are buffered by each block and applied serially, in block
+  // order, after each stratum.  The result is reproducible for a given random
+  // seed and number of threads.
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numStrata = numThreads;
+  const size_t numVisited = std::min(function.NumFunctions(),
+      numThreads * threadShareSize);
+  std::vector<std::vector<size_t>> strata;
+  std::vector<std::unordered_map<size_t, arma::vec>> implicitUpdates(
+      numStrata);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -454,97 +475,102 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
 
     if (shuffle) // Determine order of visitation.
       std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+          mlpack::math::RandGen());
 
-    #pragma omp parallel
+    // Partition the ratings so that concurrently processed blocks never share
+    // a user or an item.  This avoids atomic updates, which serialize heavily
+    // on popular items.
+    const arma::Col<size_t> visited(visitationOrder.memptr(), numVisited,
+        false, true);
+    mlpack::math::StratifyRatings(data, visited, numStrata, strata);
+
+    for (size_t s = 0; s < numStrata; ++s)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) numStrata; ++b)
       {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
+        const std::vector<size_t>& stratum =
+            strata[b * numStrata + (b + s) % numStrata];
+        std::unordered_map<size_t, arma::vec>& updates = implicitUpdates[b];
+        for (size_t k = 0; k < stratum.size(); ++k)
         {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
-        userVec += iterate.col(user).subvec(0, rank - 1);
-
-        double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, stratum[k]);
+          const size_t item = data(1, stratum[k]) + numUsers;
+          const size_t implicitStart = numUsers + numItems;
+
+          // Prediction error for the example.
+          const double rating = data(2, stratum[k]);
+          const double userBias = iterate(rank, user);
+          const double itemBias = iterate(rank, item);
+          // Iterate through each item which the user interacted with to
+          // calculate user vector.
+          arma::vec userVec(rank, arma::fill::zeros);
+          arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+          arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+          size_t implicitCount = 0;
+          for (; it != it_end; ++it)
+          {
+            userVec += iterate.col(implicitStart + it.row()).subvec(0,
+                rank - 1);
+            implicitCount += 1;
+          }
+          if (implicitCount != 0)
+            userVec /= std::sqrt(implicitCount);
+          userVec += iterate.col(user).subvec(0, rank - 1);
+
+          double ratingError = rating - userBias - itemBias -
+              arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
+
+          arma::vec userVecUpdate = stepSize * 2 * (
+              lambda * iterate.col(user).subvec(0, rank - 1) -
+              ratingError * iterate.col(item).subvec(0, rank - 1));
+          arma::vec itemVecUpdate = stepSize * 2 * (
+              lambda * iterate.col(item).subvec(0, rank - 1) -
+              ratingError * userVec);
+          double userBiasUpdate = stepSize * 2 * (
+              lambda * iterate(rank, user) - ratingError);
+          double itemBiasUpdate = stepSize * 2 * (
+              lambda * iterate(rank, item) - ratingError);
+
+          // The implicit item vectors are shared by every block, so they are
+          // only read during the stratum, and the updates are accumulated.
+          if (implicitCount != 0)
+          {
+            const arma::vec itemVec = iterate.col(item).subvec(0, rank - 1);
+            it = implicitData.begin_col(user);
+            it_end = implicitData.end_col(user);
+            for (; it != it_end; ++it)
+            {
+              const size_t implicitCol = implicitStart + it.row();
+              arma::vec& update = updates[implicitCol];
+              if (update.is_empty())
+                update.zeros(rank);
+              update += stepSize * 2.0 * (lambda / implicitCount *
+                  iterate.col(implicitCol).subvec(0, rank - 1) -
+                  ratingError / std::sqrt(implicitCount) * itemVec);
+            }
+          }
 
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.
+          iterate.col(user).subvec(0, rank - 1) -= userVecUpdate;
+          iterate.col(item).subvec(0, rank - 1) -= itemVecUpdate;
+          iterate(rank, user) -= userBiasUpdate;
+          iterate(rank, item) -= itemBiasUpdate;
         }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
+      }
+
+      // Apply the buffered implicit item updates in block order, so that the
+      // result does not depend on the scheduling of the blocks.
+      for (size_t b = 0; b < numStrata; ++b)
+      {
+        for (const std::pair<const size_t, arma::vec>& update :
+            implicitUpdates[b])
         {
-          for (size_t i = 0; i < rank; ++i)
-          {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
-          }
+          iterate.col(update.first).subvec(0, rank - 1) -= update.second;
         }
+        implicitUpdates[b].clear();
       }
     }
   }
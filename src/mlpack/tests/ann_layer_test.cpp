@@ -387,6 +387,40 @@ TEST_CASE("SimpleLinearLayerTest", "[ANNLayerTest]")
   REQUIRE(arma::accu(delta) == 0);
 }
 
+/**
+ * Make sure that the sparse Gradient() of the linear module matches the dense
+ * one, and only writes the columns of the active input features.
+ */
+TEST_CASE("SparseGradientLinearLayerTest", "[ANNLayerTest]")
+{
+  Linear<> module(20, 5);
+  module.Parameters().randu();
+  module.Reset();
+
+  arma::sp_mat sparseInput(20, 3);
+  sparseInput(2, 0) = 0.5;
+  sparseInput(7, 1) = -1.0;
+  sparseInput(7, 2) = 2.0;
+  sparseInput(15, 2) = 0.3;
+  arma::mat input(sparseInput);
+  arma::mat error = arma::randu<arma::mat>(5, 3);
+
+  arma::mat denseGradient(module.Parameters().n_elem, 1);
+  module.Gradient(input, error, denseGradient);
+
+  // A reused gradient buffer holds stale values, which must not leak into the
+  // columns of inactive features.
+  arma::mat sparseGradient(module.Parameters().n_elem, 1);
+  sparseGradient.fill(7.0);
+  module.Gradient(sparseInput, error, sparseGradient);
+
+  for (size_t i = 0; i < denseGradient.n_elem; ++i)
+  {
+    REQUIRE(sparseGradient(i) ==
+        Approx(denseGradient(i)).epsilon(1e-7).margin(1e-10));
+  }
+}
+
 /**
  * Jacobian linear module test.
  */
@@ -20,6 +20,7 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_als_method.hpp>
 #include <mlpack/methods/cf/normalization/no_normalization.hpp>
 #include <mlpack/methods/cf/normalization/overall_mean_normalization.hpp>
 #include <mlpack/methods/cf/normalization/user_mean_normalization.hpp>
@@ -29,6 +30,7 @@
 #include <mlpack/methods/cf/neighbor_search_policies/lmetric_search.hpp>
 #include <mlpack/methods/cf/neighbor_search_policies/cosine_search.hpp>
 #include <mlpack/methods/cf/neighbor_search_policies/pearson_search.hpp>
+#include <mlpack/methods/cf/neighbor_search_policies/spill_search.hpp>
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/similarity_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
@@ -580,6 +582,15 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersSVDPPTest)
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for implicit ALS method.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersImplicitALSTest)
+{
+  GetRecommendationsAllUsers<ImplicitALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -998,6 +1009,14 @@ BOOST_AUTO_TEST_CASE(SerializationNMFTest)
   Serialization<NMFPolicy>();
 }
 
+/**
+ * Ensure we can load and save the CF model using implicit ALS policy.
+ */
+BOOST_AUTO_TEST_CASE(SerializationImplicitALSTest)
+{
+  Serialization<ImplicitALSPolicy>();
+}
+
 /**
  * Ensure we can load and save the CF model using SVD Complete Incremental.
  */
@@ -1192,6 +1211,72 @@ BOOST_AUTO_TEST_CASE(CFPredictPearsonSearch)
   CFPredict<NMFPolicy, OverallMeanNormalization, PearsonSearch>(2.0);
 }
 
+/**
+ * Make sure that Predict() is returning reasonable results for
+ * SpillSearch.
+ */
+BOOST_AUTO_TEST_CASE(CFPredictSpillSearch)
+{
+  CFPredict<NMFPolicy, OverallMeanNormalization, SpillSearch>(2.0);
+}
+
+/**
+ * Make sure that SpillSearch with a moderate overlap finds most of the exact
+ * nearest neighbors, and that SpillSearch::Defaults sets the parameters of the
+ * objects that CFType constructs.
+ */
+BOOST_AUTO_TEST_CASE(SpillSearchRecallTest)
+{
+  math::RandomSeed(42);
+  arma::mat referenceSet(4, 2000, arma::fill::randu);
+  arma::mat querySet(4, 200, arma::fill::randu);
+
+  EuclideanSearch euclideanSearch(referenceSet);
+  arma::Mat<size_t> euclideanNeighbors, spillNeighbors;
+  arma::mat euclideanSimilarities, spillSimilarities;
+  euclideanSearch.Search(querySet, 5, euclideanNeighbors,
+      euclideanSimilarities);
+
+  SpillSearch spillSearch(referenceSet, 0.3);
+  BOOST_REQUIRE_EQUAL(spillSearch.Overlap(), 0.3);
+  spillSearch.Search(querySet, 5, spillNeighbors, spillSimilarities);
+
+  // Count the exact neighbors that were found.
+  size_t found = 0;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      if (arma::any(spillNeighbors.col(i) == euclideanNeighbors(j, i)))
+        ++found;
+    }
+  }
+  const double recall = (double) found / euclideanNeighbors.n_elem;
+  BOOST_REQUIRE_GT(recall, 0.6);
+
+  // Approximate neighbors can only be further away.
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      BOOST_REQUIRE_LE(spillSimilarities(j, i),
+          euclideanSimilarities(j, i) + 1e-10);
+    }
+  }
+
+  // The defaults only apply while the Defaults object lives.
+  {
+    SpillSearch::Defaults defaults(0.3, 15, 0.6);
+    SpillSearch defaultSearch(referenceSet);
+    BOOST_REQUIRE_EQUAL(defaultSearch.Overlap(), 0.3);
+    BOOST_REQUIRE_EQUAL(defaultSearch.LeafSize(), 15);
+    BOOST_REQUIRE_EQUAL(defaultSearch.Rho(), 0.6);
+  }
+  SpillSearch defaultSearch(referenceSet);
+  BOOST_REQUIRE_EQUAL(defaultSearch.Overlap(), 0.1);
+  BOOST_REQUIRE_EQUAL(defaultSearch.LeafSize(), 20);
+}
+
 /**
  * Make sure that Predict() is returning reasonable results for
  * AverageInterpolation.
@@ -1228,4 +1313,180 @@ BOOST_AUTO_TEST_CASE(CFPredictRegressionInterpolation)
             RegressionInterpolation>(2.0);
 }
 
+/**
+ * Make sure that the batched CFType::GetWeightedRatings() gives the same result
+ * as summing the weighted ratings of each neighbor with GetRatingOfUser().
+ */
+template<typename DecompositionPolicy>
+void GetWeightedRatings()
+{
+  DecompositionPolicy decomposition;
+
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  // Random neighborhoods and weights for a block of 10 users.
+  arma::Mat<size_t> neighborhood = arma::randi<arma::Mat<size_t>>(5, 10,
+      arma::distr_param(0, (int) c.CleanedData().n_cols - 1));
+  arma::mat weights(5, 10, arma::fill::randu);
+
+  arma::mat ratings;
+  c.GetWeightedRatings(neighborhood, weights, ratings);
+
+  BOOST_REQUIRE_EQUAL(ratings.n_rows, c.CleanedData().n_rows);
+  BOOST_REQUIRE_EQUAL(ratings.n_cols, 10);
+
+  for (size_t i = 0; i < neighborhood.n_cols; ++i)
+  {
+    arma::vec expected(c.CleanedData().n_rows, arma::fill::zeros);
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    {
+      arma::vec neighborRatings;
+      c.Decomposition().GetRatingOfUser(neighborhood(j, i), neighborRatings);
+      expected += weights(j, i) * neighborRatings;
+    }
+
+    for (size_t k = 0; k < expected.n_elem; ++k)
+    {
+      if (std::abs(expected[k]) < 1e-8)
+        BOOST_REQUIRE_SMALL(ratings(k, i), 1e-8);
+      else
+        BOOST_REQUIRE_CLOSE(ratings(k, i), expected[k], 1e-5);
+    }
+  }
+}
+
+/**
+ * A decomposition policy that only has the methods that CFType requires, so
+ * that CFType::GetWeightedRatings() falls back to GetRatingOfUser().
+ */
+class MinimalNMFPolicy
+{
+ public:
+  template<typename MatType>
+  void Apply(const MatType& data,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    policy.Apply(data, cleanedData, rank, maxIterations, minResidue, mit);
+  }
+
+  double GetRating(const size_t user, const size_t item) const
+  {
+    return policy.GetRating(user, item);
+  }
+
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    policy.GetRatingOfUser(user, rating);
+  }
+
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    policy.template GetNeighborhood<NeighborSearchPolicy>(users,
+        numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(policy);
+  }
+
+ private:
+  NMFPolicy policy;
+};
+
+/**
+ * Make sure GetWeightedRatings() matches GetRatingOfUser() for NMF.
+ */
+BOOST_AUTO_TEST_CASE(CFGetWeightedRatingsNMFTest)
+{
+  GetWeightedRatings<NMFPolicy>();
+}
+
+/**
+ * Make sure GetWeightedRatings() matches GetRatingOfUser() for a policy that
+ * has neither GetWeightedRatings() nor W() and H().
+ */
+BOOST_AUTO_TEST_CASE(CFGetWeightedRatingsMinimalPolicyTest)
+{
+  GetWeightedRatings<MinimalNMFPolicy>();
+}
+
+/**
+ * Make sure GetWeightedRatings() matches GetRatingOfUser() for Bias SVD.
+ */
+BOOST_AUTO_TEST_CASE(CFGetWeightedRatingsBiasSVDTest)
+{
+  GetWeightedRatings<BiasSVDPolicy>();
+}
+
+/**
+ * Make sure GetWeightedRatings() matches GetRatingOfUser() for SVDPlusPlus.
+ */
+BOOST_AUTO_TEST_CASE(CFGetWeightedRatingsSVDPPTest)
+{
+  GetWeightedRatings<SVDPlusPlusPolicy>();
+}
+
+/**
+ * Make sure GetWeightedRatings() matches GetRatingOfUser() for implicit ALS.
+ */
+BOOST_AUTO_TEST_CASE(CFGetWeightedRatingsImplicitALSTest)
+{
+  GetWeightedRatings<ImplicitALSPolicy>();
+}
+
+/**
+ * Make sure that implicit ALS recovers a simple block structure: users in one
+ * group only interact with the items of their group, so the unobserved items
+ * of their own group should be scored higher than the items of the other
+ * group.
+ */
+BOOST_AUTO_TEST_CASE(ImplicitALSBlockStructureTest)
+{
+  const size_t numItems = 40;
+  const size_t numUsers = 60;
+
+  // Each user interacts with about half of the items of their group.
+  arma::sp_mat data(numItems, numUsers);
+  for (size_t u = 0; u < numUsers; ++u)
+  {
+    const size_t group = u % 2;
+    for (size_t i = group * numItems / 2; i < (group + 1) * numItems / 2; ++i)
+      if (math::Random() < 0.5)
+        data(i, u) = math::RandInt(1, 5);
+  }
+
+  ImplicitALSPolicy decomposition(10.0, 0.1, 3);
+  decomposition.Apply(arma::mat(), data, 4, 20, 1e-5, true);
+
+  size_t failures = 0;
+  for (size_t u = 0; u < numUsers; ++u)
+  {
+    const size_t group = u % 2;
+    arma::vec ratings;
+    decomposition.GetRatingOfUser(u, ratings);
+
+    const double inGroup = arma::mean(ratings.subvec(group * numItems / 2,
+        (group + 1) * numItems / 2 - 1));
+    const double outGroup = arma::mean(ratings.subvec((1 - group) * numItems /
+        2, (2 - group) * numItems / 2 - 1));
+    if (inGroup <= outGroup)
+      ++failures;
+  }
+
+  BOOST_REQUIRE_LE(failures, 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
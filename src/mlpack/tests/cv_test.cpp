@@ -380,6 +380,50 @@ TEST_CASE("SimpleCVMSETest", "[CVTest]")
   REQUIRE(std::abs(weightedCV2.Evaluate() - expectedMSE) > 1e-5);
 }
 
+/**
+ * Test that SimpleCV and KFoldCV can train on the first part of the training
+ * points only.
+ */
+TEST_CASE("CVEvaluateOnSubsetTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 100);
+  arma::rowvec responses = arma::randu<arma::rowvec>(3) * data +
+      0.1 * arma::randn<arma::rowvec>(100);
+
+  // SimpleCV trains on the first 80 points; half of them are the first 40.
+  SimpleCV<LinearRegression, MSE> cv(0.2, data, responses);
+  std::unique_ptr<LinearRegression> model;
+  const double mse = cv.EvaluateOnSubset(model, 0.5);
+
+  LinearRegression expectedModel(data.cols(0, 39), responses.cols(0, 39));
+  const double expectedMSE = MSE::Evaluate(expectedModel, data.cols(80, 99),
+      responses.cols(80, 99));
+  REQUIRE(mse == Approx(expectedMSE).epsilon(1e-7));
+  REQUIRE(model != nullptr);
+  REQUIRE(arma::approx_equal(model->Parameters(), expectedModel.Parameters(),
+      "absdiff", 1e-7));
+
+  // The whole training set gives the same result as Evaluate().
+  REQUIRE(cv.EvaluateOnSubset(model, 1.0) ==
+      Approx(cv.Evaluate()).epsilon(1e-7));
+
+  // In 4-fold cross-validation without shuffling, the last fold trains on the
+  // last 25 points followed by the first 50, so a fifth of its training points
+  // are the points 75 to 89.
+  KFoldCV<LinearRegression, MSE> kfoldCV(4, data, responses, false);
+  kfoldCV.EvaluateOnSubset(model, 0.2);
+  LinearRegression expectedLastModel(data.cols(75, 89),
+      responses.cols(75, 89));
+  REQUIRE(arma::approx_equal(model->Parameters(),
+      expectedLastModel.Parameters(), "absdiff", 1e-7));
+  REQUIRE(kfoldCV.EvaluateOnSubset(model, 1.0) ==
+      Approx(kfoldCV.Evaluate()).epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(cv.EvaluateOnSubset(model, 0.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(kfoldCV.EvaluateOnSubset(model, 1.5),
+      std::invalid_argument);
+}
+
 /**
  * Test that scores of -nan are filtered out.
  */
@@ -533,6 +577,91 @@ TEST_CASE("KFoldCVWithWeightedLRTest", "[CVTest]")
   REQUIRE((1.0 - mse) == Approx(1.0).epsilon(1e-7));
 }
 
+/**
+ * Test that parallel k-fold cross-validation gives the same result as the
+ * serial one, with and without weights and with a cap on the number of models.
+ */
+TEST_CASE("KFoldCVParallelTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 200);
+  arma::rowvec responses = arma::randu<arma::rowvec>(4) * data +
+      0.1 * arma::randn<arma::rowvec>(200);
+  arma::rowvec weights = arma::randu<arma::rowvec>(200);
+
+  KFoldCV<LinearRegression, MSE> cv(7, data, responses, false);
+  KFoldCV<LinearRegression, MSE> weightedCV(7, data, responses, weights,
+      false);
+
+  const double serialMSE = cv.Evaluate(0.01);
+  const double serialWeightedMSE = weightedCV.Evaluate(0.01);
+  const arma::vec serialParameters = cv.Model().Parameters();
+
+  cv.Parallel() = true;
+  weightedCV.Parallel() = true;
+  for (size_t maxModels = 0; maxModels < 3; ++maxModels)
+  {
+    cv.MaxConcurrentModels() = maxModels;
+    weightedCV.MaxConcurrentModels() = maxModels;
+
+    REQUIRE(cv.Evaluate(0.01) == Approx(serialMSE).epsilon(1e-7));
+    REQUIRE(weightedCV.Evaluate(0.01) ==
+        Approx(serialWeightedMSE).epsilon(1e-7));
+
+    // The model of the last fold is kept.
+    REQUIRE(cv.Model().Parameters().n_elem == serialParameters.n_elem);
+    for (size_t i = 0; i < serialParameters.n_elem; ++i)
+    {
+      REQUIRE(cv.Model().Parameters()[i] ==
+          Approx(serialParameters[i]).epsilon(1e-7));
+    }
+  }
+
+  // EvaluateWithModel() gives the same model without keeping it.
+  std::unique_ptr<LinearRegression> model;
+  REQUIRE(cv.EvaluateWithModel(model, 0.01) ==
+      Approx(serialMSE).epsilon(1e-7));
+  REQUIRE(model != nullptr);
+  for (size_t i = 0; i < serialParameters.n_elem; ++i)
+  {
+    REQUIRE(model->Parameters()[i] ==
+        Approx(serialParameters[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Test that parallel k-fold cross-validation with a learner that draws random
+ * numbers (random initial weights, shuffled SGD) gives the same results twice
+ * with the same seed, and leaves the Armadillo generator of the calling thread
+ * in the same state.
+ */
+TEST_CASE("KFoldCVParallelRandomizedTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 300);
+  arma::Row<size_t> labels =
+      arma::conv_to<arma::Row<size_t>>::from(data.row(0) + data.row(1) > 1.0);
+
+  KFoldCV<SoftmaxRegression, Accuracy> cv(6, data, labels, 2, false);
+  cv.Parallel() = true;
+
+  // A few passes of SGD do not converge, so the model depends on the random
+  // numbers.
+  ens::StandardSGD sgd(0.1, 10, 500, 1e-10, true);
+
+  double accuracy[2], nextRandom[2];
+  arma::mat parameters[2];
+  for (size_t run = 0; run < 2; ++run)
+  {
+    math::RandomSeed(42);
+    accuracy[run] = cv.Evaluate(0.0001, false, sgd);
+    parameters[run] = cv.Model().Parameters();
+    nextRandom[run] = arma::randu();
+  }
+
+  REQUIRE(accuracy[0] == accuracy[1]);
+  REQUIRE(nextRandom[0] == nextRandom[1]);
+  REQUIRE(arma::approx_equal(parameters[0], parameters[1], "absdiff", 0.0));
+}
+
 /**
  * Test k-fold cross-validation with decision trees constructed in multiple
  * ways.
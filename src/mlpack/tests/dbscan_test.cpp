@@ -306,3 +306,39 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * Make sure that the assignments do not depend on how the range search is
+ * done: batch search with dual-tree and single-tree range search, blocked
+ * pointwise search and random point selection should all give exactly the
+ * same labels, even though the points are merged in parallel.
+ */
+TEST_CASE("DeterministicAssignmentsTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 2500);
+
+  GaussianDistribution g1(3), g2(3);
+  g1.Mean() = arma::vec("0.0 0.0 0.0");
+  g2.Mean() = arma::vec("8.0 8.0 8.0");
+  for (size_t i = 0; i < points.n_cols; ++i)
+    points.col(i) = (i % 2 == 0) ? g1.Random() : g2.Random();
+
+  DBSCAN<> dualTree(0.8, 5);
+  DBSCAN<> singleTree(0.8, 5, true, RangeSearch<>(false, true));
+  DBSCAN<> pointwise(0.8, 5, false);
+  DBSCAN<RangeSearch<>, RandomPointSelection> random(0.8, 5);
+
+  arma::Row<size_t> dualTreeAssignments, singleTreeAssignments,
+      pointwiseAssignments, randomAssignments;
+  const size_t clusters = dualTree.Cluster(points, dualTreeAssignments);
+  REQUIRE(singleTree.Cluster(points, singleTreeAssignments) == clusters);
+  REQUIRE(pointwise.Cluster(points, pointwiseAssignments) == clusters);
+  REQUIRE(random.Cluster(points, randomAssignments) == clusters);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(singleTreeAssignments[i] == dualTreeAssignments[i]);
+    REQUIRE(pointwiseAssignments[i] == dualTreeAssignments[i]);
+    REQUIRE(randomAssignments[i] == dualTreeAssignments[i]);
+  }
+}
@@ -221,6 +221,36 @@ BOOST_AUTO_TEST_CASE(DualTreeVsNaive)
   }
 }
 
+/**
+ * Compare the dual-tree and naive methods on high-dimensional data, where the
+ * leaf base cases are computed as distance tiles.
+ */
+BOOST_AUTO_TEST_CASE(DualTreeVsNaiveHighDimensional)
+{
+  arma::mat inputData = arma::randu<arma::mat>(24, 800);
+
+  arma::mat dualData = inputData;
+  arma::mat naiveData = inputData;
+
+  DualTreeBoruvka<> dtb(dualData);
+  arma::mat dualResults;
+  dtb.ComputeMST(dualResults);
+
+  DualTreeBoruvka<> dtbNaive(naiveData, true);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(naiveResults);
+
+  BOOST_REQUIRE_EQUAL(dualResults.n_cols, naiveResults.n_cols);
+  BOOST_REQUIRE_EQUAL(dualResults.n_rows, naiveResults.n_rows);
+
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(dualResults(0, i), naiveResults(0, i));
+    BOOST_REQUIRE_EQUAL(dualResults(1, i), naiveResults(1, i));
+    BOOST_REQUIRE_CLOSE(dualResults(2, i), naiveResults(2, i), 1e-5);
+  }
+}
+
 /**
  * Make sure the cover tree works fine.
  */
@@ -278,4 +308,54 @@ BOOST_AUTO_TEST_CASE(BallTreeTest)
   }
 }
 
+/**
+ * Make sure the minimum spanning tree of the mutual reachability graph is the
+ * same in dual-tree and naive mode.  Mutual reachability distances have many
+ * ties, so only the edge lengths (which are the same for every minimum
+ * spanning tree) are compared.
+ */
+BOOST_AUTO_TEST_CASE(MutualReachabilityTest)
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  // Use the distance to a few neighbors as core distances.
+  arma::vec coreDistances(inputData.n_cols);
+  for (size_t i = 0; i < inputData.n_cols; ++i)
+  {
+    arma::vec distances(inputData.n_cols);
+    for (size_t j = 0; j < inputData.n_cols; ++j)
+      distances[j] = EuclideanDistance::Evaluate(inputData.col(i),
+          inputData.col(j));
+    coreDistances[i] = arma::sort(distances)[4];
+  }
+
+  DualTreeBoruvka<> dtb(inputData);
+  DualTreeBoruvka<> naive(inputData, true);
+
+  arma::mat dtbResults;
+  arma::mat naiveResults;
+  dtb.ComputeMST(dtbResults, coreDistances);
+  naive.ComputeMST(naiveResults, coreDistances);
+
+  BOOST_REQUIRE_EQUAL(dtbResults.n_cols, inputData.n_cols - 1);
+  BOOST_REQUIRE_EQUAL(naiveResults.n_cols, inputData.n_cols - 1);
+  for (size_t i = 0; i < dtbResults.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(dtbResults(2, i), naiveResults(2, i), 1e-5);
+
+    // Every edge must be at least as long as the core distances of its
+    // endpoints.
+    const size_t a = (size_t) dtbResults(0, i);
+    const size_t b = (size_t) dtbResults(1, i);
+    BOOST_REQUIRE_GE(dtbResults(2, i), coreDistances[a]);
+    BOOST_REQUIRE_GE(dtbResults(2, i), coreDistances[b]);
+  }
+
+  // The number of core distances must match the number of points.
+  BOOST_REQUIRE_THROW(dtb.ComputeMST(dtbResults, arma::vec(10)),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -798,3 +798,46 @@ TEST_CASE("RBFNetworkTest", "[FeedForwardNetworkTest]")
   // RBFN neural net with MeanSquaredError.
   TestNetwork<>(model1, dataset, labels1, dataset, labels, 10, 0.1);
 }
+
+/**
+ * Make sure that training and prediction with sparse predictors gives the same
+ * results as with the equivalent dense predictors.
+ */
+TEST_CASE("FFNSparseInputTest", "[FeedForwardNetworkTest]")
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(500, 100, 0.02);
+  arma::mat data(sparseData);
+  arma::mat responses = arma::randu<arma::mat>(2, 100);
+
+  FFN<MeanSquaredError<> > denseModel, sparseModel;
+  denseModel.Add<Linear<> >(500, 8);
+  denseModel.Add<SigmoidLayer<> >();
+  denseModel.Add<Linear<> >(8, 2);
+  sparseModel.Add<Linear<> >(500, 8);
+  sparseModel.Add<SigmoidLayer<> >();
+  sparseModel.Add<Linear<> >(8, 2);
+
+  // Use the same seed so that both models get the same initial weights, and
+  // don't shuffle, so that both models see the batches in the same order.
+  ens::StandardSGD opt(0.01, 10, 5 * data.n_cols, -1, false);
+  math::RandomSeed(42);
+  const double denseObjective = denseModel.Train(data, responses, opt);
+  math::RandomSeed(42);
+  const double sparseObjective = sparseModel.Train(sparseData, responses, opt);
+
+  REQUIRE(sparseObjective == Approx(denseObjective).epsilon(1e-7));
+  CheckMatrices(sparseModel.Parameters(), denseModel.Parameters(), 1e-5);
+
+  arma::mat densePredictions, sparsePredictions;
+  denseModel.Predict(data, densePredictions);
+  sparseModel.Predict(sparseData, sparsePredictions);
+  CheckMatrices(sparsePredictions, densePredictions, 1e-5);
+
+  // Sparse input is only supported if the first layer is a Linear layer.
+  FFN<MeanSquaredError<> > invalidModel;
+  invalidModel.Add<SigmoidLayer<> >();
+  invalidModel.Add<Linear<> >(500, 2);
+  REQUIRE_THROWS_AS(invalidModel.Train(sparseData, responses, opt),
+      std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file tests/hdbscan_test.cpp
+ *
+ * Test the HDBSCAN implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan/hdbscan.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+using namespace mlpack::metric;
+using namespace mlpack::tree;
+
+/**
+ * Return the label that most points in the given range have, and the number
+ * of points that have it.
+ */
+static size_t MajorityLabel(const arma::Row<size_t>& assignments,
+                            const size_t begin,
+                            const size_t end,
+                            size_t& count)
+{
+  std::map<size_t, size_t> counts;
+  for (size_t i = begin; i < end; ++i)
+    ++counts[assignments[i]];
+
+  size_t label = SIZE_MAX;
+  count = 0;
+  for (std::map<size_t, size_t>::const_iterator it = counts.begin();
+       it != counts.end(); ++it)
+  {
+    if (it->second > count)
+    {
+      label = it->first;
+      count = it->second;
+    }
+  }
+
+  return label;
+}
+
+/**
+ * Two blobs of very different densities, which no single DBSCAN radius can
+ * separate well, should be found as two clusters, and far outliers should be
+ * noise.
+ */
+TEST_CASE("HDBSCANVariableDensityTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 602);
+  points.cols(0, 299) = 0.05 * arma::randn<arma::mat>(2, 300);
+  points.cols(300, 599) = 1.0 * arma::randn<arma::mat>(2, 300);
+  points.cols(300, 599).each_col() += arma::vec("10.0 10.0");
+  points.col(600) = arma::vec("100.0 -100.0");
+  points.col(601) = arma::vec("-100.0 100.0");
+
+  for (size_t naive = 0; naive < 2; ++naive)
+  {
+    HDBSCAN<> h(20, 0, false, (naive == 1));
+
+    arma::Row<size_t> assignments;
+    const size_t clusters = h.Cluster(points, assignments);
+
+    REQUIRE(clusters == 2);
+    REQUIRE(assignments.n_elem == points.n_cols);
+
+    size_t denseCount, sparseCount;
+    const size_t denseLabel = MajorityLabel(assignments, 0, 300, denseCount);
+    const size_t sparseLabel = MajorityLabel(assignments, 300, 600,
+        sparseCount);
+
+    REQUIRE(denseLabel != SIZE_MAX);
+    REQUIRE(sparseLabel != SIZE_MAX);
+    REQUIRE(denseLabel != sparseLabel);
+    REQUIRE(denseCount >= 270);
+    REQUIRE(sparseCount >= 270);
+
+    REQUIRE(assignments[600] == SIZE_MAX);
+    REQUIRE(assignments[601] == SIZE_MAX);
+  }
+}
+
+/**
+ * The centroids of the clusters should be close to the blob centers.
+ */
+TEST_CASE("HDBSCANCentroidTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 400);
+  points.cols(0, 199) = 0.1 * arma::randn<arma::mat>(3, 200);
+  points.cols(200, 399) = 0.1 * arma::randn<arma::mat>(3, 200);
+  points.cols(200, 399).each_col() += arma::vec("5.0 5.0 5.0");
+
+  HDBSCAN<EuclideanDistance, BallTree> h(10);
+
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  const size_t clusters = h.Cluster(points, assignments, centroids);
+
+  REQUIRE(clusters == 2);
+  REQUIRE(centroids.n_rows == 3);
+  REQUIRE(centroids.n_cols == 2);
+
+  // One centroid must be near the origin, the other near (5, 5, 5).
+  const size_t nearOrigin = (arma::norm(centroids.col(0)) <
+      arma::norm(centroids.col(1))) ? 0 : 1;
+  REQUIRE(arma::norm(centroids.col(nearOrigin)) < 0.2);
+  REQUIRE(arma::norm(centroids.col(1 - nearOrigin) -
+      arma::vec("5.0 5.0 5.0")) < 0.2);
+}
+
+/**
+ * A single blob that is too small to be split into two clusters is one
+ * cluster if allowSingleCluster is set, and noise otherwise.
+ */
+TEST_CASE("HDBSCANSingleClusterTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 200);
+  points = 0.01 * arma::randn<arma::mat>(2, 200);
+
+  HDBSCAN<> h(150, 5, true);
+
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  // No two clusters of 150 points each fit into 200 points.
+  REQUIRE(clusters == 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE((assignments[i] == 0 || assignments[i] == SIZE_MAX));
+
+  h.AllowSingleCluster() = false;
+  REQUIRE(h.Cluster(points, assignments) == 0);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+}
+
+/**
+ * Invalid parameters and tiny datasets should be handled.
+ */
+TEST_CASE("HDBSCANEdgeCaseTest", "[HDBSCANTest]")
+{
+  REQUIRE_THROWS_AS(HDBSCAN<>(1), std::invalid_argument);
+
+  HDBSCAN<> h(2);
+  arma::Row<size_t> assignments;
+  arma::mat points(3, 1, arma::fill::randu);
+  REQUIRE(h.Cluster(points, assignments) == 0);
+  REQUIRE(assignments.n_elem == 1);
+  REQUIRE(assignments[0] == SIZE_MAX);
+}
@@ -326,6 +326,246 @@ BOOST_AUTO_TEST_CASE(HPTTest)
   BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
 }
 
+/**
+ * Test HyperParameterTuner with ParallelGridSearch gives the same result as
+ * with GridSearch.
+ */
+BOOST_AUTO_TEST_CASE(HPTParallelGridSearchTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  for (size_t maxModels = 0; maxModels < 3; ++maxModels)
+  {
+    double actualLambda1, actualLambda2;
+    HyperParameterTuner<LARS, MSE, SimpleCV, ParallelGridSearch>
+        hpt(validationSize, xs, ys);
+    hpt.Optimizer().MaxConcurrentModels() = maxModels;
+    std::tie(actualLambda1, actualLambda2) = hpt.Optimize(
+        Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+    BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+    BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+    BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+
+    // The best model is the one trained with the best lambdas.
+    size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+    arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+    arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+    double objective = MSE::Evaluate(hpt.BestModel(), validationXs,
+        validationYs);
+    BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
+  }
+}
+
+/**
+ * Make sure that the given tuner found a combination of the given lambdas whose
+ * objective and model are the ones of a full evaluation.
+ */
+template<typename TunerType>
+void CheckLARSTunerResult(TunerType& hpt,
+                          const arma::mat& xs,
+                          const arma::rowvec& ys,
+                          const double validationSize,
+                          const arma::vec& lambda1Set,
+                          const arma::vec& lambda2Set,
+                          const double lambda1,
+                          const double lambda2)
+{
+  BOOST_REQUIRE(arma::any(arma::abs(lambda1Set - lambda1) < 1e-10));
+  BOOST_REQUIRE(arma::any(arma::abs(lambda2Set - lambda2) < 1e-10));
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  const double expectedObjective = cv.Evaluate(true, false, lambda1, lambda2);
+  BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  double objective = MSE::Evaluate(hpt.BestModel(), validationXs,
+      validationYs);
+  BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
+}
+
+/**
+ * Test HyperParameterTuner with SuccessiveHalving.  With a single rung it must
+ * give the same result as GridSearch.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      hpt(validationSize, xs, ys);
+  hpt.Optimizer().MinBudget() = 1.0;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+
+  // With two rungs, the first one trains on a third of the training points.
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      hpt2(validationSize, xs, ys);
+  hpt2.Optimizer().MinBudget() = 1.0 / 3.0;
+  BOOST_REQUIRE_EQUAL(hpt2.Optimizer().NumRungs(), 2);
+  std::tie(actualLambda1, actualLambda2) = hpt2.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  CheckLARSTunerResult(hpt2, xs, ys, validationSize, lambda1Set, lambda2Set,
+      actualLambda1, actualLambda2);
+}
+
+/**
+ * Test HyperParameterTuner with Hyperband.
+ */
+BOOST_AUTO_TEST_CASE(HPTHyperbandTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, Hyperband>
+      hpt(validationSize, xs, ys);
+  hpt.Optimizer().MinBudget() = 1.0 / 3.0;
+  hpt.Optimizer().MaxConcurrentModels() = 2;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  CheckLARSTunerResult(hpt, xs, ys, validationSize, lambda1Set, lambda2Set,
+      actualLambda1, actualLambda2);
+
+  // Invalid parameters are rejected.
+  hpt.Optimizer().Eta() = 1.0;
+  BOOST_REQUIRE_THROW(hpt.Optimize(Fixed(transposeData), Fixed(useCholesky),
+      lambda1Set, lambda2Set), std::invalid_argument);
+}
+
+/**
+ * A function on a two-dimensional grid for SuccessiveHalving and Hyperband,
+ * which counts its evaluations.  The objective is the distance to a target
+ * point, with random noise that shrinks as the budget grows.  The model is the
+ * objective itself.
+ */
+class CountingGridFunction
+{
+ public:
+  CountingGridFunction() : evaluations(0), bestModel(0.0) { }
+
+  double Evaluate(const arma::mat& parameters,
+                  std::unique_ptr<double>& model,
+                  const double budget)
+  {
+    #pragma omp atomic
+    ++evaluations;
+
+    const double objective = std::abs(parameters(0) - 5.0) +
+        std::abs(parameters(1) - 3.0) +
+        (1.0 - budget) * mlpack::math::Random(0.0, 2.0);
+    model.reset(new double(objective));
+    return objective;
+  }
+
+  double& BestModel() { return bestModel; }
+
+  size_t evaluations;
+
+ private:
+  double bestModel;
+};
+
+/**
+ * Make sure that SuccessiveHalving only evaluates the best points on the
+ * larger budgets.
+ */
+BOOST_AUTO_TEST_CASE(SuccessiveHalvingPruningTest)
+{
+  const std::vector<bool> categoricalDimensions(2, true);
+  const arma::Row<size_t> numCategories("9 9");
+
+  // Three rungs: 81, 27 and 9 points.
+  SuccessiveHalving sh(3.0, 1.0 / 9.0);
+  BOOST_REQUIRE_EQUAL(sh.NumRungs(), 3);
+
+  CountingGridFunction function;
+  arma::mat iterate;
+  sh.Optimize(function, iterate, categoricalDimensions, numCategories);
+
+  BOOST_REQUIRE_EQUAL(function.evaluations, 81 + 27 + 9);
+  BOOST_REQUIRE_LT(function.evaluations, 81 * sh.NumRungs());
+}
+
+/**
+ * Make sure that Hyperband gives the same result twice with the same seed,
+ * and that its brackets are pruned.
+ */
+BOOST_AUTO_TEST_CASE(HyperbandSeedTest)
+{
+  const std::vector<bool> categoricalDimensions(2, true);
+  const arma::Row<size_t> numCategories("9 9");
+
+  Hyperband hyperband(3.0, 1.0 / 9.0);
+  const size_t numRungs = SuccessiveHalving(3.0, 1.0 / 9.0).NumRungs();
+
+  double objective[2], bestModel[2], nextRandom[2];
+  arma::mat iterate[2];
+  size_t evaluations[2];
+  for (size_t run = 0; run < 2; ++run)
+  {
+    mlpack::math::RandomSeed(42);
+    CountingGridFunction function;
+    objective[run] = hyperband.Optimize(function, iterate[run],
+        categoricalDimensions, numCategories);
+    bestModel[run] = function.BestModel();
+    evaluations[run] = function.evaluations;
+    nextRandom[run] = arma::randu();
+  }
+
+  BOOST_REQUIRE_EQUAL(objective[0], objective[1]);
+  BOOST_REQUIRE_EQUAL(bestModel[0], bestModel[1]);
+  BOOST_REQUIRE_EQUAL(iterate[0](0), iterate[1](0));
+  BOOST_REQUIRE_EQUAL(iterate[0](1), iterate[1](1));
+  BOOST_REQUIRE_EQUAL(nextRandom[0], nextRandom[1]);
+
+  // Brackets of 9, 5 and 3 points, with 3, 2 and 1 rungs.
+  BOOST_REQUIRE_EQUAL(evaluations[0], (9 + 3 + 1) + (5 + 1) + 3);
+  BOOST_REQUIRE_LT(evaluations[0], 81 * numRungs);
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
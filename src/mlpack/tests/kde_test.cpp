@@ -10,6 +10,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/kde/kde.hpp>
+#include <mlpack/methods/kde/gaussian_taylor_expansion.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
@@ -1301,4 +1302,262 @@ BOOST_AUTO_TEST_CASE(GaussianBreadthDualKDTreeMonteCarloKDE)
   BOOST_REQUIRE_GT(correctResults, 70);
 }
 
+/**
+ * Make sure that the Taylor expansion of the Gaussian kernel converges to the
+ * sum of the kernel values, within its error bound.
+ */
+BOOST_AUTO_TEST_CASE(GaussianTaylorExpansionTest)
+{
+  arma::mat reference = 0.3 * arma::randu(3, 50);
+  const double bandwidth = 0.5;
+  arma::vec query("0.6 0.5 0.4");
+
+  // Build a tree with a single node so that every point is expanded.
+  tree::KDTree<metric::EuclideanDistance, kde::KDEStat, arma::mat>
+      node(reference, 100);
+  arma::vec center;
+  node.Center(center);
+  const double distance = arma::norm(query - center);
+
+  GaussianKernel kernel(bandwidth);
+  double exact = 0.0;
+  for (size_t i = 0; i < reference.n_cols; ++i)
+    exact += kernel.Evaluate(arma::norm(query - node.Dataset().col(i)));
+
+  GaussianTaylorExpansion expansion(bandwidth, 3);
+  BOOST_REQUIRE_EQUAL(expansion.NumTerms(1), 1);
+  BOOST_REQUIRE_EQUAL(expansion.NumTerms(2), 4);
+  BOOST_REQUIRE_EQUAL(expansion.NumTerms(3), 10);
+
+  double error = 0.0;
+  for (size_t order = 1; order <= 8; ++order)
+  {
+    arma::vec moments;
+    expansion.Moments(node, node.Dataset(), center, order, moments);
+    BOOST_REQUIRE_EQUAL(moments.n_elem, expansion.NumTerms(order));
+
+    const double estimate = expansion.Evaluate(moments, center, order, query);
+    const double bound = reference.n_cols * expansion.ErrorBound(order,
+        math::Range(distance, distance), node.FurthestDescendantDistance());
+
+    error = std::abs(estimate - exact);
+    BOOST_REQUIRE_LE(error, bound);
+  }
+
+  // With order 8 the expansion should be very accurate.
+  BOOST_REQUIRE_LT(error, 1e-5 * exact);
+}
+
+/**
+ * Test dual-tree KD-tree results with Taylor expansions against brute force
+ * results.  The error guarantee is still absolute.
+ */
+BOOST_AUTO_TEST_CASE(GaussianDualKDTreeSeriesKDE)
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 200);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.05;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Optimized KDE.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+    kde(relError,
+        0.0,
+        kernel,
+        KDEMode::DUAL_TREE_MODE,
+        metric,
+        false,
+        KDEDefaultParams::mcProb,
+        KDEDefaultParams::initialSampleSize,
+        KDEDefaultParams::mcEntryCoef,
+        KDEDefaultParams::mcBreakCoef,
+        true);
+  BOOST_REQUIRE(kde.SeriesExpansion());
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
+}
+
+/**
+ * Test single-tree cover tree results with Taylor expansions against brute
+ * force results, for the monochromatic case.
+ */
+BOOST_AUTO_TEST_CASE(GaussianSingleCoverTreeSeriesMonoKDE)
+{
+  arma::mat reference = arma::randu(3, 2000);
+  arma::vec bfEstimations = arma::vec(reference.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.1;
+  const double relError = 0.02;
+
+  // Brute force KDE, without the contribution of each point to itself.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                reference,
+                                bfEstimations,
+                                kernel);
+  bfEstimations -= 1.0 / reference.n_cols;
+
+  // Optimized KDE.
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::StandardCoverTree>
+    kde(relError, 0.0, kernel, KDEMode::SINGLE_TREE_MODE);
+  kde.SeriesExpansion() = true;
+  kde.Train(reference);
+  kde.Evaluate(treeEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < reference.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
+}
+
+/**
+ * Test that adding reference points in batches gives the same results as
+ * training with all of the points at once.
+ */
+BOOST_AUTO_TEST_CASE(AddReferencePointsKDE)
+{
+  arma::mat reference = arma::randu(2, 1450);
+  arma::mat query = arma::randu(2, 300);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec bfMonoEstimations = arma::vec(reference.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.2;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+  BruteForceKDE<GaussianKernel>(reference, reference, bfMonoEstimations,
+      kernel);
+  bfMonoEstimations -= 1.0 / reference.n_cols;
+
+  // Train with the first 1000 points and add the rest in batches.
+  KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, tree::KDTree>
+      kde(relError, 0.0, kernel);
+  kde.Train(reference.cols(0, 999));
+  kde.AddReferencePoints(reference.cols(1000, 1099));
+  kde.AddReferencePoints(reference.cols(1100, 1199));
+  BOOST_REQUIRE_EQUAL(kde.AddedTrees().size(), 1);
+  kde.AddReferencePoints(reference.cols(1200, 1249));
+  kde.AddReferencePoints(reference.cols(1250, 1449));
+  BOOST_REQUIRE_EQUAL(kde.AddedTrees().size(), 1);
+  BOOST_REQUIRE_EQUAL(kde.NumReferencePoints(), reference.n_cols);
+
+  kde.Evaluate(query, treeEstimations);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
+
+  // Monochromatic estimations are returned in the order the points were
+  // added.
+  kde.Evaluate(treeEstimations);
+  BOOST_REQUIRE_EQUAL(treeEstimations.n_elem, reference.n_cols);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(bfMonoEstimations[i], treeEstimations[i],
+        relError * 100);
+  }
+
+  // Adding as many points as the reference tree has rebuilds a single tree.
+  arma::mat extra = arma::randu(2, 1500);
+  kde.AddReferencePoints(extra);
+  BOOST_REQUIRE_EQUAL(kde.AddedTrees().size(), 0);
+  BOOST_REQUIRE_EQUAL(kde.NumReferencePoints(), 2950);
+}
+
+/**
+ * Test that Monte Carlo estimations keep their guarantees when the reference
+ * set is split between several trees.
+ */
+BOOST_AUTO_TEST_CASE(AddReferencePointsMonteCarloKDE)
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 200);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.4;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  // Optimized KDE, with the reference set in three trees.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, tree::KDTree>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric, true, 0.95,
+          100, 3, 0.8);
+  kde.Train(reference.cols(0, 1999));
+  kde.AddReferencePoints(reference.cols(2000, 2599));
+  kde.AddReferencePoints(reference.cols(2600, 2999));
+  BOOST_REQUIRE_EQUAL(kde.AddedTrees().size(), 2);
+  kde.Evaluate(query, treeEstimations);
+
+  // The Monte Carlo estimation has a random component so it can fail.
+  // Therefore we require a reasonable amount of results to be right.
+  size_t correctResults = 0;
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    const double resultRelativeError =
+      std::abs((bfEstimations[i] - treeEstimations[i]) / bfEstimations[i]);
+    if (resultRelativeError < relError)
+      ++correctResults;
+  }
+
+  BOOST_REQUIRE_GT(correctResults, 70);
+}
+
+/**
+ * Test that adding reference points works with trees that do not rearrange
+ * the dataset, in single-tree mode.
+ */
+BOOST_AUTO_TEST_CASE(AddReferencePointsSingleCoverTreeKDE)
+{
+  arma::mat reference = arma::randu(3, 800);
+  arma::mat query = arma::randu(3, 200);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  EpanechnikovKernel kernel(kernelBandwidth);
+  BruteForceKDE<EpanechnikovKernel>(reference, query, bfEstimations, kernel);
+
+  // Optimized KDE, with points added one at a time at the end.
+  KDE<EpanechnikovKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::StandardCoverTree>
+    kde(relError, 0.0, kernel, KDEMode::SINGLE_TREE_MODE);
+  kde.Train(reference.cols(0, 499));
+  for (size_t i = 500; i < reference.n_cols; i += 20)
+    kde.AddReferencePoints(reference.cols(i, i + 19));
+
+  // 300 points in batches of 20: one tree per set bit of 15.
+  BOOST_REQUIRE_EQUAL(kde.AddedTrees().size(), 4);
+
+  kde.Evaluate(query, treeEstimations);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -683,6 +683,51 @@ TEST_CASE("KNNDualTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test the dual-tree nearest-neighbors method with the naive method on
+ * high-dimensional data, where the leaf base cases are computed as distance
+ * tiles.  Both nearest and furthest neighbor search are checked.
+ */
+TEST_CASE("KNNDualTreeVsNaiveHighDimensional", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(32, 1200);
+  arma::mat queryData = arma::randu<arma::mat>(32, 300);
+
+  KNN knn(referenceData);
+  KNN naive(referenceData, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+
+  // Monochromatic search.
+  knn.Search(10, neighborsTree, distancesTree);
+  naive.Search(10, neighborsNaive, distancesNaive);
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // Bichromatic search.
+  knn.Search(queryData, 10, neighborsTree, distancesTree);
+  naive.Search(queryData, 10, neighborsNaive, distancesNaive);
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  KFN kfn(referenceData);
+  KFN naiveKFN(referenceData, NAIVE_MODE);
+  kfn.Search(queryData, 10, neighborsTree, distancesTree);
+  naiveKFN.Search(queryData, 10, neighborsNaive, distancesNaive);
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
+
 /**
  * Test the dual-tree nearest-neighbors method with the naive method.  This uses
  * only a reference dataset.
@@ -1143,6 +1188,56 @@ TEST_CASE("KNNModelTest", "[KNNTest]")
   }
 }
 
+TEST_CASE("KNNModelFlatFileTest", "[KNNTest]")
+{
+  // Save kd-tree and ball tree models to flat files, load them into fresh
+  // models, and make sure that the results are the same.
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(10, 500);
+  const std::string filename = "knn_model_flat_test.bin";
+
+  const KNNModel::TreeTypes treeTypes[2] = { KNNModel::TreeTypes::KD_TREE,
+      KNNModel::TreeTypes::BALL_TREE };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    KNNModel model(treeTypes[i], false);
+    arma::mat referenceCopy(referenceData);
+    model.BuildModel(std::move(referenceCopy), 20, DUAL_TREE_MODE);
+
+    arma::Mat<size_t> baselineNeighbors;
+    arma::mat baselineDistances;
+    arma::mat queryCopy(queryData);
+    model.Search(std::move(queryCopy), 3, baselineNeighbors,
+        baselineDistances);
+
+    model.SaveFlat(filename);
+
+    KNNModel loaded(treeTypes[i], false);
+    loaded.LoadFlat(filename);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    queryCopy = queryData;
+    loaded.Search(std::move(queryCopy), 3, neighbors, distances);
+
+    REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+    REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+    for (size_t k = 0; k < neighbors.n_elem; ++k)
+    {
+      REQUIRE(neighbors[k] == baselineNeighbors[k]);
+      REQUIRE(distances[k] == Approx(baselineDistances[k]).epsilon(1e-7));
+    }
+
+    // A model of another tree type cannot load the file.
+    KNNModel other(KNNModel::TreeTypes::COVER_TREE, false);
+    REQUIRE_THROWS(other.LoadFlat(filename));
+  }
+
+  remove(filename.c_str());
+}
+
 TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1814,3 +1909,38 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Make sure that the candidate arena keeps the k best candidates of each query
+ * sorted, both with the linear scan (small k) and the binary search (large k).
+ */
+TEST_CASE("KNNCandidateArenaTest", "[KNNTest]")
+{
+  const size_t ks[] = { 3, CandidateArena<NearestNeighborSort>::LinearScanLimit
+      + 5 };
+  for (size_t t = 0; t < 2; ++t)
+  {
+    const size_t k = ks[t];
+    CandidateArena<NearestNeighborSort> arena(k, 2);
+
+    arma::vec values = arma::randu<arma::vec>(100);
+    for (size_t i = 0; i < values.n_elem; ++i)
+    {
+      arena.Insert(0, i, values[i]);
+      arena.Insert(1, i, -values[i]);
+    }
+
+    // A candidate that is no better than the worst one must be rejected.
+    REQUIRE(!arena.Insert(0, 100, arena.WorstDistance(0)));
+
+    const arma::uvec order = arma::sort_index(values, "ascend");
+    const arma::uvec reverseOrder = arma::sort_index(values, "descend");
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(arena.Indices()(j, 0) == order[j]);
+      REQUIRE(arena.Distances()(j, 0) == Approx(values[order[j]]));
+      REQUIRE(arena.Indices()(j, 1) == reverseOrder[j]);
+    }
+    REQUIRE(arena.WorstDistance(0) == Approx(values[order[k - 1]]));
+  }
+}
@@ -12,6 +12,8 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/chunk_reader.hpp>
+#include <mlpack/core/data/chunk_writer.hpp>
 #include <mlpack/core/data/load_arff.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include "catch.hpp"
@@ -2466,3 +2468,238 @@ TEST_CASE("DatasetMapperNonUniqueTest", "[LoadSaveTest]")
   REQUIRE(dm.UnmapString(nan, 0, 1) == "goodbye");
   REQUIRE(dm.UnmapString(nan, 0, 2) == "cheese");
 }
+
+/**
+ * Read every chunk of the given reader, and make sure that the chunks make up
+ * the given matrix.
+ */
+static void CheckChunks(ChunkReader<double>& reader, const arma::mat& expected)
+{
+  arma::mat chunk;
+  size_t begin = 0;
+  while (reader.Next(chunk))
+  {
+    REQUIRE(chunk.n_rows == expected.n_rows);
+    REQUIRE(chunk.n_cols <= reader.ChunkSize());
+    CheckMatrices(chunk,
+        arma::mat(expected.cols(begin, begin + chunk.n_cols - 1)));
+    begin += chunk.n_cols;
+  }
+
+  REQUIRE(chunk.is_empty());
+  REQUIRE(begin == expected.n_cols);
+  REQUIRE(reader.PointsRead() == expected.n_cols);
+}
+
+/**
+ * Make sure that text files are read in chunks like data::Load() reads them.
+ */
+TEST_CASE("ChunkReaderTextTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 103, arma::fill::randu);
+  REQUIRE(data::Save("chunk_test.csv", dataset) == true);
+  REQUIRE(data::Save("chunk_test.txt", dataset) == true);
+
+  arma::mat csvDataset, txtDataset;
+  REQUIRE(data::Load("chunk_test.csv", csvDataset) == true);
+  REQUIRE(data::Load("chunk_test.txt", txtDataset) == true);
+
+  ChunkReader<double> csvReader("chunk_test.csv", 10);
+  REQUIRE(csvReader.Type() == arma::csv_ascii);
+  REQUIRE(csvReader.Dimensionality() == 4);
+  CheckChunks(csvReader, csvDataset);
+
+  // The file can be read again.
+  csvReader.Reset();
+  CheckChunks(csvReader, csvDataset);
+
+  // Read the other file without the background thread.
+  ChunkReader<double> txtReader("chunk_test.txt", 10, true, arma::auto_detect,
+      1, false);
+  REQUIRE(txtReader.Type() == arma::raw_ascii);
+  REQUIRE(txtReader.Dimensionality() == 4);
+  CheckChunks(txtReader, txtDataset);
+
+  remove("chunk_test.csv");
+  remove("chunk_test.txt");
+}
+
+/**
+ * Make sure that Armadillo binary and raw binary files are read in chunks.
+ */
+TEST_CASE("ChunkReaderBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+
+  // data::Save() transposes the data, so the file stores one dimension after
+  // the other.
+  REQUIRE(data::Save("chunk_test.bin", dataset) == true);
+  ChunkReader<double> reader("chunk_test.bin", 64);
+  REQUIRE(reader.Type() == arma::arma_binary);
+  REQUIRE(reader.Dimensionality() == 5);
+  REQUIRE(reader.NumPoints() == 1000);
+  CheckChunks(reader, dataset);
+
+  REQUIRE(data::Save("chunk_test_points.bin", dataset, true, false) == true);
+  ChunkReader<double> pointsReader("chunk_test_points.bin", 64, false);
+  REQUIRE(pointsReader.Dimensionality() == 5);
+  REQUIRE(pointsReader.NumPoints() == 1000);
+  CheckChunks(pointsReader, dataset);
+
+  REQUIRE(dataset.save("chunk_test.raw", arma::raw_binary) == true);
+  ChunkReader<double> rawReader("chunk_test.raw", 64, true, arma::raw_binary,
+      5);
+  REQUIRE(rawReader.NumPoints() == 1000);
+  CheckChunks(rawReader, dataset);
+
+  remove("chunk_test.bin");
+  remove("chunk_test_points.bin");
+  remove("chunk_test.raw");
+}
+
+/**
+ * Make sure that the errors of a malformed file are reported.
+ */
+TEST_CASE("ChunkReaderInvalidFileTest", "[LoadSaveTest]")
+{
+  std::fstream f;
+  f.open("chunk_test.csv", std::fstream::out);
+  f << "1, 2, 3" << std::endl;
+  f << "4, 5, 6" << std::endl;
+  f << "7, 8" << std::endl;
+  f.close();
+
+  ChunkReader<double> reader("chunk_test.csv", 2);
+  REQUIRE(reader.Dimensionality() == 3);
+
+  arma::mat chunk;
+  REQUIRE(reader.Next(chunk) == true);
+  REQUIRE(chunk.n_cols == 2);
+  REQUIRE_THROWS_AS(reader.Next(chunk), std::runtime_error);
+
+  REQUIRE_THROWS_AS(ChunkReader<double>("chunk_test_missing.csv"),
+      std::runtime_error);
+
+  remove("chunk_test.csv");
+}
+
+/**
+ * Make sure that files written in chunks hold the same data as if they were
+ * written by data::Save().
+ */
+TEST_CASE("ChunkWriterTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(3, 250, arma::fill::randu);
+
+  const std::vector<std::string> filenames = { "chunk_test.csv",
+      "chunk_test.txt", "chunk_test.bin" };
+  for (const std::string& filename : filenames)
+  {
+    ChunkWriter<double> writer(filename);
+    for (size_t begin = 0; begin < dataset.n_cols; begin += 40)
+    {
+      const size_t end = std::min((size_t) dataset.n_cols, begin + 40);
+      writer.Write(arma::mat(dataset.cols(begin, end - 1)));
+    }
+    writer.Close();
+    REQUIRE(writer.Dimensionality() == 3);
+    REQUIRE(writer.PointsWritten() == 250);
+
+    arma::mat loaded;
+    REQUIRE(data::Load(filename, loaded) == true);
+    CheckMatrices(loaded, dataset);
+
+    ChunkReader<double> reader(filename, 32);
+    CheckChunks(reader, dataset);
+
+    remove(filename.c_str());
+  }
+
+  // An Armadillo binary file with one point per column.
+  {
+    ChunkWriter<double> writer("chunk_test_points.bin", false);
+    writer.Write(arma::mat(dataset.cols(0, 99)));
+    writer.Write(arma::mat(dataset.cols(100, 249)));
+  }
+
+  arma::mat loaded;
+  REQUIRE(data::Load("chunk_test_points.bin", loaded, true, false) == true);
+  CheckMatrices(loaded, dataset);
+
+  // A raw binary file.
+  {
+    ChunkWriter<double> writer("chunk_test.raw", true, arma::raw_binary);
+    writer.Write(arma::mat(dataset.cols(0, 99)));
+    writer.Write(arma::mat(dataset.cols(100, 249)));
+  }
+
+  ChunkReader<double> rawReader("chunk_test.raw", 100, true, arma::raw_binary,
+      3);
+  CheckChunks(rawReader, dataset);
+
+  // Chunks of another dimensionality are not accepted.
+  ChunkWriter<double> writer("chunk_test.csv");
+  writer.Write(arma::mat(dataset.cols(0, 9)));
+  REQUIRE_THROWS_AS(writer.Write(arma::mat(2, 10, arma::fill::randu)),
+      std::invalid_argument);
+  writer.Close();
+
+  remove("chunk_test_points.bin");
+  remove("chunk_test.raw");
+  remove("chunk_test.csv");
+}
+
+#if defined(ARMA_USE_HDF5)
+/**
+ * Make sure that HDF5 files can be read and written in chunks.
+ */
+TEST_CASE("ChunkReaderWriterHDF5Test", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 300, arma::fill::randu);
+  REQUIRE(data::Save("chunk_test.h5", dataset) == true);
+
+  {
+    ChunkReader<double> reader("chunk_test.h5", 50);
+    REQUIRE(reader.Type() == arma::hdf5_binary);
+    REQUIRE(reader.Dimensionality() == 4);
+    REQUIRE(reader.NumPoints() == 300);
+    CheckChunks(reader, dataset);
+  }
+
+  {
+    ChunkWriter<double> writer("chunk_test_output.h5");
+    writer.Write(arma::mat(dataset.cols(0, 149)));
+    writer.Write(arma::mat(dataset.cols(150, 299)));
+  }
+
+  arma::mat loaded;
+  REQUIRE(data::Load("chunk_test_output.h5", loaded) == true);
+  CheckMatrices(loaded, dataset);
+
+  remove("chunk_test.h5");
+  remove("chunk_test_output.h5");
+}
+
+/**
+ * Make sure that closing an HDF5 ChunkWriter without writing any chunk gives
+ * an empty matrix.
+ */
+TEST_CASE("ChunkWriterEmptyHDF5Test", "[LoadSaveTest]")
+{
+  {
+    ChunkWriter<double> writer("chunk_test_empty.h5");
+    REQUIRE_NOTHROW(writer.Close());
+  }
+
+  arma::mat loaded(3, 3, arma::fill::ones);
+  REQUIRE(data::Load("chunk_test_empty.h5", loaded) == true);
+  REQUIRE(loaded.n_elem == 0);
+
+  ChunkReader<double> reader("chunk_test_empty.h5", 10);
+  REQUIRE(reader.NumPoints() == 0);
+  arma::mat chunk;
+  REQUIRE(reader.Next(chunk) == false);
+
+  remove("chunk_test_empty.h5");
+}
+#endif
@@ -12,6 +12,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
+#include "serialization.hpp"
 
 #include <mlpack/methods/lsh/lsh_search.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
@@ -985,4 +986,144 @@ BOOST_AUTO_TEST_CASE(SparseLSHTest)
   }
 }
 
+/**
+ * Test: with unlimited bucket size, the packed buckets must hold every point
+ * exactly once per table, each in the bucket its hash points to, and the
+ * unpacked second hash table must hold the same contents.
+ */
+BOOST_AUTO_TEST_CASE(LSHPackedBucketsTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+  const size_t numTables = 4;
+  LSHSearch<> lsh(referenceData, 3, numTables, 0.3, 1009, 0);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<uint32_t>& points = lsh.BucketPoints();
+  const arma::Col<size_t>& sizes = lsh.BucketContentSize();
+
+  BOOST_REQUIRE_EQUAL(offsets.n_elem, sizes.n_elem + 1);
+  BOOST_REQUIRE_EQUAL(points.n_elem, numTables * referenceData.n_cols);
+  BOOST_REQUIRE_EQUAL(offsets[offsets.n_elem - 1], points.n_elem);
+
+  arma::Col<size_t> counts(referenceData.n_cols, arma::fill::zeros);
+  const std::vector<arma::Col<size_t>> table = lsh.SecondHashTable();
+  BOOST_REQUIRE_EQUAL(table.size(), sizes.n_elem);
+  for (size_t i = 0; i < sizes.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(offsets[i + 1] - offsets[i], sizes[i]);
+    BOOST_REQUIRE_EQUAL(table[i].n_elem, sizes[i]);
+    for (size_t j = 0; j < sizes[i]; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(table[i][j], points[offsets[i] + j]);
+      counts[points[offsets[i] + j]]++;
+    }
+  }
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], numTables);
+
+  // Since every point is in the buckets, a monochromatic search must return
+  // valid neighbors that are not the query point itself.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(1, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    BOOST_REQUIRE_NE(neighbors(0, i), i);
+}
+
+/**
+ * Make sure that removed points are never returned, that inserted points can
+ * be found, and that both survive compaction and serialization.
+ */
+BOOST_AUTO_TEST_CASE(LSHInsertRemoveTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+  LSHSearch<> lsh(referenceData, 3, 4, 0.3, 1009, 0);
+
+  // Only compact when asked to.
+  lsh.CompactionThreshold() = DBL_MAX;
+
+  const arma::Col<size_t> removed = arma::regspace<arma::Col<size_t>>(0, 99);
+  lsh.Remove(removed);
+  for (size_t i = 0; i < 1000; ++i)
+    BOOST_REQUIRE_EQUAL(lsh.IsRemoved(i), (i < 100));
+
+  // Insert copies of the removed points; they hash to the same buckets.
+  const arma::mat newPoints = referenceData.cols(0, 99);
+  lsh.Insert(newPoints);
+  BOOST_REQUIRE_EQUAL(lsh.ReferenceSet().n_cols, 1100);
+
+  LSHSearch<> xmlLsh, textLsh, binaryLsh;
+  for (size_t pass = 0; pass < 3; ++pass)
+  {
+    if (pass == 1)
+      lsh.Compact();
+    else if (pass == 2)
+      SerializeObjectAll(lsh, xmlLsh, textLsh, binaryLsh);
+
+    std::vector<LSHSearch<>*> models;
+    models.push_back(&lsh);
+    if (pass == 2)
+    {
+      models.push_back(&xmlLsh);
+      models.push_back(&textLsh);
+      models.push_back(&binaryLsh);
+
+      // The removed points are still known after loading.
+      for (size_t m = 1; m < models.size(); ++m)
+        for (size_t i = 0; i < 1100; ++i)
+          BOOST_REQUIRE_EQUAL(models[m]->IsRemoved(i), (i < 100));
+    }
+
+    for (size_t m = 0; m < models.size(); ++m)
+    {
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      models[m]->Search(referenceData, 1, neighbors, distances);
+
+      for (size_t i = 0; i < neighbors.n_cols; ++i)
+      {
+        if (i < 100)
+        {
+          // The copy of the point must be found instead of the point itself.
+          BOOST_REQUIRE_EQUAL(neighbors(0, i), i + 1000);
+          BOOST_REQUIRE_SMALL(distances(0, i), 1e-10);
+        }
+        else if (neighbors(0, i) != models[m]->ReferenceSet().n_cols)
+        {
+          BOOST_REQUIRE_GE(neighbors(0, i), 100);
+        }
+      }
+    }
+  }
+
+  BOOST_REQUIRE_THROW(lsh.Insert(arma::randu<arma::mat>(4, 10)),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(lsh.Remove(arma::Col<size_t>({ 1100 })),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that removed points do not count towards the bucket size when
+ * points are inserted.
+ */
+BOOST_AUTO_TEST_CASE(LSHInsertIntoFullBucketTest)
+{
+  // Identical points always share their buckets, which are full.
+  arma::mat referenceData(3, 10, arma::fill::zeros);
+  LSHSearch<> lsh(referenceData, 3, 2, 1.0, 1009, 10);
+  lsh.CompactionThreshold() = DBL_MAX;
+
+  lsh.Remove(arma::regspace<arma::Col<size_t>>(0, 4));
+  lsh.Insert(arma::mat(3, 5, arma::fill::zeros));
+
+  // The inserted points replace the removed ones.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(arma::mat(3, 1, arma::fill::zeros), 10, neighbors, distances);
+  const arma::Col<size_t> found = arma::sort(neighbors.col(0));
+  for (size_t i = 0; i < 10; ++i)
+    BOOST_REQUIRE_EQUAL(found[i], i + 5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -611,6 +611,20 @@ BOOST_AUTO_TEST_CASE(CFNeighborSearchTest)
   BOOST_REQUIRE_EQUAL(output3.n_rows, 5);
   BOOST_REQUIRE_EQUAL(output3.n_cols, 7);
 
+  // Using approximate spill tree neighbor search.
+  SetInputParam("input_model",
+      std::move(IO::GetParam<CFModel*>("output_model")));
+  SetInputParam("query", query);
+  SetInputParam("neighbor_search", std::string("spill"));
+  SetInputParam("recommendations", 5);
+
+  mlpackMain();
+
+  const arma::Mat<size_t> output4 = IO::GetParam<arma::Mat<size_t>>("output");
+
+  BOOST_REQUIRE_EQUAL(output4.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(output4.n_cols, 7);
+
   // The resulting matrices should be different.
   BOOST_REQUIRE(arma::any(arma::vectorise(output1 != output2)));
   BOOST_REQUIRE(arma::any(arma::vectorise(output1 != output3)));
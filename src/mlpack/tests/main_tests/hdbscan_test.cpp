@@ -0,0 +1,105 @@
+/**
+ * @file tests/main_tests/hdbscan_test.cpp
+ *
+ * Test mlpackMain() of hdbscan_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <string>
+
+#define BINDING_TYPE BINDING_TYPE_TEST
+static const std::string testName = "HDBSCAN";
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include "test_helper.hpp"
+#include <mlpack/methods/hdbscan/hdbscan_main.cpp>
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+struct HDBSCANTestFixture
+{
+ public:
+  HDBSCANTestFixture()
+  {
+    // Cache in the options for this program.
+    IO::RestoreSettings(testName);
+  }
+
+  ~HDBSCANTestFixture()
+  {
+    // Clear the settings.
+    bindings::tests::CleanMemory();
+    IO::ClearSettings();
+  }
+};
+
+/**
+ * Check that number of output labels and number of input points are equal.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANOutputDimensionTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  const size_t inputSize = inputData.n_cols;
+
+  SetInputParam("input", inputData);
+
+  mlpackMain();
+
+  const arma::Row<size_t>& assignments =
+      IO::GetParam<arma::Row<size_t>>("assignments");
+  REQUIRE(assignments.n_cols == inputSize);
+  REQUIRE(assignments.n_rows == 1);
+  REQUIRE(IO::GetParam<arma::mat>("centroids").n_rows == 4);
+
+  // Every label is either noise or a valid cluster index.
+  const size_t clusters = IO::GetParam<arma::mat>("centroids").n_cols;
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE((assignments[i] == SIZE_MAX || assignments[i] < clusters));
+}
+
+/**
+ * Check that the minimum cluster size must be at least 2.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANMinClusterSizeTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("min_cluster_size", (int) 1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that an unknown tree type is rejected.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANTreeTypeTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("tree_type", std::string("octree"));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -698,3 +698,63 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNDifferentLeafSizes",
   REQUIRE(IO::GetParam<KNNModel*>("output_model")->LeafSize() == (int) 10);
   delete output_model;
 }
+
+/**
+ * Ensure that a query file that is read in chunks gives the same results as
+ * the same query matrix.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNQueryFileTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  arma::mat queryData;
+  queryData.randu(3, 90); // 90 points in 3 dimensions.
+  REQUIRE(data::Save("knn_query_file.bin", queryData) == true);
+  REQUIRE(data::Save("knn_query_file.csv", queryData) == true);
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", std::move(queryData));
+  SetInputParam("k", (int) 10);
+
+  mlpackMain();
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  neighbors = std::move(IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  distances = std::move(IO::GetParam<arma::mat>("distances"));
+
+  bindings::tests::CleanMemory();
+
+  IO::GetSingleton().Parameters()["reference"].wasPassed = false;
+  IO::GetSingleton().Parameters()["query"].wasPassed = false;
+
+  // The query file is read 7 points at a time.  The number of points of a
+  // binary file is known in advance.
+  SetInputParam("reference", referenceData);
+  SetInputParam("query_file", std::string("knn_query_file.bin"));
+  SetInputParam("chunk_size", (int) 7);
+
+  mlpackMain();
+
+  CheckMatrices(neighbors, IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, IO::GetParam<arma::mat>("distances"));
+
+  bindings::tests::CleanMemory();
+
+  IO::GetSingleton().Parameters()["reference"].wasPassed = false;
+  IO::GetSingleton().Parameters()["query_file"].wasPassed = false;
+
+  // The number of points of a text file is only known once it is read.
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("query_file", std::string("knn_query_file.csv"));
+
+  mlpackMain();
+
+  CheckMatrices(neighbors, IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, IO::GetParam<arma::mat>("distances"));
+
+  remove("knn_query_file.bin");
+  remove("knn_query_file.csv");
+}
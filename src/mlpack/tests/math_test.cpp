@@ -1009,4 +1009,36 @@ BOOST_AUTO_TEST_CASE(InplaceSparseShuffleWeightsTest)
   }
 }
 
+/**
+ * Make sure that a LocalRandomSeed gives the same numbers for the same seed on
+ * every thread, and does not touch the global generator.
+ */
+BOOST_AUTO_TEST_CASE(LocalRandomSeedTest)
+{
+  arma::vec expected(10);
+  {
+    LocalRandomSeed localSeed(42);
+    for (size_t i = 0; i < expected.n_elem; ++i)
+      expected[i] = (i % 2 == 0) ? Random() : RandNormal();
+  }
+
+  const std::mt19937 globalGen = randGen;
+
+  arma::mat results(expected.n_elem, 8);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) results.n_cols; ++j)
+  {
+    LocalRandomSeed localSeed(42);
+    for (size_t i = 0; i < results.n_rows; ++i)
+      results(i, j) = (i % 2 == 0) ? Random() : RandNormal();
+  }
+
+  for (size_t j = 0; j < results.n_cols; ++j)
+    for (size_t i = 0; i < results.n_rows; ++i)
+      BOOST_REQUIRE_EQUAL(results(i, j), expected[i]);
+
+  BOOST_REQUIRE(randGen == globalGen);
+  BOOST_REQUIRE(&RandGen() == &randGen);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -14,6 +14,7 @@
 #include <mlpack/core/metrics/iou_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
 #include <mlpack/core/metrics/bleu.hpp>
+#include <mlpack/core/metrics/distance_tile.hpp>
 #include "test_tools.hpp"
 
 using namespace std;
@@ -360,4 +361,136 @@ BOOST_AUTO_TEST_CASE(BLEUScoreTest)
   }
 }
 
+/**
+ * Make sure that the bounds of a Euclidean distance tile contain the distances
+ * returned by LMetric::Evaluate(), even for nearly duplicate points far away
+ * from the origin, where the expanded formula suffers from cancellation.
+ */
+BOOST_AUTO_TEST_CASE(EuclideanDistanceTileBoundsTest)
+{
+  arma::mat data = arma::randu<arma::mat>(16, 40) + 1000.0;
+  data.cols(20, 39) = data.cols(0, 19) +
+      1e-7 * arma::randn<arma::mat>(16, 20);
+
+  EuclideanDistance metric;
+  DistanceTile<EuclideanDistance, arma::mat> tile(metric, data, data);
+  BOOST_REQUIRE(tile.Enabled());
+
+  const arma::uvec queries = { 0, 3, 7, 19, 25 };
+  arma::mat lower, upper, distances;
+  tile.Bounds(queries, 10, 30, lower, upper);
+  tile.Evaluate(queries, 10, 30, distances);
+
+  BOOST_REQUIRE_EQUAL(lower.n_rows, queries.n_elem);
+  BOOST_REQUIRE_EQUAL(lower.n_cols, (size_t) 30);
+  for (size_t i = 0; i < queries.n_elem; ++i)
+  {
+    for (size_t j = 0; j < 30; ++j)
+    {
+      const double d = metric.Evaluate(data.col(queries[i]),
+          data.col(10 + j));
+      BOOST_REQUIRE_LE(lower(i, j), d);
+      BOOST_REQUIRE_GE(upper(i, j), d);
+      BOOST_REQUIRE_LE(lower(i, j), distances(i, j));
+      BOOST_REQUIRE_GE(upper(i, j), distances(i, j));
+    }
+  }
+}
+
+/**
+ * Make sure that the tile distances stay accurate for data that is far from the
+ * origin, where expanding the distances with the norms of the points would
+ * cancel catastrophically.
+ */
+BOOST_AUTO_TEST_CASE(EuclideanDistanceTileOffsetTest)
+{
+  arma::mat data = arma::randu<arma::mat>(16, 40) + 1e6;
+
+  EuclideanDistance metric;
+  DistanceTile<EuclideanDistance, arma::mat> tile(metric, data, data);
+
+  const arma::uvec queries = { 0, 3, 7, 19, 25 };
+  arma::mat distances;
+  tile.Evaluate(queries, 10, 30, distances);
+
+  for (size_t i = 0; i < queries.n_elem; ++i)
+  {
+    for (size_t j = 0; j < 30; ++j)
+    {
+      const double d = metric.Evaluate(data.col(queries[i]),
+          data.col(10 + j));
+      if (d == 0.0)
+        BOOST_REQUIRE_SMALL(distances(i, j), 1e-6);
+      else
+        BOOST_REQUIRE_CLOSE(distances(i, j), d, 1e-6);
+    }
+  }
+}
+
+/**
+ * Make sure that the contiguous-memory distance loops give the same results as
+ * Armadillo expressions, and that the bounded evaluations are exact below the
+ * bound and exceed the bound otherwise.
+ */
+BOOST_AUTO_TEST_CASE(RawDistanceTest)
+{
+  // Use a dimensionality that is not a multiple of the block size.
+  arma::mat data = arma::randn<arma::mat>(75, 10);
+  const arma::vec a = data.col(0);
+
+  for (size_t i = 1; i < data.n_cols; ++i)
+  {
+    const arma::vec b = data.col(i);
+    const arma::mat diff = data.col(0) - data.col(i);
+
+    BOOST_REQUIRE_CLOSE(ManhattanDistance::Evaluate(data.col(0), data.col(i)),
+        arma::accu(arma::abs(diff)), 1e-10);
+    BOOST_REQUIRE_CLOSE(SquaredEuclideanDistance::Evaluate(a, b),
+        arma::accu(arma::square(diff)), 1e-10);
+    BOOST_REQUIRE_CLOSE(EuclideanDistance::Evaluate(data.col(0), b),
+        arma::norm(diff, 2), 1e-10);
+    BOOST_REQUIRE_CLOSE(ChebyshevDistance::Evaluate(a, data.col(i)),
+        arma::max(arma::abs(arma::vectorise(diff))), 1e-10);
+
+    const double d = EuclideanDistance::Evaluate(data.col(0), data.col(i));
+    BOOST_REQUIRE_EQUAL(EuclideanDistance::EvaluateBounded(data.col(0),
+        data.col(i), d), d);
+    BOOST_REQUIRE_EQUAL(EuclideanDistance::EvaluateBounded(data.col(0),
+        data.col(i), 2 * d), d);
+    BOOST_REQUIRE_GT(EuclideanDistance::EvaluateBounded(data.col(0),
+        data.col(i), 0.1 * d), 0.1 * d);
+
+    const double l1 = ManhattanDistance::Evaluate(a, b);
+    BOOST_REQUIRE_EQUAL(ManhattanDistance::EvaluateBounded(a, b, l1), l1);
+    BOOST_REQUIRE_GT(ManhattanDistance::EvaluateBounded(a, b, 0.1 * l1),
+        0.1 * l1);
+
+    BOOST_REQUIRE_CLOSE(mlpack::kernel::LinearKernel::Evaluate(a,
+        data.col(i)), arma::dot(a, b), 1e-5);
+    BOOST_REQUIRE_CLOSE(mlpack::kernel::CosineDistance::Evaluate(data.col(0),
+        b), arma::dot(a, b) / (arma::norm(a, 2) * arma::norm(b, 2)), 1e-5);
+  }
+}
+
+#ifndef ARMA_NO_DEBUG
+/**
+ * Make sure that the contiguous-memory distance loops are not run on vectors of
+ * different sizes.
+ */
+BOOST_AUTO_TEST_CASE(RawDistanceSizeMismatchTest)
+{
+  arma::mat data = arma::randn<arma::mat>(10, 2);
+  arma::vec shorter = arma::randn<arma::vec>(9);
+
+  BOOST_REQUIRE_THROW(EuclideanDistance::Evaluate(data.col(0), shorter),
+      std::logic_error);
+  BOOST_REQUIRE_THROW(ManhattanDistance::Evaluate(shorter, data.col(1)),
+      std::logic_error);
+  BOOST_REQUIRE_THROW(SquaredEuclideanDistance::EvaluateBounded(data.col(0),
+      shorter, 1.0), std::logic_error);
+  BOOST_REQUIRE_THROW(ChebyshevDistance::Evaluate(data.col(0), shorter),
+      std::logic_error);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -229,3 +229,62 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Make sure that the sparse encoding of a matrix is the same as the dense one.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::Mat<int> input;
+  input = "1 1 -1 -1 -1 -1 1 1;"
+          "-1 1 -1 -1 -1 -1 1 -1;"
+          "0 1 0 2 0 0 1 0;"
+          "3 1 -1 5 -1 4 1 7;"
+          "-1 1 -1 -1 -1 -1 1 -1;";
+
+  arma::Mat<int> output;
+  arma::SpMat<int> sparseOutput;
+  arma::Col<size_t> indices("1 3");
+  data::OneHotEncoding(input, indices, output);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == output.n_rows);
+  REQUIRE(sparseOutput.n_cols == output.n_cols);
+  // The zeros of the dimensions that are not encoded are not stored.
+  REQUIRE(sparseOutput.n_nonzero == (size_t) arma::accu(output != 0));
+  for (size_t i = 0; i < output.n_elem; ++i)
+    REQUIRE(sparseOutput(i) == output(i));
+}
+
+/**
+ * Make sure that all the NaN values of an encoded dimension are one category.
+ */
+TEST_CASE("OneHotEncodingNaNTest", "[OneHotEncodingTest]")
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  arma::mat input(2, 5);
+  input.row(0) = arma::rowvec({ 1.0, nan, 2.0, nan, 1.0 });
+  input.row(1) = arma::rowvec({ 0.5, 1.5, 2.5, 3.5, 4.5 });
+
+  // The categories of the first dimension are 1, NaN and 2.
+  arma::mat expected = { { 1.0, 0.0, 0.0, 0.0, 1.0 },
+                         { 0.0, 1.0, 0.0, 1.0, 0.0 },
+                         { 0.0, 0.0, 1.0, 0.0, 0.0 },
+                         { 0.5, 1.5, 2.5, 3.5, 4.5 } };
+
+  arma::mat output;
+  arma::sp_mat sparseOutput;
+  arma::Col<size_t> indices("0");
+  data::OneHotEncoding(input, indices, output);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(output.n_rows == expected.n_rows);
+  REQUIRE(output.n_cols == expected.n_cols);
+  REQUIRE(sparseOutput.n_rows == expected.n_rows);
+  REQUIRE(sparseOutput.n_cols == expected.n_cols);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+  {
+    REQUIRE(output(i) == expected(i));
+    REQUIRE(sparseOutput(i) == expected(i));
+  }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file tests/preprocess_pipeline_test.cpp
+ *
+ * Tests for the preprocessing Pipeline and PipelineModel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/imputation_methods/mean_imputation.hpp>
+#include <mlpack/core/data/imputation_methods/median_imputation.hpp>
+#include <mlpack/core/data/one_hot_encoding.hpp>
+#include <mlpack/core/data/scaler_methods/pca_whitening.hpp>
+#include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
+#include <mlpack/core/data/scaler_methods/zca_whitening.hpp>
+#include <mlpack/methods/linear_regression/linear_regression.hpp>
+#include <mlpack/methods/preprocess/pipeline.hpp>
+#include <mlpack/methods/preprocess/pipeline_model.hpp>
+
+#include "serialization_catch.hpp"
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+using namespace mlpack::regression;
+
+/**
+ * Make sure that the pipeline gives the same result as the imputers, the
+ * one-hot encoding and the scaler applied one after the other.
+ */
+TEST_CASE("PipelineTransformTest", "[PreprocessPipelineTest]")
+{
+  arma::mat data(4, 20000, arma::fill::randu);
+  // Dimension 1 is categorical, with 5 categories.
+  data.row(1) = arma::floor(5 * data.row(1));
+  // Dimensions 0 and 2 have missing values.
+  for (size_t i = 0; i < data.n_cols; i += 7)
+    data(0, i) = -1.0;
+  for (size_t i = 0; i < data.n_cols; i += 11)
+    data(2, i) = std::numeric_limits<double>::quiet_NaN();
+
+  Pipeline pipeline;
+  pipeline.AddImputation(0, -1.0, Pipeline::MEAN_IMPUTATION);
+  pipeline.AddImputation(2, std::numeric_limits<double>::quiet_NaN(),
+      Pipeline::MEDIAN_IMPUTATION);
+  pipeline.AddOneHotEncoding(1);
+  pipeline.AddScaling(ScalingModel::STANDARD_SCALER);
+  pipeline.Fit(data);
+
+  arma::mat output;
+  pipeline.Transform(data, output);
+  REQUIRE(pipeline.InputDimensionality() == 4);
+  REQUIRE(pipeline.OutputDimensionality() == 8);
+
+  arma::mat expected(data);
+  MeanImputation<double>().Impute(expected, -1.0, 0);
+  MedianImputation<double>().Impute(expected,
+      std::numeric_limits<double>::quiet_NaN(), 2);
+  arma::mat encoded;
+  OneHotEncoding(expected, arma::Col<size_t>("1"), encoded);
+  StandardScaler scaler;
+  scaler.Fit(encoded);
+  scaler.Transform(encoded, expected);
+
+  CheckMatrices(output, expected);
+}
+
+/**
+ * Make sure that the pipeline whitens the data like PCAWhitening and
+ * ZCAWhitening do, with more points than fit in a block.
+ */
+TEST_CASE("PipelineWhiteningTest", "[PreprocessPipelineTest]")
+{
+  arma::mat data(5, 20000, arma::fill::randu);
+  // Correlate the dimensions, so that whitening is not just scaling.
+  data.row(1) += 2.0 * data.row(0);
+  data.row(3) -= data.row(2);
+  for (size_t i = 0; i < data.n_cols; i += 7)
+    data(4, i) = -1.0;
+
+  arma::mat imputed(data);
+  MeanImputation<double>().Impute(imputed, -1.0, 4);
+
+  Pipeline pcaPipeline;
+  pcaPipeline.AddImputation(4, -1.0, Pipeline::MEAN_IMPUTATION);
+  pcaPipeline.AddScaling(ScalingModel::PCA_WHITENING);
+  pcaPipeline.Fit(data);
+
+  arma::mat output, expected;
+  pcaPipeline.Transform(data, output);
+  PCAWhitening pca;
+  pca.Fit(imputed);
+  pca.Transform(imputed, expected);
+  CheckMatrices(output, expected);
+
+  Pipeline zcaPipeline;
+  zcaPipeline.AddImputation(4, -1.0, Pipeline::MEAN_IMPUTATION);
+  zcaPipeline.AddScaling(ScalingModel::ZCA_WHITENING);
+  zcaPipeline.Fit(data);
+
+  zcaPipeline.Transform(data, output);
+  ZCAWhitening zca;
+  zca.Fit(imputed);
+  zca.Transform(imputed, expected);
+  CheckMatrices(output, expected);
+}
+
+/**
+ * Make sure that a serialized pipeline transforms data like the original one,
+ * and that unknown categories are encoded as zeros.
+ */
+TEST_CASE("PipelineSerializationTest", "[PreprocessPipelineTest]")
+{
+  arma::mat data(3, 100, arma::fill::randu);
+  data.row(0) = arma::floor(3 * data.row(0));
+  data(2, 5) = std::numeric_limits<double>::quiet_NaN();
+
+  Pipeline pipeline;
+  pipeline.AddImputation(2, std::numeric_limits<double>::quiet_NaN(),
+      Pipeline::MEAN_IMPUTATION);
+  pipeline.AddOneHotEncoding(0);
+  pipeline.AddScaling(ScalingModel::MIN_MAX_SCALER);
+  pipeline.Fit(data);
+
+  arma::mat test(3, 10, arma::fill::randu);
+  test.row(0) = arma::floor(3 * test.row(0));
+  test(0, 0) = 7.0;
+  test(2, 1) = std::numeric_limits<double>::quiet_NaN();
+
+  arma::mat output;
+  pipeline.Transform(test, output);
+  REQUIRE(output.n_rows == 5);
+  REQUIRE(arma::accu(arma::abs(output.submat(0, 0, 2, 0))) == 0.0);
+  REQUIRE(output.is_finite());
+
+  Pipeline xmlPipeline, textPipeline, binaryPipeline;
+  SerializeObjectAll(pipeline, xmlPipeline, textPipeline, binaryPipeline);
+
+  arma::mat xmlOutput, textOutput, binaryOutput;
+  xmlPipeline.Transform(test, xmlOutput);
+  textPipeline.Transform(test, textOutput);
+  binaryPipeline.Transform(test, binaryOutput);
+
+  CheckMatrices(output, xmlOutput);
+  CheckMatrices(output, textOutput);
+  CheckMatrices(output, binaryOutput);
+}
+
+/**
+ * Make sure that a PipelineModel applies its pipeline before its model.
+ */
+TEST_CASE("PipelineModelTest", "[PreprocessPipelineTest]")
+{
+  arma::mat data(3, 500, arma::fill::randu);
+  data.row(0) = arma::floor(3 * data.row(0));
+  const arma::rowvec responses = 2 * data.row(1) + data.row(0) - data.row(2);
+
+  Pipeline pipeline;
+  pipeline.AddOneHotEncoding(0);
+  pipeline.AddScaling(ScalingModel::STANDARD_SCALER);
+
+  PipelineModel<LinearRegression> model(pipeline);
+  model.Train(data, responses);
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+
+  arma::mat transformed;
+  model.Preprocessing().Transform(data, transformed);
+  REQUIRE(transformed.n_rows == 5);
+  arma::rowvec expected;
+  model.Model().Predict(transformed, expected);
+
+  CheckMatrices(predictions, expected);
+}
@@ -126,6 +126,59 @@ BOOST_AUTO_TEST_CASE(CartPoleWithDQN)
   BOOST_REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task, stepping several copies of the task at once.
+BOOST_AUTO_TEST_CASE(CartPoleWithDQNVectorizedEnvironment)
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  // Setting all training hyperparameters.
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  VectorizedEnvironment<CartPole> environments(4);
+
+  bool converged = false;
+  std::vector<double> returnList;
+  for (size_t episodes = 0; episodes < 250; ++episodes)
+  {
+    const size_t steps = agent.TotalSteps();
+    arma::vec episodeReturns = agent.Episode(environments);
+    BOOST_REQUIRE_EQUAL(episodeReturns.n_elem, 4);
+
+    // Every copy takes at least one step.
+    BOOST_REQUIRE_GE(agent.TotalSteps() - steps, 4);
+
+    returnList.insert(returnList.end(), episodeReturns.begin(),
+        episodeReturns.end());
+    if (returnList.size() > 50)
+      returnList.erase(returnList.begin(), returnList.end() - 50);
+
+    const double averageReturn = std::accumulate(returnList.begin(),
+        returnList.end(), 0.0) / returnList.size();
+    if (averageReturn > 40 && returnList.size() >= 50)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  BOOST_REQUIRE(converged);
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 BOOST_AUTO_TEST_CASE(CartPoleWithDQNPrioritizedReplay)
 {
@@ -1384,4 +1384,169 @@ BOOST_AUTO_TEST_CASE(RectangleTreeMoveDatasetTest)
   BOOST_REQUIRE_EQUAL(tree.Dataset().n_cols, 1000);
 }
 
+// Make sure that a bulk-loaded R* tree is valid and balanced, stays valid
+// under later insertions and deletions, and gives correct search results.
+BOOST_AUTO_TEST_CASE(RStarTreeBulkLoadTest)
+{
+  const int numIter = 50;
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RStarTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType tree(dataset, STRPacking(), 20, 6, 5, 2);
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+  BOOST_REQUIRE_EQUAL(GetMinLevel(tree), GetMaxLevel(tree));
+  BOOST_REQUIRE_EQUAL(tree.TreeDepth(), GetMinLevel(tree));
+
+  // Delete some points, then add some new ones.
+  for (int i = 0; i < numIter; ++i)
+    tree.DeletePoint(999 - i);
+
+  tree.Dataset().reshape(8, 1000 + numIter);
+  dataset.reshape(8, 1000 + numIter);
+  arma::mat tmpData;
+  tmpData.randu(8, numIter);
+  for (int i = 0; i < numIter; ++i)
+  {
+    tree.Dataset().col(1000 + i) = tmpData.col(i);
+    dataset.col(1000 + i) = tmpData.col(i);
+    tree.InsertPoint(1000 + i);
+  }
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  BOOST_REQUIRE_EQUAL(GetMinLevel(tree), GetMaxLevel(tree));
+
+  arma::mat querySet;
+  querySet.randu(8, 200);
+
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RStarTree> knn1(std::move(tree), SINGLE_TREE_MODE);
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(querySet, 5, neighbors1, distances1);
+
+  // The naive search must not see the deleted points.
+  arma::mat newDataset = arma::join_rows(dataset.cols(0, 999 - numIter),
+      dataset.cols(1000, 1000 + numIter - 1));
+  KNN knn2(newDataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(querySet, 5, neighbors2, distances2);
+
+  for (size_t i = 0; i < distances1.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(distances1[i], distances2[i], 1e-5);
+}
+
+// Make sure that a bulk-loaded Hilbert R tree keeps its points in Hilbert
+// order, also after new points are inserted.
+BOOST_AUTO_TEST_CASE(HilbertRTreeBulkLoadTest)
+{
+  const int numIter = 50;
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef HilbertRTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType tree(dataset, HilbertPacking(), 20, 6, 5, 2);
+
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+  CheckHilbertOrdering(tree);
+  CheckDiscreteHilbertValueSync(tree);
+  BOOST_REQUIRE_EQUAL(GetMinLevel(tree), GetMaxLevel(tree));
+
+  tree.Dataset().reshape(8, 1000 + numIter);
+  arma::mat tmpData;
+  tmpData.randu(8, numIter);
+  for (int i = 0; i < numIter; ++i)
+  {
+    tree.Dataset().col(1000 + i) = tmpData.col(i);
+    tree.InsertPoint(1000 + i);
+  }
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1000 + numIter);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+  CheckHilbertOrdering(tree);
+  CheckDiscreteHilbertValueSync(tree);
+}
+
+// Make sure that the children of bulk-loaded R+ and R++ trees do not overlap.
+BOOST_AUTO_TEST_CASE(RPlusTreeBulkLoadTest)
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RPlusTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RPlusTreeType;
+  RPlusTreeType rPlusTree(dataset, STRPacking(), 20, 6, 5, 2);
+
+  CheckContainment(rPlusTree);
+  CheckExactContainment(rPlusTree);
+  CheckNumDescendants(rPlusTree);
+  CheckOverlap(rPlusTree);
+  BOOST_REQUIRE_EQUAL(GetMinLevel(rPlusTree), GetMaxLevel(rPlusTree));
+
+  typedef RPlusPlusTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RPlusPlusTreeType;
+  RPlusPlusTreeType rPlusPlusTree(dataset, STRPacking(), 20, 6, 5, 2);
+
+  CheckContainment(rPlusPlusTree);
+  CheckExactContainment(rPlusPlusTree);
+  CheckNumDescendants(rPlusPlusTree);
+  CheckRPlusPlusTreeBound(rPlusPlusTree);
+  BOOST_REQUIRE_EQUAL(GetMinLevel(rPlusPlusTree), GetMaxLevel(rPlusPlusTree));
+
+  // New points must respect the outer bounds that came from the packing.
+  rPlusPlusTree.Dataset().reshape(8, 1050);
+  rPlusPlusTree.Dataset().cols(1000, 1049).randu();
+  for (size_t i = 1000; i < 1050; ++i)
+    rPlusPlusTree.InsertPoint(i);
+
+  CheckContainment(rPlusPlusTree);
+  CheckNumDescendants(rPlusPlusTree);
+  CheckRPlusPlusTreeBound(rPlusPlusTree);
+}
+
+// Make sure that each packing only accepts the trees it can bulk load.
+BOOST_AUTO_TEST_CASE(BulkLoadPackingSupportTest)
+{
+  typedef RPlusTreeSplit<RPlusTreeSplitPolicy, MinimalCoverageSweep>
+      RPlusSplit;
+  typedef RPlusTreeSplit<RPlusPlusTreeSplitPolicy, MinimalSplitsNumberSweep>
+      RPlusPlusSplit;
+
+  BOOST_REQUIRE((STRPacking::SupportsTree<RStarTreeSplit,
+      RStarTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((STRPacking::SupportsTree<RPlusSplit,
+      RPlusTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((STRPacking::SupportsTree<RPlusPlusSplit,
+      RPlusPlusTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((!STRPacking::SupportsTree<HilbertRTreeSplit<2>,
+      HilbertRTreeDescentHeuristic>::value));
+
+  BOOST_REQUIRE((HilbertPacking::SupportsTree<RTreeSplit,
+      RTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((HilbertPacking::SupportsTree<HilbertRTreeSplit<2>,
+      HilbertRTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((!HilbertPacking::SupportsTree<RPlusSplit,
+      RPlusTreeDescentHeuristic>::value));
+  BOOST_REQUIRE((!HilbertPacking::SupportsTree<RPlusPlusSplit,
+      RPlusPlusTreeDescentHeuristic>::value));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
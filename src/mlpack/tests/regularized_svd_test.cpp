@@ -314,4 +314,50 @@ TEST_CASE("RegularizedSVDFunctionOptimizeHOGWILD", "[RegularizedSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Make sure that the stratified parallel SGD used with ExponentialBackoff gives
+// the same result for the same random seed, and decreases the objective.
+TEST_CASE("RegularizedSVDFunctionStratifiedParallelSGD", "[RegularizedSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 500;
+  const size_t rank = 5;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data.row(2) = floor(data.row(2) * 5 + 0.5);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  RegularizedSVDFunction<arma::mat> function(data, rank, lambda);
+
+  // Both runs use the same number of threads, so the ratings are partitioned in
+  // the same way.
+  const size_t threadShareSize = std::ceil((float) function.NumFunctions() / 4);
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer1(20, threadShareSize, 0,
+      true, ens::ExponentialBackoff(100, alpha, 0.9));
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer2(20, threadShareSize, 0,
+      true, ens::ExponentialBackoff(100, alpha, 0.9));
+
+  const arma::mat initialParameters = function.GetInitialPoint();
+  arma::mat parameters1 = initialParameters;
+  arma::mat parameters2 = initialParameters;
+
+  math::RandomSeed(42);
+  optimizer1.Optimize(function, parameters1);
+  math::RandomSeed(42);
+  optimizer2.Optimize(function, parameters2);
+
+  REQUIRE(arma::approx_equal(parameters1, parameters2, "absdiff", 1e-10));
+  REQUIRE(function.Evaluate(parameters1) <
+      function.Evaluate(initialParameters));
+}
+
 #endif
@@ -172,3 +172,43 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Make sure the scalers give the same result as the plain Armadillo
+ * expressions on a dataset that is processed in several blocks of columns.
+ */
+TEST_CASE("ColumnBlockedScalingTest", "[ScalingTest]")
+{
+  arma::mat input(5, 20000, arma::fill::randu);
+  input.row(1) *= 100.0;
+  input.row(3) -= 0.5;
+
+  const arma::vec mean = arma::mean(input, 1);
+  const arma::vec stddev = arma::stddev(input, 1, 1);
+  const arma::vec min = arma::min(input, 1);
+  const arma::vec max = arma::max(input, 1);
+
+  data::StandardScaler standard;
+  standard.Fit(input);
+  arma::mat output;
+  standard.Transform(input, output);
+  CheckMatrices(standard.ItemMean(), mean);
+  CheckMatrices(standard.ItemStdDev(), stddev);
+  CheckMatrices(output,
+      arma::mat((input.each_col() - mean).each_col() / stddev));
+
+  data::MinMaxScaler minMax;
+  minMax.Fit(input);
+  minMax.Transform(input, output);
+  CheckMatrices(minMax.ItemMin(), min);
+  CheckMatrices(minMax.ItemMax(), max);
+  CheckMatrices(output,
+      arma::mat((input.each_col() - min).each_col() / (max - min)));
+
+  data::ZCAWhitening zca;
+  zca.Fit(input);
+  zca.Transform(input, output);
+  const arma::mat whitened = arma::diagmat(1.0 / arma::sqrt(zca.EigenValues()))
+      * zca.EigenVectors().t() * (input.each_col() - mean);
+  CheckMatrices(output, arma::mat(zca.EigenVectors() * whitened));
+}
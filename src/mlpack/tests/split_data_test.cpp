@@ -212,3 +212,32 @@ TEST_CASE("SplitLabeledDataLargerTest", "[SplitDataTest]")
 
   CheckDuplication(std::get<2>(value), std::get<3>(value));
 }
+
+/**
+ * Make sure that the index-only split gives the same split as the one that
+ * copies the data, for the same random seed.
+ */
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 497, arma::fill::randu);
+
+  math::RandomSeed(100);
+  uvec trainIndices, testIndices;
+  Split(input.n_cols, trainIndices, testIndices, 0.3);
+  REQUIRE(trainIndices.n_elem == 497 - size_t(0.3 * 497));
+  REQUIRE(testIndices.n_elem == size_t(0.3 * 497));
+
+  math::RandomSeed(100);
+  mat trainData, testData;
+  Split(input, trainData, testData, 0.3);
+
+  CheckMatrices(trainData, mat(input.cols(trainIndices)));
+  CheckMatrices(testData, mat(input.cols(testIndices)));
+
+  // Without shuffling, the indices are in order.
+  std::tie(trainIndices, testIndices) = Split(input.n_cols, 0.3, false);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    REQUIRE(trainIndices[i] == i);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    REQUIRE(testIndices[i] == trainIndices.n_elem + i);
+}
@@ -16,6 +16,7 @@
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
 
+#include <fstream>
 #include <queue>
 #include <stack>
 
@@ -1360,6 +1361,339 @@ BOOST_AUTO_TEST_CASE(KdTreeTest)
   TreeType root(dataset);
 }
 
+/**
+ * Build a kd-tree large enough for its top levels to be built in parallel,
+ * and make sure that it is valid and does not depend on the scheduling of the
+ * threads.
+ */
+BOOST_AUTO_TEST_CASE(ParallelKdTreeTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 60000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew, oldFromNew2;
+  TreeType root(dataset, oldFromNew);
+  TreeType root2(dataset, oldFromNew2);
+
+  BOOST_REQUIRE_EQUAL(root.Count(), dataset.n_cols);
+  BOOST_REQUIRE(CheckPointBounds(root));
+
+  // Check the mapping, and that both builds gave the same tree.
+  const arma::mat& treeset = root.Dataset();
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(oldFromNew[i], oldFromNew2[i]);
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+      BOOST_REQUIRE_EQUAL(treeset(j, i), dataset(j, oldFromNew[i]));
+  }
+
+  // Walk both trees together.
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(&root, &root2));
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top().first;
+    TreeType* node2 = nodes.top().second;
+    nodes.pop();
+
+    BOOST_REQUIRE_EQUAL(node->Begin(), node2->Begin());
+    BOOST_REQUIRE_EQUAL(node->Count(), node2->Count());
+    BOOST_REQUIRE_EQUAL(node->NumChildren(), node2->NumChildren());
+    BOOST_REQUIRE_CLOSE(node->ParentDistance(), node2->ParentDistance(),
+        1e-5);
+
+    if (!node->IsLeaf())
+    {
+      nodes.push(std::make_pair(node->Left(), node2->Left()));
+      nodes.push(std::make_pair(node->Right(), node2->Right()));
+    }
+  }
+}
+
+/**
+ * Make sure that the nodes of a kd-tree are held in depth-first order in the
+ * arena, and that copies and moves of the tree are independent of the arena.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeNodeArenaTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 5000, arma::fill::randu);
+  TreeType* root = new TreeType(dataset, 10);
+
+  // A tree of this size is built by one thread, so every node but the root is
+  // next to the previous node in depth-first order, except where a new block
+  // of the arena starts.
+  std::vector<TreeType*> preorder;
+  std::stack<TreeType*> nodes;
+  nodes.push(root);
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top();
+    nodes.pop();
+    preorder.push_back(node);
+
+    if (!node->IsLeaf())
+    {
+      nodes.push(node->Right());
+      nodes.push(node->Left());
+    }
+  }
+
+  BOOST_REQUIRE_GT(preorder.size(), (size_t) 64);
+  size_t jumps = 0;
+  for (size_t i = 2; i < preorder.size(); ++i)
+  {
+    if (preorder[i] != preorder[i - 1] + 1)
+      ++jumps;
+  }
+  BOOST_REQUIRE_LE(jumps, preorder.size() / 64);
+
+  // Copy and move the tree, then destroy the original tree first.
+  TreeType copy(*root);
+  TreeType moved(std::move(*root));
+  delete root;
+
+  BOOST_REQUIRE_EQUAL(copy.Count(), dataset.n_cols);
+  BOOST_REQUIRE_EQUAL(moved.Count(), dataset.n_cols);
+  BOOST_REQUIRE(CheckPointBounds(copy));
+  BOOST_REQUIRE(CheckPointBounds(moved));
+  BOOST_REQUIRE_EQUAL(moved.Left()->Parent(), &moved);
+  BOOST_REQUIRE_EQUAL(moved.Right()->Parent(), &moved);
+
+  // Assigning over a tree held in an arena frees its nodes.
+  moved = copy;
+  BOOST_REQUIRE_EQUAL(moved.Count(), dataset.n_cols);
+  BOOST_REQUIRE(CheckPointBounds(moved));
+}
+
+/**
+ * Save the given tree to a flat file, load it back, and make sure that the
+ * loaded tree is the same as the original tree.
+ */
+template<typename TreeType>
+void CheckFlatFile(TreeType& root, const std::vector<size_t>& oldFromNew)
+{
+  const std::string filename = "flat_tree_test.bin";
+  root.SaveFlat(filename, oldFromNew);
+
+  std::vector<size_t> loadedOldFromNew;
+  TreeType loaded(filename, loadedOldFromNew);
+
+  BOOST_REQUIRE_EQUAL(loadedOldFromNew.size(), oldFromNew.size());
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    BOOST_REQUIRE_EQUAL(loadedOldFromNew[i], oldFromNew[i]);
+
+  const arma::mat& dataset = root.Dataset();
+  const arma::mat& loadedDataset = loaded.Dataset();
+  BOOST_REQUIRE_EQUAL(loadedDataset.n_rows, dataset.n_rows);
+  BOOST_REQUIRE_EQUAL(loadedDataset.n_cols, dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(loadedDataset[i], dataset[i]);
+
+  // Walk both trees together.
+  const arma::vec point(dataset.n_rows, arma::fill::ones);
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(&root, &loaded));
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top().first;
+    TreeType* node2 = nodes.top().second;
+    nodes.pop();
+
+    BOOST_REQUIRE_EQUAL(node->Begin(), node2->Begin());
+    BOOST_REQUIRE_EQUAL(node->Count(), node2->Count());
+    BOOST_REQUIRE_EQUAL(node->NumChildren(), node2->NumChildren());
+    BOOST_REQUIRE_EQUAL(node->ParentDistance(), node2->ParentDistance());
+    BOOST_REQUIRE_EQUAL(node->FurthestDescendantDistance(),
+        node2->FurthestDescendantDistance());
+    BOOST_REQUIRE_EQUAL(node->MinimumBoundDistance(),
+        node2->MinimumBoundDistance());
+    BOOST_REQUIRE_EQUAL(node->MinDistance(point), node2->MinDistance(point));
+    BOOST_REQUIRE_EQUAL(node->MaxDistance(point), node2->MaxDistance(point));
+
+    if (!node->IsLeaf())
+    {
+      BOOST_REQUIRE_EQUAL(node2->Left()->Parent(), node2);
+      BOOST_REQUIRE_EQUAL(node2->Right()->Parent(), node2);
+      nodes.push(std::make_pair(node->Left(), node2->Left()));
+      nodes.push(std::make_pair(node->Right(), node2->Right()));
+    }
+  }
+
+  remove(filename.c_str());
+}
+
+/**
+ * Save a kd-tree to a flat file and load it back.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeFlatFileTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(4, 3000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew);
+
+  CheckFlatFile(root, oldFromNew);
+  CheckFlatFile(root, std::vector<size_t>());
+}
+
+/**
+ * Save a ball tree to a flat file and load it back, and make sure that a ball
+ * tree file cannot be loaded as a kd-tree.
+ */
+BOOST_AUTO_TEST_CASE(BallTreeFlatFileTest)
+{
+  typedef BallTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> KDTreeType;
+
+  arma::mat dataset(4, 3000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew);
+
+  CheckFlatFile(root, oldFromNew);
+
+  const std::string filename = "flat_ball_tree_test.bin";
+  root.SaveFlat(filename, oldFromNew);
+  std::vector<size_t> kdOldFromNew;
+  BOOST_REQUIRE_THROW(KDTreeType kdTree(filename, kdOldFromNew),
+      std::runtime_error);
+  remove(filename.c_str());
+}
+
+/**
+ * Make sure that flat files whose sections or nodes point outside of the file
+ * or the dataset are rejected.
+ */
+BOOST_AUTO_TEST_CASE(CorruptFlatFileTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew);
+
+  const std::string filename = "corrupt_flat_tree_test.bin";
+  FlatTreeHeader header;
+  FlatNode node;
+  std::vector<size_t> loadedOldFromNew;
+
+  // Move the mapping past the end of the file.
+  root.SaveFlat(filename, oldFromNew);
+  {
+    std::fstream file(filename, std::ios::in | std::ios::out |
+        std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(FlatTreeHeader));
+    header.mappingOffset = header.fileSize;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header),
+        sizeof(FlatTreeHeader));
+  }
+  BOOST_REQUIRE_THROW(TreeType tree(filename, loadedOldFromNew),
+      std::runtime_error);
+
+  // Give the second node more points than the dataset holds.
+  root.SaveFlat(filename, oldFromNew);
+  {
+    std::fstream file(filename, std::ios::in | std::ios::out |
+        std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(FlatTreeHeader));
+    file.seekg(header.nodesOffset + sizeof(FlatNode));
+    file.read(reinterpret_cast<char*>(&node), sizeof(FlatNode));
+    node.count = dataset.n_cols + 1;
+    file.seekp(header.nodesOffset + sizeof(FlatNode));
+    file.write(reinterpret_cast<const char*>(&node), sizeof(FlatNode));
+  }
+  BOOST_REQUIRE_THROW(TreeType tree(filename, loadedOldFromNew),
+      std::runtime_error);
+
+  // Make both children of the root the same node.
+  root.SaveFlat(filename, oldFromNew);
+  {
+    std::fstream file(filename, std::ios::in | std::ios::out |
+        std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(FlatTreeHeader));
+    file.seekg(header.nodesOffset);
+    file.read(reinterpret_cast<char*>(&node), sizeof(FlatNode));
+    node.right = node.left;
+    file.seekp(header.nodesOffset);
+    file.write(reinterpret_cast<const char*>(&node), sizeof(FlatNode));
+  }
+  BOOST_REQUIRE_THROW(TreeType tree(filename, loadedOldFromNew),
+      std::runtime_error);
+
+  remove(filename.c_str());
+}
+
+/**
+ * Make sure that flat files where a node has a single child, or where a child
+ * holds points that its parent does not hold, are rejected.
+ */
+BOOST_AUTO_TEST_CASE(MalformedFlatFileTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew);
+
+  const std::string filename = "malformed_flat_tree_test.bin";
+  FlatTreeHeader header;
+  FlatNode node, child;
+  std::vector<size_t> loadedOldFromNew;
+
+  // Move the right child of the root below the last node of the left subtree,
+  // which is a leaf.  Every node still has one parent that comes before it,
+  // but the root and the leaf have one child each.
+  root.SaveFlat(filename, oldFromNew);
+  {
+    std::fstream file(filename, std::ios::in | std::ios::out |
+        std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(FlatTreeHeader));
+    file.seekg(header.nodesOffset);
+    file.read(reinterpret_cast<char*>(&node), sizeof(FlatNode));
+    const uint64_t right = node.right;
+    node.right = 0;
+    file.seekp(header.nodesOffset);
+    file.write(reinterpret_cast<const char*>(&node), sizeof(FlatNode));
+
+    file.seekg(header.nodesOffset + (right - 1) * sizeof(FlatNode));
+    file.read(reinterpret_cast<char*>(&node), sizeof(FlatNode));
+    BOOST_REQUIRE(node.left == 0);
+    node.left = right;
+    file.seekp(header.nodesOffset + (right - 1) * sizeof(FlatNode));
+    file.write(reinterpret_cast<const char*>(&node), sizeof(FlatNode));
+  }
+  BOOST_REQUIRE_THROW(TreeType tree(filename, loadedOldFromNew),
+      std::runtime_error);
+
+  // Move the points of the left child of the root to the points of the right
+  // child.  They are still in the dataset.
+  root.SaveFlat(filename, oldFromNew);
+  {
+    std::fstream file(filename, std::ios::in | std::ios::out |
+        std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(FlatTreeHeader));
+    file.seekg(header.nodesOffset);
+    file.read(reinterpret_cast<char*>(&node), sizeof(FlatNode));
+    file.seekg(header.nodesOffset + node.right * sizeof(FlatNode));
+    file.read(reinterpret_cast<char*>(&child), sizeof(FlatNode));
+    const uint64_t begin = child.begin;
+    file.seekg(header.nodesOffset + node.left * sizeof(FlatNode));
+    file.read(reinterpret_cast<char*>(&child), sizeof(FlatNode));
+    child.begin = begin;
+    child.count = std::min<uint64_t>(child.count, dataset.n_cols - begin);
+    file.seekp(header.nodesOffset + node.left * sizeof(FlatNode));
+    file.write(reinterpret_cast<const char*>(&child), sizeof(FlatNode));
+  }
+  BOOST_REQUIRE_THROW(TreeType tree(filename, loadedOldFromNew),
+      std::runtime_error);
+
+  remove(filename.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(MaxRPTreeTest)
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -1590,6 +1924,53 @@ BOOST_AUTO_TEST_CASE(RPTreeSplitTest)
   CheckRPTreeSplit<TreeType, EuclideanDistance>(root);
 }
 
+/**
+ * Build a max-RP tree large enough for its top levels to be built in parallel
+ * twice with the same seed, and make sure that both trees are the same.  The
+ * seed is set with a LocalRandomSeed, which the build has to follow.
+ */
+BOOST_AUTO_TEST_CASE(SeededParallelMaxRPTreeTest)
+{
+  typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 60000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew, oldFromNew2;
+  std::unique_ptr<TreeType> root, root2;
+  {
+    math::LocalRandomSeed localSeed(42);
+    root.reset(new TreeType(dataset, oldFromNew));
+  }
+  {
+    math::LocalRandomSeed localSeed(42);
+    root2.reset(new TreeType(dataset, oldFromNew2));
+  }
+
+  BOOST_REQUIRE_EQUAL(root->Count(), dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(oldFromNew[i], oldFromNew2[i]);
+
+  // Walk both trees together.
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(root.get(), root2.get()));
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top().first;
+    TreeType* node2 = nodes.top().second;
+    nodes.pop();
+
+    BOOST_REQUIRE_EQUAL(node->Begin(), node2->Begin());
+    BOOST_REQUIRE_EQUAL(node->Count(), node2->Count());
+    BOOST_REQUIRE_EQUAL(node->NumChildren(), node2->NumChildren());
+
+    if (!node->IsLeaf())
+    {
+      nodes.push(std::make_pair(node->Left(), node2->Left()));
+      nodes.push(std::make_pair(node->Right(), node2->Right()));
+    }
+  }
+}
+
 // Recursively checks that each node contains all points that it claims to have.
 template<typename TreeType>
 bool CheckPointBounds(TreeType& node)
@@ -1951,6 +2332,53 @@ BOOST_AUTO_TEST_CASE(CoverTreeConstructionTest)
   // implementation.
 }
 
+/**
+ * Build a cover tree large enough for its distances to be computed in parallel,
+ * and make sure that it is valid and does not depend on the scheduling of the
+ * threads.
+ */
+BOOST_AUTO_TEST_CASE(ParallelCoverTreeConstructionTest)
+{
+  arma::mat dataset;
+  // 20-dimensional, 8000 point.
+  dataset.randu(20, 8000);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+  TreeType tree2(dataset);
+
+  arma::vec counts;
+  counts.zeros(8000);
+  RecurseTreeCountLeaves(tree, counts);
+
+  for (size_t i = 0; i < 8000; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+
+  CheckSelfChild<TreeType>(tree);
+  CheckCovering<TreeType, LMetric<2, true> >(tree);
+
+  // Walk both trees together.
+  std::stack<std::pair<TreeType*, TreeType*>> nodes;
+  nodes.push(std::make_pair(&tree, &tree2));
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top().first;
+    TreeType* node2 = nodes.top().second;
+    nodes.pop();
+
+    BOOST_REQUIRE_EQUAL(node->Point(), node2->Point());
+    BOOST_REQUIRE_EQUAL(node->Scale(), node2->Scale());
+    BOOST_REQUIRE_EQUAL(node->NumDescendants(), node2->NumDescendants());
+    BOOST_REQUIRE_EQUAL(node->NumChildren(), node2->NumChildren());
+    BOOST_REQUIRE_CLOSE(node->FurthestDescendantDistance(),
+        node2->FurthestDescendantDistance(), 1e-5);
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(std::make_pair(&node->Child(i), &node2->Child(i)));
+  }
+}
+
 /**
  * Create a cover tree on sparse data and make sure it's accurate.
  */
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 
 #include <mlpack/core.hpp>
 #include <boost/test/unit_test.hpp>
@@ -51,4 +52,37 @@ BOOST_AUTO_TEST_CASE(TestUnion)
   BOOST_REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
 
+/**
+ * Union many pairs from several threads at once, and make sure the components
+ * are correct and each union succeeded exactly once.
+ */
+BOOST_AUTO_TEST_CASE(ConcurrentUnionTest)
+{
+  static const size_t testSize = 10000;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  // Join every point with the next point of the same parity; each pair is
+  // given twice, in both orders.
+  size_t successes = 0;
+  #pragma omp parallel for reduction(+:successes)
+  for (omp_size_t i = 0; i < (omp_size_t) (2 * (testSize - 2)); ++i)
+  {
+    const size_t j = i % (testSize - 2);
+    const bool merged = (i < testSize - 2) ?
+        testUnionFind.Union(j, j + 2) : testUnionFind.Union(j + 2, j);
+    if (merged)
+      ++successes;
+  }
+
+  BOOST_REQUIRE_EQUAL(successes, testSize - 2);
+
+  // The representative of each component is its smallest element.
+  for (size_t i = 0; i < testSize; ++i)
+    BOOST_REQUIRE_EQUAL(testUnionFind.Find(i), i % 2);
+
+  BOOST_REQUIRE(!testUnionFind.Union(0, testSize - 2));
+  BOOST_REQUIRE(testUnionFind.Union(1, testSize - 2));
+  BOOST_REQUIRE_EQUAL(testUnionFind.Find(testSize - 1), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -14,6 +14,8 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
+#include <stack>
+
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -188,6 +190,49 @@ BOOST_AUTO_TEST_CASE(VPTreeBoundTest)
   CheckBound(tree);
 }
 
+/**
+ * Check the bounds of a VP tree large enough for its top levels to be built in
+ * parallel; the hole of each right child is centered at its left sibling.
+ */
+BOOST_AUTO_TEST_CASE(ParallelVPTreeBoundTest)
+{
+  typedef VPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(4, 50000);
+  dataset.randu();
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+  CheckBound(tree);
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+      BOOST_REQUIRE_EQUAL(tree.Dataset()(j, i), dataset(j, oldFromNew[i]));
+  }
+
+  // The hole of every right child is centered at its left sibling.
+  std::stack<TreeType*> stack;
+  stack.push(&tree);
+  while (!stack.empty())
+  {
+    TreeType* node = stack.top();
+    stack.pop();
+    if (node->IsLeaf())
+      continue;
+
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(node->Right()->Bound().HollowCenter()[j],
+          node->Left()->Bound().Center()[j]);
+    }
+
+    stack.push(node->Left());
+    stack.push(node->Right());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(VPTreeTest)
 {
   typedef VPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;